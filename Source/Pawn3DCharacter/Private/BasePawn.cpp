@@ -1,11 +1,18 @@
 ﻿#include "BasePawn.h"
+#include "BasePawnMovementComponent.h"
+#include "P3DNetMovementComponent.h"
+#include "P3DReplaySubsystem.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "EnhancedInputComponent.h"
 #include "P3DPlayerController.h"
+#include "P3DProfiling.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/ScopeExit.h"
 
 ABasePawn::ABasePawn()
 {
@@ -18,7 +25,7 @@ ABasePawn::ABasePawn()
     CapsuleComp->InitCapsuleSize(42.f, 96.f);
     CapsuleComp->SetCollisionProfileName(TEXT("Pawn"));
 
-    MeshComp = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("MeshComp"));
+    MeshComp = CreateDefaultSubobject<USkeletalMeshComponentBudgeted>(TEXT("MeshComp"));
     MeshComp->SetupAttachment(CapsuleComp);
 
     MeshComp->SetRelativeLocation(FVector(0.f, 0.f, -88.f));
@@ -35,20 +42,81 @@ ABasePawn::ABasePawn()
     CameraComp = CreateDefaultSubobject<UCameraComponent>(TEXT("CameraComp"));
     CameraComp->SetupAttachment(SpringArmComp);
     CameraComp->bUsePawnControlRotation = false;
+
+    MovementComp = CreateDefaultSubobject<UBasePawnMovementComponent>(TEXT("MovementComp"));
+    MovementComp->UpdatedComponent = CapsuleComp;
+
+    // 이동은 NetMovement가 입력/상태로 직접 주고받음(엔진 기본 이동 복제 끔)
+    NetMovement = CreateDefaultSubobject<UP3DNetMovementComponent>(TEXT("NetMovement"));
+    bReplicates = true;
+    SetReplicatingMovement(false);
 }
 
 void ABasePawn::BeginPlay()
 {
     Super::BeginPlay();
     PrevLocation = GetActorLocation();
+
+    SignificanceSubsystem = GetWorld()->GetSubsystem<UP3DSignificanceSubsystem>();
+    if (SignificanceSubsystem)
+    {
+        SignificanceSubsystem->RegisterPawn(this);
+    }
+
+    ReplaySubsystem = GetWorld()->GetSubsystem<UP3DReplaySubsystem>();
+}
+
+void ABasePawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (SignificanceSubsystem)
+    {
+        SignificanceSubsystem->UnregisterPawn(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ABasePawn::PossessedBy(AController* NewController)
+{
+    Super::PossessedBy(NewController);
+
+    // 조종 시작 → 다음 재평가까지 기다리지 않고 바로 깨움
+    WakeSignificance();
+}
+
+void ABasePawn::NotifyActorBeginOverlap(AActor* OtherActor)
+{
+    Super::NotifyActorBeginOverlap(OtherActor);
+    WakeSignificance();
+}
+
+void ABasePawn::WakeSignificance()
+{
+    if (SignificanceSubsystem)
+    {
+        SignificanceSubsystem->WakePawn(this);
+    }
+}
+
+bool ABasePawn::IsSignificanceIdle() const
+{
+    return !bIsMoving && !bIsInteracting && !bWantsInteract && CachedMoveInput.IsNearlyZero();
+}
+
+USkeletalMeshComponentBudgeted* ABasePawn::GetSignificanceAnimMesh() const
+{
+    return Cast<USkeletalMeshComponentBudgeted>(MeshComp);
 }
 
 void ABasePawn::Move(const FInputActionValue& Value)
 {
+    if (!UP3DReplaySubsystem::FilterInput(ReplaySubsystem, EP3DReplayInput::Move, Value.Get<FVector2D>())) return;
+
     // Interact 중엔 입력이 들어와도 이동 입력 자체를 무시(락)
     if (bIsInteracting)
     {
         CachedMoveInput = FVector2D::ZeroVector;
+        InputBuffer.DiscardMove();
         return;
     }
 
@@ -57,26 +125,72 @@ void ABasePawn::Move(const FInputActionValue& Value)
     // 완전 0이면 비우기
     if (MoveInput.IsNearlyZero())
     {
-        CachedMoveInput = FVector2D::ZeroVector;
+        InputBuffer.PushMove(FVector2D::ZeroVector);
         return;
     }
 
-    CachedMoveInput = MoveInput;
+    InputBuffer.PushMove(MoveInput);
+    WakeSignificance();
 }
 
 void ABasePawn::MoveCompleted(const FInputActionValue& Value)
 {
-    CachedMoveInput = FVector2D::ZeroVector;
+    if (!UP3DReplaySubsystem::FilterInput(ReplaySubsystem, EP3DReplayInput::MoveCompleted)) return;
+
+    InputBuffer.PushMove(FVector2D::ZeroVector);
 }
 
 void ABasePawn::Look(const FInputActionValue& Value)
 {
-    const FVector2D LookInput = Value.Get<FVector2D>();
-    CachedLookInput = LookInput;
+    if (!UP3DReplaySubsystem::FilterInput(ReplaySubsystem, EP3DReplayInput::Look, Value.Get<FVector2D>())) return;
+
+    // 덮어쓰지 않고 쌓아둠(한 프레임에 여러 번 들어와도 Tick에서 전부 합산)
+    InputBuffer.PushLook(Value.Get<FVector2D>());
+}
+
+void ABasePawn::ReplayInput(EP3DReplayInput Input, const FVector2D& Value)
+{
+    switch (Input)
+    {
+    case EP3DReplayInput::Move:          Move(FInputActionValue(Value)); break;
+    case EP3DReplayInput::MoveCompleted: MoveCompleted(FInputActionValue(FVector2D::ZeroVector)); break;
+    case EP3DReplayInput::Look:          Look(FInputActionValue(Value)); break;
+    case EP3DReplayInput::Interact:      Interact(FInputActionValue(true)); break;
+    default: break;
+    }
+}
+
+void ABasePawn::InjectScriptedInput(const FP3DScriptedInput& Input)
+{
+    if (bIsInteracting) return;
+
+    InputBuffer.PushMove(Input.Move);
+    InputBuffer.PushLook(Input.Look);
+
+    if (!Input.Move.IsNearlyZero()) WakeSignificance();
+}
+
+void ABasePawn::ConsumeBufferedInput(float DeltaTime)
+{
+    const FP3DInputFrame Frame = InputBuffer.Consume(DeltaTime, LookSmoothing);
+
+    if (Frame.bHasMove && !bIsInteracting)
+    {
+        CachedMoveInput = Frame.Move;
+    }
+
+    CachedLookInput += Frame.Look;
+
+    if (Frame.OldestLookTimestamp > 0.0 && PendingLookTimestamp == 0.0)
+    {
+        PendingLookTimestamp = Frame.OldestLookTimestamp;
+    }
 }
 
 void ABasePawn::Interact(const FInputActionValue& Value)
 {
+    if (!UP3DReplaySubsystem::FilterInput(ReplaySubsystem, EP3DReplayInput::Interact)) return;
+
     UE_LOG(LogTemp, Warning, TEXT("[BasePawn] Interact CALLED"));
 
     //이미 상호작용 중이면 무시
@@ -86,9 +200,17 @@ void ABasePawn::Interact(const FInputActionValue& Value)
         return;
     }
     bWantsInteract = true;
+    WakeSignificance();
+
+    // 드론 에셋 비동기 로드 시작 → Interact 애니(Start~End) 동안 로드해서 전환 히치를 가림
+    if (AP3DPlayerController* PC = Cast<AP3DPlayerController>(GetController()))
+    {
+        PC->PreloadDroneAssets();
+    }
 
     // 이동 입력은 즉시 끊어서, 상호작용 시작 시 미끄러지는 느낌 방지
     CachedMoveInput = FVector2D::ZeroVector;
+    InputBuffer.DiscardMove();
 }
 
 void ABasePawn::Notify_InteractStart()
@@ -99,6 +221,7 @@ void ABasePawn::Notify_InteractStart()
 
     // 이동 완전 차단
     CachedMoveInput = FVector2D::ZeroVector;
+    InputBuffer.DiscardMove();
 
     UE_LOG(LogTemp, Warning, TEXT("[BasePawn] Notify_InteractStart"));
 }
@@ -141,14 +264,59 @@ void ABasePawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
     }
 }
 
+void ABasePawn::DestroyPlayerInputComponent()
+{
+    // 캐시 모드: 바인딩을 그대로 들고 있다가 다시 빙의되면 재사용
+    // (PawnClientRestart는 InputComponent가 있으면 새로 만들지 않음)
+    if (bCacheInputBindings && !IsActorBeingDestroyed())
+    {
+        return;
+    }
+
+    Super::DestroyPlayerInputComponent();
+}
+
 void ABasePawn::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    const float SafeDT = FMath::Max(DeltaTime, KINDA_SMALL_NUMBER);
+    P3D_SCOPE(BasePawnTick);
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    ON_SCOPE_EXIT
+    {
+        const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+        P3DCounters::PawnTickCycles += Cycles;
+
+        if (SignificanceSubsystem)
+        {
+            SignificanceSubsystem->ReportTickCost(Cycles);
+        }
+    };
+
+    // 콜백에서 쌓인 입력 샘플 소비
+    ConsumeBufferedInput(DeltaTime);
+
+    // 롤백 기록: 시뮬 전 상태 + 이번 프레임 입력
+    P3DRollback::RecordFrame(*this, DeltaTime);
+
+    // 네트워크 게임: 예측/서버 입력 시뮬/프록시 보간은 NetMovement가 NetSimulateMove 등으로 처리
+    if (NetMovement && NetMovement->TickNetworkedMove(DeltaTime))
+    {
+        return;
+    }
 
     // Interact 중이면 이동/회전 입력 적용 자체를 막고 싶다면 여기서도 한 번 더 방어
-    const bool bCanControl = IsLocallyControlled() && !bIsInteracting;
+    SimulateMove(DeltaTime, CanApplyMoveInput());
+}
+
+void ABasePawn::SimulateMove(float DeltaTime, bool bCanControl)
+{
+    const float SafeDT = FMath::Max(DeltaTime, KINDA_SMALL_NUMBER);
+    const bool bUseMoveComp = bUseMovementComponent && MovementComp;
+
+    // 이동 컴포넌트는 입력이 없어도 매 프레임(중력/바닥 처리)
+    FVector DesiredMove = FVector::ZeroVector;
 
     if (bCanControl)
     {
@@ -163,7 +331,15 @@ void ABasePawn::Tick(float DeltaTime)
                 0.f
             );
 
-            AddActorLocalOffset(LocalDelta * CurSpeed * DeltaTime, false);
+            if (bUseMoveComp)
+            {
+                DesiredMove = GetActorRotation().RotateVector(LocalDelta) * CurSpeed * DeltaTime;
+            }
+            else
+            {
+                AddActorLocalOffset(LocalDelta * CurSpeed * DeltaTime, false);
+                P3DCounters::AddOffset();
+            }
         }
 
         // ===== 회전(직접) =====
@@ -173,19 +349,12 @@ void ABasePawn::Tick(float DeltaTime)
             const float PitchDelta = CachedLookInput.Y * MouseSensitivityPitch;
 
             AddActorLocalRotation(FRotator(0.f, YawDelta, 0.f));
-
-            if (SpringArmComp)
-            {
-                FRotator ArmRot = SpringArmComp->GetRelativeRotation();
-                const float CurPitch = FRotator::NormalizeAxis(ArmRot.Pitch);
-                const float NewPitch = FMath::Clamp(CurPitch + PitchDelta, PitchMin, PitchMax);
-
-                ArmRot.Pitch = NewPitch;
-                ArmRot.Roll = 0.f;
-                SpringArmComp->SetRelativeRotation(ArmRot);
-            }
+            AddArmPitch(PitchDelta);
 
             CachedLookInput = FVector2D::ZeroVector;
+
+            FP3DPawnInputBuffer::ReportLookLatency(PendingLookTimestamp);
+            PendingLookTimestamp = 0.0;
         }
     }
     else
@@ -195,15 +364,37 @@ void ABasePawn::Tick(float DeltaTime)
         {
             CachedMoveInput = FVector2D::ZeroVector;
             CachedLookInput = FVector2D::ZeroVector;
+            PendingLookTimestamp = 0.0;
         }
     }
 
+    // ===== 이동 컴포넌트(스윕/미끄러짐/계단/중력) =====
+    if (bUseMoveComp)
+    {
+        MovementComp->MoveStep(DesiredMove, DeltaTime);
+    }
+
     // ===== 속도/이동 상태 계산 =====
     const FVector NewLoc = GetActorLocation();
-    const FVector WorldDelta = NewLoc - PrevLocation;
 
-    CurrentSpeed2D = FVector(WorldDelta.X, WorldDelta.Y, 0.f).Size() / SafeDT;
+    if (bUseMoveComp)
+    {
+        // 컴포넌트 속도(막히거나 미끄러진 뒤 실제 이동량 기준)
+        CurrentSpeed2D = MovementComp->GetSpeed2D();
+    }
+    else
+    {
+        const FVector WorldDelta = NewLoc - PrevLocation;
+        CurrentSpeed2D = FVector(WorldDelta.X, WorldDelta.Y, 0.f).Size() / SafeDT;
+    }
 
+    UpdateMovingState();
+
+    PrevLocation = NewLoc;
+}
+
+void ABasePawn::UpdateMovingState()
+{
     // Interact 중에는 강제로 “이동 아님”
     if (bIsInteracting)
     {
@@ -217,6 +408,137 @@ void ABasePawn::Tick(float DeltaTime)
         if (!bIsMoving) bIsMoving = (CurrentSpeed2D > StartMoveSpeed);
         else            bIsMoving = (CurrentSpeed2D > StopMoveSpeed);
     }
+}
 
-    PrevLocation = NewLoc;
+void ABasePawn::AddArmPitch(float PitchDelta)
+{
+    if (!SpringArmComp) return;
+
+    FRotator ArmRot = SpringArmComp->GetRelativeRotation();
+    const float CurPitch = FRotator::NormalizeAxis(ArmRot.Pitch);
+    const float NewPitch = FMath::Clamp(CurPitch + PitchDelta, PitchMin, PitchMax);
+
+    ArmRot.Pitch = NewPitch;
+    ArmRot.Roll = 0.f;
+    SpringArmComp->SetRelativeRotation(ArmRot);
+}
+
+// ===== IP3DNetMovementPawn =====
+
+void ABasePawn::NetGatherInput(float DeltaTime, FP3DNetMoveInput& OutInput)
+{
+    FRotator Rotation = GetActorRotation();
+
+    if (!bIsInteracting)
+    {
+        OutInput.SetMove(CachedMoveInput);
+
+        // Yaw는 입력에 실어 보내고, 피치는 카메라(로컬)에만
+        if (!CachedLookInput.IsNearlyZero())
+        {
+            Rotation.Yaw = FRotator::NormalizeAxis(Rotation.Yaw + CachedLookInput.X * MouseSensitivity);
+            AddArmPitch(CachedLookInput.Y * MouseSensitivityPitch);
+
+            CachedLookInput = FVector2D::ZeroVector;
+
+            FP3DPawnInputBuffer::ReportLookLatency(PendingLookTimestamp);
+            PendingLookTimestamp = 0.0;
+        }
+    }
+    else
+    {
+        OutInput.SetMove(FVector2D::ZeroVector);
+
+        CachedMoveInput = FVector2D::ZeroVector;
+        CachedLookInput = FVector2D::ZeroVector;
+        PendingLookTimestamp = 0.0;
+    }
+
+    OutInput.SetUpDown(0.f);
+    OutInput.SetRotation(Rotation, false);
+}
+
+void ABasePawn::NetSimulateMove(const FP3DNetMoveInput& Input)
+{
+    // 로컬 입력 캐시는 보존(보정 재적용이 이번 프레임 입력 수집보다 먼저 돌 수 있음)
+    const FVector2D LocalMove = CachedMoveInput;
+    const FVector2D LocalLook = CachedLookInput;
+
+    SetActorRotation(Input.GetRotation());
+
+    CachedMoveInput = Input.GetMove();
+    CachedLookInput = FVector2D::ZeroVector;
+
+    SimulateMove(Input.GetDeltaTime(), true);
+
+    CachedMoveInput = LocalMove;
+    CachedLookInput = LocalLook;
+}
+
+void ABasePawn::NetSaveState(FP3DNetMoveState& OutState) const
+{
+    OutState.Location = GetActorLocation();
+    OutState.Rotation = GetActorRotation();
+    OutState.VerticalVelocity = MovementComp ? MovementComp->GetVerticalSpeed() : 0.f;
+    OutState.bGrounded = MovementComp ? MovementComp->IsOnGround() : true;
+}
+
+void ABasePawn::NetRestoreState(const FP3DNetMoveState& State)
+{
+    SetActorLocationAndRotation(State.Location, State.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+
+    if (MovementComp)
+    {
+        MovementComp->RestoreMoveState(State.VerticalVelocity, State.bGrounded);
+    }
+
+    PrevLocation = State.Location;
+}
+
+void ABasePawn::NetApplyProxyTransform(const FVector& Location, const FRotator& Rotation, float DeltaTime)
+{
+    const FVector WorldDelta = Location - GetActorLocation();
+    SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::None);
+
+    // 애니용 속도는 보간된 이동량으로
+    CurrentSpeed2D = WorldDelta.Size2D() / FMath::Max(DeltaTime, KINDA_SMALL_NUMBER);
+    UpdateMovingState();
+
+    PrevLocation = Location;
+}
+
+// 롤백 (P3DRollback)
+
+void ABasePawn::CaptureSnapshot(FP3DPawnSnapshot& Out) const
+{
+    NetSaveState(Out.State);
+
+    Out.MoveInput = CachedMoveInput;
+    Out.LookInput = CachedLookInput;
+    Out.UpDownInput = 0.f;
+    Out.RollInput = 0.f;
+    Out.bInputEnabled = CanApplyMoveInput();
+}
+
+void ABasePawn::RestoreSnapshotState(const FP3DPawnSnapshot& Snapshot)
+{
+    NetRestoreState(Snapshot.State);
+}
+
+void ABasePawn::ApplySnapshotInput(const FP3DPawnSnapshot& Snapshot)
+{
+    CachedMoveInput = Snapshot.MoveInput;
+    CachedLookInput = Snapshot.LookInput;
+}
+
+void ABasePawn::ResimulateFrame(float DeltaTime, bool bInputEnabled)
+{
+    // 카메라 피치는 이미 적용됨, 재시뮬 Look은 지연 측정 제외
+    const double LocalLookTimestamp = PendingLookTimestamp;
+    PendingLookTimestamp = 0.0;
+    CachedLookInput.Y = 0.f;
+
+    SimulateMove(DeltaTime, bInputEnabled);
+
+    PendingLookTimestamp = LocalLookTimestamp;
 }
@@ -0,0 +1,266 @@
+﻿#include "BasePawnMovementComponent.h"
+
+#include "P3DProfiling.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+UBasePawnMovementComponent::UBasePawnMovementComponent()
+{
+	// Pawn Tick에서 직접 호출(자체 Tick 없음)
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UBasePawnMovementComponent::InvalidateFloor()
+{
+	Floor.Clear();
+	bOnGround = false;
+}
+
+void UBasePawnMovementComponent::RestoreMoveState(float InVerticalSpeed, bool bInOnGround)
+{
+	InvalidateFloor();
+
+	VerticalSpeed = InVerticalSpeed;
+	bOnGround = bInOnGround;
+}
+
+void UBasePawnMovementComponent::MoveStep(const FVector& DesiredDelta, float DeltaTime)
+{
+	if (!UpdatedComponent || !UpdatedPrimitive || ShouldSkipUpdate(DeltaTime)) return;
+
+	P3D_SCOPE(PawnMove);
+
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+	bool bBlocked = false;
+	bool bFloorUpdated = false;
+
+	// 1) 수평 이동(스윕) → 막히면 계단 오르기 / 미끄러짐
+	if (!DesiredDelta.IsNearlyZero())
+	{
+		const FVector Delta = bOnGround ? ProjectToFloor(DesiredDelta) : DesiredDelta;
+
+		FHitResult Hit;
+		SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+
+		if (Hit.IsValidBlockingHit())
+		{
+			bBlocked = true;
+			bFloorUpdated = ResolveBlockingHit(Delta, Hit);
+		}
+	}
+
+	// 2) 바닥: 같은 프리미티브 위 짧은 이동이면 캐시 사용
+	// (계단 오르기는 내려오는 스윕으로 이미 바닥을 갱신함)
+	if (!bFloorUpdated)
+	{
+		Floor.TraveledSinceQuery += FVector::Dist2D(OldLocation, UpdatedComponent->GetComponentLocation());
+
+		if (!bBlocked && CanReuseFloor())
+		{
+			INC_DWORD_STAT(STAT_P3D_PawnFloorCacheHit);
+		}
+		else
+		{
+			FindFloor();
+		}
+	}
+
+	// 3) 바닥에 붙이기 / 낙하
+	UpdateVertical(DeltaTime);
+
+	Velocity = (DeltaTime > 0.f) ? (UpdatedComponent->GetComponentLocation() - OldLocation) / DeltaTime : FVector::ZeroVector;
+	UpdateComponentVelocity();
+}
+
+FVector UBasePawnMovementComponent::ProjectToFloor(const FVector& Delta) const
+{
+	const FVector& N = Floor.Normal;
+	if (!Floor.bWalkable || N.Z >= 1.f - KINDA_SMALL_NUMBER || N.Z <= KINDA_SMALL_NUMBER) return Delta;
+
+	// 수평 성분은 그대로, Z만 경사면에 맞춤
+	return FVector(Delta.X, Delta.Y, -(Delta.X * N.X + Delta.Y * N.Y) / N.Z);
+}
+
+bool UBasePawnMovementComponent::ResolveBlockingHit(const FVector& Delta, const FHitResult& Hit)
+{
+	if (bOnGround && !IsWalkable(Hit) && StepUp(Delta * (1.f - Hit.Time), Hit))
+	{
+		return true;
+	}
+
+	FHitResult SlideHit = Hit;
+	SlideAlongSurface(Delta, 1.f - Hit.Time, Hit.Normal, SlideHit, true);
+	return false;
+}
+
+bool UBasePawnMovementComponent::StepUp(const FVector& Delta, const FHitResult& WallHit)
+{
+	if (MaxStepHeight <= 0.f) return false;
+
+	const float HalfHeight = UpdatedPrimitive->GetCollisionShape().GetCapsuleHalfHeight();
+	const float StartZ = UpdatedComponent->GetComponentLocation().Z;
+
+	// 막힌 지점이 발 기준 MaxStepHeight보다 높으면 벽
+	if (WallHit.ImpactPoint.Z - (StartZ - HalfHeight) > MaxStepHeight) return false;
+
+	const FQuat Rotation = UpdatedComponent->GetComponentQuat();
+
+	// 실패하면 통째로 되돌림(자식 트랜스폼 갱신도 한 번만)
+	FScopedMovementUpdate ScopedStepUp(UpdatedComponent, EScopedUpdate::DeferredUpdates);
+
+	// 위로
+	FHitResult Hit;
+	SafeMoveUpdatedComponent(FVector(0.f, 0.f, MaxStepHeight), Rotation, true, Hit);
+	if (Hit.bStartPenetrating)
+	{
+		ScopedStepUp.RevertMove();
+		return false;
+	}
+
+	const float Raised = UpdatedComponent->GetComponentLocation().Z - StartZ;
+
+	// 앞으로
+	SafeMoveUpdatedComponent(Delta, Rotation, true, Hit);
+	if (Hit.bStartPenetrating || (Hit.bBlockingHit && Hit.Time <= KINDA_SMALL_NUMBER))
+	{
+		ScopedStepUp.RevertMove();
+		return false;
+	}
+
+	// 아래로: 걸을 수 있는 바닥에 닿아야 성공
+	SafeMoveUpdatedComponent(FVector(0.f, 0.f, -(Raised + FloorGap)), Rotation, true, Hit);
+	if (!IsWalkable(Hit) || Hit.bStartPenetrating
+		|| UpdatedComponent->GetComponentLocation().Z - StartZ > MaxStepHeight)
+	{
+		ScopedStepUp.RevertMove();
+		return false;
+	}
+
+	SetFloorFromHit(Hit, 0.f);
+	return true;
+}
+
+bool UBasePawnMovementComponent::CanReuseFloor() const
+{
+	if (FloorCacheDistance <= 0.f || !bOnGround || !Floor.bWalkable) return false;
+
+	const UPrimitiveComponent* FloorComp = Floor.Component.Get();
+	if (!FloorComp) return false;
+
+	// 바닥 자체가 움직였으면(엘리베이터 등) 다시 찾음
+	if (FloorComp->Mobility == EComponentMobility::Movable && !FloorComp->GetComponentLocation().Equals(Floor.ComponentLocation))
+	{
+		return false;
+	}
+
+	return Floor.TraveledSinceQuery < FloorCacheDistance;
+}
+
+void UBasePawnMovementComponent::FindFloor()
+{
+	INC_DWORD_STAT(STAT_P3D_PawnFloorQueries);
+	P3DCounters::AddSceneQuery();
+
+	// 반경만 살짝 줄인 캡슐(바닥 높이는 같음) → 옆 벽에 걸리지 않게
+	const FCollisionShape Shape = UpdatedPrimitive->GetCollisionShape();
+	const FCollisionShape ProbeShape = FCollisionShape::MakeCapsule(Shape.GetCapsuleRadius() * 0.9f, Shape.GetCapsuleHalfHeight());
+
+	const float ProbeLength = MaxStepHeight + FloorGap;
+	const FVector Start = UpdatedComponent->GetComponentLocation();
+	const FVector End = Start - FVector(0.f, 0.f, ProbeLength);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(PawnFindFloor), false, GetOwner());
+	FCollisionResponseParams ResponseParams;
+	UpdatedPrimitive->InitSweepCollisionParams(Params, ResponseParams);
+
+	FHitResult Hit;
+	const bool bHit = GetWorld()->SweepSingleByChannel(Hit, Start, End, FQuat::Identity,
+		UpdatedPrimitive->GetCollisionObjectType(), ProbeShape, Params, ResponseParams);
+
+	// 겹친 상태는 다음 이동의 depenetration이 처리
+	if (!bHit || Hit.bStartPenetrating)
+	{
+		Floor.Clear();
+		return;
+	}
+
+	SetFloorFromHit(Hit, Hit.Distance);
+}
+
+void UBasePawnMovementComponent::SetFloorFromHit(const FHitResult& Hit, float Distance)
+{
+	Floor.Component = Hit.GetComponent();
+	Floor.Normal = Hit.ImpactNormal;
+	Floor.Distance = Distance;
+	Floor.bBlockingHit = Hit.bBlockingHit;
+	Floor.bWalkable = IsWalkable(Hit);
+	Floor.ComponentLocation = Hit.GetComponent() ? Hit.GetComponent()->GetComponentLocation() : FVector::ZeroVector;
+	Floor.TraveledSinceQuery = 0.f;
+}
+
+void UBasePawnMovementComponent::UpdateVertical(float DeltaTime)
+{
+	const FQuat Rotation = UpdatedComponent->GetComponentQuat();
+
+	// 걸을 수 있는 바닥이 스텝 높이 안에 있으면 붙임
+	if (Floor.bWalkable && Floor.Distance <= MaxStepHeight + FloorGap && VerticalSpeed <= 0.f)
+	{
+		const float Adjust = FloorGap - Floor.Distance;
+		if (FMath::Abs(Adjust) > 0.5f)
+		{
+			FHitResult Hit;
+			SafeMoveUpdatedComponent(FVector(0.f, 0.f, Adjust), Rotation, true, Hit);
+			Floor.Distance += Adjust * (Hit.bBlockingHit ? Hit.Time : 1.f);
+		}
+
+		bOnGround = true;
+		VerticalSpeed = 0.f;
+		return;
+	}
+
+	// 낙하
+	bOnGround = false;
+	VerticalSpeed = FMath::Max(VerticalSpeed + GetGravityZ() * DeltaTime, -MaxFallSpeed);
+
+	const FVector FallDelta(0.f, 0.f, VerticalSpeed * DeltaTime);
+
+	FHitResult Hit;
+	SafeMoveUpdatedComponent(FallDelta, Rotation, true, Hit);
+
+	if (!Hit.IsValidBlockingHit()) return;
+
+	if (VerticalSpeed <= 0.f && IsWalkable(Hit))
+	{
+		// 착지: 이 스윕이 곧 바닥 탐색
+		SetFloorFromHit(Hit, 0.f);
+		bOnGround = true;
+		VerticalSpeed = 0.f;
+		return;
+	}
+
+	// 경사가 심한 면/천장: 남은 만큼 미끄러지고 수직 속도는 끊음
+	if (Hit.ImpactNormal.Z < 0.f)
+	{
+		VerticalSpeed = 0.f;
+	}
+
+	FHitResult SlideHit = Hit;
+	SlideAlongSurface(FallDelta, 1.f - Hit.Time, Hit.Normal, SlideHit, true);
+}
+
+bool UBasePawnMovementComponent::IsWalkable(const FHitResult& Hit) const
+{
+	return Hit.IsValidBlockingHit() && Hit.ImpactNormal.Z >= WalkableFloorZ;
+}
+
+bool UBasePawnMovementComponent::MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit, ETeleportType Teleport)
+{
+	if (bSweep && !Delta.IsNearlyZero())
+	{
+		INC_DWORD_STAT(STAT_P3D_PawnMoveSweeps);
+		P3DCounters::AddSceneQuery();
+	}
+	P3DCounters::AddOffset();
+
+	return Super::MoveUpdatedComponentImpl(Delta, NewRotation, bSweep, OutHit, Teleport);
+}
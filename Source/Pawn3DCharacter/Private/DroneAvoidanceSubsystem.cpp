@@ -0,0 +1,427 @@
+﻿#include "DroneAvoidanceSubsystem.h"
+
+#include "DronePawn.h"
+#include "P3DStats.h"
+#include "Async/ParallelFor.h"
+#include "Components/SphereComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarDroneAvoidRayBudget(
+	TEXT("p3d.DroneAvoid.RayBudget"),
+	1024,
+	TEXT("프레임당 회피 레이 수 상한(넘는 드론은 축소 팬 또는 이번 프레임 생략)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDroneAvoidLookAhead(
+	TEXT("p3d.DroneAvoid.LookAheadSeconds"),
+	0.75f,
+	TEXT("정면 레이 길이 = 속도 x 이 시간(초)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDroneAvoidMinRayLength(
+	TEXT("p3d.DroneAvoid.MinRayLength"),
+	200.f,
+	TEXT("정면 레이 최소 길이(cm, 정지/저속)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDroneAvoidMaxRayLength(
+	TEXT("p3d.DroneAvoid.MaxRayLength"),
+	1500.f,
+	TEXT("정면 레이 최대 길이(cm)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDroneAvoidSmoothTime(
+	TEXT("p3d.DroneAvoid.SmoothTime"),
+	0.1f,
+	TEXT("회피 보정 스무딩 시간(초, 0이면 즉시)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneAvoidPawns(
+	TEXT("p3d.DroneAvoid.Pawns"),
+	1,
+	TEXT("다른 Pawn(드론 포함)도 장애물로 감지"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneAvoidParallel(
+	TEXT("p3d.DroneAvoid.Parallel"),
+	1,
+	TEXT("회피 레이를 워커 스레드로 나눠서 트레이스(0이면 게임 스레드에서 순차)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneAvoidDebug(
+	TEXT("p3d.DroneAvoid.Debug"),
+	0,
+	TEXT("회피 레이 그리기(맞음 빨강 / 빈 레이 초록)"),
+	ECVF_Default);
+
+namespace
+{
+	// 진행 방향 기준 레이(앞 3개 = 축소 팬)
+	struct FFanRay
+	{
+		float Yaw;
+		float Pitch;
+		float LengthScale;
+		float Weight;
+	};
+
+	const FFanRay Fan[] =
+	{
+		{   0.f,   0.f, 1.0f, 1.0f },
+		{ -35.f,   0.f, 0.8f, 0.8f },
+		{  35.f,   0.f, 0.8f, 0.8f },
+		{ -90.f,   0.f, 0.4f, 0.5f },
+		{  90.f,   0.f, 0.4f, 0.5f },
+		{   0.f,  30.f, 0.6f, 0.6f },
+		{   0.f, -30.f, 0.6f, 0.6f },
+	};
+
+	constexpr int32 FullFanSize = UE_ARRAY_COUNT(Fan);
+	constexpr int32 ReducedFanSize = 3;
+
+	// 이보다 느리고 근처에 아무것도 없으면 감지 안 함
+	constexpr float IdleSpeed = 10.f;
+
+	// 한 프레임 못 볼 때마다 우선순위 가산(cm/s 단위, 속도와 같은 척도)
+	constexpr float StalePriorityPerFrame = 100.f;
+
+	// 근접도가 우선순위를 키우는 비율
+	constexpr float ProximityPriorityScale = 4.f;
+
+	// 생략한 드론의 보정 감쇠(스무딩 계수에 곱함)
+	constexpr float SkippedDecayScale = 0.25f;
+
+	// 진행 방향(속도가 있으면 속도, 없으면 기수) - 위아래는 ±60도까지만
+	FRotator GetHeading(const ADronePawn* Drone, const FVector& Velocity)
+	{
+		if (Velocity.SizeSquared() > FMath::Square(IdleSpeed))
+		{
+			FRotator Heading = Velocity.Rotation();
+			Heading.Pitch = FMath::Clamp(Heading.Pitch, -60.f, 60.f);
+			Heading.Roll = 0.f;
+			return Heading;
+		}
+		return FRotator(0.f, Drone->GetActorRotation().Yaw, 0.f);
+	}
+}
+
+// ===== Subsystem =====
+
+bool UDroneAvoidanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDroneAvoidanceSubsystem::Deinitialize()
+{
+	for (ADronePawn* Drone : Drones)
+	{
+		if (Drone)
+		{
+			Drone->SetAvoidanceCorrection(FVector::ZeroVector);
+		}
+	}
+	Drones.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UDroneAvoidanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDroneAvoidanceSubsystem, STATGROUP_Tickables);
+}
+
+void UDroneAvoidanceSubsystem::RegisterDrone(ADronePawn* Drone)
+{
+	if (!IsValid(Drone) || IsRegistered(Drone)) return;
+
+	Drones.Add(Drone);
+	Radius.Add(Drone->SphereComp ? Drone->SphereComp->GetScaledSphereRadius() : 30.f);
+	LastLocation.Add(Drone->GetActorLocation());
+	Velocity.Add(FVector::ZeroVector);
+	Correction.Add(FVector::ZeroVector);
+	Urgency.Add(0.f);
+	FramesSinceSensed.Add(0);
+}
+
+void UDroneAvoidanceSubsystem::UnregisterDrone(ADronePawn* Drone)
+{
+	const int32 Slot = Drones.Find(Drone);
+	if (Slot == INDEX_NONE) return;
+
+	if (Drone)
+	{
+		Drone->SetAvoidanceCorrection(FVector::ZeroVector);
+	}
+	RemoveSlot(Slot);
+}
+
+void UDroneAvoidanceSubsystem::RemoveSlot(int32 Slot)
+{
+	Drones.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Radius.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	LastLocation.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Velocity.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Correction.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Urgency.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	FramesSinceSensed.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+}
+
+// Tick: 속도 → 레이 배정 → 트레이스 → 보정
+
+void UDroneAvoidanceSubsystem::Tick(float DeltaTime)
+{
+	LastFrame = FFrameStats();
+
+	// 파괴된 드론 정리
+	for (int32 Slot = Drones.Num() - 1; Slot >= 0; --Slot)
+	{
+		if (!IsValid(Drones[Slot]))
+		{
+			RemoveSlot(Slot);
+		}
+	}
+
+	if (Drones.Num() == 0 || DeltaTime <= 0.f)
+	{
+		SET_DWORD_STAT(STAT_P3D_AvoidRaysPerFrame, 0);
+		SET_DWORD_STAT(STAT_P3D_AvoidDronesSensed, 0);
+		SET_DWORD_STAT(STAT_P3D_AvoidDronesOverBudget, 0);
+		SET_FLOAT_STAT(STAT_P3D_AvoidMs, 0.f);
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_P3D_DroneAvoidance);
+	const double StartTime = FPlatformTime::Seconds();
+
+	UpdateKinematics(DeltaTime);
+	BuildRays();
+	TraceRays();
+	ResolveCorrections(DeltaTime);
+
+	if (CVarDroneAvoidDebug.GetValueOnGameThread() != 0)
+	{
+		DrawDebugRays();
+	}
+
+	LastFrame.Rays = Rays.Num();
+	LastFrame.Ms = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	SET_DWORD_STAT(STAT_P3D_AvoidRaysPerFrame, LastFrame.Rays);
+	SET_DWORD_STAT(STAT_P3D_AvoidDronesSensed, LastFrame.DronesSensed);
+	SET_DWORD_STAT(STAT_P3D_AvoidDronesOverBudget, LastFrame.DronesOverBudget);
+	SET_FLOAT_STAT(STAT_P3D_AvoidMs, LastFrame.Ms);
+}
+
+void UDroneAvoidanceSubsystem::UpdateKinematics(float DeltaTime)
+{
+	const int32 Num = Drones.Num();
+	Priority.SetNumUninitialized(Num, EAllowShrinking::No);
+
+	for (int32 Slot = 0; Slot < Num; ++Slot)
+	{
+		const ADronePawn* Drone = Drones[Slot];
+		const FVector Location = Drone->GetActorLocation();
+
+		Velocity[Slot] = (Location - LastLocation[Slot]) / DeltaTime;
+		LastLocation[Slot] = Location;
+
+		// 플레이어 조종 중(옵션 꺼짐)이거나 정지 + 주변 빈 드론은 감지 대상 아님
+		const AController* Controller = Drone->GetController();
+		const bool bPlayerControlled = Controller && Controller->IsPlayerController();
+		const float Speed = Velocity[Slot].Size();
+
+		if ((bPlayerControlled && !Drone->bAvoidWhenPlayerControlled) || (Speed < IdleSpeed && Urgency[Slot] <= 0.f))
+		{
+			Priority[Slot] = -1.f;
+			continue;
+		}
+
+		Priority[Slot] = Speed * (1.f + ProximityPriorityScale * Urgency[Slot]) + StalePriorityPerFrame * FramesSinceSensed[Slot];
+	}
+}
+
+void UDroneAvoidanceSubsystem::BuildRays()
+{
+	const int32 Num = Drones.Num();
+
+	Order.SetNumUninitialized(Num, EAllowShrinking::No);
+	for (int32 Slot = 0; Slot < Num; ++Slot)
+	{
+		Order[Slot] = Slot;
+	}
+	Order.Sort([this](int32 A, int32 B) { return Priority[A] > Priority[B]; });
+
+	FanSize.Reset();
+	FanSize.SetNumZeroed(Num);
+	FirstRay.SetNumUninitialized(Num, EAllowShrinking::No);
+	Rays.Reset();
+
+	const int32 Budget = FMath::Max(CVarDroneAvoidRayBudget.GetValueOnGameThread(), 0);
+	const float LookAhead = CVarDroneAvoidLookAhead.GetValueOnGameThread();
+	const float MinLength = CVarDroneAvoidMinRayLength.GetValueOnGameThread();
+	const float MaxLength = FMath::Max(CVarDroneAvoidMaxRayLength.GetValueOnGameThread(), MinLength);
+
+	for (const int32 Slot : Order)
+	{
+		if (Priority[Slot] < 0.f) break;
+
+		const int32 Remaining = Budget - Rays.Num();
+		const int32 Size = Remaining >= FullFanSize ? FullFanSize : (Remaining >= ReducedFanSize ? ReducedFanSize : 0);
+		if (Size == 0)
+		{
+			++LastFrame.DronesOverBudget;
+			continue;
+		}
+
+		const ADronePawn* Drone = Drones[Slot];
+		const FRotator Heading = GetHeading(Drone, Velocity[Slot]);
+		const float Length = FMath::Clamp(Velocity[Slot].Size() * LookAhead, MinLength, MaxLength) + Radius[Slot];
+
+		FanSize[Slot] = static_cast<uint8>(Size);
+		FirstRay[Slot] = Rays.Num();
+		++LastFrame.DronesSensed;
+
+		for (int32 f = 0; f < Size; ++f)
+		{
+			FRay& Ray = Rays.AddDefaulted_GetRef();
+			Ray.Start = LastLocation[Slot];
+			Ray.Dir = (Heading + FRotator(Fan[f].Pitch, Fan[f].Yaw, 0.f)).Vector();
+			Ray.Length = FMath::Max(Length * Fan[f].LengthScale, Radius[Slot] + MinLength * 0.5f);
+			Ray.Slot = Slot;
+			Ray.FanIndex = static_cast<uint8>(f);
+		}
+	}
+}
+
+void UDroneAvoidanceSubsystem::TraceRays()
+{
+	const int32 NumRays = Rays.Num();
+	HitDistance.SetNumUninitialized(NumRays, EAllowShrinking::No);
+	if (NumRays == 0) return;
+
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+	if (CVarDroneAvoidPawns.GetValueOnGameThread() != 0)
+	{
+		ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	}
+
+	const UWorld* World = GetWorld();
+
+	auto TraceOne = [this, World, &ObjectParams](int32 i)
+	{
+		const FRay& Ray = Rays[i];
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(DroneAvoidance), false, Drones[Ray.Slot]);
+
+		FHitResult Hit;
+		HitDistance[i] = World->LineTraceSingleByObjectType(Hit, Ray.Start, Ray.Start + Ray.Dir * Ray.Length, ObjectParams, Params)
+			? Hit.Distance
+			: Ray.Length;
+	};
+
+	// 레이 하나는 짧음 → 묶음 단위로 나눠서 태스크 오버헤드 줄임
+	if (CVarDroneAvoidParallel.GetValueOnGameThread() != 0)
+	{
+		constexpr int32 RaysPerTask = 32;
+		const int32 NumTasks = FMath::DivideAndRoundUp(NumRays, RaysPerTask);
+
+		ParallelFor(NumTasks, [&](int32 Task)
+		{
+			const int32 End = FMath::Min((Task + 1) * RaysPerTask, NumRays);
+			for (int32 i = Task * RaysPerTask; i < End; ++i)
+			{
+				TraceOne(i);
+			}
+		});
+	}
+	else
+	{
+		for (int32 i = 0; i < NumRays; ++i)
+		{
+			TraceOne(i);
+		}
+	}
+
+	P3DCounters::AddSceneQuery(NumRays);
+}
+
+void UDroneAvoidanceSubsystem::ResolveCorrections(float DeltaTime)
+{
+	const float SmoothTime = CVarDroneAvoidSmoothTime.GetValueOnGameThread();
+	const float Alpha = SmoothTime > 0.f ? 1.f - FMath::Exp(-DeltaTime / SmoothTime) : 1.f;
+
+	for (int32 Slot = 0; Slot < Drones.Num(); ++Slot)
+	{
+		ADronePawn* Drone = Drones[Slot];
+		const int32 Size = FanSize[Slot];
+
+		if (Size == 0)
+		{
+			// 감지 대상 아님 → 0으로 / 예산 초과 → 지난 보정을 천천히 줄이며 유지
+			const bool bOverBudget = Priority[Slot] >= 0.f;
+			Correction[Slot] = FMath::Lerp(Correction[Slot], FVector::ZeroVector, bOverBudget ? Alpha * SkippedDecayScale : 1.f);
+			FramesSinceSensed[Slot] = bOverBudget ? static_cast<uint16>(FMath::Min<int32>(FramesSinceSensed[Slot] + 1, MAX_uint16)) : 0;
+			if (!bOverBudget)
+			{
+				Urgency[Slot] = 0.f;
+			}
+			Drone->SetAvoidanceCorrection(Correction[Slot]);
+			continue;
+		}
+
+		FramesSinceSensed[Slot] = 0;
+
+		// 레이마다 근접도 w = (1 - 여유 거리 / 레이 길이)^2 → 레이 반대 방향으로 밀기
+		FVector Push = FVector::ZeroVector;
+		float MaxW = 0.f;
+		float SideFree[2] = { 1.f, 1.f };
+
+		for (int32 f = 0; f < Size; ++f)
+		{
+			const int32 RayIndex = FirstRay[Slot] + f;
+			const FRay& Ray = Rays[RayIndex];
+
+			const float Clearance = FMath::Max(Ray.Length - Radius[Slot], 1.f);
+			const float Free = FMath::Clamp((HitDistance[RayIndex] - Radius[Slot]) / Clearance, 0.f, 1.f);
+			const float W = FMath::Square(1.f - Free);
+
+			if (f == 1 || f == 2)
+			{
+				SideFree[f - 1] = Free;
+			}
+
+			Push -= Ray.Dir * (W * Fan[f].Weight);
+			MaxW = FMath::Max(MaxW, W);
+		}
+
+		// 정면이 막혔으면 더 빈 쪽 대각으로 비켜감(정면 충돌에서 밀어내기만 하면 제자리에서 멈춤)
+		const float FrontFree = FMath::Clamp((HitDistance[FirstRay[Slot]] - Radius[Slot]) / FMath::Max(Rays[FirstRay[Slot]].Length - Radius[Slot], 1.f), 0.f, 1.f);
+		if (FrontFree < 1.f)
+		{
+			const FVector Side = SideFree[1] >= SideFree[0] ? Rays[FirstRay[Slot] + 2].Dir : Rays[FirstRay[Slot] + 1].Dir;
+			Push += Side * FMath::Square(1.f - FrontFree);
+		}
+
+		Urgency[Slot] = MaxW;
+		Correction[Slot] = FMath::Lerp(Correction[Slot], Push.GetClampedToMaxSize(1.f), Alpha);
+		Drone->SetAvoidanceCorrection(Correction[Slot]);
+	}
+}
+
+void UDroneAvoidanceSubsystem::DrawDebugRays() const
+{
+	const UWorld* World = GetWorld();
+
+	for (int32 i = 0; i < Rays.Num(); ++i)
+	{
+		const FRay& Ray = Rays[i];
+		const bool bHit = HitDistance[i] < Ray.Length;
+		DrawDebugLine(World, Ray.Start, Ray.Start + Ray.Dir * HitDistance[i], bHit ? FColor::Red : FColor::Green, false, -1.f, 0, 1.f);
+	}
+}
@@ -0,0 +1,105 @@
+﻿#include "DroneFlightKernel.h"
+
+namespace P3DDroneFlight
+{
+	void UpdateGrounded(const FDroneFlightParams& Params, const FDroneGroundSample& Ground, float DeltaTime, FDroneFlightState& State)
+	{
+		if (Ground.IsActuallyGrounded(Params))
+		{
+			State.TimeSinceGrounded = 0.f;
+		}
+		else
+		{
+			State.TimeSinceGrounded += DeltaTime;
+		}
+
+		State.bGrounded = Ground.IsActuallyGrounded(Params) || (State.TimeSinceGrounded <= Params.CoyoteTime);
+	}
+
+	float GetHorizontalSpeed(const FDroneFlightParams& Params, const FDroneFlightState& State)
+	{
+		float ControlMul = 1.f;
+		if (Params.bEnableGravity && !State.bGrounded)
+		{
+			ControlMul = FMath::Clamp(Params.AirControlMultiplier, 0.f, 1.f);
+		}
+
+		return Params.NormalSpeed * ControlMul;
+	}
+
+	float GetHoverInput(const FDroneFlightParams& Params)
+	{
+		if (!Params.bEnableGravity || Params.ThrustAccel <= KINDA_SMALL_NUMBER) return 0.f;
+
+		return FMath::Clamp(-Params.GravityAccel / Params.ThrustAccel, 0.f, 1.f);
+	}
+
+	float IntegrateVertical(const FDroneFlightParams& Params, const FDroneGroundSample& Ground, float DeltaTime, float UpDownInput, FDroneFlightState& State)
+	{
+		// 1) 추진 가속(입력 기반)
+		const float Input = FMath::Clamp(UpDownInput, -1.f, 1.f);
+
+		// 입력이 있으면 가속 누적
+		State.VerticalVelocity += (Input * Params.ThrustAccel) * DeltaTime;
+
+		// 입력이 거의 없으면 드래그로 서서히 0으로
+		if (FMath::IsNearlyZero(Input, 0.02f))
+		{
+			State.VerticalVelocity = FMath::FInterpTo(State.VerticalVelocity, 0.f, DeltaTime, Params.ThrustDrag);
+		}
+
+		// 2) 중력/접지 스틱(떨림 방지)
+		if (!State.bGrounded)
+		{
+			State.VerticalVelocity += Params.GravityAccel * DeltaTime; // 월드 -Z
+		}
+		else
+		{
+			// 상승 입력(또는 이미 상승 속도)이면 "붙이기" 금지 + 이륙
+			const bool bTryingToRise = (Input > 0.05f) || (State.VerticalVelocity > 0.f);
+
+			if (bTryingToRise)
+			{
+				State.bGrounded = false;
+				State.TimeSinceGrounded = Params.CoyoteTime + 1.f; // 코요테 끊기(이륙 즉시 공중으로)
+			}
+			else
+			{
+				// 내려가려는 상황에서만 살짝 붙임(떨림 제거)
+				State.VerticalVelocity = FMath::Min(State.VerticalVelocity, -Params.GroundStickForce * DeltaTime);
+			}
+		}
+
+		// 3) 속도 제한
+		State.VerticalVelocity = FMath::Clamp(State.VerticalVelocity, -Params.MaxFallSpeed, Params.MaxRiseSpeed);
+
+		// 4) 이번 스텝 이동량(월드 Z)
+		float DeltaZ = State.VerticalVelocity * DeltaTime;
+
+		// 5) 접지 스냅(진짜 바닥인데 내려가려는 상황이면 딱 붙이기)
+		if (Ground.bHitGround && Ground.bIsFloor)
+		{
+			if (Ground.Gap >= 0.f && Ground.Gap <= Params.GroundSnapMax && DeltaZ < 0.f)
+			{
+				// Gap 중에서 ProbeDistance만큼은 남기고 내려가서 안정화(경사에서 끼임 방지)
+				const float SnapDown = FMath::Max(0.f, Ground.Gap - Params.GroundProbeDistance);
+				DeltaZ = -SnapDown;
+				State.VerticalVelocity = 0.f;
+			}
+		}
+
+		return DeltaZ;
+	}
+
+	void OnVerticalBlocked(const FDroneFlightParams& Params, float ImpactNormalZ, FDroneFlightState& State)
+	{
+		State.VerticalVelocity = 0.f;
+
+		// 바닥으로 충돌한 경우 grounded 확정
+		if (ImpactNormalZ >= Params.WalkableFloorZ)
+		{
+			State.bGrounded = true;
+			State.TimeSinceGrounded = 0.f;
+		}
+	}
+}
@@ -0,0 +1,135 @@
+﻿#include "DroneGroundCache.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/HitResult.h"
+
+void FDroneGroundCache::SetCellSize(float InCellSize)
+{
+	const float NewSize = FMath::Max(1.f, InCellSize);
+	if (!FMath::IsNearlyEqual(NewSize, CellSize))
+	{
+		CellSize = NewSize;
+		Invalidate();
+	}
+}
+
+FIntPoint FDroneGroundCache::ToCell(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+bool FDroneGroundCache::IsStaticGround(const UPrimitiveComponent& Component)
+{
+	return Component.Mobility == EComponentMobility::Static
+		&& Component.GetCollisionObjectType() == ECC_WorldStatic;
+}
+
+FDroneGroundCache::ELookup FDroneGroundCache::Lookup(const FVector& Start, float TraceLen, float ProbeRadius, float MaxVerticalDrift, FHitResult& OutHit)
+{
+	const FIntPoint Key = ToCell(Start);
+	const FDroneGroundCell* Cell = Cells.Find(Key);
+	if (!Cell) return ELookup::Miss;
+
+	// 바닥이 사라졌거나, 런타임에 움직일 수 있게 바뀌었거나(SetMobility/채널 변경), 오래된 셀 → 버리고 재탐색
+	const UPrimitiveComponent* CellComp = Cell->Component.Get();
+	if (!CellComp || !IsStaticGround(*CellComp)
+		|| (MaxEntryAge > 0.f && Now - Cell->StoredTime > MaxEntryAge))
+	{
+		Cells.Remove(Key);
+		return ELookup::Miss;
+	}
+
+	// 다른 모양으로 얻은 값이면 못 씀
+	if (!FMath::IsNearlyEqual(Cell->ProbeRadius, ProbeRadius, 0.5f)) return ELookup::Miss;
+
+	const FVector& N = Cell->ImpactNormal;
+	if (N.Z <= KINDA_SMALL_NUMBER) return ELookup::Miss;
+
+	// 셀 안에서는 바닥을 평면으로 보고 현재 XY에서의 접촉 높이 외삽
+	const float DX = Start.X - Cell->ContactLocation.X;
+	const float DY = Start.Y - Cell->ContactLocation.Y;
+	const float ContactZ = Cell->ContactLocation.Z - (N.X * DX + N.Y * DY) / N.Z;
+
+	const float Distance = Start.Z - ContactZ;
+
+	// 바닥 아래로 내려갔거나 너무 멀어졌으면(큰 수직 이동) 재탐색
+	if (Distance < 0.f || Distance > TraceLen + MaxVerticalDrift) return ELookup::Miss;
+
+	// 탐색 범위 밖이지만 가까움 → 탐색해도 miss
+	if (Distance > TraceLen) return ELookup::NoGround;
+
+	OutHit = FHitResult();
+	OutHit.bBlockingHit = true;
+	OutHit.Distance = Distance;
+	OutHit.Time = TraceLen > 0.f ? Distance / TraceLen : 0.f;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = Start + FVector(0, 0, -TraceLen);
+	OutHit.Location = FVector(Start.X, Start.Y, ContactZ);
+	OutHit.ImpactPoint = Cell->ImpactPoint + FVector(DX, DY, ContactZ - Cell->ContactLocation.Z);
+	OutHit.ImpactNormal = N;
+	OutHit.Normal = N;
+	OutHit.Component = Cell->Component;
+	OutHit.HitObjectHandle = FActorInstanceHandle(CellComp->GetOwner());
+
+	return ELookup::Hit;
+}
+
+void FDroneGroundCache::Store(const FHitResult& Hit, float ProbeRadius, float WalkableFloorZ)
+{
+	if (!Hit.bBlockingHit || Hit.bStartPenetrating) return;
+
+	// 움직일 수 있는 물체는 캐시하지 않음(정적 월드 지오메트리만)
+	const UPrimitiveComponent* HitComp = Hit.GetComponent();
+	if (!HitComp || !IsStaticGround(*HitComp)) return;
+
+	// 벽/모서리는 셀 대표값으로 부적절
+	const bool bWalkable = Hit.ImpactNormal.Z >= WalkableFloorZ;
+	if (!bWalkable) return;
+
+	FDroneGroundCell& Cell = Cells.FindOrAdd(ToCell(Hit.TraceStart));
+	Cell.ContactLocation = Hit.Location;
+	Cell.ImpactPoint = Hit.ImpactPoint;
+	Cell.ImpactNormal = Hit.ImpactNormal;
+	Cell.ProbeRadius = ProbeRadius;
+	Cell.bWalkable = bWalkable;
+	Cell.StoredTime = Now;
+	Cell.Component = Hit.Component;
+}
+
+void FDroneGroundCache::Invalidate()
+{
+	Cells.Reset();
+}
+
+void FDroneGroundCache::InvalidateBox(const FBox& Box)
+{
+	if (!Box.IsValid) return;
+
+	const FIntPoint Min = ToCell(Box.Min);
+	const FIntPoint Max = ToCell(Box.Max);
+
+	// 박스가 크면 셀 순회보다 전체 순회가 쌈
+	const int64 BoxCells = int64(Max.X - Min.X + 1) * int64(Max.Y - Min.Y + 1);
+	if (BoxCells > Cells.Num())
+	{
+		for (auto It = Cells.CreateIterator(); It; ++It)
+		{
+			const FIntPoint& Key = It.Key();
+			if (Key.X >= Min.X && Key.X <= Max.X && Key.Y >= Min.Y && Key.Y <= Max.Y)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		return;
+	}
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			Cells.Remove(FIntPoint(X, Y));
+		}
+	}
+}
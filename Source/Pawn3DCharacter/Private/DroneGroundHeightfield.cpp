@@ -0,0 +1,328 @@
+﻿#include "DroneGroundHeightfield.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Engine/HitResult.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// 바닥이 하나도 없는 타일(파일에서 생략)
+	const FDroneHeightCell EmptyCell;
+
+	FVector DecodeNormal(const FDroneHeightCell& Cell)
+	{
+		const float X = Cell.NormalX / 127.f;
+		const float Y = Cell.NormalY / 127.f;
+		const float Z = FMath::Sqrt(FMath::Max(0.f, 1.f - X * X - Y * Y));
+		return FVector(X, Y, Z);
+	}
+}
+
+FDroneGroundHeightfield::~FDroneGroundHeightfield()
+{
+	Unload();
+}
+
+FString FDroneGroundHeightfield::GetPathForMap(const FString& MapName)
+{
+	return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("Baked"), TEXT("Heightfields"), MapName + TEXT(".p3dh"));
+}
+
+// 로드
+
+bool FDroneGroundHeightfield::Load(const FString& Path, FString& OutError)
+{
+	Unload();
+
+	// 1) 메모리 매핑(루스 파일)
+	auto Result = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+	if (!Result.HasError())
+	{
+		MappedFile = Result.StealValue();
+		const int64 FileSize = MappedFile->GetFileSize();
+		if (FileSize > 0)
+		{
+			MappedRegion.Reset(MappedFile->MapRegion(0, FileSize));
+		}
+
+		if (MappedRegion)
+		{
+			Data = MappedRegion->GetMappedPtr();
+			Size = MappedRegion->GetMappedSize();
+		}
+		else
+		{
+			MappedFile.Reset();
+		}
+	}
+
+	// 2) 매핑이 안 되는 곳(pak 안 등)은 통째로 읽음
+	if (!Data)
+	{
+		if (!FFileHelper::LoadFileToArray(Loaded, *Path, FILEREAD_Silent))
+		{
+			OutError = FString::Printf(TEXT("cannot open %s"), *Path);
+			return false;
+		}
+
+		Data = Loaded.GetData();
+		Size = Loaded.Num();
+	}
+
+	// ===== 검증 =====
+	if (Size < static_cast<int64>(sizeof(FDroneHeightfieldHeader)))
+	{
+		OutError = TEXT("truncated header");
+		Unload();
+		return false;
+	}
+
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+	if (Header.Magic != Magic || Header.Version != Version)
+	{
+		OutError = TEXT("not a P3D heightfield or version mismatch");
+		Unload();
+		return false;
+	}
+
+	if (Header.TileSize == 0 || Header.CellSize <= 0.f || Header.HeightStep <= 0.f
+		|| Header.NumTilesX <= 0 || Header.NumTilesY <= 0 || Header.NumStoredTiles < 0)
+	{
+		OutError = TEXT("bad header");
+		Unload();
+		return false;
+	}
+
+	const int64 NumTiles = int64(Header.NumTilesX) * Header.NumTilesY;
+	TileStride = sizeof(FDroneHeightTileHeader) + int32(Header.TileSize) * Header.TileSize * sizeof(FDroneHeightCell);
+
+	const int64 TableOffset = sizeof(FDroneHeightfieldHeader);
+	const int64 TilesOffset = TableOffset + NumTiles * sizeof(int32);
+	if (Size < TilesOffset + int64(Header.NumStoredTiles) * TileStride)
+	{
+		OutError = TEXT("truncated tiles");
+		Unload();
+		return false;
+	}
+
+	TileTable = reinterpret_cast<const int32*>(Data + TableOffset);
+	Tiles = Data + TilesOffset;
+
+	for (int64 i = 0; i < NumTiles; ++i)
+	{
+		if (TileTable[i] < INDEX_NONE || TileTable[i] >= Header.NumStoredTiles)
+		{
+			OutError = TEXT("bad tile table");
+			Unload();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FDroneGroundHeightfield::Unload()
+{
+	TileTable = nullptr;
+	Tiles = nullptr;
+	TileStride = 0;
+
+	Data = nullptr;
+	Size = 0;
+
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	Loaded.Empty();
+
+	Header = FDroneHeightfieldHeader();
+}
+
+// 조회
+
+const FDroneHeightCell* FDroneGroundHeightfield::FindCell(const FVector& Location, float& OutBaseZ, FVector2D& OutCenter) const
+{
+	const int32 GlobalX = FMath::FloorToInt32(Location.X / Header.CellSize);
+	const int32 GlobalY = FMath::FloorToInt32(Location.Y / Header.CellSize);
+
+	const int32 CellX = GlobalX - Header.MinCellX;
+	const int32 CellY = GlobalY - Header.MinCellY;
+	if (CellX < 0 || CellY < 0) return nullptr;
+
+	const int32 TileSize = Header.TileSize;
+	const int32 TileX = CellX / TileSize;
+	const int32 TileY = CellY / TileSize;
+	if (TileX >= Header.NumTilesX || TileY >= Header.NumTilesY) return nullptr;
+
+	OutCenter = FVector2D((GlobalX + 0.5) * Header.CellSize, (GlobalY + 0.5) * Header.CellSize);
+
+	const int32 TileIndex = TileTable[TileY * Header.NumTilesX + TileX];
+	if (TileIndex == INDEX_NONE)
+	{
+		OutBaseZ = 0.f;
+		return &EmptyCell;
+	}
+
+	const uint8* Tile = Tiles + int64(TileIndex) * TileStride;
+	OutBaseZ = reinterpret_cast<const FDroneHeightTileHeader*>(Tile)->BaseZ;
+
+	const FDroneHeightCell* TileCells = reinterpret_cast<const FDroneHeightCell*>(Tile + sizeof(FDroneHeightTileHeader));
+	return &TileCells[(CellY % TileSize) * TileSize + (CellX % TileSize)];
+}
+
+FDroneGroundHeightfield::ELookup FDroneGroundHeightfield::Lookup(const FVector& Start, float TraceLen, float ProbeRadius, FHitResult& OutHit) const
+{
+	// 다른 모양으로 베이크한 값은 못 씀
+	if (!Data || !FMath::IsNearlyEqual(Header.ProbeRadius, ProbeRadius, 0.5f)) return ELookup::Miss;
+
+	float BaseZ = 0.f;
+	FVector2D Center;
+	const FDroneHeightCell* Cell = FindCell(Start, BaseZ, Center);
+	if (!Cell) return ELookup::Miss;
+
+	const EDroneHeightCellFlags Flags = static_cast<EDroneHeightCellFlags>(Cell->Flags);
+	if (EnumHasAnyFlags(Flags, EDroneHeightCellFlags::Dynamic | EDroneHeightCellFlags::Ambiguous)) return ELookup::Miss;
+	if (!EnumHasAnyFlags(Flags, EDroneHeightCellFlags::Ground)) return ELookup::NoGround;
+
+	const FVector N = DecodeNormal(*Cell);
+	if (N.Z <= KINDA_SMALL_NUMBER) return ELookup::Miss;
+
+	// 셀 중심 접촉 높이에서 셀 평면으로 외삽(FDroneGroundCache와 같은 재구성)
+	const float CellZ = BaseZ + Cell->Height * Header.HeightStep;
+	const float DX = Start.X - Center.X;
+	const float DY = Start.Y - Center.Y;
+	const float ContactZ = CellZ - (N.X * DX + N.Y * DY) / N.Z;
+
+	const float Distance = Start.Z - ContactZ;
+
+	// 베이크한 맨 위 바닥보다 아래(지오메트리 안쪽/지하) → 위에서 본 정보가 안 맞음
+	if (Distance < 0.f) return ELookup::Miss;
+	if (Distance > TraceLen) return ELookup::NoGround;
+
+	OutHit = FHitResult();
+	OutHit.bBlockingHit = true;
+	OutHit.Distance = Distance;
+	OutHit.Time = TraceLen > 0.f ? Distance / TraceLen : 0.f;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = Start + FVector(0, 0, -TraceLen);
+	OutHit.Location = FVector(Start.X, Start.Y, ContactZ);
+	OutHit.ImpactPoint = OutHit.Location - N * ProbeRadius;
+	OutHit.ImpactNormal = N;
+	OutHit.Normal = N;
+
+	return ELookup::Hit;
+}
+
+// 베이크 저장
+
+bool FDroneGroundHeightfield::Save(const FString& Path, FDroneHeightfieldHeader InHeader, int32 NumCellsX, int32 NumCellsY,
+	const TArray<FBakeCell>& Cells, int64& OutBytes, FString& OutError)
+{
+	OutBytes = 0;
+
+	const int32 TileSize = InHeader.TileSize;
+	if (TileSize <= 0 || NumCellsX <= 0 || NumCellsY <= 0 || Cells.Num() != NumCellsX * NumCellsY || InHeader.HeightStep <= 0.f)
+	{
+		OutError = TEXT("bad bake input");
+		return false;
+	}
+
+	InHeader.Magic = Magic;
+	InHeader.Version = Version;
+	InHeader.NumTilesX = FMath::DivideAndRoundUp(NumCellsX, TileSize);
+	InHeader.NumTilesY = FMath::DivideAndRoundUp(NumCellsY, TileSize);
+
+	const int32 NumTiles = InHeader.NumTilesX * InHeader.NumTilesY;
+	const int32 CellsPerTile = TileSize * TileSize;
+
+	TArray<int32> TileTable;
+	TileTable.Init(INDEX_NONE, NumTiles);
+
+	TArray<uint8> TileData;
+	TArray<FDroneHeightCell> TileCells;
+	int32 NumStored = 0;
+
+	for (int32 TileY = 0; TileY < InHeader.NumTilesY; ++TileY)
+	{
+		for (int32 TileX = 0; TileX < InHeader.NumTilesX; ++TileX)
+		{
+			const int32 X0 = TileX * TileSize;
+			const int32 Y0 = TileY * TileSize;
+			const int32 X1 = FMath::Min(X0 + TileSize, NumCellsX);
+			const int32 Y1 = FMath::Min(Y0 + TileSize, NumCellsY);
+
+			// 타일 기준 높이 = 바닥 최저점(셀 높이는 그 위 uint16 오프셋)
+			float MinZ = TNumericLimits<float>::Max();
+			bool bAnyInfo = false;
+
+			for (int32 Y = Y0; Y < Y1; ++Y)
+			{
+				for (int32 X = X0; X < X1; ++X)
+				{
+					const FBakeCell& Cell = Cells[Y * NumCellsX + X];
+					bAnyInfo |= Cell.Flags != EDroneHeightCellFlags::None;
+					if (EnumHasAnyFlags(Cell.Flags, EDroneHeightCellFlags::Ground))
+					{
+						MinZ = FMath::Min(MinZ, Cell.Z);
+					}
+				}
+			}
+
+			// 전부 빈 곳 → 생략(런타임에 NoGround)
+			if (!bAnyInfo) continue;
+
+			FDroneHeightTileHeader TileHeader;
+			TileHeader.BaseZ = (MinZ == TNumericLimits<float>::Max()) ? 0.f : MinZ;
+
+			TileCells.Reset();
+			TileCells.AddDefaulted(CellsPerTile);
+
+			for (int32 Y = Y0; Y < Y1; ++Y)
+			{
+				for (int32 X = X0; X < X1; ++X)
+				{
+					const FBakeCell& Cell = Cells[Y * NumCellsX + X];
+					FDroneHeightCell& Out = TileCells[(Y - Y0) * TileSize + (X - X0)];
+
+					EDroneHeightCellFlags Flags = Cell.Flags;
+					if (EnumHasAnyFlags(Flags, EDroneHeightCellFlags::Ground))
+					{
+						const int64 Quantized = FMath::RoundToInt64((Cell.Z - TileHeader.BaseZ) / InHeader.HeightStep);
+
+						// 타일 안 높이 차가 uint16 범위를 넘으면 런타임 스윕으로
+						if (Quantized > TNumericLimits<uint16>::Max())
+						{
+							Flags |= EDroneHeightCellFlags::Ambiguous;
+						}
+						Out.Height = static_cast<uint16>(FMath::Clamp<int64>(Quantized, 0, TNumericLimits<uint16>::Max()));
+						Out.NormalX = static_cast<int8>(FMath::RoundToInt32(FMath::Clamp(Cell.Normal.X, -1.f, 1.f) * 127.f));
+						Out.NormalY = static_cast<int8>(FMath::RoundToInt32(FMath::Clamp(Cell.Normal.Y, -1.f, 1.f) * 127.f));
+					}
+					Out.Flags = static_cast<uint8>(Flags);
+				}
+			}
+
+			TileTable[TileY * InHeader.NumTilesX + TileX] = NumStored++;
+			TileData.Append(reinterpret_cast<const uint8*>(&TileHeader), sizeof(TileHeader));
+			TileData.Append(reinterpret_cast<const uint8*>(TileCells.GetData()), TileCells.Num() * sizeof(FDroneHeightCell));
+		}
+	}
+
+	InHeader.NumStoredTiles = NumStored;
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(sizeof(InHeader) + TileTable.Num() * sizeof(int32) + TileData.Num());
+	Buffer.Append(reinterpret_cast<const uint8*>(&InHeader), sizeof(InHeader));
+	Buffer.Append(reinterpret_cast<const uint8*>(TileTable.GetData()), TileTable.Num() * sizeof(int32));
+	Buffer.Append(TileData);
+
+	if (!FFileHelper::SaveArrayToFile(Buffer, *Path))
+	{
+		OutError = FString::Printf(TEXT("cannot write %s"), *Path);
+		return false;
+	}
+
+	OutBytes = Buffer.Num();
+	return true;
+}
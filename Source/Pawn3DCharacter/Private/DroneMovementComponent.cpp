@@ -0,0 +1,74 @@
+﻿#include "DroneMovementComponent.h"
+
+#include "P3DStats.h"
+
+UDroneMovementComponent::UDroneMovementComponent()
+{
+	// Pawn 고정 스텝 루프에서 직접 호출(자체 Tick 없음)
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UDroneMovementComponent::MoveStep(const FVector& Delta, const FQuat& NewRotation, float DeltaTime, FHitResult& OutHit, FHitResult& OutSlideHit)
+{
+	OutHit.Reset(1.f, false);
+	OutSlideHit.Reset(1.f, false);
+
+	if (!UpdatedComponent || ShouldSkipUpdate(DeltaTime)) return;
+
+	// 움직임도 회전도 없으면 스윕 생략
+	if (Delta.IsNearlyZero() && UpdatedComponent->GetComponentQuat().Equals(NewRotation))
+	{
+		Velocity = FVector::ZeroVector;
+		UpdateComponentVelocity();
+		return;
+	}
+
+	const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+
+	SafeMoveUpdatedComponent(Delta, NewRotation, true, OutHit);
+
+	if (OutHit.IsValidBlockingHit())
+	{
+		// 남은 이동량을 충돌면에 투영해서 미끄러짐(막힌 자리에서 멈추지 않게)
+		const FVector SlideDelta = ComputeSlideVector(Delta, 1.f - OutHit.Time, OutHit.Normal, OutHit);
+		if (!SlideDelta.IsNearlyZero() && (SlideDelta | Delta) > 0.f)
+		{
+			FHitResult SlideHit;
+			SafeMoveUpdatedComponent(SlideDelta, NewRotation, true, SlideHit);
+
+			if (SlideHit.IsValidBlockingHit())
+			{
+				OutSlideHit = SlideHit;
+
+				// 두 벽 모서리: 두 충돌면 모두를 따라가는 방향으로 보정 후 한 번 더 미끄러짐
+				FVector CornerDelta = SlideDelta;
+				TwoWallAdjust(CornerDelta, SlideHit, OutHit.Normal);
+
+				if (!CornerDelta.IsNearlyZero(1e-3f) && (CornerDelta | Delta) > 0.f)
+				{
+					FHitResult CornerHit;
+					SafeMoveUpdatedComponent(CornerDelta, NewRotation, true, CornerHit);
+					if (CornerHit.IsValidBlockingHit())
+					{
+						OutSlideHit = CornerHit;
+					}
+				}
+			}
+		}
+	}
+
+	Velocity = (DeltaTime > 0.f) ? (UpdatedComponent->GetComponentLocation() - OldLocation) / DeltaTime : FVector::ZeroVector;
+	UpdateComponentVelocity();
+}
+
+bool UDroneMovementComponent::MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit, ETeleportType Teleport)
+{
+	if (bSweep && !Delta.IsNearlyZero())
+	{
+		INC_DWORD_STAT(STAT_P3D_DroneMoveSweeps);
+		P3DCounters::AddSceneQuery();
+	}
+	P3DCounters::AddOffset();
+
+	return Super::MoveUpdatedComponentImpl(Delta, NewRotation, bSweep, OutHit, Teleport);
+}
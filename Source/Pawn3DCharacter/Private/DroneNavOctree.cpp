@@ -0,0 +1,727 @@
+﻿#include "DroneNavOctree.h"
+
+#include "Algo/Reverse.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	const FIntVector FaceDirs[6] =
+	{
+		FIntVector( 1, 0, 0), FIntVector(-1, 0, 0),
+		FIntVector( 0, 1, 0), FIntVector( 0, -1, 0),
+		FIntVector( 0, 0, 1), FIntVector( 0, 0, -1),
+	};
+
+	FDroneNavRef MakeRef(int32 Index, int32 Layer, uint8 Voxel = FDroneNavRef::WholeNode)
+	{
+		FDroneNavRef Ref;
+		Ref.Index = Index;
+		Ref.Layer = static_cast<uint8>(Layer);
+		Ref.Voxel = Voxel;
+		return Ref;
+	}
+
+	FIntVector VoxelCoord(int32 Voxel)
+	{
+		return FIntVector(Voxel & 3, (Voxel >> 2) & 3, Voxel >> 4);
+	}
+
+	int32 VoxelIndex(const FIntVector& V)
+	{
+		return V.X + V.Y * 4 + V.Z * 16;
+	}
+
+	// Dir 방향에서 들어올 때 닿는 면(Dir이 +면 0쪽, -면 Max쪽)에 있는지
+	bool IsOnFace(const FIntVector& V, const FIntVector& Dir, int32 Max)
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (Dir[Axis] > 0 && V[Axis] != 0) return false;
+			if (Dir[Axis] < 0 && V[Axis] != Max) return false;
+		}
+		return true;
+	}
+
+	// 탐색 중 정점(인덱스로만 참조: 배열이 늘어나도 안전)
+	struct FSearchNode
+	{
+		FDroneNavRef Ref;
+		FVector Center = FVector::ZeroVector;
+		int32 Parent = INDEX_NONE;
+		float G = TNumericLimits<float>::Max();
+		bool bClosed = false;
+	};
+
+	struct FOpenEntry
+	{
+		float F = 0.f;
+		int32 Node = INDEX_NONE;
+
+		bool operator<(const FOpenEntry& Other) const { return F < Other.F; }
+	};
+}
+
+FString FDroneNavOctree::GetPathForMap(const FString& MapName)
+{
+	return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("Baked"), TEXT("NavOctree"), MapName + TEXT(".p3dn"));
+}
+
+FDroneNavOctree::FBlockedTest FDroneNavOctree::MakeWorldBlockedTest(const UWorld* World, float InAgentRadius)
+{
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+
+	return [World, InAgentRadius, ObjectParams](const FBox& Box)
+	{
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(DroneNavBuild), false);
+		return World->OverlapAnyTestByObjectType(Box.GetCenter(), FQuat::Identity, ObjectParams,
+			FCollisionShape::MakeBox(Box.GetExtent() + FVector(InAgentRadius)), Params);
+	};
+}
+
+// 생성
+
+void FDroneNavOctree::Reset()
+{
+	Layers.Empty();
+	LeafMasks.Empty();
+	NumStaleNodes = 0;
+}
+
+void FDroneNavOctree::Build(const FBuildSettings& Settings, const FBlockedTest& IsBlocked)
+{
+	Reset();
+
+	VoxelSize = FMath::Max(Settings.VoxelSize, 1.f);
+	LeafNodeSize = VoxelSize * 4.f;
+	AgentRadius = Settings.AgentRadius;
+	Origin = Settings.Bounds.Min;
+	SourceBounds = Settings.Bounds;
+
+	// 루트 한 변이 바운드를 덮을 때까지 레이어 추가(좌표는 uint16)
+	const float MaxExtent = Settings.Bounds.GetSize().GetMax();
+	int32 NumLayers = 1;
+	while (GetNodeSize(NumLayers - 1) < MaxExtent && NumLayers < 16)
+	{
+		++NumLayers;
+	}
+
+	Layers.SetNum(NumLayers);
+	Layers.Last().AddDefaulted();
+
+	BuildFrom(NumLayers - 1, { 0 }, IsBlocked);
+}
+
+void FDroneNavOctree::BuildFrom(int32 Layer, TArray<int32> StartNodes, const FBlockedTest& IsBlocked)
+{
+	TArray<int32> Frontier = MoveTemp(StartNodes);
+
+	for (int32 L = Layer; L >= 0 && Frontier.Num() > 0; --L)
+	{
+		TArray<FDroneNavNode>& Nodes = Layers[L];
+
+		// 1) 분류(겹침 검사만, 병렬)
+		TArray<EDroneNavNodeState> States;
+		TArray<uint64> Masks;
+		States.SetNum(Frontier.Num());
+		Masks.SetNumZeroed(L == 0 ? Frontier.Num() : 0);
+
+		ParallelFor(Frontier.Num(), [&](int32 i)
+		{
+			const FBox Box = GetNodeBox(L, Nodes[Frontier[i]]);
+			if (!IsBlocked(Box))
+			{
+				States[i] = EDroneNavNodeState::Free;
+				return;
+			}
+
+			if (L > 0)
+			{
+				States[i] = EDroneNavNodeState::Mixed;
+				return;
+			}
+
+			uint64 Mask = 0;
+			for (int32 v = 0; v < 64; ++v)
+			{
+				const FVector Min = Box.Min + FVector(VoxelCoord(v)) * VoxelSize;
+				if (IsBlocked(FBox(Min, Min + FVector(VoxelSize))))
+				{
+					Mask |= 1ull << v;
+				}
+			}
+
+			Masks[i] = Mask;
+			States[i] = (Mask == 0) ? EDroneNavNodeState::Free : (Mask == ~0ull ? EDroneNavNodeState::Blocked : EDroneNavNodeState::Mixed);
+		});
+
+		// 2) 결과 반영 + Mixed는 자식 할당(순차)
+		TArray<int32> NextFrontier;
+
+		for (int32 i = 0; i < Frontier.Num(); ++i)
+		{
+			const int32 NodeIndex = Frontier[i];
+			const int32 OldChild = Nodes[NodeIndex].FirstChild;
+			const EDroneNavNodeState OldState = Nodes[NodeIndex].State;
+
+			Nodes[NodeIndex].State = States[i];
+			Nodes[NodeIndex].FirstChild = INDEX_NONE;
+
+			if (L == 0)
+			{
+				if (States[i] != EDroneNavNodeState::Mixed) continue;
+
+				// 잎 마스크는 제자리 재사용
+				if (OldState == EDroneNavNodeState::Mixed && OldChild != INDEX_NONE)
+				{
+					LeafMasks[OldChild] = Masks[i];
+					Nodes[NodeIndex].FirstChild = OldChild;
+				}
+				else
+				{
+					Nodes[NodeIndex].FirstChild = LeafMasks.Add(Masks[i]);
+				}
+				continue;
+			}
+
+			// 예전 자식은 버림(도달 불가)
+			if (OldState == EDroneNavNodeState::Mixed && OldChild != INDEX_NONE)
+			{
+				NumStaleNodes += 8;
+			}
+
+			if (States[i] != EDroneNavNodeState::Mixed) continue;
+
+			TArray<FDroneNavNode>& Children = Layers[L - 1];
+			const FDroneNavNode& Parent = Nodes[NodeIndex];
+			Nodes[NodeIndex].FirstChild = Children.Num();
+
+			for (int32 c = 0; c < 8; ++c)
+			{
+				FDroneNavNode Child;
+				Child.X = static_cast<uint16>(Parent.X * 2 + (c & 1));
+				Child.Y = static_cast<uint16>(Parent.Y * 2 + ((c >> 1) & 1));
+				Child.Z = static_cast<uint16>(Parent.Z * 2 + (c >> 2));
+				NextFrontier.Add(Children.Add(Child));
+			}
+		}
+
+		Frontier = MoveTemp(NextFrontier);
+	}
+}
+
+int32 FDroneNavOctree::RebuildBox(const FBox& Box, const FBlockedTest& IsBlocked)
+{
+	if (!IsValid()) return 0;
+
+	// Box = 이미 에이전트 반지름만큼 넓힌 영향 범위(UDroneNavSubsystem::InvalidateNavBox)
+	const FBox& Affected = Box;
+
+	// 박스에 걸친 노드 중 자식이 없는(또는 잎) 노드만 모음
+	TArray<TArray<int32>> PerLayer;
+	PerLayer.SetNum(Layers.Num());
+
+	TArray<TPair<int32, int32>> Stack;
+	Stack.Emplace(Layers.Num() - 1, 0);
+
+	while (Stack.Num() > 0)
+	{
+		const TPair<int32, int32> Item = Stack.Pop(EAllowShrinking::No);
+		const int32 L = Item.Key;
+		const FDroneNavNode& Node = Layers[L][Item.Value];
+
+		if (!GetNodeBox(L, Node).Intersect(Affected)) continue;
+
+		if (L > 0 && Node.State == EDroneNavNodeState::Mixed)
+		{
+			for (int32 c = 0; c < 8; ++c)
+			{
+				Stack.Emplace(L - 1, Node.FirstChild + c);
+			}
+			continue;
+		}
+
+		PerLayer[L].Add(Item.Value);
+	}
+
+	int32 NumRebuilt = 0;
+	for (int32 L = Layers.Num() - 1; L >= 0; --L)
+	{
+		NumRebuilt += PerLayer[L].Num();
+		if (PerLayer[L].Num() > 0)
+		{
+			BuildFrom(L, MoveTemp(PerLayer[L]), IsBlocked);
+		}
+	}
+
+	return NumRebuilt;
+}
+
+// 저장/로드
+
+void FDroneNavOctree::Serialize(FArchive& Ar)
+{
+	Ar << Origin << SourceBounds << VoxelSize << AgentRadius;
+	Ar << Layers;
+	Ar << LeafMasks;
+
+	if (Ar.IsLoading())
+	{
+		LeafNodeSize = VoxelSize * 4.f;
+		NumStaleNodes = 0;
+	}
+}
+
+bool FDroneNavOctree::Save(const FString& Path, FString& OutError) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+
+	uint32 FileMagic = Magic;
+	int32 FileVersion = Version;
+	Ar << FileMagic << FileVersion;
+	const_cast<FDroneNavOctree*>(this)->Serialize(Ar);
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+	{
+		OutError = FString::Printf(TEXT("cannot write %s"), *Path);
+		return false;
+	}
+	return true;
+}
+
+bool FDroneNavOctree::Load(const FString& Path, FString& OutError)
+{
+	Reset();
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+	{
+		OutError = FString::Printf(TEXT("cannot open %s"), *Path);
+		return false;
+	}
+
+	FMemoryReader Ar(Bytes);
+	uint32 FileMagic = 0;
+	int32 FileVersion = 0;
+	Ar << FileMagic << FileVersion;
+
+	if (FileMagic != Magic || FileVersion != Version)
+	{
+		OutError = TEXT("not a P3D nav octree or version mismatch");
+		return false;
+	}
+
+	Serialize(Ar);
+
+	// 자식 인덱스 검증(잘못된 파일로 탐색 중 범위 밖 접근 방지)
+	bool bValid = !Ar.IsError() && Layers.Num() > 0 && Layers.Num() <= 16 && Layers.Last().Num() >= 1 && VoxelSize > 0.f;
+	for (int32 L = 0; bValid && L < Layers.Num(); ++L)
+	{
+		for (const FDroneNavNode& Node : Layers[L])
+		{
+			if (Node.State != EDroneNavNodeState::Mixed) continue;
+
+			const bool bChildOk = (L == 0)
+				? LeafMasks.IsValidIndex(Node.FirstChild)
+				: (Node.FirstChild >= 0 && Node.FirstChild + 8 <= Layers[L - 1].Num());
+			if (!bChildOk)
+			{
+				bValid = false;
+				break;
+			}
+		}
+	}
+
+	if (!bValid)
+	{
+		OutError = TEXT("corrupt nav octree");
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+// 조회
+
+FBox FDroneNavOctree::GetBounds() const
+{
+	if (!IsValid()) return FBox(ForceInit);
+
+	const float RootSize = GetNodeSize(Layers.Num() - 1);
+	return FBox(Origin, Origin + FVector(RootSize));
+}
+
+int32 FDroneNavOctree::GetNumNodes() const
+{
+	int32 Num = 0;
+	for (const TArray<FDroneNavNode>& Nodes : Layers)
+	{
+		Num += Nodes.Num();
+	}
+	return Num;
+}
+
+SIZE_T FDroneNavOctree::GetAllocatedSize() const
+{
+	SIZE_T Size = Layers.GetAllocatedSize() + LeafMasks.GetAllocatedSize();
+	for (const TArray<FDroneNavNode>& Nodes : Layers)
+	{
+		Size += Nodes.GetAllocatedSize();
+	}
+	return Size;
+}
+
+FBox FDroneNavOctree::GetNodeBox(int32 Layer, const FDroneNavNode& Node) const
+{
+	const float Size = GetNodeSize(Layer);
+	const FVector Min = Origin + FVector(Node.X, Node.Y, Node.Z) * Size;
+	return FBox(Min, Min + FVector(Size));
+}
+
+FBox FDroneNavOctree::GetRefBox(const FDroneNavRef& Ref) const
+{
+	const FBox NodeBox = GetNodeBox(Ref.Layer, Layers[Ref.Layer][Ref.Index]);
+	if (Ref.Voxel == FDroneNavRef::WholeNode) return NodeBox;
+
+	const FVector Min = NodeBox.Min + FVector(VoxelCoord(Ref.Voxel)) * VoxelSize;
+	return FBox(Min, Min + FVector(VoxelSize));
+}
+
+FVector FDroneNavOctree::GetRefCenter(const FDroneNavRef& Ref) const
+{
+	return GetRefBox(Ref).GetCenter();
+}
+
+bool FDroneNavOctree::FindNode(int32 Layer, const FIntVector& Coord, int32& OutLayer, int32& OutIndex) const
+{
+	const int32 RootLayer = Layers.Num() - 1;
+	const int32 Range = 1 << (RootLayer - Layer);
+	if (Coord.X < 0 || Coord.Y < 0 || Coord.Z < 0 || Coord.X >= Range || Coord.Y >= Range || Coord.Z >= Range)
+	{
+		return false;
+	}
+
+	int32 L = RootLayer;
+	int32 Index = 0;
+
+	while (L > Layer)
+	{
+		const FDroneNavNode& Node = Layers[L][Index];
+		if (Node.State != EDroneNavNodeState::Mixed) break;
+
+		const int32 Shift = L - 1 - Layer;
+		const int32 Octant = ((Coord.X >> Shift) & 1) | (((Coord.Y >> Shift) & 1) << 1) | (((Coord.Z >> Shift) & 1) << 2);
+		Index = Node.FirstChild + Octant;
+		--L;
+	}
+
+	OutLayer = L;
+	OutIndex = Index;
+	return true;
+}
+
+FDroneNavRef FDroneNavOctree::FindRef(const FVector& Location) const
+{
+	if (!IsValid()) return FDroneNavRef();
+
+	const FVector Local = Location - Origin;
+	const FIntVector LeafCoord(
+		FMath::FloorToInt32(Local.X / LeafNodeSize),
+		FMath::FloorToInt32(Local.Y / LeafNodeSize),
+		FMath::FloorToInt32(Local.Z / LeafNodeSize));
+
+	int32 L = 0;
+	int32 Index = INDEX_NONE;
+	if (!FindNode(0, LeafCoord, L, Index)) return FDroneNavRef();
+
+	const FDroneNavNode& Node = Layers[L][Index];
+	if (Node.State == EDroneNavNodeState::Blocked) return FDroneNavRef();
+	if (Node.State == EDroneNavNodeState::Free) return MakeRef(Index, L);
+
+	// 잎 안의 복셀
+	const FVector InLeaf = Local - FVector(LeafCoord) * LeafNodeSize;
+	const FIntVector V(
+		FMath::Clamp(FMath::FloorToInt32(InLeaf.X / VoxelSize), 0, 3),
+		FMath::Clamp(FMath::FloorToInt32(InLeaf.Y / VoxelSize), 0, 3),
+		FMath::Clamp(FMath::FloorToInt32(InLeaf.Z / VoxelSize), 0, 3));
+	const int32 Voxel = VoxelIndex(V);
+
+	if (LeafMasks[Node.FirstChild] & (1ull << Voxel)) return FDroneNavRef();
+	return MakeRef(Index, 0, static_cast<uint8>(Voxel));
+}
+
+void FDroneNavOctree::GetNeighbors(const FDroneNavRef& Ref, TArray<FDroneNavRef>& OutNeighbors) const
+{
+	OutNeighbors.Reset();
+
+	const FDroneNavNode& Node = Layers[Ref.Layer][Ref.Index];
+	const FIntVector Coord(Node.X, Node.Y, Node.Z);
+	const bool bVoxel = Ref.Voxel != FDroneNavRef::WholeNode;
+
+	for (const FIntVector& Dir : FaceDirs)
+	{
+		FIntVector V = FIntVector::ZeroValue;
+
+		// 같은 잎 안의 옆 복셀
+		if (bVoxel)
+		{
+			V = VoxelCoord(Ref.Voxel) + Dir;
+			if (V.X >= 0 && V.X < 4 && V.Y >= 0 && V.Y < 4 && V.Z >= 0 && V.Z < 4)
+			{
+				if (!(LeafMasks[Node.FirstChild] & (1ull << VoxelIndex(V))))
+				{
+					OutNeighbors.Add(MakeRef(Ref.Index, 0, static_cast<uint8>(VoxelIndex(V))));
+				}
+				continue;
+			}
+		}
+
+		int32 NeighborLayer = 0;
+		int32 NeighborIndex = INDEX_NONE;
+		if (!FindNode(Ref.Layer, Coord + Dir, NeighborLayer, NeighborIndex)) continue;
+
+		const FDroneNavNode& Neighbor = Layers[NeighborLayer][NeighborIndex];
+		if (Neighbor.State == EDroneNavNodeState::Free)
+		{
+			OutNeighbors.Add(MakeRef(NeighborIndex, NeighborLayer));
+		}
+		else if (Neighbor.State == EDroneNavNodeState::Mixed)
+		{
+			if (bVoxel)
+			{
+				// 옆 잎의 맞닿은 복셀 하나
+				const FIntVector Wrapped(V.X & 3, V.Y & 3, V.Z & 3);
+				if (!(LeafMasks[Neighbor.FirstChild] & (1ull << VoxelIndex(Wrapped))))
+				{
+					OutNeighbors.Add(MakeRef(NeighborIndex, 0, static_cast<uint8>(VoxelIndex(Wrapped))));
+				}
+			}
+			else
+			{
+				AddFaceChildren(NeighborLayer, NeighborIndex, Dir, OutNeighbors);
+			}
+		}
+	}
+}
+
+void FDroneNavOctree::AddFaceChildren(int32 Layer, int32 Index, const FIntVector& Dir, TArray<FDroneNavRef>& OutNeighbors) const
+{
+	const FDroneNavNode& Node = Layers[Layer][Index];
+
+	if (Layer == 0)
+	{
+		const uint64 Mask = LeafMasks[Node.FirstChild];
+		for (int32 v = 0; v < 64; ++v)
+		{
+			if (IsOnFace(VoxelCoord(v), Dir, 3) && !(Mask & (1ull << v)))
+			{
+				OutNeighbors.Add(MakeRef(Index, 0, static_cast<uint8>(v)));
+			}
+		}
+		return;
+	}
+
+	for (int32 c = 0; c < 8; ++c)
+	{
+		if (!IsOnFace(FIntVector(c & 1, (c >> 1) & 1, c >> 2), Dir, 1)) continue;
+
+		const int32 ChildIndex = Node.FirstChild + c;
+		const FDroneNavNode& Child = Layers[Layer - 1][ChildIndex];
+
+		if (Child.State == EDroneNavNodeState::Free)
+		{
+			OutNeighbors.Add(MakeRef(ChildIndex, Layer - 1));
+		}
+		else if (Child.State == EDroneNavNodeState::Mixed)
+		{
+			AddFaceChildren(Layer - 1, ChildIndex, Dir, OutNeighbors);
+		}
+	}
+}
+
+bool FDroneNavOctree::LineOfSight(const FVector& From, const FVector& To) const
+{
+	const FVector Delta = To - From;
+	const double Length = Delta.Size();
+	if (Length < KINDA_SMALL_NUMBER) return FindRef(From).IsValid();
+
+	const FVector Dir = Delta / Length;
+	const double Nudge = VoxelSize * 0.01;
+
+	// 지나가는 빈 노드/복셀마다 한 번씩: 박스 출구까지 건너뜀
+	double T = 0.0;
+	while (T < Length)
+	{
+		const FVector P = From + Dir * T;
+		const FDroneNavRef Ref = FindRef(P);
+		if (!Ref.IsValid()) return false;
+
+		const FBox Box = GetRefBox(Ref);
+		double Exit = Length;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (Dir[Axis] > KINDA_SMALL_NUMBER)
+			{
+				Exit = FMath::Min(Exit, (Box.Max[Axis] - P[Axis]) / Dir[Axis]);
+			}
+			else if (Dir[Axis] < -KINDA_SMALL_NUMBER)
+			{
+				Exit = FMath::Min(Exit, (Box.Min[Axis] - P[Axis]) / Dir[Axis]);
+			}
+		}
+
+		T += FMath::Max(Exit, 0.0) + Nudge;
+	}
+
+	return true;
+}
+
+// 경로 탐색 (A* / Theta*)
+
+FDroneNavPath FDroneNavOctree::FindPath(const FDroneNavQuery& Query) const
+{
+	FDroneNavPath Path;
+	if (!IsValid()) return Path;
+
+	const FDroneNavRef StartRef = FindRef(Query.Start);
+	if (!StartRef.IsValid())
+	{
+		Path.Result = EDroneNavPathResult::StartBlocked;
+		return Path;
+	}
+
+	const FDroneNavRef GoalRef = FindRef(Query.Goal);
+	if (!GoalRef.IsValid())
+	{
+		Path.Result = EDroneNavPathResult::GoalBlocked;
+		return Path;
+	}
+
+	if (StartRef == GoalRef)
+	{
+		Path.Result = EDroneNavPathResult::Success;
+		Path.Points = { Query.Start, Query.Goal };
+		return Path;
+	}
+
+	TArray<FSearchNode> Nodes;
+	TMap<FDroneNavRef, int32> NodeLookup;
+	TArray<FOpenEntry> Open;
+	TArray<FDroneNavRef> Neighbors;
+
+	Nodes.Reserve(1024);
+	NodeLookup.Reserve(1024);
+
+	// 시작/목표 정점 위치는 실제 점(노드 중심 대신)
+	auto GetOrAdd = [&](const FDroneNavRef& Ref) -> int32
+	{
+		if (const int32* Found = NodeLookup.Find(Ref)) return *Found;
+
+		FSearchNode& Node = Nodes.AddDefaulted_GetRef();
+		Node.Ref = Ref;
+		Node.Center = (Ref == StartRef) ? Query.Start : (Ref == GoalRef) ? Query.Goal : GetRefCenter(Ref);
+		return NodeLookup.Add(Ref, Nodes.Num() - 1);
+	};
+
+	const int32 StartNode = GetOrAdd(StartRef);
+	Nodes[StartNode].G = 0.f;
+	Open.HeapPush({ float(FVector::Dist(Query.Start, Query.Goal)), StartNode });
+
+	int32 GoalNode = INDEX_NONE;
+	Path.Result = EDroneNavPathResult::NoPath;
+
+	while (Open.Num() > 0)
+	{
+		FOpenEntry Entry;
+		Open.HeapPop(Entry, EAllowShrinking::No);
+
+		if (Nodes[Entry.Node].bClosed) continue;
+		Nodes[Entry.Node].bClosed = true;
+
+		if (Nodes[Entry.Node].Ref == GoalRef)
+		{
+			GoalNode = Entry.Node;
+			break;
+		}
+
+		if (++Path.Expansions > Query.MaxExpansions)
+		{
+			Path.Result = EDroneNavPathResult::ExpansionLimit;
+			break;
+		}
+
+		const int32 Current = Entry.Node;
+		GetNeighbors(Nodes[Current].Ref, Neighbors);
+
+		for (const FDroneNavRef& NeighborRef : Neighbors)
+		{
+			const int32 Next = GetOrAdd(NeighborRef);
+			if (Nodes[Next].bClosed) continue;
+
+			int32 Parent = Current;
+			const int32 GrandParent = Nodes[Current].Parent;
+
+			// Theta*: 한 칸 위 부모에서 바로 보이면 건너뜀
+			if (Query.bThetaStar && GrandParent != INDEX_NONE && LineOfSight(Nodes[GrandParent].Center, Nodes[Next].Center))
+			{
+				Parent = GrandParent;
+			}
+
+			const float NewG = Nodes[Parent].G + FVector::Dist(Nodes[Parent].Center, Nodes[Next].Center);
+			if (NewG < Nodes[Next].G)
+			{
+				Nodes[Next].G = NewG;
+				Nodes[Next].Parent = Parent;
+				Open.HeapPush({ NewG + float(FVector::Dist(Nodes[Next].Center, Query.Goal)), Next });
+			}
+		}
+	}
+
+	if (GoalNode == INDEX_NONE) return Path;
+
+	for (int32 Node = GoalNode; Node != INDEX_NONE; Node = Nodes[Node].Parent)
+	{
+		Path.Points.Add(Nodes[Node].Center);
+	}
+	Algo::Reverse(Path.Points);
+
+	if (Query.bSmooth)
+	{
+		SmoothPath(Path.Points);
+	}
+
+	Path.Result = EDroneNavPathResult::Success;
+	return Path;
+}
+
+void FDroneNavOctree::SmoothPath(TArray<FVector>& Points) const
+{
+	if (Points.Num() <= 2) return;
+
+	// 기준점에서 보이는 가장 먼 점까지 당김
+	TArray<FVector> Smoothed;
+	Smoothed.Add(Points[0]);
+
+	int32 Anchor = 0;
+	while (Anchor < Points.Num() - 1)
+	{
+		int32 Next = Anchor + 1;
+		while (Next + 1 < Points.Num() && LineOfSight(Points[Anchor], Points[Next + 1]))
+		{
+			++Next;
+		}
+
+		Smoothed.Add(Points[Next]);
+		Anchor = Next;
+	}
+
+	Points = MoveTemp(Smoothed);
+}
@@ -0,0 +1,454 @@
+﻿#include "DroneNavSubsystem.h"
+
+#include "DronePawn.h"
+#include "P3DCommandletWorld.h"
+#include "P3DStats.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/PackageName.h"
+#include "Tasks/Task.h"
+
+static TAutoConsoleVariable<int32> CVarDroneNavBuildMissing(
+	TEXT("p3d.DroneNav.BuildMissing"),
+	0,
+	TEXT("베이크된 내비 옥트리가 없으면 BeginPlay에서 현재 레벨 충돌로 생성(큰 맵은 수 초 걸림)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDroneNavVoxelSize(
+	TEXT("p3d.DroneNav.VoxelSize"),
+	50.f,
+	TEXT("런타임 생성 복셀 크기(cm)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneNavMaxDispatchPerFrame(
+	TEXT("p3d.DroneNav.MaxDispatchPerFrame"),
+	32,
+	TEXT("프레임마다 워커로 보내는 경로 요청 수 상한"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneNavMaxInFlight(
+	TEXT("p3d.DroneNav.MaxInFlight"),
+	64,
+	TEXT("동시에 실행 중인 경로 탐색 수 상한"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneNavMaxExpansions(
+	TEXT("p3d.DroneNav.MaxExpansions"),
+	20000,
+	TEXT("요청 하나가 펼칠 수 있는 정점 수(넘으면 ExpansionLimit)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneNavThetaStar(
+	TEXT("p3d.DroneNav.ThetaStar"),
+	0,
+	TEXT("1 = Theta*(탐색 중 가시선 연결), 0 = A* + 사후 당기기"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneNavSmooth(
+	TEXT("p3d.DroneNav.Smooth"),
+	1,
+	TEXT("결과 경로를 가시선으로 당겨서 꺾임 제거"),
+	ECVF_Default);
+
+namespace
+{
+	double Percentile(TArray<double> Values, double Pct)
+	{
+		if (Values.Num() == 0) return 0.0;
+
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Pct * Values.Num()) - 1, 0, Values.Num() - 1);
+		return Values[Index];
+	}
+
+	float ResolveAgentRadius(const UWorld* World)
+	{
+		// 월드에 있는 드론(BP 값) 우선, 없으면 C++ 기본값
+		for (TActorIterator<ADronePawn> It(const_cast<UWorld*>(World)); It; ++It)
+		{
+			if (It->SphereComp)
+			{
+				return It->SphereComp->GetScaledSphereRadius();
+			}
+		}
+
+		const ADronePawn* DroneCDO = GetDefault<ADronePawn>();
+		return DroneCDO->SphereComp ? DroneCDO->SphereComp->GetScaledSphereRadius() : 45.f;
+	}
+}
+
+// ===== 콘솔 명령 =====
+
+static FAutoConsoleCommandWithWorldAndArgs CmdDroneNavBuild(
+	TEXT("p3d.DroneNav.Build"),
+	TEXT("현재 레벨 충돌로 내비 옥트리 생성(저장 안 함, 베이크는 -run=P3DBakeNav)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UDroneNavSubsystem* Nav = World ? World->GetSubsystem<UDroneNavSubsystem>() : nullptr)
+		{
+			Nav->BuildNavOctree();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdDroneNavStress(
+	TEXT("p3d.DroneNav.Stress"),
+	TEXT("경로 요청 부하 테스트. 인자: 요청 수(기본 500), 시드(기본 0)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UDroneNavSubsystem* Nav = World ? World->GetSubsystem<UDroneNavSubsystem>() : nullptr)
+		{
+			const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 500;
+			const int32 Seed = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+			Nav->StartStressTest(FMath::Max(Count, 1), Seed);
+		}
+	}));
+
+// ===== Subsystem =====
+
+bool UDroneNavSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDroneNavSubsystem::Deinitialize()
+{
+	// 워커가 this/옥트리를 잡고 있음 → 다 끝날 때까지 대기
+	Blockers.Stop();
+
+	WaitForInFlight();
+
+	Requests.Empty();
+	Pending.Empty();
+	StressIds.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDroneNavSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LoadOrBuild();
+
+	Blockers.Start(InWorld, [this](const FBox& Bounds)
+	{
+		InvalidateNavBox(Bounds);
+	});
+}
+
+TStatId UDroneNavSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDroneNavSubsystem, STATGROUP_Tickables);
+}
+
+void UDroneNavSubsystem::Tick(float DeltaTime)
+{
+	CompletedThisFrame = 0;
+	SearchMsThisFrame = 0.0;
+	LatencyMsThisFrame = 0.0;
+
+	DeliverResults();
+	Blockers.Flush();
+
+	// 바뀐 영역이 있으면 발송을 멈추고 실행 중 탐색이 빠지길 기다림
+	if (DirtyBoxes.Num() > 0)
+	{
+		if (NumInFlight > 0)
+		{
+			PublishStats();
+			return;
+		}
+		ApplyDirtyBoxes();
+	}
+
+	DispatchRequests();
+	PublishStats();
+}
+
+// ===== 옥트리 =====
+
+void UDroneNavSubsystem::LoadOrBuild()
+{
+	const UWorld* World = GetWorld();
+	const FString MapName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(World->GetOutermost()->GetName()));
+	const FString Path = FDroneNavOctree::GetPathForMap(MapName);
+
+	if (IFileManager::Get().FileExists(*Path))
+	{
+		FString Error;
+		if (Octree.Load(Path, Error))
+		{
+			UE_LOG(LogTemp, Log, TEXT("[DroneNav] %s: %d nodes, %.1f KB"), *Path,
+				Octree.GetNumNodes(), Octree.GetAllocatedSize() / 1024.0);
+			return;
+		}
+		UE_LOG(LogTemp, Warning, TEXT("[DroneNav] %s: %s"), *Path, *Error);
+	}
+
+	if (CVarDroneNavBuildMissing.GetValueOnGameThread() != 0)
+	{
+		BuildNavOctree();
+	}
+}
+
+bool UDroneNavSubsystem::BuildNavOctree()
+{
+	WaitForInFlight();
+	DeliverResults();
+	DirtyBoxes.Reset();
+
+	const UWorld* World = GetWorld();
+
+	FDroneNavOctree::FBuildSettings Settings;
+	Settings.Bounds = P3DCommandletWorld::ComputeCollisionBounds(World);
+	Settings.VoxelSize = FMath::Max(CVarDroneNavVoxelSize.GetValueOnGameThread(), 10.f);
+	Settings.AgentRadius = ResolveAgentRadius(World);
+
+	if (!Settings.Bounds.IsValid)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[DroneNav] Build: no collision in persistent level"));
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	Octree.Build(Settings, FDroneNavOctree::MakeWorldBlockedTest(World, Settings.AgentRadius));
+
+	UE_LOG(LogTemp, Log, TEXT("[DroneNav] Built %d nodes (%.1f KB) in %.1f ms, voxel %.0f cm, agent %.0f cm"),
+		Octree.GetNumNodes(), Octree.GetAllocatedSize() / 1024.0, (FPlatformTime::Seconds() - StartTime) * 1000.0,
+		Settings.VoxelSize, Settings.AgentRadius);
+	return Octree.IsValid();
+}
+
+void UDroneNavSubsystem::InvalidateNavBox(const FBox& Box)
+{
+	if (!Octree.IsValid() || !Box.IsValid) return;
+
+	// 바뀐 지오메트리에서 에이전트 반지름 안쪽 노드까지 막힘 판정이 달라짐
+	DirtyBoxes.Add(Box.ExpandBy(Octree.GetAgentRadius()));
+}
+
+void UDroneNavSubsystem::ApplyDirtyBoxes()
+{
+	check(NumInFlight == 0);
+
+	const FDroneNavOctree::FBlockedTest IsBlocked = FDroneNavOctree::MakeWorldBlockedTest(GetWorld(), Octree.GetAgentRadius());
+
+	int32 NumRebuilt = 0;
+	for (const FBox& Box : DirtyBoxes)
+	{
+		NumRebuilt += Octree.RebuildBox(Box, IsBlocked);
+	}
+	DirtyBoxes.Reset();
+
+	UE_LOG(LogTemp, Verbose, TEXT("[DroneNav] Rebuilt %d nodes (%d stale)"), NumRebuilt, Octree.GetNumStaleNodes());
+}
+
+// ===== 요청 =====
+
+int32 UDroneNavSubsystem::RequestPath(const FVector& Start, const FVector& Goal, FOnDronePathReady OnReady)
+{
+	if (!Octree.IsValid())
+	{
+		FDroneNavPath Path;
+		Path.Result = EDroneNavPathResult::NotReady;
+		OnReady.ExecuteIfBound(Path);
+		return INDEX_NONE;
+	}
+
+	const int32 Id = NextRequestId++;
+	if (NextRequestId == MAX_int32)
+	{
+		NextRequestId = 1;
+	}
+
+	FRequest& Request = Requests.Add(Id);
+	Request.OnReady = MoveTemp(OnReady);
+	Request.SubmitTime = FPlatformTime::Seconds();
+
+	FPendingRequest& Entry = Pending.AddDefaulted_GetRef();
+	Entry.Id = Id;
+	Entry.Query.Start = Start;
+	Entry.Query.Goal = Goal;
+	Entry.Query.bThetaStar = CVarDroneNavThetaStar.GetValueOnGameThread() != 0;
+	Entry.Query.bSmooth = CVarDroneNavSmooth.GetValueOnGameThread() != 0;
+	Entry.Query.MaxExpansions = FMath::Max(CVarDroneNavMaxExpansions.GetValueOnGameThread(), 1);
+
+	return Id;
+}
+
+void UDroneNavSubsystem::CancelPath(int32 RequestId)
+{
+	if (Requests.Remove(RequestId) == 0) return;
+
+	// 아직 안 보냈으면 대기열에서도 뺌(보낸 것은 결과만 버려짐)
+	Pending.RemoveAll([RequestId](const FPendingRequest& Entry) { return Entry.Id == RequestId; });
+	StressIds.Remove(RequestId);
+}
+
+void UDroneNavSubsystem::DispatchRequests()
+{
+	SCOPE_CYCLE_COUNTER(STAT_P3D_DroneNavDispatch);
+
+	// 끝난 태스크 핸들 정리
+	InFlightTasks.RemoveAllSwap([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+
+	const int32 MaxInFlight = FMath::Max(CVarDroneNavMaxInFlight.GetValueOnGameThread(), 1);
+	const int32 Budget = FMath::Min(FMath::Max(CVarDroneNavMaxDispatchPerFrame.GetValueOnGameThread(), 1), MaxInFlight - NumInFlight);
+	const int32 NumToSend = FMath::Min(Budget, Pending.Num());
+	if (NumToSend <= 0) return;
+
+	for (int32 i = 0; i < NumToSend; ++i)
+	{
+		const FPendingRequest Entry = Pending[i];
+		++NumInFlight;
+
+		// 옥트리는 NumInFlight가 0일 때만 바뀜 → 잠금 없이 읽음
+		InFlightTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Entry]()
+		{
+			const double StartTime = FPlatformTime::Seconds();
+
+			FCompletedRequest Result;
+			Result.Id = Entry.Id;
+			Result.Path = Octree.FindPath(Entry.Query);
+			Result.SearchMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			Completed.Enqueue(MoveTemp(Result));
+		}));
+	}
+
+	// FIFO: 보낸 만큼 앞에서 제거
+	Pending.RemoveAt(0, NumToSend, EAllowShrinking::No);
+}
+
+void UDroneNavSubsystem::DeliverResults()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	FCompletedRequest Result;
+	while (Completed.Dequeue(Result))
+	{
+		--NumInFlight;
+
+		// 취소된 요청은 결과만 버림
+		FRequest Request;
+		if (!Requests.RemoveAndCopyValue(Result.Id, Request)) continue;
+
+		const double LatencyMs = (Now - Request.SubmitTime) * 1000.0;
+
+		++CompletedThisFrame;
+		SearchMsThisFrame += Result.SearchMs;
+		LatencyMsThisFrame += LatencyMs;
+
+		if (StressIds.Contains(Result.Id))
+		{
+			RecordStress(Result.Id, Result, LatencyMs);
+		}
+
+		Request.OnReady.ExecuteIfBound(Result.Path);
+	}
+}
+
+void UDroneNavSubsystem::WaitForInFlight()
+{
+	UE::Tasks::Wait(InFlightTasks);
+	InFlightTasks.Reset();
+}
+
+// ===== 부하 테스트 =====
+
+bool UDroneNavSubsystem::StartStressTest(int32 Count, int32 Seed)
+{
+	if (!Octree.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[DroneNav] Stress: no nav octree (bake with -run=P3DBakeNav or p3d.DroneNav.Build)"));
+		return false;
+	}
+
+	// 이전 테스트가 남아 있으면 결과만 버림
+	for (const int32 Id : StressIds)
+	{
+		Requests.Remove(Id);
+	}
+	StressIds.Reset();
+	Stress = FStressStats();
+
+	const FBox Bounds = Octree.GetSourceBounds().IsValid ? Octree.GetSourceBounds() : Octree.GetBounds();
+	FRandomStream Random(Seed);
+
+	auto RandomFreePoint = [this, &Bounds, &Random](FVector& OutPoint)
+	{
+		for (int32 Attempt = 0; Attempt < 64; ++Attempt)
+		{
+			OutPoint = FVector(
+				Random.FRandRange(Bounds.Min.X, Bounds.Max.X),
+				Random.FRandRange(Bounds.Min.Y, Bounds.Max.Y),
+				Random.FRandRange(Bounds.Min.Z, Bounds.Max.Z));
+			if (!Octree.IsBlocked(OutPoint)) return true;
+		}
+		return false;
+	};
+
+	StressStartTime = FPlatformTime::Seconds();
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		FVector Start, Goal;
+		if (!RandomFreePoint(Start) || !RandomFreePoint(Goal)) continue;
+
+		const int32 Id = RequestPath(Start, Goal, FOnDronePathReady());
+		if (Id != INDEX_NONE)
+		{
+			StressIds.Add(Id);
+		}
+	}
+
+	Stress.Requested = StressIds.Num();
+	Stress.LatencyMs.Reserve(Stress.Requested);
+
+	UE_LOG(LogTemp, Log, TEXT("[DroneNav] Stress: %d requests (seed %d)"), Stress.Requested, Seed);
+	return Stress.Requested > 0;
+}
+
+void UDroneNavSubsystem::RecordStress(int32 Id, const FCompletedRequest& Result, double LatencyMs)
+{
+	StressIds.Remove(Id);
+
+	++Stress.Completed;
+	Stress.Succeeded += Result.Path.Result == EDroneNavPathResult::Success ? 1 : 0;
+	Stress.SearchMsSum += Result.SearchMs;
+	Stress.Expansions += Result.Path.Expansions;
+	Stress.LatencyMs.Add(LatencyMs);
+
+	if (StressIds.Num() == 0)
+	{
+		Stress.WallMs = (FPlatformTime::Seconds() - StressStartTime) * 1000.0;
+		LogStressResult();
+	}
+}
+
+void UDroneNavSubsystem::LogStressResult() const
+{
+	const int32 N = FMath::Max(Stress.Completed, 1);
+
+	UE_LOG(LogTemp, Log, TEXT("[DroneNav] Stress: %d/%d ok in %.1f ms (%.0f paths/s) | latency p50 %.2f p95 %.2f p99 %.2f ms | search avg %.3f ms, %lld expansions avg"),
+		Stress.Succeeded, Stress.Completed, Stress.WallMs,
+		Stress.WallMs > 0.0 ? Stress.Completed * 1000.0 / Stress.WallMs : 0.0,
+		Percentile(Stress.LatencyMs, 0.50), Percentile(Stress.LatencyMs, 0.95), Percentile(Stress.LatencyMs, 0.99),
+		Stress.SearchMsSum / N, Stress.Expansions / N);
+}
+
+// ===== Stats =====
+
+void UDroneNavSubsystem::PublishStats()
+{
+	SET_DWORD_STAT(STAT_P3D_DroneNavPending, Pending.Num());
+	SET_DWORD_STAT(STAT_P3D_DroneNavInFlight, NumInFlight);
+	INC_DWORD_STAT_BY(STAT_P3D_DroneNavCompleted, CompletedThisFrame);
+	SET_FLOAT_STAT(STAT_P3D_DroneNavSearchMs, CompletedThisFrame > 0 ? SearchMsThisFrame / CompletedThisFrame : 0.0);
+	SET_FLOAT_STAT(STAT_P3D_DroneNavLatencyMs, CompletedThisFrame > 0 ? LatencyMsThisFrame / CompletedThisFrame : 0.0);
+	SET_FLOAT_STAT(STAT_P3D_DroneNavOctreeKB, Octree.GetAllocatedSize() / 1024.0);
+}
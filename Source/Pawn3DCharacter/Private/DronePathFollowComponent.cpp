@@ -0,0 +1,155 @@
+﻿#include "DronePathFollowComponent.h"
+
+#include "DroneNavSubsystem.h"
+#include "DronePawn.h"
+#include "P3DInputBuffer.h"
+#include "Engine/World.h"
+
+UDronePathFollowComponent::UDronePathFollowComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UDronePathFollowComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelPendingRequest();
+	Points.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+ADronePawn* UDronePathFollowComponent::GetDrone() const
+{
+	return Cast<ADronePawn>(GetOwner());
+}
+
+// ===== 요청 =====
+
+void UDronePathFollowComponent::MoveToLocation(const FVector& Goal)
+{
+	CancelPendingRequest();
+	Points.Reset();
+	SetComponentTickEnabled(false);
+
+	const ADronePawn* Drone = GetDrone();
+	UDroneNavSubsystem* Nav = GetWorld() ? GetWorld()->GetSubsystem<UDroneNavSubsystem>() : nullptr;
+	if (!Drone || !Nav)
+	{
+		Finish(false);
+		return;
+	}
+
+	// 옥트리가 없으면 콜백이 바로 불림(NotReady) → 그 안에서 실패 처리
+	PathRequestId = Nav->RequestPath(Drone->GetActorLocation(), Goal,
+		FOnDronePathReady::CreateUObject(this, &UDronePathFollowComponent::OnPathReady));
+}
+
+void UDronePathFollowComponent::StopMovement()
+{
+	CancelPendingRequest();
+	Points.Reset();
+	SetComponentTickEnabled(false);
+}
+
+void UDronePathFollowComponent::CancelPendingRequest()
+{
+	if (PathRequestId == INDEX_NONE) return;
+
+	if (UDroneNavSubsystem* Nav = GetWorld() ? GetWorld()->GetSubsystem<UDroneNavSubsystem>() : nullptr)
+	{
+		Nav->CancelPath(PathRequestId);
+	}
+	PathRequestId = INDEX_NONE;
+}
+
+void UDronePathFollowComponent::OnPathReady(const FDroneNavPath& Path)
+{
+	PathRequestId = INDEX_NONE;
+
+	if (Path.Result != EDroneNavPathResult::Success || Path.Points.Num() < 2)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[DroneNav] %s: path failed (%d)"), *GetNameSafe(GetOwner()), (int32)Path.Result);
+		Finish(false);
+		return;
+	}
+
+	// Points[0] = 요청 시점 위치 → 바로 다음 점부터
+	Points = Path.Points;
+	CurrentIndex = 1;
+	LastLocation = GetOwner()->GetActorLocation();
+	SetComponentTickEnabled(true);
+}
+
+void UDronePathFollowComponent::Finish(bool bSuccess)
+{
+	Points.Reset();
+	SetComponentTickEnabled(false);
+
+	OnMoveFinished.Broadcast(bSuccess);
+}
+
+// ===== 따라가기 =====
+
+void UDronePathFollowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	ADronePawn* Drone = GetDrone();
+	if (!Drone || Points.Num() == 0 || DeltaTime <= 0.f) return;
+
+	const FVector Location = Drone->GetActorLocation();
+	const float VerticalSpeed = (Location.Z - LastLocation.Z) / DeltaTime;
+	LastLocation = Location;
+
+	// 통과한 중간 점 건너뛰기
+	while (CurrentIndex < Points.Num() - 1 && FVector::DistSquared(Location, Points[CurrentIndex]) < FMath::Square(WaypointRadius))
+	{
+		++CurrentIndex;
+	}
+
+	const bool bLastPoint = CurrentIndex == Points.Num() - 1;
+	const FVector ToTarget = Points[CurrentIndex] - Location;
+
+	if (bLastPoint && ToTarget.SizeSquared() < FMath::Square(AcceptanceRadius))
+	{
+		Finish(true);
+		return;
+	}
+
+	FP3DScriptedInput Input;
+
+	// ===== 수평 =====
+	const FVector2D Flat(ToTarget.X, ToTarget.Y);
+	const float FlatDist = Flat.Size();
+	if (FlatDist > KINDA_SMALL_NUMBER)
+	{
+		const float Yaw = Drone->GetActorRotation().Yaw;
+
+		if (bFaceMovementDirection && Drone->MouseSensitivity > KINDA_SMALL_NUMBER)
+		{
+			// 드론은 Look.X * MouseSensitivity(도)만큼 돌림 → 프레임당 최대 회전량을 축 값으로 환산
+			const float DesiredYaw = FMath::RadiansToDegrees(FMath::Atan2(ToTarget.Y, ToTarget.X));
+			const float MaxStep = TurnRateDegPerSec * DeltaTime;
+			const float YawStep = FMath::Clamp(FRotator::NormalizeAxis(DesiredYaw - Yaw), -MaxStep, MaxStep);
+			Input.Look.X = YawStep / Drone->MouseSensitivity;
+		}
+
+		// 월드 방향 → 기체 기준 (오른쪽, 앞)
+		const float YawRad = FMath::DegreesToRadians(Yaw);
+		const FVector2D Forward(FMath::Cos(YawRad), FMath::Sin(YawRad));
+		const FVector2D Right(-Forward.Y, Forward.X);
+		const FVector2D Dir = Flat / FlatDist;
+
+		const float Scale = (bLastPoint && SlowDownDistance > 0.f) ? FMath::Min(FlatDist / SlowDownDistance, 1.f) : 1.f;
+		Input.Move = FVector2D(FVector2D::DotProduct(Dir, Right), FVector2D::DotProduct(Dir, Forward)) * Scale;
+	}
+
+	// ===== 수직 =====
+	// 호버 입력(중력 상쇄)을 깔고 고도 차 P 제어 - 수직 속도 감쇠(없으면 목표 고도 아래로 처짐)
+	const float Hover = P3DDroneFlight::GetHoverInput(Drone->GetFlightParams());
+	Input.UpDown = FMath::Clamp(Hover + AltitudeGain * ToTarget.Z - VerticalDamping * VerticalSpeed, -1.f, 1.f);
+
+	// 드론이 다음 입력 소비 때 반영(Tick 순서에 따라 한 프레임 늦을 수 있음)
+	Drone->InjectScriptedInput(Input);
+}
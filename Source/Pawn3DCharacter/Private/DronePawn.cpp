@@ -2,15 +2,26 @@
 
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/SceneComponent.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "DroneMovementComponent.h"
+#include "P3DNetMovementComponent.h"
+#include "DronePathFollowComponent.h"
 
 #include "EnhancedInputComponent.h"
 #include "InputActionValue.h"
 
 #include "P3DPlayerController.h"
+#include "DroneSimSubsystem.h"
+#include "DroneAvoidanceSubsystem.h"
+#include "P3DReplaySubsystem.h"
+#include "P3DProfiling.h"
 #include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/AssetManager.h"
 #include "DrawDebugHelpers.h"
+#include "Misc/ScopeExit.h"
 
 
 // 생성자 / 기본
@@ -26,15 +37,19 @@ ADronePawn::ADronePawn()
 	SphereComp->SetCollisionProfileName(TEXT("Pawn"));
 	SphereComp->SetSimulatePhysics(false);
 
+	// 렌더 보간 오프셋 전용(메시/스프링암 부모)
+	VisualRoot = CreateDefaultSubobject<USceneComponent>(TEXT("VisualRoot"));
+	VisualRoot->SetupAttachment(SphereComp);
+
 	// ===== 2) Mesh =====
 	MeshComp = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComp"));
-	MeshComp->SetupAttachment(SphereComp);
+	MeshComp->SetupAttachment(VisualRoot);
 	MeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	MeshComp->SetSimulatePhysics(false);
 
 	// ===== 3) SpringArm =====
 	SpringArmComp = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArmComp"));
-	SpringArmComp->SetupAttachment(SphereComp);
+	SpringArmComp->SetupAttachment(VisualRoot);
 	SpringArmComp->TargetArmLength = 320.f;
 	SpringArmComp->bUsePawnControlRotation = false;
 
@@ -43,6 +58,19 @@ ADronePawn::ADronePawn()
 	CameraComp->SetupAttachment(SpringArmComp);
 	CameraComp->bUsePawnControlRotation = false;
 
+	// ===== 5) Movement =====
+	MovementComp = CreateDefaultSubobject<UDroneMovementComponent>(TEXT("MovementComp"));
+	MovementComp->UpdatedComponent = SphereComp;
+
+	// ===== 6) Network =====
+	// 이동은 NetMovement가 입력/상태로 직접 주고받음(엔진 기본 이동 복제 끔)
+	NetMovement = CreateDefaultSubobject<UP3DNetMovementComponent>(TEXT("NetMovement"));
+	bReplicates = true;
+	SetReplicatingMovement(false);
+
+	// ===== 7) Path Following =====
+	PathFollowComp = CreateDefaultSubobject<UDronePathFollowComponent>(TEXT("PathFollowComp"));
+
 	// ===== (기본값들: 헤더에 UPROPERTY로 두는 걸 권장) =====
 	// Gravity / Ground
 	bEnableGravity = true;
@@ -54,6 +82,8 @@ ADronePawn::ADronePawn()
 	CoyoteTime = 0.08f;
 
 	bUseSphereSweep = true;
+	bUseAsyncGroundProbe = false;
+	bUseGroundCache = true;
 
 	//접지 확정 파라미터(반지름 오판정 제거)
 	GroundedTolerance = 2.0f;     // Gap 허용(1~3 추천)
@@ -79,9 +109,15 @@ ADronePawn::ADronePawn()
 	RollMaxAbs = 65.f;
 
 	// State
-	VerticalVelocity = 0.f;
-	bGrounded = false;
-	TimeSinceGrounded = 999.f;
+	FlightState = FDroneFlightState();
+
+	// Simulation (고정 스텝)
+	bUseFixedTimestep = true;
+	FixedStepHz = 120.f;
+	MaxSubstepsPerFrame = 8;
+	bInterpolateRender = true;
+	bUseMovementComponent = true;
+	bUseBatchedSimulation = false;
 
 	// Debug
 	bDrawGroundDebug = false;
@@ -90,6 +126,312 @@ ADronePawn::ADronePawn()
 void ADronePawn::BeginPlay()
 {
 	Super::BeginPlay();
+
+	SimSubsystem = GetWorld()->GetSubsystem<UDroneSimSubsystem>();
+
+	if (bUseBatchedSimulation && SimSubsystem)
+	{
+		SimSubsystem->RegisterDrone(this);
+	}
+
+	SignificanceSubsystem = GetWorld()->GetSubsystem<UP3DSignificanceSubsystem>();
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->RegisterPawn(this);
+	}
+
+	AvoidanceSubsystem = GetWorld()->GetSubsystem<UDroneAvoidanceSubsystem>();
+	if (bUseAvoidance && AvoidanceSubsystem)
+	{
+		AvoidanceSubsystem->RegisterDrone(this);
+	}
+
+	ReplaySubsystem = GetWorld()->GetSubsystem<UP3DReplaySubsystem>();
+
+	ApplyDroneMesh();
+}
+
+void ADronePawn::ApplyDroneMesh()
+{
+	if (DroneMesh.IsNull() || !MeshComp) return;
+
+	if (UStaticMesh* Mesh = DroneMesh.Get())
+	{
+		MeshComp->SetStaticMesh(Mesh);
+		return;
+	}
+
+	// 미리 로드 안 된 경로(벤치마크/Mass 승격 등): 로드될 때까지 메시 없이 보임
+	UAssetManager::GetStreamableManager().RequestAsyncLoad(DroneMesh.ToSoftObjectPath(),
+		FStreamableDelegate::CreateWeakLambda(this, [this]()
+		{
+			if (UStaticMesh* Mesh = DroneMesh.Get())
+			{
+				MeshComp->SetStaticMesh(Mesh);
+			}
+		}));
+}
+
+void ADronePawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (BatchIndex != INDEX_NONE && SimSubsystem)
+	{
+		SimSubsystem->UnregisterDrone(this);
+	}
+
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->UnregisterPawn(this);
+	}
+
+	if (AvoidanceSubsystem)
+	{
+		AvoidanceSubsystem->UnregisterDrone(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ADronePawn::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+
+	// 조종 시작 → 다음 재평가까지 기다리지 않고 바로 깨움
+	WakeSignificance();
+}
+
+void ADronePawn::NotifyActorBeginOverlap(AActor* OtherActor)
+{
+	Super::NotifyActorBeginOverlap(OtherActor);
+	WakeSignificance();
+}
+
+void ADronePawn::WakeSignificance()
+{
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->WakePawn(this);
+	}
+}
+
+bool ADronePawn::IsSignificanceIdle() const
+{
+	// 바닥에 내려앉아 입력 없이 멈춰 있음
+	return FlightState.bGrounded
+		&& FMath::IsNearlyZero(FlightState.VerticalVelocity, 1.f)
+		&& CachedMoveInput.IsNearlyZero()
+		&& FMath::IsNearlyZero(CachedUpDownInput)
+		&& FMath::IsNearlyZero(CachedRollInput);
+}
+
+bool ADronePawn::AllowsSignificanceTickControl() const
+{
+	// 배치 시뮬/풀 대기 중이면 Tick은 그쪽에서 관리
+	return BatchIndex == INDEX_NONE && !bInPool;
+}
+
+// 풀 활성/비활성
+
+void ADronePawn::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	ResetFlightState();
+
+	SetActorEnableCollision(true);
+
+	// 스폰 때의 AdjustIfPossible과 같은 역할: 겹치면 근처 빈 곳으로
+	TeleportTo(Location, Rotation);
+
+	// 다른 클라가 풀 위치에서 끌어오는 보간을 하지 않게
+	if (NetMovement)
+	{
+		NetMovement->NotifyTeleported();
+	}
+
+	SetActorHiddenInGame(false);
+	bInPool = false;
+
+	if (bUseAvoidance && AvoidanceSubsystem)
+	{
+		AvoidanceSubsystem->RegisterDrone(this);
+	}
+
+	if (bUseBatchedSimulation && SimSubsystem)
+	{
+		SimSubsystem->RegisterDrone(this);
+	}
+	else
+	{
+		SetActorTickEnabled(true);
+	}
+}
+
+void ADronePawn::DeactivateToPool()
+{
+	if (BatchIndex != INDEX_NONE && SimSubsystem)
+	{
+		SimSubsystem->UnregisterDrone(this);
+	}
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	if (PathFollowComp)
+	{
+		PathFollowComp->StopMovement();
+	}
+
+	if (AvoidanceSubsystem)
+	{
+		AvoidanceSubsystem->UnregisterDrone(this);
+	}
+
+	ResetFlightState();
+	bInPool = true;
+}
+
+void ADronePawn::ResetFlightState()
+{
+	CachedMoveInput = FVector2D::ZeroVector;
+	CachedUpDownInput = 0.f;
+	CachedLookInput = FVector2D::ZeroVector;
+	CachedRollInput = 0.f;
+
+	InputBuffer.Reset();
+	PendingLookTimestamp = 0.0;
+
+	AvoidanceCorrection = FVector::ZeroVector;
+	bAvoidanceBlended = false;
+
+	FlightState = FDroneFlightState();
+	PendingNetRotation.Reset();
+	SnapshotHistory.Reset();
+
+	StreamingVelocity = FVector::ZeroVector;
+	bHasStreamingLocation = false;
+
+	StepAccumulator = 0.f;
+	SimStepCount = 0;
+	bHasSimTransform = false;
+
+	PendingGroundProbe = FTraceHandle();
+	AsyncGroundProbe = FAsyncGroundProbeResult();
+}
+
+// 네트워크 이동 (UP3DNetMovementComponent)
+
+void ADronePawn::NetGatherInput(float DeltaTime, FP3DNetMoveInput& OutInput)
+{
+	// 회전 기준: 아직 안 쓴 네트워크 회전 > 보간 전 시뮬 트랜스폼 > 액터
+	FRotator BaseRotation = GetActorRotation();
+	if (PendingNetRotation.IsSet())
+	{
+		BaseRotation = PendingNetRotation.GetValue();
+	}
+	else if (bUseFixedTimestep && bHasSimTransform)
+	{
+		BaseRotation = CurrSimTransform.Rotator();
+	}
+
+	OutInput.SetMove(CachedMoveInput);
+	OutInput.SetUpDown(CachedUpDownInput);
+	OutInput.SetRotation(ApplyLookAndRoll(BaseRotation, DeltaTime), true);
+}
+
+void ADronePawn::NetSimulateMove(const FP3DNetMoveInput& Input)
+{
+	// 로컬 입력 캐시는 보존(보정 재적용이 이번 프레임 입력 수집보다 먼저 돌 수 있음)
+	const FVector2D LocalMove = CachedMoveInput;
+	const float LocalUpDown = CachedUpDownInput;
+	const FVector2D LocalLook = CachedLookInput;
+	const float LocalRoll = CachedRollInput;
+
+	// 회전은 입력에 실린 값 그대로(서브스텝에서 Look/Roll 재적용 금지)
+	CachedMoveInput = Input.GetMove();
+	CachedUpDownInput = Input.GetUpDown();
+	CachedLookInput = FVector2D::ZeroVector;
+	CachedRollInput = 0.f;
+	PendingNetRotation = Input.GetRotation();
+
+	AdvanceSimulation(Input.GetDeltaTime());
+
+	CachedMoveInput = LocalMove;
+	CachedUpDownInput = LocalUpDown;
+	CachedLookInput = LocalLook;
+	CachedRollInput = LocalRoll;
+}
+
+void ADronePawn::NetSaveState(FP3DNetMoveState& OutState) const
+{
+	// 렌더 보간 전 시뮬 결과 기준
+	const FTransform SimTransform = (bUseFixedTimestep && bHasSimTransform) ? CurrSimTransform : GetActorTransform();
+
+	OutState.Location = SimTransform.GetLocation();
+	OutState.Rotation = SimTransform.Rotator();
+	OutState.VerticalVelocity = FlightState.VerticalVelocity;
+	OutState.bGrounded = FlightState.bGrounded;
+	OutState.TimeSinceGrounded = FlightState.TimeSinceGrounded;
+	OutState.StepAccumulator = StepAccumulator;
+}
+
+void ADronePawn::NetRestoreState(const FP3DNetMoveState& State)
+{
+	SetActorLocationAndRotation(State.Location, State.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+
+	FlightState.VerticalVelocity = State.VerticalVelocity;
+	FlightState.bGrounded = State.bGrounded;
+	FlightState.TimeSinceGrounded = State.TimeSinceGrounded;
+
+	PendingNetRotation.Reset();
+
+	// 이전 위치 기준 비동기 바닥 결과는 버림
+	PendingGroundProbe = FTraceHandle();
+	AsyncGroundProbe = FAsyncGroundProbeResult();
+
+	ResetSimTransform();
+	StepAccumulator = State.StepAccumulator;
+}
+
+void ADronePawn::NetApplyProxyTransform(const FVector& Location, const FRotator& Rotation, float DeltaTime)
+{
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::None);
+}
+
+// 롤백 (P3DRollback)
+
+void ADronePawn::CaptureSnapshot(FP3DPawnSnapshot& Out) const
+{
+	NetSaveState(Out.State);
+
+	Out.MoveInput = CachedMoveInput;
+	Out.LookInput = CachedLookInput;
+	Out.UpDownInput = CachedUpDownInput;
+	Out.RollInput = CachedRollInput;
+	Out.bInputEnabled = true;
+}
+
+void ADronePawn::RestoreSnapshotState(const FP3DPawnSnapshot& Snapshot)
+{
+	NetRestoreState(Snapshot.State);
+}
+
+void ADronePawn::ApplySnapshotInput(const FP3DPawnSnapshot& Snapshot)
+{
+	CachedMoveInput = Snapshot.MoveInput;
+	CachedLookInput = Snapshot.LookInput;
+	CachedUpDownInput = Snapshot.UpDownInput;
+	CachedRollInput = Snapshot.RollInput;
+}
+
+void ADronePawn::ResimulateFrame(float DeltaTime, bool bInputEnabled)
+{
+	// 재시뮬에서 소비한 Look은 지연 측정에서 제외
+	const double LocalLookTimestamp = PendingLookTimestamp;
+	PendingLookTimestamp = 0.0;
+
+	AdvanceSimulation(DeltaTime);
+
+	PendingLookTimestamp = LocalLookTimestamp;
 }
 
 // 입력 바인딩 (기존 유지)
@@ -138,37 +480,163 @@ void ADronePawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent
 	}
 }
 
+void ADronePawn::DestroyPlayerInputComponent()
+{
+	// 캐시 모드: 바인딩을 유지하고 재빙의 시 재사용
+	// (PawnClientRestart는 InputComponent가 있으면 새로 만들지 않음)
+	if (bCacheInputBindings && !IsActorBeingDestroyed())
+	{
+		return;
+	}
+
+	Super::DestroyPlayerInputComponent();
+}
+
 void ADronePawn::Move2D(const FInputActionValue& Value)
 {
 	const FVector2D MoveInput = Value.Get<FVector2D>();
+	if (!UP3DReplaySubsystem::FilterInput(ReplaySubsystem, EP3DReplayInput::Move, MoveInput)) return;
 
 	if (MoveInput.IsNearlyZero())
 	{
-		CachedMoveInput = FVector2D::ZeroVector;
+		InputBuffer.PushMove(FVector2D::ZeroVector);
 		return;
 	}
 
-	CachedMoveInput = MoveInput;
+	InputBuffer.PushMove(MoveInput);
+	WakeSignificance();
 }
 
 void ADronePawn::UpDown(const FInputActionValue& Value)
 {
+	if (!UP3DReplaySubsystem::FilterInput(ReplaySubsystem, EP3DReplayInput::UpDown, FVector2D(Value.Get<float>(), 0.f))) return;
+
 	CachedUpDownInput = Value.Get<float>();
+	if (!FMath::IsNearlyZero(CachedUpDownInput)) WakeSignificance();
 }
 
 void ADronePawn::Look(const FInputActionValue& Value)
 {
-	CachedLookInput = Value.Get<FVector2D>(); // X=Yaw, Y=Pitch
+	if (!UP3DReplaySubsystem::FilterInput(ReplaySubsystem, EP3DReplayInput::Look, Value.Get<FVector2D>())) return;
+
+	// 덮어쓰지 않고 쌓아둠(한 프레임에 여러 번 들어와도 Tick에서 전부 합산)
+	InputBuffer.PushLook(Value.Get<FVector2D>()); // X=Yaw, Y=Pitch
 }
 
 void ADronePawn::Roll(const FInputActionValue& Value)
 {
 	const float Axis = Value.Get<float>();
-	CachedRollInput = FMath::IsNearlyZero(Axis) ? 0.f : Axis;
+	if (!UP3DReplaySubsystem::FilterInput(ReplaySubsystem, EP3DReplayInput::Roll, FVector2D(Axis, 0.f))) return;
+
+	InputBuffer.PushRoll(FMath::IsNearlyZero(Axis) ? 0.f : Axis);
+}
+
+void ADronePawn::ReplayInput(EP3DReplayInput Input, const FVector2D& Value)
+{
+	switch (Input)
+	{
+	case EP3DReplayInput::Move:           Move2D(FInputActionValue(Value)); break;
+	case EP3DReplayInput::UpDown:         UpDown(FInputActionValue(static_cast<float>(Value.X))); break;
+	case EP3DReplayInput::Look:           Look(FInputActionValue(Value)); break;
+	case EP3DReplayInput::Roll:           Roll(FInputActionValue(static_cast<float>(Value.X))); break;
+	case EP3DReplayInput::ReturnToPlayer: ReturnToPlayer(FInputActionValue(true)); break;
+	default: break;
+	}
+}
+
+void ADronePawn::InjectScriptedInput(const FP3DScriptedInput& Input)
+{
+	InputBuffer.PushMove(Input.Move);
+	InputBuffer.PushLook(Input.Look);
+	InputBuffer.PushRoll(Input.Roll);
+	CachedUpDownInput = Input.UpDown;
+
+	if (!Input.Move.IsNearlyZero() || !FMath::IsNearlyZero(Input.UpDown)) WakeSignificance();
+}
+
+void ADronePawn::ConsumeBufferedInput(float DeltaTime)
+{
+	UnblendAvoidance();
+
+	const FP3DInputFrame Frame = InputBuffer.Consume(DeltaTime, LookSmoothing);
+
+	if (Frame.bHasMove) CachedMoveInput = Frame.Move;
+	if (Frame.bHasRoll) CachedRollInput = Frame.Roll;
+
+	// 이번 프레임에 서브스텝이 안 돌 수도 있으니 덮어쓰지 않고 누적
+	CachedLookInput += Frame.Look;
+
+	if (Frame.OldestLookTimestamp > 0.0 && PendingLookTimestamp == 0.0)
+	{
+		PendingLookTimestamp = Frame.OldestLookTimestamp;
+	}
+
+	BlendAvoidance();
+}
+
+// 회피 보정
+
+void ADronePawn::SetAvoidanceEnabled(bool bEnabled)
+{
+	bUseAvoidance = bEnabled;
+
+	if (!AvoidanceSubsystem) return;
+
+	if (bEnabled && !bInPool)
+	{
+		AvoidanceSubsystem->RegisterDrone(this);
+	}
+	else
+	{
+		AvoidanceSubsystem->UnregisterDrone(this);
+	}
+}
+
+void ADronePawn::BlendAvoidance()
+{
+	if (AvoidanceCorrection.IsNearlyZero() || AvoidanceStrength <= 0.f) return;
+
+	// 월드 보정 → 기체 기준 (오른쪽, 앞)
+	const FRotator YawOnly(0.f, GetActorRotation().Yaw, 0.f);
+	const FVector Fwd = FRotationMatrix(YawOnly).GetUnitAxis(EAxis::X);
+	const FVector Rgt = FRotationMatrix(YawOnly).GetUnitAxis(EAxis::Y);
+	const FVector2D Push(FVector::DotProduct(AvoidanceCorrection, Rgt), FVector::DotProduct(AvoidanceCorrection, Fwd));
+
+	FVector2D Move = CachedMoveInput;
+
+	// 장애물 쪽(보정 반대)으로 향하는 입력은 급한 만큼 걷어냄
+	const FVector2D Away = Push.GetSafeNormal();
+	const float Into = -FVector2D::DotProduct(Move, Away);
+	if (Into > 0.f)
+	{
+		Move += Away * Into * FMath::Min(Push.Size() * AvoidanceStrength, 1.f);
+	}
+	Move += Push * AvoidanceStrength;
+
+	PreAvoidanceMove = CachedMoveInput;
+	PreAvoidanceUpDown = CachedUpDownInput;
+
+	BlendedMove = FVector2D(FMath::Clamp(Move.X, -1.f, 1.f), FMath::Clamp(Move.Y, -1.f, 1.f));
+	BlendedUpDown = FMath::Clamp(CachedUpDownInput + float(AvoidanceCorrection.Z) * AvoidanceStrength, -1.f, 1.f);
+
+	CachedMoveInput = BlendedMove;
+	CachedUpDownInput = BlendedUpDown;
+	bAvoidanceBlended = true;
+}
+
+void ADronePawn::UnblendAvoidance()
+{
+	if (!bAvoidanceBlended) return;
+	bAvoidanceBlended = false;
+
+	if (CachedMoveInput == BlendedMove) CachedMoveInput = PreAvoidanceMove;
+	if (CachedUpDownInput == BlendedUpDown) CachedUpDownInput = PreAvoidanceUpDown;
 }
 
 void ADronePawn::ReturnToPlayer(const FInputActionValue& Value)
 {
+	if (!UP3DReplaySubsystem::FilterInput(ReplaySubsystem, EP3DReplayInput::ReturnToPlayer)) return;
+
 	UE_LOG(LogTemp, Warning, TEXT("[Drone] ReturnToPlayer fired. Type=%d"), (int32)Value.GetValueType());
 
 	if (AP3DPlayerController* PC = Cast<AP3DPlayerController>(GetController()))
@@ -178,72 +646,240 @@ void ADronePawn::ReturnToPlayer(const FInputActionValue& Value)
 	}
 }
 
-// Tick (완성형)
+// Tick: 고정 스텝 누적 → 서브스텝 시뮬 → 렌더 보간
 
 void ADronePawn::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// 0) 회전
-	TickRotation(DeltaTime);
+	// 배치 시뮬에 등록된 동안은 서브시스템이 처리(롤백 기록도 끊김 → 비움)
+	if (BatchIndex != INDEX_NONE)
+	{
+		SnapshotHistory.Reset();
+		return;
+	}
 
-	// 1) 바닥 탐색(후보 찾기)
-	FHitResult GroundHit;
-	const bool bHitGround = ProbeGround(GroundHit);
+	P3D_SCOPE(DroneActorTick);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
 
-	// 1-1) 접지 "확정"은 Hit가 아니라 Gap + 바닥 노멀로 판단
-	float Gap = 999999.f;           // 스피어 표면 ~ 바닥 틈(근사)
-	bool bIsFloor = false;
+	ON_SCOPE_EXIT
+	{
+		const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+		P3DCounters::PawnTickCycles += Cycles;
 
-	const float SphereR = SphereComp ? SphereComp->GetScaledSphereRadius() : 45.f;
+		if (SimSubsystem)
+		{
+			SimSubsystem->ReportActorTickCycles(Cycles);
+		}
+		if (SignificanceSubsystem)
+		{
+			SignificanceSubsystem->ReportTickCost(Cycles);
+		}
+	};
 
-	if (bHitGround)
+	PollAsyncGroundProbe();
+	ConsumeBufferedInput(DeltaTime);
+
+	// 롤백 기록: 시뮬 전 상태 + 이번 프레임 입력
+	P3DRollback::RecordFrame(*this, DeltaTime);
+
+	// 네트워크 게임: 예측/서버 입력 시뮬/프록시 보간은 NetMovement가 NetSimulateMove 등으로 처리
+	if (NetMovement && NetMovement->TickNetworkedMove(DeltaTime))
+	{
+		UpdateStreamingVelocity(DeltaTime);
+		return;
+	}
+
+	AdvanceSimulation(DeltaTime);
+	UpdateStreamingVelocity(DeltaTime);
+}
+
+// World Partition 스트리밍 소스(AP3DPlayerController가 빙의한 Pawn에 물어봄)
+
+void ADronePawn::UpdateStreamingVelocity(float DeltaTime)
+{
+	if (!IsPlayerControlled() || DeltaTime <= 0.f)
+	{
+		bHasStreamingLocation = false;
+		return;
+	}
+
+	const FVector Location = GetActorLocation();
+	if (bHasStreamingLocation)
+	{
+		// 프레임 간 흔들림(서브스텝 수 차이/보정)에 예측 영역이 떨지 않게 0.25초 정도로 스무딩
+		const FVector RawVelocity = (Location - LastStreamingLocation) / DeltaTime;
+		const float Alpha = 1.f - FMath::Exp(-DeltaTime / 0.25f);
+		StreamingVelocity = FMath::Lerp(StreamingVelocity, RawVelocity, Alpha);
+	}
+
+	LastStreamingLocation = Location;
+	bHasStreamingLocation = true;
+}
+
+void ADronePawn::GetStreamingShapes(TArray<FStreamingSourceShape>& OutShapes) const
+{
+	const FVector ViewDirection = CameraComp ? CameraComp->GetForwardVector() : GetActorForwardVector();
+	const float LookAheadCm = P3DStreaming::BuildPredictiveShapes(StreamingPrediction, StreamingVelocity, ViewDirection, OutShapes);
+	SET_FLOAT_STAT(STAT_P3D_StreamingLookAheadCm, LookAheadCm);
+}
+
+void ADronePawn::AdvanceSimulation(float DeltaTime)
+{
+	if (!bUseFixedTimestep)
+	{
+		SimulateStep(DeltaTime);
+		IssueAsyncGroundProbe(GetActorLocation());
+
+		// 고정 스텝에서 바뀐 경우 남아 있던 보간 오프셋 정리
+		ApplyRenderTransform(GetActorTransform());
+		return;
+	}
+
+	const float StepDT = 1.f / FMath::Clamp(FixedStepHz, 10.f, 480.f);
+	// 중요도 때문에 Tick 간격이 늘어났으면 그만큼은 따라잡을 수 있게
+	const int32 IntervalSteps = FMath::CeilToInt32(GetActorTickInterval() / StepDT) + 1;
+	const int32 MaxSteps = FMath::Max3(1, MaxSubstepsPerFrame, IntervalSteps);
+
+	// 서브스텝 동안 자식(메시/카메라) 트랜스폼 전파는 스코프 끝에서 한 번만
+	FScopedMovementUpdate ScopedMovement(SphereComp, bUseMovementComponent ? EScopedUpdate::DeferredUpdates : EScopedUpdate::ImmediateUpdates);
+
+	// 1) 루트는 항상 시뮬 위치(보간은 VisualRoot만) → 되돌릴 것 없음
+	if (!bHasSimTransform || !GetActorTransform().Equals(CurrSimTransform, KINDA_SMALL_NUMBER))
 	{
-		Gap = GroundHit.Distance - SphereR;                     // 표면-바닥 틈(대략)
-		bIsFloor = (GroundHit.ImpactNormal.Z >= WalkableFloorZ);
+		// 첫 프레임이거나, 누군가 액터를 직접 옮겼음(텔레포트/스폰 보정 등)
+		ResetSimTransform();
 	}
 
-	const bool bActuallyGrounded = bHitGround && bIsFloor && (Gap <= GroundedTolerance);
+	// 2) 누적 + 서브스텝
+	StepAccumulator += DeltaTime;
 
-	if (bActuallyGrounded)
+	int32 NumSteps = 0;
+	while (StepAccumulator >= StepDT && NumSteps < MaxSteps)
 	{
-		TimeSinceGrounded = 0.f;
+		PrevSimTransform = CurrSimTransform;
+		SimulateStep(StepDT);
+		CurrSimTransform = GetActorTransform();
+
+		StepAccumulator -= StepDT;
+		++NumSteps;
+		++SimStepCount;
+	}
+
+	// 최대 서브스텝을 넘긴 시간은 버림(스파이럴 방지)
+	if (NumSteps >= MaxSteps)
+	{
+		StepAccumulator = FMath::Min(StepAccumulator, StepDT);
+	}
+
+	// 다음 프레임용 바닥 탐색은 보간 전 시뮬 위치 기준으로
+	IssueAsyncGroundProbe(CurrSimTransform.GetLocation());
+
+	// 3) 렌더 보간: Prev ~ Curr 사이를 남은 누적 비율만큼(시각 노드만, 충돌은 시뮬 위치 그대로)
+	if (bInterpolateRender)
+	{
+		const float Alpha = FMath::Clamp(StepAccumulator / StepDT, 0.f, 1.f);
+
+		FTransform RenderTransform;
+		RenderTransform.Blend(PrevSimTransform, CurrSimTransform, Alpha);
+		ApplyRenderTransform(RenderTransform);
 	}
 	else
 	{
-		TimeSinceGrounded += DeltaTime;
+		ApplyRenderTransform(CurrSimTransform);
 	}
+}
 
-	bGrounded = bActuallyGrounded || (TimeSinceGrounded <= CoyoteTime);
+void ADronePawn::ResetSimTransform()
+{
+	PrevSimTransform = GetActorTransform();
+	CurrSimTransform = PrevSimTransform;
+	StepAccumulator = 0.f;
+	bHasSimTransform = true;
 
-	// 2) 수평 이동 (Yaw-only 평면 이동: 기울기와 무관, Z=0)
-	float ControlMul = 1.f;
-	if (bEnableGravity && !bGrounded)
+	ApplyRenderTransform(CurrSimTransform);
+}
+
+void ADronePawn::ApplyRenderTransform(const FTransform& RenderTransform)
+{
+	if (!VisualRoot) return;
+
+	const FTransform Offset = RenderTransform.GetRelativeTransform(GetActorTransform());
+	if (!VisualRoot->GetRelativeTransform().Equals(Offset, KINDA_SMALL_NUMBER))
 	{
-		ControlMul = FMath::Clamp(AirControlMultiplier, 0.f, 1.f);
+		VisualRoot->SetRelativeTransform(Offset);
 	}
+}
 
-	const float CurSpeed = NormalSpeed * ControlMul;
+// 한 스텝 시뮬레이션 (기존 Tick 본문)
 
-	const float RightAxis = CachedMoveInput.X;   // A/D
-	const float ForwardAxis = CachedMoveInput.Y; // W/S
+void ADronePawn::SimulateStep(float DeltaTime)
+{
+	const FDroneFlightParams Params = GetFlightParams();
+	const bool bSingleSweep = bUseMovementComponent && MovementComp;
 
-	if (!FMath::IsNearlyZero(RightAxis) || !FMath::IsNearlyZero(ForwardAxis))
+	// 0) 회전 (단일 스윕 경로는 목표 회전만 구하고 이동과 함께 적용)
+	FRotator StepRotation;
+	if (bSingleSweep)
 	{
-		const FRotator YawOnly(0.f, GetActorRotation().Yaw, 0.f);
-		const FVector Fwd = FRotationMatrix(YawOnly).GetUnitAxis(EAxis::X);
-		const FVector Rgt = FRotationMatrix(YawOnly).GetUnitAxis(EAxis::Y);
+		StepRotation = ComputeStepRotation(DeltaTime);
+	}
+	else
+	{
+		TickRotation(DeltaTime);
+		StepRotation = GetActorRotation();
+	}
 
-		FVector WorldHorizontal = (Fwd * ForwardAxis + Rgt * RightAxis) * CurSpeed * DeltaTime;
-		WorldHorizontal.Z = 0.f;
+	// 1) 바닥 탐색(후보 찾기)
+	FHitResult GroundHit;
+	const bool bHitGround = ProbeGround(GroundHit);
 
-		AddActorWorldOffset(WorldHorizontal, true);
+	// 1-1) 접지 "확정"은 Hit가 아니라 Gap + 바닥 노멀로 판단
+	const FDroneGroundSample Ground = MakeGroundSample(GroundHit, bHitGround);
+	P3DDroneFlight::UpdateGrounded(Params, Ground, DeltaTime, FlightState);
+
+	// 2) 수평 이동량 (Yaw-only 평면 이동: 기울기와 무관, Z=0)
+	const FVector WorldHorizontal = ComputeHorizontalDelta(DeltaTime, P3DDroneFlight::GetHorizontalSpeed(Params, FlightState), StepRotation.Yaw);
+
+	if (bSingleSweep)
+	{
+		// 3) 수직 이동량만 구하고 회전 + 수평 + 수직을 한 번에
+		float DeltaZ = 0.f;
+		if (bEnableGravity)
+		{
+			P3D_SCOPE(DroneTickVertical);
+			DeltaZ = P3DDroneFlight::IntegrateVertical(Params, Ground, DeltaTime, CachedUpDownInput, FlightState);
+		}
+		else
+		{
+			DeltaZ = CachedUpDownInput * (NormalSpeed * 0.8f) * DeltaTime;
+			FlightState = FDroneFlightState();
+		}
+
+		MoveCombined(WorldHorizontal + FVector(0.f, 0.f, DeltaZ), StepRotation, DeltaTime, Params);
 	}
+	else
+	{
+		if (!WorldHorizontal.IsNearlyZero())
+		{
+			AddActorWorldOffset(WorldHorizontal, true);
+			INC_DWORD_STAT(STAT_P3D_DroneMoveSweeps);
+			P3DCounters::AddSceneQuery();
+			P3DCounters::AddOffset();
+		}
 
-	// 3) 수직 이동 (월드) = 중력 + 추진(가속/감속)
+		// 3) 수직 이동 (월드) = 중력 + 추진(가속/감속)
+		SimulateVerticalLegacy(DeltaTime, Ground);
+	}
+
+	DrawStepDebug(Ground);
+}
+
+void ADronePawn::SimulateVerticalLegacy(float DeltaTime, const FDroneGroundSample& Ground)
+{
 	if (bEnableGravity)
 	{
-		TickVertical_World(DeltaTime, GroundHit, bHitGround, Gap, bIsFloor, bActuallyGrounded);
+		TickVertical_World(DeltaTime, Ground);
 	}
 	else
 	{
@@ -252,148 +888,269 @@ void ADronePawn::Tick(float DeltaTime)
 		if (!FMath::IsNearlyZero(DirectZ))
 		{
 			AddActorWorldOffset(FVector(0, 0, DirectZ * DeltaTime), true);
+			INC_DWORD_STAT(STAT_P3D_DroneMoveSweeps);
+			P3DCounters::AddSceneQuery();
+			P3DCounters::AddOffset();
 		}
 
-		VerticalVelocity = 0.f;
-		bGrounded = false;
-		TimeSinceGrounded = 999.f;
+		FlightState = FDroneFlightState();
 	}
+}
 
-	// Debug
-	if (bDrawGroundDebug && GetWorld())
+void ADronePawn::MoveCombined(const FVector& Delta, const FRotator& NewRotation, float DeltaTime, const FDroneFlightParams& Params)
+{
+	FHitResult Hit;
+	FHitResult SlideHit;
+	MovementComp->MoveStep(Delta, NewRotation.Quaternion(), DeltaTime, Hit, SlideHit);
+
+	if (!bEnableGravity) return;
+
+	// 수평 벽에 막힌 건 수직 속도와 무관 → 바닥(아래로 갈 때) / 천장(위로 갈 때)만 커널에 알림
+	auto NotifyVerticalBlock = [&](const FHitResult& BlockHit)
+	{
+		if (!BlockHit.bBlockingHit) return;
+
+		if ((Delta.Z < 0.f && BlockHit.ImpactNormal.Z >= Params.WalkableFloorZ)
+			|| (Delta.Z > 0.f && BlockHit.ImpactNormal.Z < -0.5f))
+		{
+			P3DDroneFlight::OnVerticalBlocked(Params, BlockHit.ImpactNormal.Z, FlightState);
+		}
+	};
+
+	NotifyVerticalBlock(Hit);
+	NotifyVerticalBlock(SlideHit);
+}
+
+void ADronePawn::DrawStepDebug(const FDroneGroundSample& Ground) const
+{
+	// Debug (화면 밖이면 그리지 않음)
+	if (bDrawGroundDebug && GetWorld() && WasRecentlyRendered(0.2f))
 	{
 		const FVector P = GetActorLocation();
 		DrawDebugString(GetWorld(), P + FVector(0, 0, 90.f),
 			FString::Printf(TEXT("Hit:%d Floor:%d  Gap:%.2f  Grounded:%d  VelZ:%.1f"),
-				bHitGround ? 1 : 0, bIsFloor ? 1 : 0, Gap, bGrounded ? 1 : 0, VerticalVelocity),
+				Ground.bHitGround ? 1 : 0, Ground.bIsFloor ? 1 : 0, Ground.Gap, FlightState.bGrounded ? 1 : 0, FlightState.VerticalVelocity),
 			nullptr, FColor::White, 0.f, true);
 	}
 }
 
+FDroneFlightParams ADronePawn::GetFlightParams() const
+{
+	FDroneFlightParams Params;
+	Params.bEnableGravity = bEnableGravity;
+	Params.GravityAccel = GravityAccel;
+	Params.GroundProbeDistance = GroundProbeDistance;
+	Params.GroundSnapMax = GroundSnapMax;
+	Params.GroundStickForce = GroundStickForce;
+	Params.CoyoteTime = CoyoteTime;
+	Params.GroundedTolerance = GroundedTolerance;
+	Params.WalkableFloorZ = WalkableFloorZ;
+	Params.ThrustAccel = ThrustAccel;
+	Params.ThrustDrag = ThrustDrag;
+	Params.MaxRiseSpeed = MaxRiseSpeed;
+	Params.MaxFallSpeed = MaxFallSpeed;
+	Params.NormalSpeed = NormalSpeed;
+	Params.AirControlMultiplier = AirControlMultiplier;
+	return Params;
+}
+
+#if WITH_EDITOR
+void ADronePawn::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// 개별 Tick 경로는 매 스텝 GetFlightParams()로 읽으므로 배치 슬롯만 해당
+	MarkFlightParamsDirty();
+}
+#endif
+
+FDroneGroundSample ADronePawn::MakeGroundSample(const FHitResult& GroundHit, bool bHitGround) const
+{
+	FDroneGroundSample Ground;
+	Ground.bHitGround = bHitGround;
+
+	if (bHitGround)
+	{
+		const float SphereR = SphereComp ? SphereComp->GetScaledSphereRadius() : 45.f;
+
+		Ground.Gap = GroundHit.Distance - SphereR;                     // 표면-바닥 틈(대략)
+		Ground.bIsFloor = (GroundHit.ImpactNormal.Z >= WalkableFloorZ);
+	}
+
+	return Ground;
+}
+
+FVector ADronePawn::ComputeHorizontalDelta(float DeltaTime, float Speed, float Yaw) const
+{
+	const float RightAxis = CachedMoveInput.X;   // A/D
+	const float ForwardAxis = CachedMoveInput.Y; // W/S
+
+	if (FMath::IsNearlyZero(RightAxis) && FMath::IsNearlyZero(ForwardAxis))
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FRotator YawOnly(0.f, Yaw, 0.f);
+	const FVector Fwd = FRotationMatrix(YawOnly).GetUnitAxis(EAxis::X);
+	const FVector Rgt = FRotationMatrix(YawOnly).GetUnitAxis(EAxis::Y);
+
+	FVector WorldHorizontal = (Fwd * ForwardAxis + Rgt * RightAxis) * Speed * DeltaTime;
+	WorldHorizontal.Z = 0.f;
+	return WorldHorizontal;
+}
+
 // 회전
 void ADronePawn::TickRotation(float DeltaTime)
+{
+	P3D_SCOPE(DroneTickRotation);
+
+	// Look + Roll을 합쳐서 한 번만 적용
+	const FRotator NewRotation = ComputeStepRotation(DeltaTime);
+	if (!NewRotation.Equals(GetActorRotation()))
+	{
+		SetActorRotation(NewRotation);
+	}
+}
+
+FRotator ADronePawn::ComputeStepRotation(float DeltaTime)
+{
+	// 네트워크 입력: 클라에서 이미 Look/Roll을 적용한 회전
+	if (PendingNetRotation.IsSet())
+	{
+		const FRotator NetRotation = PendingNetRotation.GetValue();
+		PendingNetRotation.Reset();
+		return NetRotation;
+	}
+
+	return ApplyLookAndRoll(GetActorRotation(), DeltaTime);
+}
+
+FRotator ADronePawn::ApplyLookAndRoll(FRotator Cur, float DeltaTime)
 {
 	if (!CachedLookInput.IsNearlyZero())
 	{
 		const float YawDelta = CachedLookInput.X * MouseSensitivity;
 		const float PitchDelta = CachedLookInput.Y * MouseSensitivityPitch;
 
-		FRotator Cur = GetActorRotation();
-
 		const float CurPitch = FRotator::NormalizeAxis(Cur.Pitch);
 		const float NewPitch = FMath::Clamp(CurPitch + PitchDelta, PitchMin, PitchMax);
 
 		Cur.Yaw = FRotator::NormalizeAxis(Cur.Yaw + YawDelta);
 		Cur.Pitch = NewPitch;
 
-		SetActorRotation(Cur);
 		CachedLookInput = FVector2D::ZeroVector;
+
+		// 이 스텝에서 바로 적용되므로 여기서 지연 기록
+		FP3DPawnInputBuffer::ReportLookLatency(PendingLookTimestamp);
+		PendingLookTimestamp = 0.0;
 	}
 
 	if (!FMath::IsNearlyZero(CachedRollInput))
 	{
-		FRotator Cur = GetActorRotation();
-
 		const float RollDelta = CachedRollInput * RollSpeedDegPerSec * DeltaTime;
 		const float CurRoll = FRotator::NormalizeAxis(Cur.Roll);
-		const float NewRoll = FMath::Clamp(CurRoll + RollDelta, -RollMaxAbs, RollMaxAbs);
 
-		Cur.Roll = NewRoll;
-		SetActorRotation(Cur);
+		Cur.Roll = FMath::Clamp(CurRoll + RollDelta, -RollMaxAbs, RollMaxAbs);
 	}
+
+	return Cur;
 }
 
 
-// 수직 처리: 월드 수직낙하 + 스냅/떨림 방지 + 추진 가속/감속
-void ADronePawn::TickVertical_World(
-	float DeltaTime,
-	const FHitResult& GroundHit,
-	bool bHitGround,
-	float Gap,
-	bool bIsFloor,
-	bool bActuallyGrounded
-)
+// 수직 처리: 월드 수직낙하 + 스냅/떨림 방지 + 추진 가속/감속 (식은 DroneFlightKernel)
+void ADronePawn::TickVertical_World(float DeltaTime, const FDroneGroundSample& Ground)
 {
-	// 1) 추진 가속(입력 기반)
-	const float Input = FMath::Clamp(CachedUpDownInput, -1.f, 1.f);
+	P3D_SCOPE(DroneTickVertical);
+
+	const FDroneFlightParams Params = GetFlightParams();
 
-	// 입력이 있으면 가속 누적
-	VerticalVelocity += (Input * ThrustAccel) * DeltaTime;
+	const float DeltaZ = P3DDroneFlight::IntegrateVertical(Params, Ground, DeltaTime, CachedUpDownInput, FlightState);
 
-	// 입력이 거의 없으면 드래그로 서서히 0으로
-	if (FMath::IsNearlyZero(Input, 0.02f))
+	// 실제 이동(월드 Z) + 충돌 처리
+	FHitResult MoveHit;
+	AddActorWorldOffset(FVector(0, 0, DeltaZ), true, &MoveHit);
+	INC_DWORD_STAT(STAT_P3D_DroneMoveSweeps);
+	P3DCounters::AddSceneQuery();
+	P3DCounters::AddOffset();
+
+	if (MoveHit.bBlockingHit)
 	{
-		VerticalVelocity = FMath::FInterpTo(VerticalVelocity, 0.f, DeltaTime, ThrustDrag);
+		P3DDroneFlight::OnVerticalBlocked(Params, MoveHit.ImpactNormal.Z, FlightState);
 	}
+}
+// Ground Probe: Sphere Sweep 권장 (채널 설정 중요)
 
-	// 2) 중력/접지 스틱(떨림 방지)
-	if (!bGrounded)
+bool ADronePawn::ProbeGround(FHitResult& OutHit)
+{
+	P3D_SCOPE(DroneProbeGround);
+
+	if (!GetWorld()) return false;
+
+	const float ProbeRadius = GetGroundProbeRadius();
+
+	// 0) 베이크 높이맵: 정적 바닥은 셀 조회만으로 끝(Miss면 아래로)
+	const FDroneGroundHeightfield* Heightfield = (bUseGroundHeightfield && SimSubsystem) ? SimSubsystem->GetGroundHeightfield() : nullptr;
+	if (Heightfield)
 	{
-		VerticalVelocity += GravityAccel * DeltaTime; // 월드 -Z
+		const FDroneGroundHeightfield::ELookup Result = Heightfield->Lookup(GetActorLocation(), GetGroundTraceLength(), ProbeRadius, OutHit);
+		if (Result != FDroneGroundHeightfield::ELookup::Miss)
+		{
+			INC_DWORD_STAT(STAT_P3D_GroundHeightfieldHit);
+			return Result == FDroneGroundHeightfield::ELookup::Hit;
+		}
+		INC_DWORD_STAT(STAT_P3D_GroundHeightfieldFallback);
 	}
-	else
+
+	// 1) 바닥 캐시: 같은 셀 + 캐시 높이 근처면 스윕 생략
+	FDroneGroundCache* Cache = (bUseGroundCache && SimSubsystem) ? &SimSubsystem->GetGroundCache() : nullptr;
+
+	if (Cache)
 	{
-		// 상승 입력(또는 이미 상승 속도)이면 "붙이기" 금지 + 이륙
-		const bool bTryingToRise = (Input > 0.05f) || (VerticalVelocity > 0.f);
+		const FDroneGroundCache::ELookup Result = Cache->Lookup(GetActorLocation(), GetGroundTraceLength(), ProbeRadius, GroundSnapMax, OutHit);
+		SimSubsystem->RecordGroundCacheLookup(Result != FDroneGroundCache::ELookup::Miss);
+
+		if (Result == FDroneGroundCache::ELookup::Hit) return true;
+		if (Result == FDroneGroundCache::ELookup::NoGround) return false;
+	}
+
+	// 2) 비동기 모드: 지난 프레임에 던져둔 결과를 보정해서 사용
+	bool bHit = false;
+	bool bHasResult = false;
 
-		if (bTryingToRise)
+	if (bUseAsyncGroundProbe)
+	{
+		bHasResult = ConsumeAsyncGroundProbe(OutHit, bHit);
+		if (bHasResult)
 		{
-			bGrounded = false;
-			TimeSinceGrounded = CoyoteTime + 1.f; // 코요테 끊기(이륙 즉시 공중으로)
+			INC_DWORD_STAT(STAT_P3D_GroundProbeAsync);
 		}
 		else
 		{
-			// 내려가려는 상황에서만 살짝 붙임(떨림 제거)
-			VerticalVelocity = FMath::Min(VerticalVelocity, -GroundStickForce * DeltaTime);
+			INC_DWORD_STAT(STAT_P3D_GroundProbeAsyncFallback);
 		}
 	}
 
-	// 3) 속도 제한
-	VerticalVelocity = FMath::Clamp(VerticalVelocity, -MaxFallSpeed, MaxRiseSpeed);
-
-	// 4) 이번 프레임 이동량(월드 Z)
-	float DeltaZ = VerticalVelocity * DeltaTime;
-
-	// 5) 접지 스냅(진짜 바닥인데 내려가려는 상황이면 딱 붙이기)
-	if (bHitGround && bIsFloor)
+	// 3) 동기 스윕
+	if (!bHasResult)
 	{
-		if (Gap >= 0.f && Gap <= GroundSnapMax && DeltaZ < 0.f)
-		{
-			// Gap 중에서 ProbeDistance만큼은 남기고 내려가서 안정화(경사에서 끼임 방지)
-			const float SnapDown = FMath::Max(0.f, Gap - GroundProbeDistance);
-			DeltaZ = -SnapDown;
-			VerticalVelocity = 0.f;
-		}
+		bHit = ProbeGroundSync(OutHit);
 	}
 
-	// 6) 실제 이동(월드 Z) + 충돌 처리
-	FHitResult MoveHit;
-	AddActorWorldOffset(FVector(0, 0, DeltaZ), true, &MoveHit);
-
-	if (MoveHit.bBlockingHit)
+	if (Cache && bHit)
 	{
-		VerticalVelocity = 0.f;
-
-		// 바닥으로 충돌한 경우 grounded 확정
-		if (MoveHit.ImpactNormal.Z >= WalkableFloorZ)
-		{
-			bGrounded = true;
-			TimeSinceGrounded = 0.f;
-		}
+		Cache->Store(OutHit, ProbeRadius, WalkableFloorZ);
 	}
+
+	return bHit;
 }
-// Ground Probe: Sphere Sweep 권장 (채널 설정 중요)
 
-bool ADronePawn::ProbeGround(FHitResult& OutHit) const
+bool ADronePawn::ProbeGroundSync(FHitResult& OutHit) const
 {
-	if (!GetWorld()) return false;
+	INC_DWORD_STAT(STAT_P3D_GroundProbeSync);
+	P3DCounters::AddSceneQuery();
 
 	const FVector Start = GetActorLocation();
-	const float SphereR = SphereComp ? SphereComp->GetScaledSphereRadius() : 45.f;
-
-	// 중심에서 (반지름 + ProbeDistance) 만큼 아래를 확인
-	const float TraceLen = SphereR + GroundProbeDistance;
-	const FVector End = Start + FVector(0, 0, -TraceLen);
+	const FVector End = Start + FVector(0, 0, -GetGroundTraceLength());
 
 	FCollisionQueryParams Params(SCENE_QUERY_STAT(DroneGroundProbe), false);
 	Params.AddIgnoredActor(this);
@@ -408,15 +1165,11 @@ bool ADronePawn::ProbeGround(FHitResult& OutHit) const
 	}
 	else
 	{
-		// 살짝 작은 반지름이 모서리/벽 긁힘에 안정적
-		const float SweepR = FMath::Max(1.f, SphereR - 2.f);
-		const FCollisionShape Shape = FCollisionShape::MakeSphere(SweepR);
-
-		bHit = GetWorld()->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, Channel, Shape, Params);
+		bHit = GetWorld()->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, Channel, GetGroundProbeShape(), Params);
 	}
 
-	// Debug draw
-	if (bDrawGroundDebug && GetWorld())
+	// Debug draw (화면 밖이면 그리지 않음)
+	if (bDrawGroundDebug && GetWorld() && WasRecentlyRendered(0.2f))
 	{
 		const FColor C = bHit ? FColor::Green : FColor::Red;
 		DrawDebugLine(GetWorld(), Start, End, C, false, 0.f, 0, 1.2f);
@@ -429,3 +1182,96 @@ bool ADronePawn::ProbeGround(FHitResult& OutHit) const
 
 	return bHit;
 }
+
+float ADronePawn::GetGroundTraceLength() const
+{
+	// 중심에서 (반지름 + ProbeDistance) 만큼 아래를 확인
+	const float SphereR = SphereComp ? SphereComp->GetScaledSphereRadius() : 45.f;
+	return SphereR + GroundProbeDistance;
+}
+
+float ADronePawn::GetGroundProbeRadius() const
+{
+	return bUseSphereSweep ? GetGroundProbeShape().GetSphereRadius() : 0.f;
+}
+
+FCollisionShape ADronePawn::GetGroundProbeShape() const
+{
+	// 살짝 작은 반지름이 모서리/벽 긁힘에 안정적
+	const float SphereR = SphereComp ? SphereComp->GetScaledSphereRadius() : 45.f;
+	return FCollisionShape::MakeSphere(FMath::Max(1.f, SphereR - 2.f));
+}
+
+// Async Ground Probe: 프레임 끝에 던지고 다음 프레임에 받음
+
+void ADronePawn::IssueAsyncGroundProbe(const FVector& Start)
+{
+	UWorld* World = GetWorld();
+	if (!World || !bUseAsyncGroundProbe) return;
+
+	const FVector End = Start + FVector(0, 0, -GetGroundTraceLength());
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(DroneGroundProbeAsync), false);
+	Params.AddIgnoredActor(this);
+
+	if (!bUseSphereSweep)
+	{
+		PendingGroundProbe = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_Visibility, Params);
+	}
+	else
+	{
+		PendingGroundProbe = World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, End, FQuat::Identity, ECC_Visibility, GetGroundProbeShape(), Params);
+	}
+
+	PendingGroundProbeStart = Start;
+	P3DCounters::AddSceneQuery();
+}
+
+void ADronePawn::PollAsyncGroundProbe()
+{
+	// 이전 결과는 한 프레임만 유효
+	AsyncGroundProbe.bValid = false;
+
+	UWorld* World = GetWorld();
+	if (!World || !PendingGroundProbe.IsValid()) return;
+
+	// 결과 버퍼는 한 프레임만 유지됨(Tick 간격이 길면 놓침) → 못 받으면 이번엔 동기로
+	FTraceDatum Datum;
+	if (World->QueryTraceData(PendingGroundProbe, Datum))
+	{
+		AsyncGroundProbe.bValid = true;
+		AsyncGroundProbe.bHit = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit;
+		AsyncGroundProbe.Hit = AsyncGroundProbe.bHit ? Datum.OutHits[0] : FHitResult();
+		AsyncGroundProbe.Start = PendingGroundProbeStart;
+	}
+
+	PendingGroundProbe = FTraceHandle();
+}
+
+bool ADronePawn::ConsumeAsyncGroundProbe(FHitResult& OutHit, bool& bOutHit) const
+{
+	if (!AsyncGroundProbe.bValid) return false;
+
+	// 던진 이후 이동량이 탐색 거리(GroundProbeDistance)를 넘으면 결과를 믿지 않음
+	const FVector Drift = GetActorLocation() - AsyncGroundProbe.Start;
+	if (Drift.Size() > GroundProbeDistance) return false;
+
+	if (!AsyncGroundProbe.bHit)
+	{
+		// 그때 못 찾았는데 지금 더 내려와 있으면 새 바닥이 범위에 들어왔을 수 있음
+		if (Drift.Z < -KINDA_SMALL_NUMBER) return false;
+
+		bOutHit = false;
+		return true;
+	}
+
+	// 바닥은 그대로라고 보고, 그 사이 수직 이동만큼 거리 보정
+	OutHit = AsyncGroundProbe.Hit;
+	OutHit.Distance += Drift.Z;
+	OutHit.TraceStart = GetActorLocation();
+	OutHit.TraceEnd = OutHit.TraceStart + FVector(0, 0, -GetGroundTraceLength());
+
+	// 보정 결과가 탐색 범위를 벗어나면 miss
+	bOutHit = OutHit.Distance <= GetGroundTraceLength();
+	return true;
+}
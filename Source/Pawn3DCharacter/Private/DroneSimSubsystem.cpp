@@ -0,0 +1,554 @@
+﻿#include "DroneSimSubsystem.h"
+
+#include "DroneMovementComponent.h"
+#include "DronePawn.h"
+#include "P3DProfiling.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+
+static TAutoConsoleVariable<float> CVarDroneBatchFixedHz(
+	TEXT("p3d.Drone.BatchFixedHz"),
+	120.f,
+	TEXT("배치 드론 시뮬레이션 고정 스텝 주파수(Hz)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneBatchMaxSubsteps(
+	TEXT("p3d.Drone.BatchMaxSubsteps"),
+	8,
+	TEXT("배치 드론 시뮬레이션 프레임당 최대 서브스텝 수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDroneGroundCacheCellSize(
+	TEXT("p3d.Drone.GroundCacheCellSize"),
+	50.f,
+	TEXT("드론 바닥 캐시 XY 셀 크기(cm). 바꾸면 캐시가 비워짐"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarDroneGroundCacheMaxAge(
+	TEXT("p3d.Drone.GroundCacheMaxAge"),
+	2.f,
+	TEXT("드론 바닥 캐시 셀 수명(초). 지나면 다시 스윕해서 갱신(0 이하면 무제한)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarDroneGroundHeightfield(
+	TEXT("p3d.Drone.GroundHeightfield"),
+	1,
+	TEXT("베이크된 바닥 높이맵(Content/Baked/Heightfields/<맵>.p3dh)으로 바닥 탐색(0이면 캐시/스윕만)"),
+	ECVF_Default);
+
+void UDroneSimSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	GroundCache.SetCellSize(CVarDroneGroundCacheCellSize.GetValueOnGameThread());
+
+	// 스트리밍 레벨이 붙거나 빠지면 베이크 높이맵은 못 믿음(캐시는 GroundBlockers가 레벨 바운드만 비움)
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UDroneSimSubsystem::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UDroneSimSubsystem::OnLevelChanged);
+}
+
+void UDroneSimSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	GroundBlockers.Stop();
+
+	// 남아있는 드론은 상태를 돌려주고 개별 Tick으로 복귀
+	while (Drones.Num() > 0)
+	{
+		if (ADronePawn* Drone = Drones.Last())
+		{
+			UnregisterDrone(Drone);
+		}
+		else
+		{
+			RemoveAtSwap(Drones.Num() - 1);
+		}
+	}
+
+	Super::Deinitialize();
+}
+
+void UDroneSimSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LoadGroundHeightfield();
+
+	GroundBlockers.Start(InWorld, [this](const FBox& Bounds)
+	{
+		// 셀 하나 안쪽까지 스윕이 닿을 수 있음(셀 = 탐색 시작 XY)
+		const float CellSize = GroundCache.GetCellSize();
+		InvalidateGroundCacheInBox(Bounds.ExpandBy(FVector(CellSize, CellSize, 0.f)));
+	});
+}
+
+TStatId UDroneSimSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDroneSimSubsystem, STATGROUP_Tickables);
+}
+
+// 등록 / 해제
+
+void UDroneSimSubsystem::RegisterDrone(ADronePawn* Drone)
+{
+	if (!IsValid(Drone) || IsRegistered(Drone)) return;
+
+	Drone->BatchIndex = Drones.Add(Drone);
+
+	Params.Add(Drone->GetFlightParams());
+	Drone->bFlightParamsDirty = false;
+
+	VerticalVelocity.Add(Drone->FlightState.VerticalVelocity);
+	Grounded.Add(Drone->FlightState.bGrounded ? 1 : 0);
+	TimeSinceGrounded.Add(Drone->FlightState.TimeSinceGrounded);
+
+	MoveInput.Add(FVector2D::ZeroVector);
+	UpDownInput.Add(0.f);
+
+	StepRotation.Add(Drone->GetActorRotation());
+	Ground.AddDefaulted();
+	PendingDelta.Add(FVector::ZeroVector);
+
+	PrevSimTransform.Add(Drone->GetActorTransform());
+	CurrSimTransform.Add(Drone->GetActorTransform());
+
+	// 액터 Tick은 끄고 배치에서 처리
+	Drone->SetActorTickEnabled(false);
+}
+
+void UDroneSimSubsystem::UnregisterDrone(ADronePawn* Drone)
+{
+	if (!IsRegistered(Drone)) return;
+
+	const int32 Index = Drone->BatchIndex;
+
+	// 비행 상태 / 시뮬 트랜스폼을 드론에게 돌려줌
+	Drone->FlightState = ReadState(Index);
+	// 루트는 이미 시뮬 위치 → 보간 오프셋만 걷어냄(개별 Tick이 자기 시뮬 기준을 다시 잡음)
+	Drone->ApplyRenderTransform(Drone->GetActorTransform());
+	Drone->BatchIndex = INDEX_NONE;
+
+	if (!Drone->IsActorBeingDestroyed())
+	{
+		Drone->SetActorTickEnabled(true);
+	}
+
+	if (bIsTicking)
+	{
+		// 순회 중에는 인덱스를 흔들지 않고 비워두기만
+		Drones[Index] = nullptr;
+		bHasPendingRemovals = true;
+		return;
+	}
+
+	RemoveAtSwap(Index);
+}
+
+bool UDroneSimSubsystem::IsRegistered(const ADronePawn* Drone) const
+{
+	return Drone
+		&& Drones.IsValidIndex(Drone->BatchIndex)
+		&& Drones[Drone->BatchIndex] == Drone;
+}
+
+void UDroneSimSubsystem::RemoveAtSwap(int32 Index)
+{
+	Drones.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Params.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	VerticalVelocity.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Grounded.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TimeSinceGrounded.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	MoveInput.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	UpDownInput.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	StepRotation.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Ground.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PendingDelta.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	PrevSimTransform.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	CurrSimTransform.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// 뒤에서 당겨온 드론의 인덱스 갱신
+	if (Drones.IsValidIndex(Index) && Drones[Index])
+	{
+		Drones[Index]->BatchIndex = Index;
+	}
+}
+
+void UDroneSimSubsystem::CompactRemovedSlots()
+{
+	for (int32 i = Drones.Num() - 1; i >= 0; --i)
+	{
+		if (!Drones[i])
+		{
+			RemoveAtSwap(i);
+		}
+	}
+	bHasPendingRemovals = false;
+}
+
+FDroneFlightState UDroneSimSubsystem::ReadState(int32 Index) const
+{
+	FDroneFlightState State;
+	State.VerticalVelocity = VerticalVelocity[Index];
+	State.bGrounded = Grounded[Index] != 0;
+	State.TimeSinceGrounded = TimeSinceGrounded[Index];
+	return State;
+}
+
+void UDroneSimSubsystem::WriteState(int32 Index, const FDroneFlightState& State)
+{
+	VerticalVelocity[Index] = State.VerticalVelocity;
+	Grounded[Index] = State.bGrounded ? 1 : 0;
+	TimeSinceGrounded[Index] = State.TimeSinceGrounded;
+}
+
+void UDroneSimSubsystem::ReportActorTickCycles(uint64 Cycles)
+{
+	ActorTickCycles += Cycles;
+	++ActorTickCount;
+}
+
+// Ground Cache
+
+void UDroneSimSubsystem::RecordGroundCacheLookup(bool bAvoidedSweep)
+{
+	if (bAvoidedSweep)
+	{
+		++GroundCacheHits;
+		++AvoidedSweepsInWindow;
+	}
+	else
+	{
+		++GroundCacheMisses;
+	}
+}
+
+void UDroneSimSubsystem::InvalidateGroundCacheInBox(const FBox& Box)
+{
+	GroundCache.InvalidateBox(Box);
+}
+
+void UDroneSimSubsystem::InvalidateGroundCache()
+{
+	GroundCache.Invalidate();
+}
+
+void UDroneSimSubsystem::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		if (bHeightfieldValid && Level && !Level->IsPersistentLevel())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[DroneSim] Streaming level changed -> baked ground heightfield disabled"));
+			bHeightfieldValid = false;
+		}
+	}
+}
+
+// Baked Heightfield
+
+void UDroneSimSubsystem::LoadGroundHeightfield()
+{
+	bHeightfieldValid = false;
+
+	const UWorld* World = GetWorld();
+	const FString MapName = UWorld::RemovePIEPrefix(FPackageName::GetShortName(World->GetOutermost()->GetName()));
+	const FString Path = FDroneGroundHeightfield::GetPathForMap(MapName);
+
+	// 베이크 안 한 맵이면 조용히 넘어감
+	if (!IFileManager::Get().FileExists(*Path)) return;
+
+	FString Error;
+	if (!GroundHeightfield.Load(Path, Error))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[DroneSim] Ground heightfield %s: %s"), *Path, *Error);
+		return;
+	}
+
+	bHeightfieldValid = true;
+	SET_FLOAT_STAT(STAT_P3D_GroundHeightfieldKB, GroundHeightfield.GetSizeBytes() / 1024.f);
+	UE_LOG(LogTemp, Log, TEXT("[DroneSim] Ground heightfield %s (%.1f KB, %s)"), *Path,
+		GroundHeightfield.GetSizeBytes() / 1024.0, GroundHeightfield.IsMemoryMapped() ? TEXT("mapped") : TEXT("loaded"));
+}
+
+const FDroneGroundHeightfield* UDroneSimSubsystem::GetGroundHeightfield() const
+{
+	return (bHeightfieldValid && CVarDroneGroundHeightfield.GetValueOnGameThread() != 0) ? &GroundHeightfield : nullptr;
+}
+
+void UDroneSimSubsystem::PublishGroundCacheStats(float DeltaTime)
+{
+	AvoidedSweepWindowTime += DeltaTime;
+	if (AvoidedSweepWindowTime >= 1.f)
+	{
+		AvoidedSweepsPerSec = AvoidedSweepsInWindow / AvoidedSweepWindowTime;
+		AvoidedSweepsInWindow = 0;
+		AvoidedSweepWindowTime = 0.f;
+	}
+
+	INC_DWORD_STAT_BY(STAT_P3D_GroundCacheHit, GroundCacheHits);
+	INC_DWORD_STAT_BY(STAT_P3D_GroundCacheMiss, GroundCacheMisses);
+	SET_DWORD_STAT(STAT_P3D_GroundCacheCells, GroundCache.Num());
+	SET_FLOAT_STAT(STAT_P3D_GroundCacheAvoidedPerSec, AvoidedSweepsPerSec);
+
+	GroundCacheHits = 0;
+	GroundCacheMisses = 0;
+}
+
+// Tick: 고정 스텝 누적 → 배치 서브스텝 → 보간 트랜스폼 일괄 반영
+
+void UDroneSimSubsystem::Tick(float DeltaTime)
+{
+	P3D_SCOPE(DroneBatchTick);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	GroundCache.SetCellSize(CVarDroneGroundCacheCellSize.GetValueOnGameThread());
+	GroundCache.SetMaxEntryAge(CVarDroneGroundCacheMaxAge.GetValueOnGameThread());
+	GroundCache.Advance(DeltaTime);
+	GroundBlockers.Flush();
+
+	if (Drones.Num() > 0)
+	{
+		TGuardValue<bool> TickingGuard(bIsTicking, true);
+
+		const float StepDT = 1.f / FMath::Clamp(CVarDroneBatchFixedHz.GetValueOnGameThread(), 10.f, 480.f);
+		const int32 MaxSteps = FMath::Max(1, CVarDroneBatchMaxSubsteps.GetValueOnGameThread());
+
+		// 1) 튜닝 값 갱신 + 외부 이동 확인(루트는 항상 시뮬 위치, 보간은 드론 VisualRoot만)
+		for (int32 i = 0; i < Drones.Num(); ++i)
+		{
+			ADronePawn* Drone = Drones[i];
+			if (!Drone) continue;
+
+			if (Drone->bFlightParamsDirty)
+			{
+				Params[i] = Drone->GetFlightParams();
+				Drone->bFlightParamsDirty = false;
+			}
+
+			if (!Drone->GetActorTransform().Equals(CurrSimTransform[i], KINDA_SMALL_NUMBER))
+			{
+				// 외부에서 직접 옮겼음(텔레포트 등) → 그 위치를 새 기준으로
+				PrevSimTransform[i] = Drone->GetActorTransform();
+				CurrSimTransform[i] = PrevSimTransform[i];
+			}
+		}
+
+		// 지난 프레임에 던져둔 비동기 바닥 탐색 수거 + 쌓인 입력 샘플 소비
+		for (ADronePawn* Drone : Drones)
+		{
+			if (!Drone) continue;
+
+			Drone->PollAsyncGroundProbe();
+			Drone->ConsumeBufferedInput(DeltaTime);
+		}
+
+		// 2) 서브스텝
+		StepAccumulator += DeltaTime;
+
+		int32 NumSteps = 0;
+		while (StepAccumulator >= StepDT && NumSteps < MaxSteps)
+		{
+			SimulateBatchStep(StepDT);
+
+			StepAccumulator -= StepDT;
+			++NumSteps;
+		}
+
+		if (NumSteps >= MaxSteps)
+		{
+			StepAccumulator = FMath::Min(StepAccumulator, StepDT);
+		}
+
+		// 다음 프레임용 비동기 바닥 탐색(시뮬 위치 기준)
+		for (int32 i = 0; i < Drones.Num(); ++i)
+		{
+			if (ADronePawn* Drone = Drones[i])
+			{
+				Drone->IssueAsyncGroundProbe(CurrSimTransform[i].GetLocation());
+			}
+		}
+
+		// 3) Writeback: 프레임당 한 번, 보간 오프셋을 시각 노드(VisualRoot)에만
+		// 루트(충돌)는 Move에서 이미 시뮬 위치 → 되돌리기/덮어쓰기 없음, 오프셋이 그대로면 건너뜀
+		const float Alpha = FMath::Clamp(StepAccumulator / StepDT, 0.f, 1.f);
+		for (int32 i = 0; i < Drones.Num(); ++i)
+		{
+			if (ADronePawn* Drone = Drones[i])
+			{
+				FTransform RenderTransform;
+				RenderTransform.Blend(PrevSimTransform[i], CurrSimTransform[i], Alpha);
+				Drone->ApplyRenderTransform(RenderTransform);
+			}
+		}
+	}
+
+	if (bHasPendingRemovals)
+	{
+		CompactRemovedSlots();
+	}
+
+	PublishCostStats(FPlatformTime::Cycles64() - StartCycles);
+	PublishGroundCacheStats(DeltaTime);
+}
+
+void UDroneSimSubsystem::SimulateBatchStep(float StepDT)
+{
+	for (int32 i = 0; i < Drones.Num(); ++i)
+	{
+		PrevSimTransform[i] = CurrSimTransform[i];
+	}
+
+	GatherPhase(StepDT);
+	IntegratePhase(StepDT);
+	MovePhase(StepDT);
+
+	for (int32 i = 0; i < Drones.Num(); ++i)
+	{
+		if (ADronePawn* Drone = Drones[i])
+		{
+			CurrSimTransform[i] = Drone->GetActorTransform();
+		}
+	}
+}
+
+// Gather: 액터에서 입력/목표 회전/바닥 정보를 모음 (액터 접근은 여기와 Move만, 쓰기는 Move만)
+void UDroneSimSubsystem::GatherPhase(float StepDT)
+{
+	for (int32 i = 0; i < Drones.Num(); ++i)
+	{
+		ADronePawn* Drone = Drones[i];
+		if (!Drone) continue;
+
+		MoveInput[i] = Drone->CachedMoveInput;
+		UpDownInput[i] = Drone->CachedUpDownInput;
+
+		// 회전은 구하기만 하고 Move에서 이동과 함께 적용
+		StepRotation[i] = Drone->ComputeStepRotation(StepDT);
+
+		FHitResult GroundHit;
+		const bool bHitGround = Drone->ProbeGround(GroundHit);
+		Ground[i] = Drone->MakeGroundSample(GroundHit, bHitGround);
+	}
+}
+
+// Integrate: 액터 접근 없이 배열만 사용
+void UDroneSimSubsystem::IntegratePhase(float StepDT)
+{
+	const int32 Num = Drones.Num();
+
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const FDroneFlightParams& P = Params[i];
+		FDroneFlightState State = ReadState(i);
+
+		P3DDroneFlight::UpdateGrounded(P, Ground[i], StepDT, State);
+
+		// 수평 (Yaw-only)
+		FVector Delta = FVector::ZeroVector;
+		if (!MoveInput[i].IsNearlyZero())
+		{
+			const float Speed = P3DDroneFlight::GetHorizontalSpeed(P, State);
+			const FRotator YawOnly(0.f, StepRotation[i].Yaw, 0.f);
+			const FRotationMatrix YawMat(YawOnly);
+
+			Delta = (YawMat.GetUnitAxis(EAxis::X) * MoveInput[i].Y + YawMat.GetUnitAxis(EAxis::Y) * MoveInput[i].X) * Speed * StepDT;
+			Delta.Z = 0.f;
+		}
+
+		// 수직
+		if (P.bEnableGravity)
+		{
+			Delta.Z = P3DDroneFlight::IntegrateVertical(P, Ground[i], StepDT, UpDownInput[i], State);
+		}
+		else
+		{
+			Delta.Z = UpDownInput[i] * (P.NormalSpeed * 0.8f) * StepDT;
+			State = FDroneFlightState();
+		}
+
+		PendingDelta[i] = Delta;
+		WriteState(i, State);
+	}
+}
+
+// Move: 회전 + 수평 + 수직을 드론당 이동 한 번으로(막혔을 때만 미끄러짐 한 번 더)
+// bUseMovementComponent면 UDroneMovementComponent(SafeMove + 미끄러짐 + 밀어내기), 아니면 루트 MoveComponent
+void UDroneSimSubsystem::MovePhase(float StepDT)
+{
+	for (int32 i = 0; i < Drones.Num(); ++i)
+	{
+		ADronePawn* Drone = Drones[i];
+		if (!Drone) continue;
+
+		const FVector Delta = PendingDelta[i];
+		const FQuat NewRotation = StepRotation[i].Quaternion();
+
+		FHitResult Hit;
+		FHitResult SlideHit;
+
+		if (Drone->bUseMovementComponent && Drone->MovementComp)
+		{
+			Drone->MovementComp->MoveStep(Delta, NewRotation, StepDT, Hit, SlideHit);
+		}
+		else
+		{
+			USceneComponent* Root = Drone->GetRootComponent();
+			if (!Root || (Delta.IsNearlyZero() && Root->GetComponentQuat().Equals(NewRotation))) continue;
+
+			Root->MoveComponent(Delta, NewRotation, true, &Hit);
+			P3DCounters::AddSceneQuery();
+			P3DCounters::AddOffset();
+
+			// 남은 이동량을 충돌면에 투영해서 미끄러짐
+			if (Hit.IsValidBlockingHit())
+			{
+				const FVector Remaining = FVector::VectorPlaneProject(Delta * (1.f - Hit.Time), Hit.Normal);
+				if (!Remaining.IsNearlyZero())
+				{
+					Root->MoveComponent(Remaining, NewRotation, true, &SlideHit);
+					P3DCounters::AddSceneQuery();
+					P3DCounters::AddOffset();
+				}
+			}
+		}
+
+		if (!Hit.bBlockingHit && !SlideHit.bBlockingHit) continue;
+
+		// 아래로 가다 바닥에 막힘 / 위로 가다 천장에 막힘(수평 벽은 수직 속도와 무관)
+		FDroneFlightState State = ReadState(i);
+		for (const FHitResult* BlockHit : { &Hit, &SlideHit })
+		{
+			if (!BlockHit->bBlockingHit) continue;
+
+			if ((Delta.Z < 0.f && BlockHit->ImpactNormal.Z >= Params[i].WalkableFloorZ)
+				|| (Delta.Z > 0.f && BlockHit->ImpactNormal.Z < -0.5f))
+			{
+				P3DDroneFlight::OnVerticalBlocked(Params[i], BlockHit->ImpactNormal.Z, State);
+			}
+		}
+		WriteState(i, State);
+	}
+}
+
+void UDroneSimSubsystem::PublishCostStats(uint64 BatchCycles)
+{
+	const float BatchUs = static_cast<float>(FPlatformTime::ToMilliseconds64(BatchCycles) * 1000.0);
+	const float ActorUs = static_cast<float>(FPlatformTime::ToMilliseconds64(ActorTickCycles) * 1000.0);
+
+	INC_DWORD_STAT_BY(STAT_P3D_NumBatchedDrones, Drones.Num());
+	INC_DWORD_STAT_BY(STAT_P3D_NumActorDrones, ActorTickCount);
+
+	SET_FLOAT_STAT(STAT_P3D_DroneBatchCostPerDrone, Drones.Num() > 0 ? BatchUs / Drones.Num() : 0.f);
+	SET_FLOAT_STAT(STAT_P3D_DroneActorCostPerDrone, ActorTickCount > 0 ? ActorUs / ActorTickCount : 0.f);
+
+	ActorTickCycles = 0;
+	ActorTickCount = 0;
+}
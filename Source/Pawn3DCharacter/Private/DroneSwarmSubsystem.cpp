@@ -0,0 +1,600 @@
+﻿#include "DroneSwarmSubsystem.h"
+
+#include "DronePawn.h"
+#include "P3DInputBuffer.h"
+#include "P3DStats.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarSwarmPositionGain(
+	TEXT("p3d.Swarm.PositionGain"),
+	2.f,
+	TEXT("슬롯 위치 오차 → 목표 속도 게인(1/s)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSwarmSeparationRadius(
+	TEXT("p3d.Swarm.SeparationRadius"),
+	150.f,
+	TEXT("팔로워끼리(리더 포함) 이 거리(cm) 안이면 밀어냄(대형 Spacing보다 작게)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSwarmSeparationWeight(
+	TEXT("p3d.Swarm.SeparationWeight"),
+	1.f,
+	TEXT("분리 밀어내기 세기(최대 속도 배수)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSwarmTurnRate(
+	TEXT("p3d.Swarm.TurnRate"),
+	180.f,
+	TEXT("팔로워가 리더 Yaw를 따라가는 최대 회전 속도(도/초)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSwarmAltitudeGain(
+	TEXT("p3d.Swarm.AltitudeGain"),
+	0.01f,
+	TEXT("UpDown = AltitudeGain x 고도 차(cm) - VerticalDamping x 리더 대비 수직 속도(cm/s)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSwarmVerticalDamping(
+	TEXT("p3d.Swarm.VerticalDamping"),
+	0.004f,
+	TEXT("수직 속도 감쇠(p3d.Swarm.AltitudeGain 참고)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSwarmDebug(
+	TEXT("p3d.Swarm.Debug"),
+	0,
+	TEXT("팔로워 슬롯(점)과 현재 위치 → 슬롯(선) 그리기"),
+	ECVF_Default);
+
+namespace
+{
+	// 버킷 수 = 팔로워 수 x 2 이상(2의 거듭제곱)
+	constexpr int32 MinBuckets = 64;
+
+	// 구면 대형 슬롯 간 회전각(황금각)
+	const float GoldenAngle = PI * (3.f - FMath::Sqrt(5.f));
+
+	FORCEINLINE int32 HashCell(int32 X, int32 Y, int32 Z, int32 Mask)
+	{
+		const uint32 H = (uint32(X) * 73856093u) ^ (uint32(Y) * 19349663u) ^ (uint32(Z) * 83492791u);
+		return int32(H & uint32(Mask));
+	}
+}
+
+// ===== Subsystem =====
+
+bool UDroneSwarmSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDroneSwarmSubsystem::Deinitialize()
+{
+	Followers.Empty();
+	Swarms.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UDroneSwarmSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDroneSwarmSubsystem, STATGROUP_Tickables);
+}
+
+int32 UDroneSwarmSubsystem::CreateSwarm(ADronePawn* Leader, EDroneFormation Formation, float Spacing)
+{
+	if (!IsValid(Leader)) return INDEX_NONE;
+
+	int32 SwarmId = Swarms.IndexOfByPredicate([](const FSwarm& Swarm) { return !Swarm.bActive; });
+	if (SwarmId == INDEX_NONE)
+	{
+		SwarmId = Swarms.AddDefaulted();
+	}
+
+	FSwarm& Swarm = Swarms[SwarmId];
+	Swarm = FSwarm();
+	Swarm.Leader = Leader;
+	Swarm.Formation = Formation;
+	Swarm.Spacing = FMath::Max(Spacing, 1.f);
+	Swarm.bActive = true;
+	Swarm.LastLeaderLocation = Leader->GetActorLocation();
+
+	return SwarmId;
+}
+
+void UDroneSwarmSubsystem::DestroySwarm(int32 SwarmId)
+{
+	if (!IsValidSwarm(SwarmId)) return;
+
+	for (int32 Index = Followers.Num() - 1; Index >= 0; --Index)
+	{
+		if (SwarmOf[Index] != SwarmId) continue;
+
+		// 마지막 입력이 남아 계속 날아가지 않게
+		if (IsValid(Followers[Index]))
+		{
+			Followers[Index]->InjectScriptedInput(FP3DScriptedInput());
+		}
+		RemoveSlot(Index);
+	}
+
+	Swarms[SwarmId] = FSwarm();
+}
+
+void UDroneSwarmSubsystem::AddFollower(int32 SwarmId, ADronePawn* Drone)
+{
+	if (!IsValidSwarm(SwarmId) || !IsValid(Drone) || Followers.Contains(Drone)) return;
+	if (Swarms[SwarmId].Leader.Get() == Drone) return;
+
+	const FVector Location = Drone->GetActorLocation();
+
+	Followers.Add(Drone);
+	SwarmOf.Add(SwarmId);
+	MaxSpeed.Add(FMath::Max(Drone->NormalSpeed * Drone->AirControlMultiplier, 1.f));
+	InvLookSensitivity.Add(Drone->MouseSensitivity > KINDA_SMALL_NUMBER ? 1.f / Drone->MouseSensitivity : 0.f);
+	HoverInput.Add(P3DDroneFlight::GetHoverInput(Drone->GetFlightParams()));
+	SlotX.Add(0.f);
+	SlotY.Add(0.f);
+	SlotZ.Add(0.f);
+	LastX.Add(Location.X);
+	LastY.Add(Location.Y);
+	LastZ.Add(Location.Z);
+
+	++Swarms[SwarmId].NumFollowers;
+	Swarms[SwarmId].bSlotsDirty = true;
+}
+
+void UDroneSwarmSubsystem::RemoveFollower(ADronePawn* Drone)
+{
+	const int32 Index = Followers.Find(Drone);
+	if (Index == INDEX_NONE) return;
+
+	if (IsValid(Drone))
+	{
+		Drone->InjectScriptedInput(FP3DScriptedInput());
+	}
+	RemoveSlot(Index);
+}
+
+void UDroneSwarmSubsystem::SetFormation(int32 SwarmId, EDroneFormation Formation, float Spacing)
+{
+	if (!IsValidSwarm(SwarmId)) return;
+
+	FSwarm& Swarm = Swarms[SwarmId];
+	Swarm.Formation = Formation;
+	Swarm.Spacing = FMath::Max(Spacing, 1.f);
+	Swarm.bSlotsDirty = true;
+}
+
+void UDroneSwarmSubsystem::RemoveSlot(int32 Index)
+{
+	if (Swarms.IsValidIndex(SwarmOf[Index]))
+	{
+		FSwarm& Swarm = Swarms[SwarmOf[Index]];
+		--Swarm.NumFollowers;
+		Swarm.bSlotsDirty = true;
+	}
+
+	Followers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SwarmOf.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	MaxSpeed.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	InvLookSensitivity.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	HoverInput.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SlotX.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SlotY.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SlotZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	LastX.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	LastY.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	LastZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+FVector UDroneSwarmSubsystem::ComputeSlotOffset(EDroneFormation Formation, int32 Slot, int32 NumSlots, float Spacing)
+{
+	// 좌우 번갈아 한 칸씩 멀어짐(0 = 오른쪽 1칸, 1 = 왼쪽 1칸, 2 = 오른쪽 2칸 ...)
+	const float Rank = float(Slot / 2 + 1);
+	const float Side = (Slot % 2 == 0) ? 1.f : -1.f;
+
+	switch (Formation)
+	{
+	case EDroneFormation::Line:
+		return FVector(0.f, Side * Rank * Spacing, 0.f);
+
+	case EDroneFormation::Wedge:
+		return FVector(-Rank * Spacing, Side * Rank * Spacing, 0.f);
+
+	case EDroneFormation::Sphere:
+	{
+		// 표면적 / 슬롯 수 ≈ Spacing² 이 되는 반지름
+		const int32 Num = FMath::Max(NumSlots, 1);
+		const float Radius = FMath::Max(Spacing, Spacing * FMath::Sqrt(Num / (4.f * PI)));
+		const float Z = 1.f - 2.f * (Slot + 0.5f) / Num;
+		const float Ring = FMath::Sqrt(FMath::Max(0.f, 1.f - Z * Z));
+		const float Theta = Slot * GoldenAngle;
+		return FVector(FMath::Cos(Theta) * Ring, FMath::Sin(Theta) * Ring, Z) * Radius;
+	}
+	}
+
+	return FVector::ZeroVector;
+}
+
+// Tick: 슬롯 → 위치/목표 → 격자 + 분리 → 입력
+
+void UDroneSwarmSubsystem::Tick(float DeltaTime)
+{
+	LastFrame = FFrameStats();
+
+	// 파괴된 팔로워 정리
+	for (int32 Index = Followers.Num() - 1; Index >= 0; --Index)
+	{
+		if (!IsValid(Followers[Index]))
+		{
+			RemoveSlot(Index);
+		}
+	}
+
+	if (Followers.Num() == 0 || DeltaTime <= 0.f)
+	{
+		SET_DWORD_STAT(STAT_P3D_SwarmFollowers, 0);
+		SET_DWORD_STAT(STAT_P3D_SwarmNeighborChecks, 0);
+		SET_DWORD_STAT(STAT_P3D_SwarmOverlapPairs, 0);
+		SET_FLOAT_STAT(STAT_P3D_SwarmSolverMs, 0.f);
+		SET_FLOAT_STAT(STAT_P3D_SwarmSlotErrorCm, 0.f);
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_P3D_DroneSwarm);
+	const double StartTime = FPlatformTime::Seconds();
+
+	const float SeparationRadius = FMath::Max(CVarSwarmSeparationRadius.GetValueOnGameThread(), 1.f);
+
+	UpdateSlots();
+	Gather(DeltaTime);
+	BuildGrid(SeparationRadius);
+	Separate(SeparationRadius);
+	Steer(DeltaTime);
+
+	if (CVarSwarmDebug.GetValueOnGameThread() != 0)
+	{
+		DrawDebugSlots();
+	}
+
+	LastFrame.Followers = Followers.Num();
+	LastFrame.SolverMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	SET_DWORD_STAT(STAT_P3D_SwarmFollowers, LastFrame.Followers);
+	SET_DWORD_STAT(STAT_P3D_SwarmNeighborChecks, LastFrame.NeighborChecks);
+	SET_DWORD_STAT(STAT_P3D_SwarmOverlapPairs, LastFrame.OverlapPairs);
+	SET_FLOAT_STAT(STAT_P3D_SwarmSolverMs, LastFrame.SolverMs);
+	SET_FLOAT_STAT(STAT_P3D_SwarmSlotErrorCm, LastFrame.SlotErrorCm);
+}
+
+void UDroneSwarmSubsystem::UpdateSlots()
+{
+	bool bAnyDirty = false;
+	for (const FSwarm& Swarm : Swarms)
+	{
+		bAnyDirty |= Swarm.bActive && Swarm.bSlotsDirty;
+	}
+	if (!bAnyDirty) return;
+
+	// 등록 순서대로 슬롯 번호(해제 시 RemoveAtSwap → 마지막 팔로워가 빈 슬롯을 채움)
+	TArray<int32, TInlineAllocator<8>> NextSlot;
+	NextSlot.SetNumZeroed(Swarms.Num());
+
+	for (int32 Index = 0; Index < Followers.Num(); ++Index)
+	{
+		const FSwarm& Swarm = Swarms[SwarmOf[Index]];
+		const int32 Slot = NextSlot[SwarmOf[Index]]++;
+		if (!Swarm.bSlotsDirty) continue;
+
+		const FVector Offset = ComputeSlotOffset(Swarm.Formation, Slot, Swarm.NumFollowers, Swarm.Spacing);
+		SlotX[Index] = float(Offset.X);
+		SlotY[Index] = float(Offset.Y);
+		SlotZ[Index] = float(Offset.Z);
+	}
+
+	for (FSwarm& Swarm : Swarms)
+	{
+		Swarm.bSlotsDirty = false;
+	}
+}
+
+void UDroneSwarmSubsystem::Gather(float DeltaTime)
+{
+	const float InvDT = 1.f / DeltaTime;
+
+	for (FSwarm& Swarm : Swarms)
+	{
+		const ADronePawn* Leader = Swarm.Leader.Get();
+		Swarm.bLeaderValid = Swarm.bActive && IsValid(Leader) && !Leader->IsInPool();
+		if (!Swarm.bLeaderValid) continue;
+
+		Swarm.LeaderLocation = Leader->GetActorLocation();
+		Swarm.LeaderVelocity = (Swarm.LeaderLocation - Swarm.LastLeaderLocation) * InvDT;
+		Swarm.LastLeaderLocation = Swarm.LeaderLocation;
+		Swarm.LeaderYaw = Leader->GetActorRotation().Yaw;
+	}
+
+	const int32 Num = Followers.Num();
+	PosX.SetNumUninitialized(Num, EAllowShrinking::No);
+	PosY.SetNumUninitialized(Num, EAllowShrinking::No);
+	PosZ.SetNumUninitialized(Num, EAllowShrinking::No);
+	VelX.SetNumUninitialized(Num, EAllowShrinking::No);
+	VelY.SetNumUninitialized(Num, EAllowShrinking::No);
+	VelZ.SetNumUninitialized(Num, EAllowShrinking::No);
+	Yaw.SetNumUninitialized(Num, EAllowShrinking::No);
+	TargetX.SetNumUninitialized(Num, EAllowShrinking::No);
+	TargetY.SetNumUninitialized(Num, EAllowShrinking::No);
+	TargetZ.SetNumUninitialized(Num, EAllowShrinking::No);
+
+	// 액터에서 읽는 부분만 따로(이후 단계는 배열만 사용)
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const ADronePawn* Drone = Followers[Index];
+		const FVector Location = Drone->GetActorLocation();
+
+		PosX[Index] = float(Location.X);
+		PosY[Index] = float(Location.Y);
+		PosZ[Index] = float(Location.Z);
+		Yaw[Index] = float(Drone->GetActorRotation().Yaw);
+	}
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		VelX[Index] = (PosX[Index] - LastX[Index]) * InvDT;
+		VelY[Index] = (PosY[Index] - LastY[Index]) * InvDT;
+		VelZ[Index] = (PosZ[Index] - LastZ[Index]) * InvDT;
+	}
+
+	FMemory::Memcpy(LastX.GetData(), PosX.GetData(), Num * sizeof(float));
+	FMemory::Memcpy(LastY.GetData(), PosY.GetData(), Num * sizeof(float));
+	FMemory::Memcpy(LastZ.GetData(), PosZ.GetData(), Num * sizeof(float));
+
+	// 리더 기준 슬롯 → 월드 목표(리더가 없으면 제자리)
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const FSwarm& Swarm = Swarms[SwarmOf[Index]];
+		if (!Swarm.bLeaderValid)
+		{
+			TargetX[Index] = PosX[Index];
+			TargetY[Index] = PosY[Index];
+			TargetZ[Index] = PosZ[Index];
+			continue;
+		}
+
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(Swarm.LeaderYaw));
+
+		TargetX[Index] = float(Swarm.LeaderLocation.X) + Cos * SlotX[Index] - Sin * SlotY[Index];
+		TargetY[Index] = float(Swarm.LeaderLocation.Y) + Sin * SlotX[Index] + Cos * SlotY[Index];
+		TargetZ[Index] = float(Swarm.LeaderLocation.Z) + SlotZ[Index];
+	}
+}
+
+void UDroneSwarmSubsystem::BuildGrid(float CellSize)
+{
+	const int32 Num = Followers.Num();
+	const int32 NumBuckets = int32(FMath::RoundUpToPowerOfTwo(uint32(FMath::Max(Num * 2, MinBuckets))));
+
+	BucketMask = NumBuckets - 1;
+	InvCellSize = 1.f / CellSize;
+
+	CellOf.SetNumUninitialized(Num, EAllowShrinking::No);
+	CellCoord.SetNumUninitialized(Num * 3, EAllowShrinking::No);
+	CellItems.SetNumUninitialized(Num, EAllowShrinking::No);
+	CellStart.Reset();
+	CellStart.SetNumZeroed(NumBuckets + 1);
+
+	// 버킷별 개수 → 누적(끝 위치) → 뒤에서부터 채우면 CellStart가 시작 위치로 내려옴
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const int32 X = FMath::FloorToInt32(PosX[Index] * InvCellSize);
+		const int32 Y = FMath::FloorToInt32(PosY[Index] * InvCellSize);
+		const int32 Z = FMath::FloorToInt32(PosZ[Index] * InvCellSize);
+
+		CellCoord[Index * 3 + 0] = X;
+		CellCoord[Index * 3 + 1] = Y;
+		CellCoord[Index * 3 + 2] = Z;
+		CellOf[Index] = HashCell(X, Y, Z, BucketMask);
+		++CellStart[CellOf[Index]];
+	}
+
+	for (int32 Bucket = 1; Bucket < NumBuckets; ++Bucket)
+	{
+		CellStart[Bucket] += CellStart[Bucket - 1];
+	}
+
+	for (int32 Index = Num - 1; Index >= 0; --Index)
+	{
+		CellItems[--CellStart[CellOf[Index]]] = Index;
+	}
+	CellStart[NumBuckets] = Num;
+}
+
+void UDroneSwarmSubsystem::Separate(float Radius)
+{
+	const int32 Num = Followers.Num();
+	const float RadiusSq = Radius * Radius;
+	const float InvRadius = 1.f / Radius;
+	const float OverlapSq = 0.25f * RadiusSq;
+
+	SepX.SetNumUninitialized(Num, EAllowShrinking::No);
+	SepY.SetNumUninitialized(Num, EAllowShrinking::No);
+	SepZ.SetNumUninitialized(Num, EAllowShrinking::No);
+	FMemory::Memzero(SepX.GetData(), Num * sizeof(float));
+	FMemory::Memzero(SepY.GetData(), Num * sizeof(float));
+	FMemory::Memzero(SepZ.GetData(), Num * sizeof(float));
+
+	int32 NeighborChecks = 0;
+	int32 OverlapPairs = 0;
+
+	// 가까울수록 강하게(반경 끝 0 → 중심 1), 방향은 상대에게서 멀어지는 쪽
+	auto Push = [&](int32 Index, float DX, float DY, float DZ, float DistSq)
+	{
+		if (DistSq < KINDA_SMALL_NUMBER)
+		{
+			// 같은 자리(스폰 직후 등): 인덱스 짝/홀로 좌우 분리
+			SepY[Index] += (Index % 2 == 0) ? 1.f : -1.f;
+			return;
+		}
+
+		const float Dist = FMath::Sqrt(DistSq);
+		const float Weight = (1.f - Dist * InvRadius) / Dist;
+		SepX[Index] += DX * Weight;
+		SepY[Index] += DY * Weight;
+		SepZ[Index] += DZ * Weight;
+	};
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const int32 CX = CellCoord[Index * 3 + 0];
+		const int32 CY = CellCoord[Index * 3 + 1];
+		const int32 CZ = CellCoord[Index * 3 + 2];
+
+		// 해시 충돌로 같은 버킷이 두 번 나오면 한 번만
+		int32 Visited[27];
+		int32 NumVisited = 0;
+
+		for (int32 OZ = -1; OZ <= 1; ++OZ)
+		for (int32 OY = -1; OY <= 1; ++OY)
+		for (int32 OX = -1; OX <= 1; ++OX)
+		{
+			const int32 Bucket = HashCell(CX + OX, CY + OY, CZ + OZ, BucketMask);
+
+			bool bSeen = false;
+			for (int32 V = 0; V < NumVisited && !bSeen; ++V)
+			{
+				bSeen = Visited[V] == Bucket;
+			}
+			if (bSeen) continue;
+			Visited[NumVisited++] = Bucket;
+
+			for (int32 Item = CellStart[Bucket]; Item < CellStart[Bucket + 1]; ++Item)
+			{
+				const int32 Other = CellItems[Item];
+				if (Other == Index) continue;
+
+				++NeighborChecks;
+
+				const float DX = PosX[Index] - PosX[Other];
+				const float DY = PosY[Index] - PosY[Other];
+				const float DZ = PosZ[Index] - PosZ[Other];
+				const float DistSq = DX * DX + DY * DY + DZ * DZ;
+				if (DistSq >= RadiusSq) continue;
+
+				if (Other > Index && DistSq < OverlapSq)
+				{
+					++OverlapPairs;
+				}
+				Push(Index, DX, DY, DZ, DistSq);
+			}
+		}
+
+		// 리더(격자에 없음)
+		const FSwarm& Swarm = Swarms[SwarmOf[Index]];
+		if (Swarm.bLeaderValid)
+		{
+			const float DX = PosX[Index] - float(Swarm.LeaderLocation.X);
+			const float DY = PosY[Index] - float(Swarm.LeaderLocation.Y);
+			const float DZ = PosZ[Index] - float(Swarm.LeaderLocation.Z);
+			const float DistSq = DX * DX + DY * DY + DZ * DZ;
+			if (DistSq < RadiusSq)
+			{
+				Push(Index, DX, DY, DZ, DistSq);
+			}
+		}
+	}
+
+	LastFrame.NeighborChecks = NeighborChecks;
+	LastFrame.OverlapPairs = OverlapPairs;
+}
+
+void UDroneSwarmSubsystem::Steer(float DeltaTime)
+{
+	const float PositionGain = CVarSwarmPositionGain.GetValueOnGameThread();
+	const float SeparationWeight = CVarSwarmSeparationWeight.GetValueOnGameThread();
+	const float AltitudeGain = CVarSwarmAltitudeGain.GetValueOnGameThread();
+	const float VerticalDamping = CVarSwarmVerticalDamping.GetValueOnGameThread();
+	const float MaxYawStep = CVarSwarmTurnRate.GetValueOnGameThread() * DeltaTime;
+
+	const int32 Num = Followers.Num();
+	double SlotErrorSum = 0.0;
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const FSwarm& Swarm = Swarms[SwarmOf[Index]];
+
+		FP3DScriptedInput Input;
+
+		if (Swarm.bLeaderValid)
+		{
+			const float ErrX = TargetX[Index] - PosX[Index];
+			const float ErrY = TargetY[Index] - PosY[Index];
+			const float ErrZ = TargetZ[Index] - PosZ[Index];
+			SlotErrorSum += FMath::Sqrt(ErrX * ErrX + ErrY * ErrY + ErrZ * ErrZ);
+
+			// ===== 수평: 리더 속도 + 위치 오차 + 분리 → 최대 속도로 자름 =====
+			const float Speed = MaxSpeed[Index];
+			float DesiredX = float(Swarm.LeaderVelocity.X) + ErrX * PositionGain + SepX[Index] * SeparationWeight * Speed;
+			float DesiredY = float(Swarm.LeaderVelocity.Y) + ErrY * PositionGain + SepY[Index] * SeparationWeight * Speed;
+
+			const float DesiredSq = DesiredX * DesiredX + DesiredY * DesiredY;
+			if (DesiredSq > Speed * Speed)
+			{
+				const float Scale = Speed * FMath::InvSqrt(DesiredSq);
+				DesiredX *= Scale;
+				DesiredY *= Scale;
+			}
+
+			// 월드 방향 → 기체 기준 (오른쪽, 앞)
+			float Sin, Cos;
+			FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(Yaw[Index]));
+			const float InvSpeed = 1.f / Speed;
+			Input.Move = FVector2D((Cos * DesiredY - Sin * DesiredX) * InvSpeed, (Cos * DesiredX + Sin * DesiredY) * InvSpeed);
+
+			// ===== 수직: 호버 + 고도 차 P 제어 + 리더 대비 수직 속도 감쇠 + 분리 =====
+			const float RelativeVZ = VelZ[Index] - float(Swarm.LeaderVelocity.Z);
+			Input.UpDown = FMath::Clamp(HoverInput[Index] + AltitudeGain * ErrZ - VerticalDamping * RelativeVZ + SepZ[Index] * SeparationWeight, -1.f, 1.f);
+
+			// ===== Yaw: 리더 기수 방향 =====
+			const float YawStep = FMath::Clamp(FRotator::NormalizeAxis(Swarm.LeaderYaw - Yaw[Index]), -MaxYawStep, MaxYawStep);
+			Input.Look.X = YawStep * InvLookSensitivity[Index];
+		}
+
+		Followers[Index]->InjectScriptedInput(Input);
+	}
+
+	LastFrame.SlotErrorCm = Num > 0 ? SlotErrorSum / Num : 0.0;
+}
+
+void UDroneSwarmSubsystem::DrawDebugSlots() const
+{
+	const UWorld* World = GetWorld();
+
+	for (int32 Index = 0; Index < Followers.Num(); ++Index)
+	{
+		const FVector Position(PosX[Index], PosY[Index], PosZ[Index]);
+		const FVector Target(TargetX[Index], TargetY[Index], TargetZ[Index]);
+
+		DrawDebugPoint(World, Target, 8.f, FColor::Cyan, false, -1.f);
+		DrawDebugLine(World, Position, Target, FColor::Yellow, false, -1.f);
+	}
+}
+
+// ===== 콘솔 명령 =====
+
+static FAutoConsoleCommandWithWorldAndArgs CmdSwarmStats(
+	TEXT("p3d.Swarm.Stats"),
+	TEXT("군집 솔버 마지막 프레임 집계 출력"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		const UDroneSwarmSubsystem* Swarm = World ? World->GetSubsystem<UDroneSwarmSubsystem>() : nullptr;
+		if (!Swarm) return;
+
+		const UDroneSwarmSubsystem::FFrameStats& Stats = Swarm->GetLastFrameStats();
+		UE_LOG(LogTemp, Log, TEXT("[Swarm] Followers=%d Solver=%.3f ms NeighborChecks=%d Overlaps=%d SlotError=%.1f cm"),
+			Stats.Followers, Stats.SolverMs, Stats.NeighborChecks, Stats.OverlapPairs, Stats.SlotErrorCm);
+	}));
@@ -0,0 +1,309 @@
+﻿#include "P3DBakeGroundCommandlet.h"
+
+#include "DroneGroundHeightfield.h"
+#include "DronePawn.h"
+#include "P3DCommandletWorld.h"
+#include "Async/ParallelFor.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/PackageName.h"
+
+namespace
+{
+	// 셀이 이 수를 넘으면 바운드가 잘못 잡힌 것(하늘 구 등)으로 보고 중단
+	constexpr int64 DefaultMaxCells = 16 * 1024 * 1024;
+
+	// 베이크 스윕: 위에서 아래로 한 번(런타임 ProbeGroundSync와 같은 채널/모양)
+	bool SweepDown(const UWorld* World, float X, float Y, float TopZ, float BottomZ, const FCollisionShape& Shape, FHitResult& OutHit)
+	{
+		const FCollisionQueryParams Params(SCENE_QUERY_STAT(P3DBakeGround), false);
+		const FVector Start(X, Y, TopZ);
+		const FVector End(X, Y, BottomZ);
+
+		if (Shape.IsNearlyZero())
+		{
+			return World->LineTraceSingleByChannel(OutHit, Start, End, ECC_Visibility, Params);
+		}
+		return World->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, ECC_Visibility, Shape, Params);
+	}
+
+	bool IsDynamicHit(const FHitResult& Hit)
+	{
+		const UPrimitiveComponent* Comp = Hit.GetComponent();
+		if (Comp && Comp->Mobility != EComponentMobility::Static) return true;
+
+		const AActor* Actor = Hit.GetActor();
+		return Actor && Actor->IsA<APawn>();
+	}
+}
+
+UP3DBakeGroundCommandlet::UP3DBakeGroundCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UP3DBakeGroundCommandlet::Main(const FString& Params)
+{
+	FString MapPath;
+	if (!FParse::Value(*Params, TEXT("Map="), MapPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeGround] Usage: -run=P3DBakeGround -Map=/Game/Maps/<맵> [-CellSize=50] [-TileSize=32] [-HeightStep=1] [-DroneClass=<경로>] [-Compare=N]"));
+		return 1;
+	}
+
+	float CellSize = 50.f;
+	int32 TileSize = 32;
+	float HeightStep = 1.f;
+	float PlaneTolerance = 2.f;
+	int32 CompareQueries = 0;
+	int64 MaxCells = DefaultMaxCells;
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	FParse::Value(*Params, TEXT("TileSize="), TileSize);
+	FParse::Value(*Params, TEXT("HeightStep="), HeightStep);
+	FParse::Value(*Params, TEXT("Tolerance="), PlaneTolerance);
+	FParse::Value(*Params, TEXT("Compare="), CompareQueries);
+	FParse::Value(*Params, TEXT("MaxCells="), MaxCells);
+
+	CellSize = FMath::Max(CellSize, 1.f);
+	TileSize = FMath::Clamp(TileSize, 4, 256);
+	HeightStep = FMath::Max(HeightStep, 0.1f);
+
+	// ===== 드론 탐색 모양(CDO) =====
+	UClass* DroneClass = ADronePawn::StaticClass();
+	FString DroneClassPath;
+	if (FParse::Value(*Params, TEXT("DroneClass="), DroneClassPath))
+	{
+		DroneClass = LoadClass<ADronePawn>(nullptr, *DroneClassPath);
+		if (!DroneClass)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[BakeGround] Drone class not found: %s"), *DroneClassPath);
+			return 1;
+		}
+	}
+
+	const ADronePawn* Drone = DroneClass->GetDefaultObject<ADronePawn>();
+	const float ProbeRadius = Drone->GetGroundProbeRadius();
+	const FCollisionShape Shape = ProbeRadius > 0.f ? FCollisionShape::MakeSphere(ProbeRadius) : FCollisionShape();
+
+	// ===== 월드 =====
+	UWorld* World = P3DCommandletWorld::Load(MapPath);
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeGround] Cannot load map %s"), *MapPath);
+		return 1;
+	}
+
+	const FBox Bounds = P3DCommandletWorld::ComputeCollisionBounds(World);
+	if (!Bounds.IsValid)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeGround] %s has no collidable actors"), *MapPath);
+		P3DCommandletWorld::Release(World);
+		return 1;
+	}
+
+	const int32 MinCellX = FMath::FloorToInt32(Bounds.Min.X / CellSize);
+	const int32 MinCellY = FMath::FloorToInt32(Bounds.Min.Y / CellSize);
+	const int32 NumCellsX = FMath::FloorToInt32(Bounds.Max.X / CellSize) - MinCellX + 1;
+	const int32 NumCellsY = FMath::FloorToInt32(Bounds.Max.Y / CellSize) - MinCellY + 1;
+
+	if (int64(NumCellsX) * NumCellsY > MaxCells)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeGround] %d x %d cells exceeds -MaxCells=%lld (bounds %s) - raise -CellSize or -MaxCells"),
+			NumCellsX, NumCellsY, MaxCells, *Bounds.ToString());
+		P3DCommandletWorld::Release(World);
+		return 1;
+	}
+
+	const float TopZ = Bounds.Max.Z + ProbeRadius + 100.f;
+	const float BottomZ = Bounds.Min.Z - ProbeRadius - 100.f;
+	const float WalkableFloorZ = Drone->GetWalkableFloorZ();
+
+	UE_LOG(LogTemp, Display, TEXT("[BakeGround] %s: %d x %d cells (%.0f cm), probe radius %.1f, Z %.0f..%.0f"),
+		*MapPath, NumCellsX, NumCellsY, CellSize, ProbeRadius, BottomZ, TopZ);
+
+	// ===== 베이크(행 단위 병렬, 씬 질의는 읽기 전용) =====
+	TArray<FDroneGroundHeightfield::FBakeCell> Cells;
+	Cells.SetNum(NumCellsX * NumCellsY);
+
+	const double BakeStart = FPlatformTime::Seconds();
+
+	ParallelFor(NumCellsY, [&](int32 Y)
+	{
+		const float HalfCell = CellSize * 0.5f;
+		const float CY = (MinCellY + Y + 0.5f) * CellSize;
+
+		for (int32 X = 0; X < NumCellsX; ++X)
+		{
+			const float CX = (MinCellX + X + 0.5f) * CellSize;
+			FDroneGroundHeightfield::FBakeCell& Cell = Cells[Y * NumCellsX + X];
+
+			FHitResult Hit;
+			if (!SweepDown(World, CX, CY, TopZ, BottomZ, Shape, Hit) || Hit.bStartPenetrating)
+			{
+				// 아래로 끝까지 빈 곳
+				continue;
+			}
+
+			Cell.Z = Hit.Location.Z;
+			Cell.Normal = FVector3f(Hit.ImpactNormal);
+			Cell.Flags = EDroneHeightCellFlags::Ground;
+
+			if (Hit.ImpactNormal.Z >= WalkableFloorZ)
+			{
+				Cell.Flags |= EDroneHeightCellFlags::Walkable;
+			}
+			if (IsDynamicHit(Hit))
+			{
+				Cell.Flags |= EDroneHeightCellFlags::Dynamic;
+			}
+
+			// 벽에 가까운 면은 평면 재구성 불가
+			if (Hit.ImpactNormal.Z <= KINDA_SMALL_NUMBER)
+			{
+				Cell.Flags |= EDroneHeightCellFlags::Ambiguous;
+				continue;
+			}
+
+			// 모서리 4곳이 셀 평면에서 벗어나면(턱/계단/구멍) 런타임 스윕
+			static const FVector2D Corners[] = { {-1, -1}, {1, -1}, {-1, 1}, {1, 1} };
+			for (const FVector2D& Corner : Corners)
+			{
+				const float DX = Corner.X * HalfCell;
+				const float DY = Corner.Y * HalfCell;
+
+				FHitResult CornerHit;
+				const bool bCornerHit = SweepDown(World, CX + DX, CY + DY, TopZ, BottomZ, Shape, CornerHit);
+				const float PlaneZ = Cell.Z - (Cell.Normal.X * DX + Cell.Normal.Y * DY) / Cell.Normal.Z;
+
+				if (!bCornerHit || FMath::Abs(CornerHit.Location.Z - PlaneZ) > PlaneTolerance || IsDynamicHit(CornerHit))
+				{
+					Cell.Flags |= EDroneHeightCellFlags::Ambiguous;
+					break;
+				}
+			}
+		}
+	});
+
+	const double BakeSeconds = FPlatformTime::Seconds() - BakeStart;
+
+	// ===== 저장 =====
+	FDroneHeightfieldHeader Header;
+	Header.TileSize = static_cast<uint16>(TileSize);
+	Header.CellSize = CellSize;
+	Header.HeightStep = HeightStep;
+	Header.ProbeRadius = ProbeRadius;
+	Header.WalkableFloorZ = WalkableFloorZ;
+	Header.TopZ = TopZ;
+	Header.MinCellX = MinCellX;
+	Header.MinCellY = MinCellY;
+
+	const FString MapName = FPackageName::GetShortName(MapPath);
+	const FString Path = FDroneGroundHeightfield::GetPathForMap(MapName);
+
+	int64 Bytes = 0;
+	FString Error;
+	if (!FDroneGroundHeightfield::Save(Path, Header, NumCellsX, NumCellsY, Cells, Bytes, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeGround] Save failed: %s"), *Error);
+		P3DCommandletWorld::Release(World);
+		return 1;
+	}
+
+	int32 NumGround = 0;
+	int32 NumFallback = 0;
+	for (const FDroneGroundHeightfield::FBakeCell& Cell : Cells)
+	{
+		NumGround += EnumHasAnyFlags(Cell.Flags, EDroneHeightCellFlags::Ground) ? 1 : 0;
+		NumFallback += EnumHasAnyFlags(Cell.Flags, EDroneHeightCellFlags::Dynamic | EDroneHeightCellFlags::Ambiguous) ? 1 : 0;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[BakeGround] Baked %s in %.1f s: %d cells (%d ground, %d runtime-sweep), %.1f KB"),
+		*Path, BakeSeconds, Cells.Num(), NumGround, NumFallback, Bytes / 1024.0);
+
+	if (CompareQueries > 0)
+	{
+		CompareWithSweeps(World, Path, Bounds, Drone, CompareQueries);
+	}
+
+	P3DCommandletWorld::Release(World);
+	return 0;
+}
+
+// 비교: 높이맵 조회 vs 실제 스윕
+
+void UP3DBakeGroundCommandlet::CompareWithSweeps(UWorld* World, const FString& Path, const FBox& Bounds, const ADronePawn* Drone, int32 NumQueries) const
+{
+	FDroneGroundHeightfield Heightfield;
+	FString Error;
+	if (!Heightfield.Load(Path, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeGround] Compare: %s"), *Error);
+		return;
+	}
+
+	const float ProbeRadius = Drone->GetGroundProbeRadius();
+	const float TraceLen = Drone->GetGroundTraceLength();
+	const FCollisionShape Shape = ProbeRadius > 0.f ? FCollisionShape::MakeSphere(ProbeRadius) : FCollisionShape();
+
+	// 바닥 근처를 많이 잡도록 높이는 바운드 아래~위 + 탐색 길이
+	FRandomStream Rand(0x50334448);
+	TArray<FVector> Points;
+	Points.SetNum(NumQueries);
+	for (FVector& P : Points)
+	{
+		P = FVector(Rand.FRandRange(Bounds.Min.X, Bounds.Max.X), Rand.FRandRange(Bounds.Min.Y, Bounds.Max.Y),
+			Rand.FRandRange(Bounds.Min.Z, Bounds.Max.Z + TraceLen));
+	}
+
+	TArray<FDroneGroundHeightfield::ELookup> LookupResults;
+	TArray<FHitResult> LookupHits;
+	LookupResults.SetNum(NumQueries);
+	LookupHits.SetNum(NumQueries);
+
+	const double LookupStart = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumQueries; ++i)
+	{
+		LookupResults[i] = Heightfield.Lookup(Points[i], TraceLen, ProbeRadius, LookupHits[i]);
+	}
+	const double LookupSeconds = FPlatformTime::Seconds() - LookupStart;
+
+	TArray<FHitResult> SweepHits;
+	TBitArray<> SweepHit(false, NumQueries);
+	SweepHits.SetNum(NumQueries);
+
+	const double SweepStart = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumQueries; ++i)
+	{
+		const FVector& P = Points[i];
+		SweepHit[i] = SweepDown(World, P.X, P.Y, P.Z, P.Z - TraceLen, Shape, SweepHits[i]);
+	}
+	const double SweepSeconds = FPlatformTime::Seconds() - SweepStart;
+
+	int32 NumAnswered = 0;
+	int32 NumAgree = 0;
+	double MaxErrorZ = 0.0;
+
+	for (int32 i = 0; i < NumQueries; ++i)
+	{
+		if (LookupResults[i] == FDroneGroundHeightfield::ELookup::Miss) continue;
+
+		++NumAnswered;
+		const bool bLookupHit = LookupResults[i] == FDroneGroundHeightfield::ELookup::Hit;
+		if (bLookupHit != SweepHit[i]) continue;
+
+		++NumAgree;
+		if (bLookupHit)
+		{
+			MaxErrorZ = FMath::Max(MaxErrorZ, FMath::Abs(LookupHits[i].Location.Z - SweepHits[i].Location.Z));
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[BakeGround] Compare %d queries: lookup %.1f ns/query, sweep %.1f ns/query"),
+		NumQueries, LookupSeconds * 1e9 / NumQueries, SweepSeconds * 1e9 / NumQueries);
+	UE_LOG(LogTemp, Display, TEXT("[BakeGround] Answered by heightfield %.1f%%, agree with sweep %.2f%%, max Z error %.2f cm"),
+		100.0 * NumAnswered / NumQueries, NumAnswered > 0 ? 100.0 * NumAgree / NumAnswered : 0.0, MaxErrorZ);
+}
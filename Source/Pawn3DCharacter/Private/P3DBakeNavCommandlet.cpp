@@ -0,0 +1,185 @@
+﻿#include "P3DBakeNavCommandlet.h"
+
+#include "DroneNavOctree.h"
+#include "DronePawn.h"
+#include "P3DCommandletWorld.h"
+#include "Async/ParallelFor.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "Math/RandomStream.h"
+#include "Misc/PackageName.h"
+
+UP3DBakeNavCommandlet::UP3DBakeNavCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UP3DBakeNavCommandlet::Main(const FString& Params)
+{
+	FString MapPath;
+	if (!FParse::Value(*Params, TEXT("Map="), MapPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeNav] Usage: -run=P3DBakeNav -Map=/Game/Maps/<맵> [-VoxelSize=50] [-AgentRadius=<cm>] [-DroneClass=<경로>] [-Bench=N]"));
+		return 1;
+	}
+
+	FDroneNavOctree::FBuildSettings Settings;
+	int32 BenchQueries = 0;
+	FParse::Value(*Params, TEXT("VoxelSize="), Settings.VoxelSize);
+	FParse::Value(*Params, TEXT("Bench="), BenchQueries);
+	Settings.VoxelSize = FMath::Max(Settings.VoxelSize, 10.f);
+
+	// ===== 에이전트 반지름(드론 CDO 충돌 스피어) =====
+	if (!FParse::Value(*Params, TEXT("AgentRadius="), Settings.AgentRadius))
+	{
+		UClass* DroneClass = ADronePawn::StaticClass();
+		FString DroneClassPath;
+		if (FParse::Value(*Params, TEXT("DroneClass="), DroneClassPath))
+		{
+			DroneClass = LoadClass<ADronePawn>(nullptr, *DroneClassPath);
+			if (!DroneClass)
+			{
+				UE_LOG(LogTemp, Error, TEXT("[BakeNav] Drone class not found: %s"), *DroneClassPath);
+				return 1;
+			}
+		}
+
+		const ADronePawn* Drone = DroneClass->GetDefaultObject<ADronePawn>();
+		if (Drone->SphereComp)
+		{
+			Settings.AgentRadius = Drone->SphereComp->GetScaledSphereRadius();
+		}
+	}
+	Settings.AgentRadius = FMath::Max(Settings.AgentRadius, 0.f);
+
+	// ===== 월드 =====
+	UWorld* World = P3DCommandletWorld::Load(MapPath);
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeNav] Cannot load map %s"), *MapPath);
+		return 1;
+	}
+
+	Settings.Bounds = P3DCommandletWorld::ComputeCollisionBounds(World);
+	if (!Settings.Bounds.IsValid)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeNav] %s has no collidable actors"), *MapPath);
+		P3DCommandletWorld::Release(World);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[BakeNav] %s: bounds %s, voxel %.0f cm, agent radius %.1f cm"),
+		*MapPath, *Settings.Bounds.ToString(), Settings.VoxelSize, Settings.AgentRadius);
+
+	// ===== 생성(레이어마다 병렬, 씬 질의는 읽기 전용) =====
+	FDroneNavOctree Octree;
+
+	const double BuildStart = FPlatformTime::Seconds();
+	Octree.Build(Settings, FDroneNavOctree::MakeWorldBlockedTest(World, Settings.AgentRadius));
+	const double BuildSeconds = FPlatformTime::Seconds() - BuildStart;
+
+	P3DCommandletWorld::Release(World);
+
+	// ===== 저장 =====
+	const FString MapName = FPackageName::GetShortName(MapPath);
+	const FString Path = FDroneNavOctree::GetPathForMap(MapName);
+
+	FString Error;
+	if (!Octree.Save(Path, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[BakeNav] Save failed: %s"), *Error);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[BakeNav] Baked %s in %.1f s: %d nodes, %d leaf masks, %.1f KB"),
+		*Path, BuildSeconds, Octree.GetNumNodes(), Octree.GetNumLeafMasks(), Octree.GetAllocatedSize() / 1024.0);
+
+	if (BenchQueries > 0)
+	{
+		RunBenchmark(Octree, BenchQueries);
+	}
+
+	return 0;
+}
+
+// 벤치: 같은 쌍으로 A* + 당기기 / Theta* 비교
+
+void UP3DBakeNavCommandlet::RunBenchmark(const FDroneNavOctree& Octree, int32 NumQueries) const
+{
+	const FBox& Bounds = Octree.GetSourceBounds();
+	FRandomStream Rand(0x50334E56);
+
+	auto RandomFreePoint = [&Octree, &Bounds, &Rand](FVector& OutPoint)
+	{
+		for (int32 Attempt = 0; Attempt < 64; ++Attempt)
+		{
+			OutPoint = FVector(Rand.FRandRange(Bounds.Min.X, Bounds.Max.X), Rand.FRandRange(Bounds.Min.Y, Bounds.Max.Y),
+				Rand.FRandRange(Bounds.Min.Z, Bounds.Max.Z));
+			if (!Octree.IsBlocked(OutPoint)) return true;
+		}
+		return false;
+	};
+
+	TArray<FDroneNavQuery> Queries;
+	Queries.Reserve(NumQueries);
+	for (int32 i = 0; i < NumQueries; ++i)
+	{
+		FDroneNavQuery Query;
+		if (RandomFreePoint(Query.Start) && RandomFreePoint(Query.Goal))
+		{
+			Queries.Add(Query);
+		}
+	}
+
+	if (Queries.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[BakeNav] Bench: no free space found"));
+		return;
+	}
+
+	for (const bool bThetaStar : { false, true })
+	{
+		TArray<FDroneNavPath> Paths;
+		TArray<double> SearchMs;
+		Paths.SetNum(Queries.Num());
+		SearchMs.SetNum(Queries.Num());
+
+		const double Start = FPlatformTime::Seconds();
+		ParallelFor(Queries.Num(), [&](int32 i)
+		{
+			FDroneNavQuery Query = Queries[i];
+			Query.bThetaStar = bThetaStar;
+
+			const double QueryStart = FPlatformTime::Seconds();
+			Paths[i] = Octree.FindPath(Query);
+			SearchMs[i] = (FPlatformTime::Seconds() - QueryStart) * 1000.0;
+		});
+		const double WallSeconds = FPlatformTime::Seconds() - Start;
+
+		int32 NumOk = 0;
+		int64 Expansions = 0;
+		double PathLength = 0.0;
+		for (const FDroneNavPath& Path : Paths)
+		{
+			Expansions += Path.Expansions;
+			if (Path.Result != EDroneNavPathResult::Success) continue;
+
+			++NumOk;
+			for (int32 p = 1; p < Path.Points.Num(); ++p)
+			{
+				PathLength += FVector::Dist(Path.Points[p - 1], Path.Points[p]);
+			}
+		}
+
+		SearchMs.Sort();
+		const int32 N = Queries.Num();
+
+		UE_LOG(LogTemp, Display, TEXT("[BakeNav] Bench %s: %d paths, %d ok, %.0f paths/s | search p50 %.3f p95 %.3f max %.3f ms | %lld expansions avg, %.0f cm avg length"),
+			bThetaStar ? TEXT("Theta*") : TEXT("A*+smooth"), N, NumOk, N / FMath::Max(WallSeconds, 1e-6),
+			SearchMs[N / 2], SearchMs[FMath::Min(N * 95 / 100, N - 1)], SearchMs.Last(),
+			Expansions / N, NumOk > 0 ? PathLength / NumOk : 0.0);
+	}
+}
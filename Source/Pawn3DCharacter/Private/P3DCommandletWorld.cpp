@@ -0,0 +1,74 @@
+﻿#include "P3DCommandletWorld.h"
+
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "UObject/Package.h"
+
+namespace P3DCommandletWorld
+{
+	UWorld* Load(const FString& MapPath)
+	{
+		UPackage* Package = LoadPackage(nullptr, *MapPath, LOAD_None);
+		UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+		if (!World) return nullptr;
+
+		World->AddToRoot();
+		World->WorldType = EWorldType::Editor;
+
+		if (!World->bIsWorldInitialized)
+		{
+			World->InitWorld(UWorld::InitializationValues()
+				.AllowAudioPlayback(false)
+				.RequiresHitProxies(false)
+				.CreatePhysicsScene(true)
+				.CreateNavigation(false)
+				.CreateAISystem(false)
+				.ShouldSimulatePhysics(false)
+				.EnableTraceCollision(true)
+				.SetTransactional(false)
+				.CreateFXSystem(false));
+		}
+
+		World->UpdateWorldComponents(true, false);
+
+		// 등록된 바디를 씬 질의 가속 구조에 반영
+		if (FPhysScene* Scene = World->GetPhysicsScene())
+		{
+			Scene->StartFrame();
+			Scene->WaitPhysScenes();
+			Scene->EndFrame();
+		}
+
+		return World;
+	}
+
+	void Release(UWorld* World)
+	{
+		if (!World) return;
+
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	FBox ComputeCollisionBounds(const UWorld* World)
+	{
+		FBox Bounds(ForceInit);
+
+		for (const AActor* Actor : World->PersistentLevel->Actors)
+		{
+			if (!Actor || Actor->IsA<APawn>() || !Actor->GetActorEnableCollision()) continue;
+
+			// 충돌 있는 컴포넌트만
+			const FBox ActorBounds = Actor->GetComponentsBoundingBox(false);
+			if (ActorBounds.IsValid)
+			{
+				Bounds += ActorBounds;
+			}
+		}
+
+		return Bounds;
+	}
+}
@@ -0,0 +1,683 @@
+﻿#include "P3DFlightSweepCommandlet.h"
+
+#include "DroneFlightKernel.h"
+#include "DronePawn.h"
+#include "P3DCommandletWorld.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Components/SphereComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerStart.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// ===== 스윕 가능한 파라미터 =====
+	struct FTunable
+	{
+		const TCHAR* Name;
+		float FDroneFlightParams::* Member;
+	};
+
+	const FTunable Tunables[] =
+	{
+		{ TEXT("GravityAccel"),         &FDroneFlightParams::GravityAccel },
+		{ TEXT("GroundProbeDistance"),  &FDroneFlightParams::GroundProbeDistance },
+		{ TEXT("GroundSnapMax"),        &FDroneFlightParams::GroundSnapMax },
+		{ TEXT("GroundStickForce"),     &FDroneFlightParams::GroundStickForce },
+		{ TEXT("CoyoteTime"),           &FDroneFlightParams::CoyoteTime },
+		{ TEXT("GroundedTolerance"),    &FDroneFlightParams::GroundedTolerance },
+		{ TEXT("WalkableFloorZ"),       &FDroneFlightParams::WalkableFloorZ },
+		{ TEXT("ThrustAccel"),          &FDroneFlightParams::ThrustAccel },
+		{ TEXT("ThrustDrag"),           &FDroneFlightParams::ThrustDrag },
+		{ TEXT("MaxRiseSpeed"),         &FDroneFlightParams::MaxRiseSpeed },
+		{ TEXT("MaxFallSpeed"),         &FDroneFlightParams::MaxFallSpeed },
+		{ TEXT("NormalSpeed"),          &FDroneFlightParams::NormalSpeed },
+		{ TEXT("AirControlMultiplier"), &FDroneFlightParams::AirControlMultiplier },
+	};
+
+	const FTunable* FindTunable(const FString& Name)
+	{
+		for (const FTunable& Tunable : Tunables)
+		{
+			if (Name.Equals(Tunable.Name, ESearchCase::IgnoreCase)) return &Tunable;
+		}
+		return nullptr;
+	}
+
+	// 축 하나 = 파라미터 + 값 목록(실행 = 모든 축의 데카르트 곱)
+	struct FSweepAxis
+	{
+		const FTunable* Tunable = nullptr;
+		TArray<float> Values;
+	};
+
+	// "Name=Min:Max:Step" 또는 "Name=a,b,c"를 ';'로 연결
+	bool ParseSweep(const FString& Spec, TArray<FSweepAxis>& OutAxes, FString& OutError)
+	{
+		TArray<FString> Entries;
+		Spec.ParseIntoArray(Entries, TEXT(";"));
+
+		for (const FString& Entry : Entries)
+		{
+			FString Name, Range;
+			if (!Entry.Split(TEXT("="), &Name, &Range))
+			{
+				OutError = FString::Printf(TEXT("'%s' is not Name=Values"), *Entry);
+				return false;
+			}
+
+			FSweepAxis& Axis = OutAxes.AddDefaulted_GetRef();
+			Axis.Tunable = FindTunable(Name.TrimStartAndEnd());
+			if (!Axis.Tunable)
+			{
+				OutError = FString::Printf(TEXT("unknown parameter '%s'"), *Name);
+				return false;
+			}
+
+			TArray<FString> Parts;
+			if (Range.Contains(TEXT(":")))
+			{
+				Range.ParseIntoArray(Parts, TEXT(":"));
+				const float Min = Parts.IsValidIndex(0) ? FCString::Atof(*Parts[0]) : 0.f;
+				const float Max = Parts.IsValidIndex(1) ? FCString::Atof(*Parts[1]) : 0.f;
+				const float Step = Parts.IsValidIndex(2) ? FCString::Atof(*Parts[2]) : 0.f;
+				if (Parts.Num() != 3 || Step <= 0.f || Max < Min)
+				{
+					OutError = FString::Printf(TEXT("bad range '%s' (Min:Max:Step)"), *Range);
+					return false;
+				}
+
+				for (int32 i = 0; Min + Step * i <= Max + Step * 1e-3f; ++i)
+				{
+					Axis.Values.Add(Min + Step * i);
+				}
+			}
+			else
+			{
+				Range.ParseIntoArray(Parts, TEXT(","));
+				for (const FString& Part : Parts)
+				{
+					Axis.Values.Add(FCString::Atof(*Part));
+				}
+			}
+
+			if (Axis.Values.IsEmpty())
+			{
+				OutError = FString::Printf(TEXT("no values for '%s'"), *Name);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// ===== 입력 프로파일 =====
+	struct FProfilePhase
+	{
+		float Duration = 0.f;
+		FVector2D Move = FVector2D::ZeroVector;   // X = 오른쪽, Y = 앞(Yaw 0 → 월드 +Y / +X)
+		float UpDown = 0.f;
+	};
+
+	struct FProfile
+	{
+		FString Name;
+		float StartHeight = 0.f;                  // 바닥 위(cm)
+		TArray<FProfilePhase> Phases;
+	};
+
+	TArray<FProfile> MakeProfiles()
+	{
+		TArray<FProfile> Profiles;
+
+		// 떨어뜨려서 착지 → 정지(착지 떨림/접지 깜빡임)
+		Profiles.Add({ TEXT("Land"), 300.f, { { 3.f, FVector2D::ZeroVector, 0.f } } });
+
+		// 짧은 상승 펄스 반복(이륙 + 손 뗀 뒤 호버 수렴)
+		FProfile& Hop = Profiles.Add_GetRef({ TEXT("Hop"), 0.f, {} });
+		for (int32 i = 0; i < 3; ++i)
+		{
+			Hop.Phases.Add({ 0.35f, FVector2D::ZeroVector, 1.f });
+			Hop.Phases.Add({ 1.65f, FVector2D::ZeroVector, 0.f });
+		}
+
+		// 바닥 주행(경사/턱에서 접지 깜빡임, 벽 터널링)
+		Profiles.Add({ TEXT("Cruise"), 0.f, { { 4.f, FVector2D(0.f, 1.f), 0.f }, { 1.f, FVector2D::ZeroVector, 0.f } } });
+
+		// 높은 곳에서 최대 하강(MaxFallSpeed 바닥 터널링)
+		Profiles.Add({ TEXT("Dive"), 1500.f, { { 3.f, FVector2D::ZeroVector, -1.f }, { 1.f, FVector2D::ZeroVector, 0.f } } });
+
+		return Profiles;
+	}
+
+	// ===== 모든 실행이 공유(읽기 전용) =====
+	struct FSweepContext
+	{
+		const UWorld* World = nullptr;
+		float CollisionRadius = 45.f;
+		float ProbeRadius = 43.f;                 // 0이면 라인트레이스
+		ECollisionChannel MoveChannel = ECC_Pawn;
+		FCollisionResponseParams MoveResponse;
+		FVector SpawnFloor = FVector::ZeroVector; // 바닥에 놓인 드론 중심
+		float StepDT = 1.f / 120.f;
+	};
+
+	struct FRunResult
+	{
+		float LandingJitterCm = 0.f;   // 착지 후 정지 구간 Z 최대-최소(여러 번이면 최대)
+		int32 GroundFlicker = 0;       // 입력 없이 떨어졌다가 FlickerWindow 안에 다시 접지
+		float TimeToHoverS = -1.f;     // 상승 입력을 뗀 뒤 수직 속도가 안정될 때까지(평균, 측정 없으면 -1)
+		float HoverSinkCmS = 0.f;      // 안정됐을 때 하강 속도(평균)
+		int32 TunnelIncidents = 0;     // 이동 전후 중심 사이가 막혔거나 지오메트리 안에서 시작
+		int32 Steps = 0;
+	};
+
+	constexpr float SettleDelay = 0.25f;
+	constexpr float SettleWindow = 0.5f;
+	constexpr float FlickerWindow = 0.2f;
+	constexpr float HoverAccelTolerance = 50.f;   // cm/s^2
+	constexpr float HoverHold = 0.1f;
+
+	// ===== 가상 드론(액터 없음) =====
+	class FHeadlessDrone
+	{
+	public:
+		FHeadlessDrone(const FSweepContext& InContext, const FDroneFlightParams& InParams, const FVector& Start)
+			: Context(InContext)
+			, Params(InParams)
+			, Position(Start)
+		{
+		}
+
+		// ADronePawn::SimulateStep(단일 스윕 경로)와 같은 순서: 바닥 → 접지 → 수평 → 수직 → 이동
+		// 반환: 이번 스텝에 터널링이 있었는지
+		bool Step(const FVector2D& Move, float UpDown)
+		{
+			const float DT = Context.StepDT;
+
+			FHitResult GroundHit;
+			const bool bHitGround = ProbeGround(GroundHit);
+
+			FDroneGroundSample Ground;
+			Ground.bHitGround = bHitGround;
+			if (bHitGround)
+			{
+				Ground.Gap = GroundHit.Distance - Context.CollisionRadius;
+				Ground.bIsFloor = GroundHit.ImpactNormal.Z >= Params.WalkableFloorZ;
+			}
+
+			P3DDroneFlight::UpdateGrounded(Params, Ground, DT, State);
+
+			const float Speed = P3DDroneFlight::GetHorizontalSpeed(Params, State);
+			FVector Delta(Move.Y * Speed * DT, Move.X * Speed * DT, 0.f);
+
+			if (Params.bEnableGravity)
+			{
+				Delta.Z = P3DDroneFlight::IntegrateVertical(Params, Ground, DT, UpDown, State);
+			}
+			else
+			{
+				Delta.Z = UpDown * (Params.NormalSpeed * 0.8f) * DT;
+				State = FDroneFlightState();
+			}
+
+			return MoveAndSlide(Delta);
+		}
+
+		const FVector& GetPosition() const { return Position; }
+		const FDroneFlightState& GetState() const { return State; }
+
+	private:
+		bool ProbeGround(FHitResult& OutHit) const
+		{
+			const FVector End = Position - FVector(0.f, 0.f, Context.CollisionRadius + Params.GroundProbeDistance);
+			const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(P3DFlightSweepProbe), false);
+
+			if (Context.ProbeRadius <= 0.f)
+			{
+				return Context.World->LineTraceSingleByChannel(OutHit, Position, End, ECC_Visibility, QueryParams);
+			}
+			return Context.World->SweepSingleByChannel(OutHit, Position, End, FQuat::Identity, ECC_Visibility,
+				FCollisionShape::MakeSphere(Context.ProbeRadius), QueryParams);
+		}
+
+		// 한 번 스윕 + 충돌면 따라 한 번 미끄러짐(MoveStep 근사)
+		bool MoveAndSlide(const FVector& Delta)
+		{
+			const FVector Start = Position;
+			bool bTunnel = false;
+
+			FHitResult Hit;
+			bTunnel |= SweepMove(Delta, Hit);
+
+			if (Hit.bBlockingHit)
+			{
+				NotifyVerticalBlock(Hit, Delta);
+
+				const FVector Remaining = FVector::VectorPlaneProject(Delta * (1.f - Hit.Time), Hit.Normal);
+				if (!Remaining.IsNearlyZero())
+				{
+					FHitResult SlideHit;
+					bTunnel |= SweepMove(Remaining, SlideHit);
+					NotifyVerticalBlock(SlideHit, Delta);
+				}
+			}
+
+			// 스윕은 안 막혔는데 중심 사이 선분이 막힘 → 면을 뚫고 지나감
+			if (!Start.Equals(Position, KINDA_SMALL_NUMBER))
+			{
+				const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(P3DFlightSweepTunnel), false);
+				bTunnel |= Context.World->LineTraceTestByChannel(Start, Position, Context.MoveChannel, QueryParams, Context.MoveResponse);
+			}
+
+			return bTunnel;
+		}
+
+		// 반환: 지오메트리 안에서 시작했는지(밀어내고 이번 이동은 버림)
+		bool SweepMove(const FVector& Delta, FHitResult& OutHit)
+		{
+			if (Delta.IsNearlyZero()) return false;
+
+			const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(P3DFlightSweepMove), false);
+			Context.World->SweepSingleByChannel(OutHit, Position, Position + Delta, FQuat::Identity, Context.MoveChannel,
+				FCollisionShape::MakeSphere(Context.CollisionRadius), QueryParams, Context.MoveResponse);
+
+			if (OutHit.bStartPenetrating)
+			{
+				Position += OutHit.Normal * (OutHit.PenetrationDepth + 0.125f);
+				OutHit.bBlockingHit = false;
+				return true;
+			}
+
+			Position = OutHit.bBlockingHit ? OutHit.Location : Position + Delta;
+			return false;
+		}
+
+		// ADronePawn::MoveCombined와 같은 조건: 내려가다 바닥 / 올라가다 천장만
+		void NotifyVerticalBlock(const FHitResult& BlockHit, const FVector& Delta)
+		{
+			if (!BlockHit.bBlockingHit || !Params.bEnableGravity) return;
+
+			if ((Delta.Z < 0.f && BlockHit.ImpactNormal.Z >= Params.WalkableFloorZ)
+				|| (Delta.Z > 0.f && BlockHit.ImpactNormal.Z < -0.5f))
+			{
+				P3DDroneFlight::OnVerticalBlocked(Params, BlockHit.ImpactNormal.Z, State);
+			}
+		}
+
+		const FSweepContext& Context;
+		const FDroneFlightParams Params;
+
+		FVector Position;
+		FDroneFlightState State;
+	};
+
+	// 실행 하나: 프로파일을 고정 스텝으로 끝까지 돌리면서 지표 수집
+	FRunResult RunProfile(const FSweepContext& Context, const FDroneFlightParams& Params, const FProfile& Profile)
+	{
+		FRunResult Result;
+		FHeadlessDrone Drone(Context, Params, Context.SpawnFloor + FVector(0.f, 0.f, Profile.StartHeight));
+
+		const float DT = Context.StepDT;
+		float Time = 0.f;
+		float AirTime = 0.f;
+		float PrevUpDown = 0.f;
+
+		// 착지 떨림
+		float LandedAt = -1.f;
+		float SettleMinZ = TNumericLimits<float>::Max();
+		float SettleMaxZ = TNumericLimits<float>::Lowest();
+
+		// 접지 깜빡임
+		float UngroundedAt = -1.f;
+
+		// 호버 수렴
+		float ReleasedAt = -1.f;
+		float StableTime = 0.f;
+		float HoverTimeSum = 0.f;
+		float HoverSinkSum = 0.f;
+		int32 NumHover = 0;
+
+		for (const FProfilePhase& Phase : Profile.Phases)
+		{
+			const int32 NumSteps = FMath::Max(1, FMath::RoundToInt32(Phase.Duration / DT));
+			const bool bNoInput = Phase.Move.IsNearlyZero() && FMath::IsNearlyZero(Phase.UpDown);
+
+			for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+			{
+				const bool bWasGrounded = Drone.GetState().bGrounded;
+				const float PrevVelocity = Drone.GetState().VerticalVelocity;
+
+				if (Drone.Step(Phase.Move, Phase.UpDown))
+				{
+					++Result.TunnelIncidents;
+				}
+
+				Time += DT;
+				++Result.Steps;
+
+				const FDroneFlightState& State = Drone.GetState();
+				const float Z = Drone.GetPosition().Z;
+
+				// 1) 착지 → SettleDelay 뒤 SettleWindow 동안 Z 변동
+				if (!bWasGrounded && State.bGrounded && AirTime >= 0.1f)
+				{
+					LandedAt = Time;
+					SettleMinZ = TNumericLimits<float>::Max();
+					SettleMaxZ = TNumericLimits<float>::Lowest();
+				}
+
+				if (LandedAt >= 0.f)
+				{
+					if (!bNoInput)
+					{
+						LandedAt = -1.f;
+					}
+					else if (Time - LandedAt >= SettleDelay)
+					{
+						SettleMinZ = FMath::Min(SettleMinZ, Z);
+						SettleMaxZ = FMath::Max(SettleMaxZ, Z);
+
+						if (Time - LandedAt >= SettleDelay + SettleWindow)
+						{
+							Result.LandingJitterCm = FMath::Max(Result.LandingJitterCm, SettleMaxZ - SettleMinZ);
+							LandedAt = -1.f;
+						}
+					}
+				}
+
+				// 2) 상승 입력 없이 떨어졌다가 금방 다시 붙음
+				if (bWasGrounded && !State.bGrounded && Phase.UpDown <= 0.f)
+				{
+					UngroundedAt = Time;
+				}
+				else if (!bWasGrounded && State.bGrounded && UngroundedAt >= 0.f)
+				{
+					if (Time - UngroundedAt <= FlickerWindow)
+					{
+						++Result.GroundFlicker;
+					}
+					UngroundedAt = -1.f;
+				}
+
+				// 3) 공중에서 상승 입력을 뗀 순간부터 수직 가속이 잦아들 때까지
+				if (PrevUpDown > 0.f && FMath::IsNearlyZero(Phase.UpDown) && !State.bGrounded)
+				{
+					ReleasedAt = Time;
+					StableTime = 0.f;
+				}
+				else if (ReleasedAt >= 0.f)
+				{
+					if (State.bGrounded || !FMath::IsNearlyZero(Phase.UpDown))
+					{
+						ReleasedAt = -1.f;
+					}
+					else if (FMath::Abs(State.VerticalVelocity - PrevVelocity) / DT < HoverAccelTolerance)
+					{
+						StableTime += DT;
+						if (StableTime >= HoverHold)
+						{
+							HoverTimeSum += Time - HoverHold - ReleasedAt;
+							HoverSinkSum += -State.VerticalVelocity;
+							++NumHover;
+							ReleasedAt = -1.f;
+						}
+					}
+					else
+					{
+						StableTime = 0.f;
+					}
+				}
+
+				AirTime = State.bGrounded ? 0.f : AirTime + DT;
+				PrevUpDown = Phase.UpDown;
+			}
+		}
+
+		if (NumHover > 0)
+		{
+			Result.TimeToHoverS = HoverTimeSum / NumHover;
+			Result.HoverSinkCmS = HoverSinkSum / NumHover;
+		}
+
+		return Result;
+	}
+
+	// PlayerStart(없으면 -Spawn) 아래 바닥에 놓인 충돌 스피어 중심
+	bool FindSpawnFloor(const UWorld* World, const FString& Params, const FSweepContext& Context, FVector& OutFloor)
+	{
+		FVector Spawn = FVector::ZeroVector;
+		bool bFound = false;
+
+		FString SpawnText;
+		if (FParse::Value(*Params, TEXT("Spawn="), SpawnText, false))
+		{
+			TArray<FString> Parts;
+			SpawnText.ParseIntoArray(Parts, TEXT(","));
+			if (Parts.Num() == 3)
+			{
+				Spawn = FVector(FCString::Atod(*Parts[0]), FCString::Atod(*Parts[1]), FCString::Atod(*Parts[2]));
+				bFound = true;
+			}
+		}
+
+		for (const AActor* Actor : World->PersistentLevel->Actors)
+		{
+			if (bFound) break;
+
+			if (const APlayerStart* Start = Cast<APlayerStart>(Actor))
+			{
+				Spawn = Start->GetActorLocation();
+				bFound = true;
+			}
+		}
+
+		if (!bFound) return false;
+
+		FHitResult Hit;
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(P3DFlightSweepSpawn), false);
+		if (!World->SweepSingleByChannel(Hit, Spawn + FVector(0.f, 0.f, 200.f), Spawn - FVector(0.f, 0.f, 100000.f), FQuat::Identity,
+			Context.MoveChannel, FCollisionShape::MakeSphere(Context.CollisionRadius), QueryParams, Context.MoveResponse))
+		{
+			return false;
+		}
+
+		OutFloor = Hit.Location + FVector(0.f, 0.f, 1.f);
+		return true;
+	}
+}
+
+UP3DFlightSweepCommandlet::UP3DFlightSweepCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UP3DFlightSweepCommandlet::Main(const FString& Params)
+{
+	FString MapPath;
+	if (!FParse::Value(*Params, TEXT("Map="), MapPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[FlightSweep] Usage: -run=P3DFlightSweep -Map=/Game/Maps/<맵> -Sweep=\"Name=Min:Max:Step;Name=a,b\" [-Profiles=Land,Hop,Cruise,Dive] [-Hz=120] [-Spawn=X,Y,Z] [-Serial]"));
+		return 1;
+	}
+
+	// ===== 스윕 축 =====
+	TArray<FSweepAxis> Axes;
+	FString SweepSpec;
+	if (FParse::Value(*Params, TEXT("Sweep="), SweepSpec, false))
+	{
+		FString Error;
+		if (!ParseSweep(SweepSpec, Axes, Error))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[FlightSweep] -Sweep: %s"), *Error);
+			return 1;
+		}
+	}
+
+	// ===== 프로파일 =====
+	TArray<FProfile> Profiles = MakeProfiles();
+	FString ProfileFilter;
+	if (FParse::Value(*Params, TEXT("Profiles="), ProfileFilter, false))
+	{
+		TArray<FString> Wanted;
+		ProfileFilter.ParseIntoArray(Wanted, TEXT(","));
+		Profiles.RemoveAll([&Wanted](const FProfile& Profile)
+		{
+			return !Wanted.ContainsByPredicate([&Profile](const FString& Name) { return Name.Equals(Profile.Name, ESearchCase::IgnoreCase); });
+		});
+	}
+
+	if (Profiles.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[FlightSweep] No profiles selected (Land, Hop, Cruise, Dive)"));
+		return 1;
+	}
+
+	int64 NumCombos = 1;
+	for (const FSweepAxis& Axis : Axes)
+	{
+		NumCombos *= Axis.Values.Num();
+	}
+
+	int64 MaxRuns = 200000;
+	FParse::Value(*Params, TEXT("MaxRuns="), MaxRuns);
+	MaxRuns = FMath::Min<int64>(MaxRuns, MAX_int32);
+
+	const int64 NumRuns = NumCombos * Profiles.Num();
+	if (NumRuns > MaxRuns)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[FlightSweep] %lld runs exceeds -MaxRuns=%lld"), NumRuns, MaxRuns);
+		return 1;
+	}
+
+	// ===== 드론 기본값(CDO) =====
+	UClass* DroneClass = ADronePawn::StaticClass();
+	FString DroneClassPath;
+	if (FParse::Value(*Params, TEXT("DroneClass="), DroneClassPath))
+	{
+		DroneClass = LoadClass<ADronePawn>(nullptr, *DroneClassPath);
+		if (!DroneClass)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[FlightSweep] Drone class not found: %s"), *DroneClassPath);
+			return 1;
+		}
+	}
+
+	const ADronePawn* DroneCDO = DroneClass->GetDefaultObject<ADronePawn>();
+	const FDroneFlightParams BaseParams = DroneCDO->GetFlightParams();
+
+	float Hz = 120.f;
+	FParse::Value(*Params, TEXT("Hz="), Hz);
+
+	FSweepContext Context;
+	Context.StepDT = 1.f / FMath::Clamp(Hz, 10.f, 480.f);
+	Context.ProbeRadius = DroneCDO->GetGroundProbeRadius();
+	if (const USphereComponent* Sphere = DroneCDO->SphereComp)
+	{
+		Context.CollisionRadius = Sphere->GetScaledSphereRadius();
+		Context.MoveChannel = Sphere->GetCollisionObjectType();
+		Context.MoveResponse = FCollisionResponseParams(Sphere->GetCollisionResponseToChannels());
+	}
+
+	// ===== 월드 =====
+	UWorld* World = P3DCommandletWorld::Load(MapPath);
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[FlightSweep] Cannot load map %s"), *MapPath);
+		return 1;
+	}
+	Context.World = World;
+
+	if (!FindSpawnFloor(World, Params, Context, Context.SpawnFloor))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[FlightSweep] No floor under PlayerStart/-Spawn in %s"), *MapPath);
+		P3DCommandletWorld::Release(World);
+		return 1;
+	}
+
+	// ===== 실행(실행끼리 공유 상태 없음 → 워커에 그대로 분배) =====
+	const bool bSerial = FParse::Param(*Params, TEXT("Serial"));
+	const int32 NumWorkers = bSerial ? 1 : FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+
+	UE_LOG(LogTemp, Display, TEXT("[FlightSweep] %s: %lld combos x %d profiles = %lld runs, %.0f Hz, %d threads, spawn %s"),
+		*MapPath, NumCombos, Profiles.Num(), NumRuns, 1.f / Context.StepDT, NumWorkers, *Context.SpawnFloor.ToString());
+
+	TArray<FRunResult> Results;
+	Results.SetNum(static_cast<int32>(NumRuns));
+
+	auto MakeParams = [&](int64 Combo)
+	{
+		// 혼합 기수로 조합 번호 → 축마다 값
+		FDroneFlightParams RunParams = BaseParams;
+		for (const FSweepAxis& Axis : Axes)
+		{
+			RunParams.*(Axis.Tunable->Member) = Axis.Values[Combo % Axis.Values.Num()];
+			Combo /= Axis.Values.Num();
+		}
+		return RunParams;
+	};
+
+	const double WallStart = FPlatformTime::Seconds();
+
+	ParallelFor(Results.Num(), [&](int32 RunIndex)
+	{
+		const int64 Combo = RunIndex / Profiles.Num();
+		const FProfile& Profile = Profiles[RunIndex % Profiles.Num()];
+		Results[RunIndex] = RunProfile(Context, MakeParams(Combo), Profile);
+	}, (bSerial ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None) | EParallelForFlags::Unbalanced);
+
+	const double WallSeconds = FMath::Max(FPlatformTime::Seconds() - WallStart, 1e-6);
+
+	// ===== CSV =====
+	FString Csv = TEXT("Run,Profile");
+	for (const FSweepAxis& Axis : Axes)
+	{
+		Csv += FString::Printf(TEXT(",%s"), Axis.Tunable->Name);
+	}
+	Csv += TEXT(",LandingJitterCm,GroundFlicker,TimeToHoverS,HoverSinkCmS,TunnelIncidents,Steps\n");
+
+	double SimSeconds = 0.0;
+	for (int32 RunIndex = 0; RunIndex < Results.Num(); ++RunIndex)
+	{
+		const int64 Combo = RunIndex / Profiles.Num();
+		const FProfile& Profile = Profiles[RunIndex % Profiles.Num()];
+		const FDroneFlightParams RunParams = MakeParams(Combo);
+		const FRunResult& Result = Results[RunIndex];
+
+		Csv += FString::Printf(TEXT("%d,%s"), RunIndex, *Profile.Name);
+		for (const FSweepAxis& Axis : Axes)
+		{
+			Csv += FString::Printf(TEXT(",%g"), RunParams.*(Axis.Tunable->Member));
+		}
+		Csv += FString::Printf(TEXT(",%.3f,%d,%.3f,%.1f,%d,%d\n"),
+			Result.LandingJitterCm, Result.GroundFlicker, Result.TimeToHoverS, Result.HoverSinkCmS, Result.TunnelIncidents, Result.Steps);
+
+		SimSeconds += Result.Steps * Context.StepDT;
+	}
+
+	const FString MapName = FPackageName::GetShortName(MapPath);
+	const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("FlightSweep"),
+		FString::Printf(TEXT("FlightSweep_%s_%s.csv"), *MapName, *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+
+	P3DCommandletWorld::Release(World);
+
+	if (!FFileHelper::SaveStringToFile(Csv, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[FlightSweep] Failed to write %s"), *Path);
+		return 1;
+	}
+
+	// 스레드당 실시간 배수가 -Serial 실행과 비슷하면 선형 확장
+	const double RealtimeFactor = SimSeconds / WallSeconds;
+	UE_LOG(LogTemp, Display, TEXT("[FlightSweep] %lld runs in %.2f s (%.0f runs/s), %.0fx realtime (%.0fx per thread) -> %s"),
+		NumRuns, WallSeconds, NumRuns / WallSeconds, RealtimeFactor, RealtimeFactor / NumWorkers, *Path);
+
+	return 0;
+}
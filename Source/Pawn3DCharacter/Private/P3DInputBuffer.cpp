@@ -0,0 +1,138 @@
+﻿#include "P3DInputBuffer.h"
+
+#include "P3DStats.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	// 1€ 필터 평활 계수(컷오프 Hz, dt 초)
+	float OneEuroAlpha(float CutoffHz, float DeltaTime)
+	{
+		const float Tau = 1.f / (2.f * PI * FMath::Max(CutoffHz, KINDA_SMALL_NUMBER));
+		return 1.f / (1.f + Tau / DeltaTime);
+	}
+}
+
+void FP3DPawnInputBuffer::PushLook(const FVector2D& Value)
+{
+	if (!LookRing.Push({ FPlatformTime::Seconds(), Value }))
+	{
+		INC_DWORD_STAT(STAT_P3D_InputSamplesDropped);
+	}
+}
+
+void FP3DPawnInputBuffer::PushMove(const FVector2D& Value)
+{
+	if (!MoveRing.Push({ FPlatformTime::Seconds(), Value }))
+	{
+		INC_DWORD_STAT(STAT_P3D_InputSamplesDropped);
+	}
+}
+
+void FP3DPawnInputBuffer::PushRoll(float Value)
+{
+	if (!RollRing.Push({ FPlatformTime::Seconds(), FVector2D(Value, 0.f) }))
+	{
+		INC_DWORD_STAT(STAT_P3D_InputSamplesDropped);
+	}
+}
+
+FP3DInputFrame FP3DPawnInputBuffer::Consume(float DeltaTime, const FP3DLookSmoothingSettings& Settings)
+{
+	FP3DInputFrame Frame;
+
+	// Look: 프레임 안의 모든 델타를 합산(마지막 값만 쓰면 폴링레이트/프레임레이트에 따라 회전량이 달라짐)
+	FVector2D LookSum = FVector2D::ZeroVector;
+	const int32 NumLook = LookRing.Drain([&](const FP3DInputSample& Sample)
+	{
+		if (Frame.OldestLookTimestamp == 0.0) Frame.OldestLookTimestamp = Sample.Timestamp;
+		LookSum += Sample.Value;
+	});
+	INC_DWORD_STAT_BY(STAT_P3D_LookSamples, NumLook);
+
+	Frame.Look = ApplySmoothing(LookSum, DeltaTime, Settings);
+
+	// Move/Roll: 축 입력이라 순서대로 보고 마지막 값만 유지
+	MoveRing.Drain([&](const FP3DInputSample& Sample)
+	{
+		Frame.bHasMove = true;
+		Frame.Move = Sample.Value;
+	});
+
+	RollRing.Drain([&](const FP3DInputSample& Sample)
+	{
+		Frame.bHasRoll = true;
+		Frame.Roll = Sample.Value.X;
+	});
+
+	return Frame;
+}
+
+FVector2D FP3DPawnInputBuffer::ApplySmoothing(const FVector2D& Look, float DeltaTime, const FP3DLookSmoothingSettings& Settings)
+{
+	if (Settings.Mode == EP3DLookSmoothing::None || DeltaTime <= KINDA_SMALL_NUMBER)
+	{
+		bFilterPrimed = false;
+		return Look;
+	}
+
+	// 프레임 길이와 무관하도록 "초당 회전량"에 필터를 걸고 다시 dt를 곱함
+	const FVector2D Rate = Look / DeltaTime;
+
+	if (!bFilterPrimed)
+	{
+		// 첫 샘플은 지연 없이 그대로
+		FilteredRate = Rate;
+		FilteredRateDeriv = FVector2D::ZeroVector;
+		bFilterPrimed = !Look.IsNearlyZero();
+		return Look;
+	}
+
+	if (Settings.Mode == EP3DLookSmoothing::Exponential)
+	{
+		const float Alpha = 1.f - FMath::Exp(-DeltaTime / FMath::Max(Settings.SmoothingTime, 0.001f));
+		FilteredRate += (Rate - FilteredRate) * Alpha;
+	}
+	else
+	{
+		const FVector2D Deriv = (Rate - FilteredRate) / DeltaTime;
+		FilteredRateDeriv += (Deriv - FilteredRateDeriv) * OneEuroAlpha(Settings.DerivativeCutoff, DeltaTime);
+
+		// 축마다 속도에 맞춰 컷오프 조절
+		const float AlphaX = OneEuroAlpha(Settings.MinCutoff + Settings.Beta * FMath::Abs(FilteredRateDeriv.X), DeltaTime);
+		const float AlphaY = OneEuroAlpha(Settings.MinCutoff + Settings.Beta * FMath::Abs(FilteredRateDeriv.Y), DeltaTime);
+
+		FilteredRate.X += (Rate.X - FilteredRate.X) * AlphaX;
+		FilteredRate.Y += (Rate.Y - FilteredRate.Y) * AlphaY;
+	}
+
+	FVector2D Out = FilteredRate * DeltaTime;
+
+	// 꼬리가 끝없이 이어지지 않게 정리
+	if (Look.IsNearlyZero() && Out.IsNearlyZero(1.e-3f))
+	{
+		bFilterPrimed = false;
+		Out = FVector2D::ZeroVector;
+	}
+
+	return Out;
+}
+
+void FP3DPawnInputBuffer::Reset()
+{
+	LookRing.Discard();
+	MoveRing.Discard();
+	RollRing.Discard();
+
+	FilteredRate = FVector2D::ZeroVector;
+	FilteredRateDeriv = FVector2D::ZeroVector;
+	bFilterPrimed = false;
+}
+
+void FP3DPawnInputBuffer::ReportLookLatency(double InputTimestamp)
+{
+	if (InputTimestamp <= 0.0) return;
+
+	const float LatencyMs = static_cast<float>((FPlatformTime::Seconds() - InputTimestamp) * 1000.0);
+	SET_FLOAT_STAT(STAT_P3D_LookLatencyMs, LatencyMs);
+}
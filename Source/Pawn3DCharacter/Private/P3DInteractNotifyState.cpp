@@ -0,0 +1,39 @@
+﻿#include "P3DInteractNotifyState.h"
+
+#include "BasePawn.h"
+#include "Components/SkeletalMeshComponent.h"
+
+namespace
+{
+	ABasePawn* GetBasePawn(const USkeletalMeshComponent* MeshComp)
+	{
+		return MeshComp ? Cast<ABasePawn>(MeshComp->GetOwner()) : nullptr;
+	}
+}
+
+void UP3DInteractNotifyState::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
+
+	if (ABasePawn* Pawn = GetBasePawn(MeshComp))
+	{
+		Pawn->Notify_InteractStart();
+	}
+}
+
+void UP3DInteractNotifyState::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+
+	// Begin 없이 End만 오는 경우(구간 밖에서 시작한 재생 등)는 무시
+	ABasePawn* Pawn = GetBasePawn(MeshComp);
+	if (Pawn && Pawn->bIsInteracting)
+	{
+		Pawn->Notify_InteractEnd();
+	}
+}
+
+FString UP3DInteractNotifyState::GetNotifyName_Implementation() const
+{
+	return TEXT("P3D Interact");
+}
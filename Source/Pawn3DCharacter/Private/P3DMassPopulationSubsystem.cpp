@@ -0,0 +1,484 @@
+﻿#include "P3DMassPopulationSubsystem.h"
+
+#include "BasePawn.h"
+#include "BasePawnMovementComponent.h"
+#include "DronePawn.h"
+#include "P3DStats.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/ResourceSize.h"
+
+static TAutoConsoleVariable<float> CVarMassPromoteDistance(
+	TEXT("p3d.Mass.PromoteDistance"),
+	2500.f,
+	TEXT("로컬 뷰에서 이 거리(cm) 안의 Mass 엔티티는 액터로 승격"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarMassDemoteDistance(
+	TEXT("p3d.Mass.DemoteDistance"),
+	3000.f,
+	TEXT("승격된 액터가 이 거리(cm)를 벗어나면 엔티티로 강등(PromoteDistance보다 커야 함)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarMassUpdateInterval(
+	TEXT("p3d.Mass.UpdateInterval"),
+	0.25f,
+	TEXT("승격/강등 재평가 주기(초)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMassMaxPromotionsPerUpdate(
+	TEXT("p3d.Mass.MaxPromotionsPerUpdate"),
+	8,
+	TEXT("재평가 한 번에 스폰하는 최대 액터 수(가까운 순, 스폰 히치 분산)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMassMaxActors(
+	TEXT("p3d.Mass.MaxActors"),
+	64,
+	TEXT("동시에 승격될 수 있는 최대 액터 수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarMassFloorCacheDistance(
+	TEXT("p3d.Mass.FloorCacheDistance"),
+	200.f,
+	TEXT("Mass Pawn 바닥 재탐색 간격(수평 이동 거리, cm)"),
+	ECVF_Default);
+
+bool UP3DMassPopulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UP3DMassPopulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UP3DMassPopulationSubsystem, STATGROUP_Tickables);
+}
+
+void UP3DMassPopulationSubsystem::Deinitialize()
+{
+	// EntityManager/액터는 월드와 함께 정리됨 → 목록만 비움
+	Entities.Reset();
+	Promoted.Reset();
+	PromoteRequests.Reset();
+	DemoteRequests.Reset();
+	RemoveRequests.Reset();
+
+	Super::Deinitialize();
+}
+
+FMassEntityManager* UP3DMassPopulationSubsystem::GetEntityManager() const
+{
+	UMassEntitySubsystem* EntitySubsystem = GetWorld() ? GetWorld()->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+	return EntitySubsystem ? &EntitySubsystem->GetMutableEntityManager() : nullptr;
+}
+
+SIZE_T UP3DMassPopulationSubsystem::GetEntityManagerBytes() const
+{
+	FMassEntityManager* EntityManager = GetEntityManager();
+	if (!EntityManager) return 0;
+
+	FResourceSizeEx Size(EResourceSizeMode::Exclusive);
+	EntityManager->GetResourceSizeEx(Size);
+	return Size.GetTotalMemoryBytes();
+}
+
+// 스폰 / 제거
+
+void UP3DMassPopulationSubsystem::CacheClassParams(TSubclassOf<APawn> PawnClass, bool bDrone)
+{
+	if (bDrone)
+	{
+		DronePawnClass = PawnClass;
+
+		const ADronePawn* Drone = PawnClass->GetDefaultObject<ADronePawn>();
+		DroneParams = Drone->GetFlightParams();
+		DroneRadius = Drone->SphereComp ? Drone->SphereComp->GetUnscaledSphereRadius() : 30.f;
+		return;
+	}
+
+	BasePawnClass = PawnClass;
+
+	const ABasePawn* Base = PawnClass->GetDefaultObject<ABasePawn>();
+	PawnParams.NormalSpeed = Base->NormalSpeed;
+	PawnParams.GravityZ = GetWorld()->GetGravityZ();
+
+	if (Base->CapsuleComp)
+	{
+		PawnParams.HalfHeight = Base->CapsuleComp->GetUnscaledCapsuleHalfHeight();
+	}
+
+	if (const UBasePawnMovementComponent* Movement = Base->MovementComp)
+	{
+		PawnParams.MaxStepHeight = Movement->MaxStepHeight;
+		PawnParams.WalkableFloorZ = Movement->WalkableFloorZ;
+		PawnParams.FloorGap = Movement->FloorGap;
+		PawnParams.MaxFallSpeed = Movement->MaxFallSpeed;
+	}
+}
+
+int32 UP3DMassPopulationSubsystem::SpawnPopulation(TSubclassOf<APawn> PawnClass, int32 Count, const FVector& Center, float Spacing)
+{
+	FMassEntityManager* EntityManager = GetEntityManager();
+	if (!EntityManager || !PawnClass || Count <= 0) return 0;
+
+	const bool bDrone = PawnClass->IsChildOf(ADronePawn::StaticClass());
+	if (!bDrone && !PawnClass->IsChildOf(ABasePawn::StaticClass()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Mass] %s is not a BasePawn/DronePawn class"), *GetNameSafe(PawnClass));
+		return 0;
+	}
+
+	CacheClassParams(PawnClass, bDrone);
+
+	const SIZE_T BytesBefore = GetEntityManagerBytes();
+
+	TArray<const UScriptStruct*, TInlineAllocator<8>> Composition =
+	{
+		FP3DMassTransformFragment::StaticStruct(),
+		FP3DMassMoveFragment::StaticStruct(),
+		FP3DMassActorFragment::StaticStruct(),
+	};
+
+	if (bDrone)
+	{
+		Composition.Add(FP3DMassDroneFragment::StaticStruct());
+		Composition.Add(FP3DMassDroneTag::StaticStruct());
+	}
+	else
+	{
+		Composition.Add(FP3DMassGroundFragment::StaticStruct());
+		Composition.Add(FP3DMassPawnTag::StaticStruct());
+	}
+
+	const FMassArchetypeHandle Archetype = EntityManager->CreateArchetype(Composition);
+
+	TArray<FMassEntityHandle> NewEntities;
+	{
+		// 생성 컨텍스트가 살아 있는 동안 초기값 채움(옵저버는 스코프 끝에서 한 번)
+		TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext = EntityManager->BatchCreateEntities(Archetype, Count, NewEntities);
+
+		// Center 주변 격자(Center 자리는 비움)
+		const int32 Side = FMath::CeilToInt32(FMath::Sqrt(float(Count)));
+		const FVector Origin = Center + FVector(Spacing, -0.5f * Side * Spacing, 0.f);
+
+		for (int32 i = 0; i < NewEntities.Num(); ++i)
+		{
+			const FMassEntityHandle Entity = NewEntities[i];
+
+			FP3DMassTransformFragment& Transform = EntityManager->GetFragmentDataChecked<FP3DMassTransformFragment>(Entity);
+			Transform.Location = Origin + FVector((i / Side) * Spacing, (i % Side) * Spacing, 0.f);
+			Transform.Yaw = float((i * 37) % 360);
+
+			FP3DMassMoveFragment& Move = EntityManager->GetFragmentDataChecked<FP3DMassMoveFragment>(Entity);
+			Move.WanderPhase = i * 0.37f;
+		}
+	}
+
+	Entities.Append(NewEntities);
+
+	const SIZE_T BytesAfter = GetEntityManagerBytes();
+	BytesPerEntity = NewEntities.Num() > 0 ? double(BytesAfter - FMath::Min(BytesBefore, BytesAfter)) / NewEntities.Num() : 0.0;
+
+	UE_LOG(LogTemp, Log, TEXT("[Mass] Spawned %d %s entities (%.1f bytes/entity)"),
+		NewEntities.Num(), bDrone ? TEXT("drone") : TEXT("pawn"), BytesPerEntity);
+
+	return NewEntities.Num();
+}
+
+void UP3DMassPopulationSubsystem::DestroyPopulation()
+{
+	FMassEntityManager* EntityManager = GetEntityManager();
+
+	if (EntityManager)
+	{
+		for (const FMassEntityHandle Entity : Promoted)
+		{
+			if (!EntityManager->IsEntityValid(Entity)) continue;
+
+			// 플레이어가 조종 중인 액터는 남김(엔티티만 제거)
+			APawn* Pawn = EntityManager->GetFragmentDataChecked<FP3DMassActorFragment>(Entity).Actor.Get();
+			if (Pawn && !Pawn->IsPlayerControlled())
+			{
+				Pawn->Destroy();
+			}
+		}
+
+		Entities.RemoveAll([EntityManager](const FMassEntityHandle Entity) { return !EntityManager->IsEntityValid(Entity); });
+		EntityManager->BatchDestroyEntities(Entities);
+	}
+
+	Entities.Reset();
+	Promoted.Reset();
+	PromoteRequests.Reset();
+	DemoteRequests.Reset();
+	RemoveRequests.Reset();
+	bEvaluateLOD = false;
+}
+
+// Tick: 지난 재평가 요청 반영 → 승격 액터 구동 → 다음 재평가 예약
+
+void UP3DMassPopulationSubsystem::Tick(float DeltaTime)
+{
+	FMassEntityManager* EntityManager = GetEntityManager();
+	if (!EntityManager || Entities.Num() == 0)
+	{
+		bEvaluateLOD = false;
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_P3D_MassPopulationTick);
+
+	PawnParams.FloorCacheDistance = FMath::Max(0.f, CVarMassFloorCacheDistance.GetValueOnGameThread());
+
+	// LOD 프로세서가 이번 프레임에 모은 후보(처리 단계 밖이라 구조 변경 가능)
+	if (bEvaluateLOD)
+	{
+		ApplyLODRequests();
+		bEvaluateLOD = false;
+	}
+
+	DrivePromotedActors(DeltaTime);
+
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate <= 0.f)
+	{
+		TimeUntilUpdate = FMath::Max(0.f, CVarMassUpdateInterval.GetValueOnGameThread());
+
+		const float PromoteDistance = CVarMassPromoteDistance.GetValueOnGameThread();
+		const float DemoteDistance = FMath::Max(PromoteDistance, CVarMassDemoteDistance.GetValueOnGameThread());
+		PromoteDistSq = FMath::Square(PromoteDistance);
+		DemoteDistSq = FMath::Square(DemoteDistance);
+
+		GatherViewLocations();
+		bEvaluateLOD = true;
+	}
+
+	SET_DWORD_STAT(STAT_P3D_MassEntities, Entities.Num());
+	SET_DWORD_STAT(STAT_P3D_MassPromoted, Promoted.Num());
+	SET_FLOAT_STAT(STAT_P3D_MassBytesPerEntity, BytesPerEntity);
+}
+
+void UP3DMassPopulationSubsystem::GatherViewLocations()
+{
+	ViewLocations.Reset();
+
+	// 로컬 플레이어 시점 모음(분할 화면 대비)
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC || !PC->IsLocalController()) continue;
+
+		FVector ViewLoc;
+		FRotator ViewRot;
+		PC->GetPlayerViewPoint(ViewLoc, ViewRot);
+		ViewLocations.Add(ViewLoc);
+	}
+}
+
+void UP3DMassPopulationSubsystem::RequestPromote(FMassEntityHandle Entity, float DistSq)
+{
+	PromoteRequests.Add({ Entity, DistSq });
+}
+
+void UP3DMassPopulationSubsystem::RequestDemote(FMassEntityHandle Entity)
+{
+	DemoteRequests.Add(Entity);
+}
+
+void UP3DMassPopulationSubsystem::RequestRemove(FMassEntityHandle Entity)
+{
+	RemoveRequests.Add(Entity);
+}
+
+void UP3DMassPopulationSubsystem::ApplyLODRequests()
+{
+	FMassEntityManager& EntityManager = *GetEntityManager();
+
+	// 승격 액터가 외부에서 파괴됨 → 엔티티도 제거
+	for (const FMassEntityHandle Entity : RemoveRequests)
+	{
+		Promoted.RemoveSwap(Entity);
+		Entities.RemoveSwap(Entity);
+
+		if (EntityManager.IsEntityValid(Entity))
+		{
+			EntityManager.DestroyEntity(Entity);
+		}
+	}
+
+	for (const FMassEntityHandle Entity : DemoteRequests)
+	{
+		Demote(EntityManager, Entity);
+	}
+
+	// 가까운 순으로 한도 안에서만 스폰
+	const int32 MaxActors = FMath::Max(0, CVarMassMaxActors.GetValueOnGameThread());
+	const int32 Budget = FMath::Min(FMath::Max(0, CVarMassMaxPromotionsPerUpdate.GetValueOnGameThread()), MaxActors - Promoted.Num());
+
+	if (Budget > 0 && PromoteRequests.Num() > 0)
+	{
+		PromoteRequests.Sort([](const FPromoteRequest& A, const FPromoteRequest& B) { return A.DistSq < B.DistSq; });
+
+		for (int32 i = 0; i < FMath::Min(Budget, PromoteRequests.Num()); ++i)
+		{
+			SpawnActorFor(EntityManager, PromoteRequests[i].Entity);
+		}
+	}
+
+	PromoteRequests.Reset();
+	DemoteRequests.Reset();
+	RemoveRequests.Reset();
+}
+
+// 승격 / 강등
+
+APawn* UP3DMassPopulationSubsystem::PromoteEntity(FMassEntityHandle Entity)
+{
+	FMassEntityManager* EntityManager = GetEntityManager();
+	return EntityManager ? SpawnActorFor(*EntityManager, Entity) : nullptr;
+}
+
+APawn* UP3DMassPopulationSubsystem::PromoteNearest(const FVector& Location, bool bDrone, float MaxDistance)
+{
+	FMassEntityManager* EntityManager = GetEntityManager();
+	if (!EntityManager) return nullptr;
+
+	FMassEntityHandle Best;
+	float BestDistSq = FMath::Square(MaxDistance);
+
+	for (const FMassEntityHandle Entity : Entities)
+	{
+		if (!EntityManager->IsEntityValid(Entity)) continue;
+		if ((EntityManager->GetFragmentDataPtr<FP3DMassDroneFragment>(Entity) != nullptr) != bDrone) continue;
+
+		const float DistSq = FVector::DistSquared(EntityManager->GetFragmentDataChecked<FP3DMassTransformFragment>(Entity).Location, Location);
+		if (DistSq < BestDistSq)
+		{
+			BestDistSq = DistSq;
+			Best = Entity;
+		}
+	}
+
+	return Best.IsSet() ? SpawnActorFor(*EntityManager, Best) : nullptr;
+}
+
+APawn* UP3DMassPopulationSubsystem::SpawnActorFor(FMassEntityManager& EntityManager, FMassEntityHandle Entity)
+{
+	if (!EntityManager.IsEntityValid(Entity)) return nullptr;
+
+	FP3DMassActorFragment& ActorFragment = EntityManager.GetFragmentDataChecked<FP3DMassActorFragment>(Entity);
+	if (APawn* Existing = ActorFragment.Actor.Get())
+	{
+		return Existing;
+	}
+
+	const FP3DMassTransformFragment& Transform = EntityManager.GetFragmentDataChecked<FP3DMassTransformFragment>(Entity);
+	const FP3DMassDroneFragment* DroneFragment = EntityManager.GetFragmentDataPtr<FP3DMassDroneFragment>(Entity);
+
+	const TSubclassOf<APawn> PawnClass = DroneFragment ? DronePawnClass : BasePawnClass;
+	if (!PawnClass) return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	APawn* Pawn = GetWorld()->SpawnActor<APawn>(PawnClass, Transform.Location, FRotator(0.f, Transform.Yaw, 0.f), SpawnParams);
+	if (!Pawn) return nullptr;
+
+	// 엔티티에서 진행하던 상태 이어받기
+	if (ADronePawn* Drone = Cast<ADronePawn>(Pawn))
+	{
+		if (DroneFragment)
+		{
+			Drone->FlightState = DroneFragment->FlightState;
+		}
+	}
+	else if (ABasePawn* Base = Cast<ABasePawn>(Pawn))
+	{
+		// 컨트롤러 없이 배회 입력으로 이동
+		Base->SetScriptedInputEnabled(true);
+	}
+
+	// 태그 추가는 아키타입 이동 → 프래그먼트 참조는 그 전에만 사용
+	ActorFragment.Actor = Pawn;
+	EntityManager.AddTagToEntity(Entity, FP3DMassPromotedTag::StaticStruct());
+	Promoted.Add(Entity);
+
+	return Pawn;
+}
+
+void UP3DMassPopulationSubsystem::Demote(FMassEntityManager& EntityManager, FMassEntityHandle Entity)
+{
+	if (!EntityManager.IsEntityValid(Entity)) return;
+
+	FP3DMassActorFragment& ActorFragment = EntityManager.GetFragmentDataChecked<FP3DMassActorFragment>(Entity);
+	APawn* Pawn = ActorFragment.Actor.Get();
+
+	// 플레이어가 조종 중이면 거리와 무관하게 유지
+	if (Pawn && Pawn->IsPlayerControlled()) return;
+
+	if (Pawn)
+	{
+		FP3DMassTransformFragment& Transform = EntityManager.GetFragmentDataChecked<FP3DMassTransformFragment>(Entity);
+		Transform.Location = Pawn->GetActorLocation();
+		Transform.Yaw = Pawn->GetActorRotation().Yaw;
+
+		if (const ADronePawn* Drone = Cast<ADronePawn>(Pawn))
+		{
+			if (FP3DMassDroneFragment* DroneFragment = EntityManager.GetFragmentDataPtr<FP3DMassDroneFragment>(Entity))
+			{
+				DroneFragment->FlightState = Drone->FlightState;
+			}
+		}
+		else if (FP3DMassGroundFragment* Ground = EntityManager.GetFragmentDataPtr<FP3DMassGroundFragment>(Entity))
+		{
+			// 다음 프레임에 바닥 재탐색
+			*Ground = FP3DMassGroundFragment();
+		}
+
+		Pawn->Destroy();
+	}
+
+	ActorFragment.Actor.Reset();
+	EntityManager.RemoveTagFromEntity(Entity, FP3DMassPromotedTag::StaticStruct());
+	Promoted.RemoveSwap(Entity);
+}
+
+void UP3DMassPopulationSubsystem::DrivePromotedActors(float DeltaTime)
+{
+	FMassEntityManager& EntityManager = *GetEntityManager();
+
+	for (const FMassEntityHandle Entity : Promoted)
+	{
+		if (!EntityManager.IsEntityValid(Entity)) continue;
+
+		APawn* Pawn = EntityManager.GetFragmentDataChecked<FP3DMassActorFragment>(Entity).Actor.Get();
+		if (!Pawn || Pawn->IsPlayerControlled()) continue;
+
+		// 엔티티 때와 같은 배회 입력을 이어서 주입
+		FP3DMassMoveFragment& Move = EntityManager.GetFragmentDataChecked<FP3DMassMoveFragment>(Entity);
+		P3DMass::AdvanceWander(Move, DeltaTime);
+
+		FP3DScriptedInput Input;
+		Input.Move = Move.MoveInput;
+		Input.UpDown = Move.UpDownInput;
+
+		// 폰은 Look.X * MouseSensitivity(도)만큼 돌림 → 엔티티 선회량(도)을 축 값으로 환산해서 같은 도/초 유지
+		const float YawDegrees = Move.TurnInput * DeltaTime;
+
+		if (ABasePawn* Base = Cast<ABasePawn>(Pawn))
+		{
+			Input.Look.X = Base->MouseSensitivity > KINDA_SMALL_NUMBER ? YawDegrees / Base->MouseSensitivity : 0.f;
+			Base->InjectScriptedInput(Input);
+		}
+		else if (ADronePawn* Drone = Cast<ADronePawn>(Pawn))
+		{
+			Input.Look.X = Drone->MouseSensitivity > KINDA_SMALL_NUMBER ? YawDegrees / Drone->MouseSensitivity : 0.f;
+			Drone->InjectScriptedInput(Input);
+		}
+	}
+}
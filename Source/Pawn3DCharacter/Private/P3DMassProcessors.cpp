@@ -0,0 +1,332 @@
+﻿#include "P3DMassProcessors.h"
+
+#include "P3DMassFragments.h"
+#include "P3DMassPopulationSubsystem.h"
+#include "DroneSimSubsystem.h"
+#include "P3DProfiling.h"
+#include "P3DStats.h"
+#include "MassExecutionContext.h"
+#include "MassEntityManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+namespace
+{
+	// 히치 프레임에서 한 번에 너무 멀리 가지 않도록(원거리 표현이라 서브스텝 없음)
+	constexpr float MaxMassDeltaTime = 0.1f;
+
+	UP3DMassPopulationSubsystem* GetPopulation(const FMassEntityManager& EntityManager)
+	{
+		UWorld* World = EntityManager.GetWorld();
+		UP3DMassPopulationSubsystem* Population = World ? World->GetSubsystem<UP3DMassPopulationSubsystem>() : nullptr;
+		return (Population && Population->GetNumEntities() > 0) ? Population : nullptr;
+	}
+
+	// Yaw 기준 수평 방향(입력 크기 1로 제한, Z=0)
+	FVector GetWanderDirection(const FP3DMassMoveFragment& Move, float Yaw)
+	{
+		const FVector Local(Move.MoveInput.Y, Move.MoveInput.X, 0.f);
+		return FRotator(0.f, Yaw, 0.f).RotateVector(Local).GetClampedToMaxSize(1.f);
+	}
+}
+
+// ===== Pawn =====
+
+UP3DMassPawnMoveProcessor::UP3DMassPawnMoveProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+
+	// 라인 트레이스 + 서브시스템 접근
+	bRequiresGameThreadExecution = true;
+}
+
+void UP3DMassPawnMoveProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FP3DMassTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FP3DMassMoveFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FP3DMassGroundFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddTagRequirement<FP3DMassPawnTag>(EMassFragmentPresence::All);
+	EntityQuery.AddTagRequirement<FP3DMassPromotedTag>(EMassFragmentPresence::None);
+}
+
+void UP3DMassPawnMoveProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UP3DMassPopulationSubsystem* Population = GetPopulation(EntityManager);
+	if (!Population) return;
+
+	P3D_SCOPE(MassPawnMove);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	UWorld* World = EntityManager.GetWorld();
+	const FP3DMassPawnParams& Params = Population->GetPawnParams();
+	const float DT = FMath::Min(Context.GetDeltaTimeSeconds(), MaxMassDeltaTime);
+
+	// 캡슐 중심에서 발 아래 턱 높이까지
+	const float TraceLen = Params.HalfHeight + Params.MaxStepHeight;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(P3DMassPawnFloor), false);
+	uint32 FloorQueries = 0;
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& ChunkContext)
+	{
+		const TArrayView<FP3DMassTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FP3DMassTransformFragment>();
+		const TArrayView<FP3DMassMoveFragment> Moves = ChunkContext.GetMutableFragmentView<FP3DMassMoveFragment>();
+		const TArrayView<FP3DMassGroundFragment> Grounds = ChunkContext.GetMutableFragmentView<FP3DMassGroundFragment>();
+
+		for (int32 i = 0; i < ChunkContext.GetNumEntities(); ++i)
+		{
+			FP3DMassTransformFragment& Transform = Transforms[i];
+			FP3DMassMoveFragment& Move = Moves[i];
+			FP3DMassGroundFragment& Ground = Grounds[i];
+
+			// 1) 수평: 벽 스윕 없이 그대로 이동
+			P3DMass::AdvanceWander(Move, DT);
+			Transform.Yaw = FRotator::NormalizeAxis(Transform.Yaw + Move.TurnInput * DT);
+
+			const FVector Horizontal = GetWanderDirection(Move, Transform.Yaw) * (Params.NormalSpeed * DT);
+			Transform.Location += Horizontal;
+			Ground.TraveledSinceQuery += Horizontal.Size2D();
+
+			// 2) 바닥: 공중이거나 캐시 거리를 넘었을 때만 재탐색
+			if (!Ground.bOnGround || !Ground.bHasFloor || Ground.TraveledSinceQuery >= Params.FloorCacheDistance)
+			{
+				FHitResult Hit;
+				const FVector Start = Transform.Location;
+				const FVector End = Start - FVector(0.f, 0.f, TraceLen);
+
+				Ground.bHasFloor = World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, QueryParams)
+					&& Hit.ImpactNormal.Z >= Params.WalkableFloorZ;
+				if (Ground.bHasFloor)
+				{
+					Ground.FloorZ = Hit.ImpactPoint.Z;
+				}
+
+				Ground.TraveledSinceQuery = 0.f;
+				++FloorQueries;
+			}
+
+			// 3) 수직: 턱 높이 안이면 바닥에 붙이고, 아니면 낙하
+			const float FeetZ = Transform.Location.Z - Params.HalfHeight;
+			if (Ground.bHasFloor && Ground.VerticalSpeed <= 0.f && FeetZ - Ground.FloorZ <= Params.MaxStepHeight)
+			{
+				Transform.Location.Z = Ground.FloorZ + Params.HalfHeight + Params.FloorGap;
+				Ground.VerticalSpeed = 0.f;
+				Ground.bOnGround = true;
+				continue;
+			}
+
+			Ground.bOnGround = false;
+			Ground.VerticalSpeed = FMath::Max(Ground.VerticalSpeed + Params.GravityZ * DT, -Params.MaxFallSpeed);
+			Transform.Location.Z += Ground.VerticalSpeed * DT;
+
+			// 알고 있는 바닥을 뚫고 내려가면 착지
+			if (Ground.bHasFloor && Transform.Location.Z - Params.HalfHeight < Ground.FloorZ)
+			{
+				Transform.Location.Z = Ground.FloorZ + Params.HalfHeight + Params.FloorGap;
+				Ground.VerticalSpeed = 0.f;
+				Ground.bOnGround = true;
+			}
+		}
+	});
+
+	INC_DWORD_STAT_BY(STAT_P3D_MassFloorQueries, FloorQueries);
+	P3DCounters::AddSceneQuery(FloorQueries);
+	P3DCounters::MassCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+// ===== Drone =====
+
+UP3DMassDroneProcessor::UP3DMassDroneProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+
+	// 공용 바닥 캐시(UDroneSimSubsystem)는 게임 스레드 전용
+	bRequiresGameThreadExecution = true;
+}
+
+void UP3DMassDroneProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FP3DMassTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FP3DMassMoveFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FP3DMassDroneFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddTagRequirement<FP3DMassDroneTag>(EMassFragmentPresence::All);
+	EntityQuery.AddTagRequirement<FP3DMassPromotedTag>(EMassFragmentPresence::None);
+}
+
+void UP3DMassDroneProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UP3DMassPopulationSubsystem* Population = GetPopulation(EntityManager);
+	if (!Population) return;
+
+	P3D_SCOPE(MassDroneMove);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	UWorld* World = EntityManager.GetWorld();
+	const FDroneFlightParams& Params = Population->GetDroneParams();
+	const float Radius = Population->GetDroneRadius();
+	const float DT = FMath::Min(Context.GetDeltaTimeSeconds(), MaxMassDeltaTime);
+
+	// 액터 드론과 같은 탐색 길이, 모양은 라인(반지름 0 → 캐시 셀도 스피어 스윕 결과와 섞이지 않음)
+	const float TraceLen = Radius + Params.GroundProbeDistance;
+
+	UDroneSimSubsystem* SimSubsystem = World->GetSubsystem<UDroneSimSubsystem>();
+	FDroneGroundCache* Cache = SimSubsystem ? &SimSubsystem->GetGroundCache() : nullptr;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(P3DMassDroneGround), false);
+	uint32 GroundQueries = 0;
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& ChunkContext)
+	{
+		const TArrayView<FP3DMassTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FP3DMassTransformFragment>();
+		const TArrayView<FP3DMassMoveFragment> Moves = ChunkContext.GetMutableFragmentView<FP3DMassMoveFragment>();
+		const TArrayView<FP3DMassDroneFragment> Drones = ChunkContext.GetMutableFragmentView<FP3DMassDroneFragment>();
+
+		for (int32 i = 0; i < ChunkContext.GetNumEntities(); ++i)
+		{
+			FP3DMassTransformFragment& Transform = Transforms[i];
+			FP3DMassMoveFragment& Move = Moves[i];
+			FDroneFlightState& State = Drones[i].FlightState;
+
+			P3DMass::AdvanceWander(Move, DT);
+			Transform.Yaw = FRotator::NormalizeAxis(Transform.Yaw + Move.TurnInput * DT);
+
+			// 1) 바닥: 캐시 → miss면 라인 트레이스
+			FHitResult Hit;
+			bool bHit = false;
+			bool bResolved = false;
+
+			if (Cache)
+			{
+				const FDroneGroundCache::ELookup Result = Cache->Lookup(Transform.Location, TraceLen, 0.f, Params.GroundSnapMax, Hit);
+				SimSubsystem->RecordGroundCacheLookup(Result != FDroneGroundCache::ELookup::Miss);
+
+				bHit = (Result == FDroneGroundCache::ELookup::Hit);
+				bResolved = (Result != FDroneGroundCache::ELookup::Miss);
+			}
+
+			if (!bResolved)
+			{
+				bHit = World->LineTraceSingleByChannel(Hit, Transform.Location, Transform.Location - FVector(0.f, 0.f, TraceLen), ECC_Visibility, QueryParams);
+				++GroundQueries;
+
+				if (Cache && bHit)
+				{
+					Cache->Store(Hit, 0.f, Params.WalkableFloorZ);
+				}
+			}
+
+			FDroneGroundSample Ground;
+			Ground.bHitGround = bHit;
+			if (bHit)
+			{
+				Ground.Gap = Hit.Distance - Radius;
+				Ground.bIsFloor = (Hit.ImpactNormal.Z >= Params.WalkableFloorZ);
+			}
+
+			// 2) 커널: 접지 → 수평 속도 → 수직
+			P3DDroneFlight::UpdateGrounded(Params, Ground, DT, State);
+
+			const float Speed = P3DDroneFlight::GetHorizontalSpeed(Params, State);
+			Transform.Location += GetWanderDirection(Move, Transform.Yaw) * (Speed * DT);
+
+			float DeltaZ = Params.bEnableGravity
+				? P3DDroneFlight::IntegrateVertical(Params, Ground, DT, Move.UpDownInput, State)
+				: Move.UpDownInput * (Params.NormalSpeed * 0.8f) * DT;
+
+			// 스윕 대신: 아는 바닥 아래로는 내려가지 않음
+			if (bHit && DeltaZ < 0.f && Ground.Gap + DeltaZ < 0.f)
+			{
+				DeltaZ = FMath::Min(0.f, -Ground.Gap);
+				P3DDroneFlight::OnVerticalBlocked(Params, Hit.ImpactNormal.Z, State);
+			}
+
+			Transform.Location.Z += DeltaZ;
+		}
+	});
+
+	INC_DWORD_STAT_BY(STAT_P3D_MassFloorQueries, GroundQueries);
+	P3DCounters::AddSceneQuery(GroundQueries);
+	P3DCounters::MassCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+// ===== LOD (승격/강등 후보) =====
+
+UP3DMassLODProcessor::UP3DMassLODProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+	ProcessingPhase = EMassProcessingPhase::PrePhysics;
+
+	// 액터 위치 읽기 + 서브시스템 요청 목록
+	bRequiresGameThreadExecution = true;
+}
+
+void UP3DMassLODProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FP3DMassTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FP3DMassActorFragment>(EMassFragmentAccess::ReadOnly);
+}
+
+void UP3DMassLODProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UP3DMassPopulationSubsystem* Population = GetPopulation(EntityManager);
+	if (!Population || !Population->IsEvaluatingLOD()) return;
+
+	P3D_SCOPE(MassLOD);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	const TArray<FVector, TInlineAllocator<4>>& ViewLocations = Population->GetViewLocations();
+	const float PromoteDistSq = Population->GetPromoteDistSq();
+	const float DemoteDistSq = Population->GetDemoteDistSq();
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& ChunkContext)
+	{
+		const TArrayView<FP3DMassTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FP3DMassTransformFragment>();
+		const TConstArrayView<FP3DMassActorFragment> Actors = ChunkContext.GetFragmentView<FP3DMassActorFragment>();
+		const bool bPromotedChunk = ChunkContext.DoesArchetypeHaveTag<FP3DMassPromotedTag>();
+
+		for (int32 i = 0; i < ChunkContext.GetNumEntities(); ++i)
+		{
+			FP3DMassTransformFragment& Transform = Transforms[i];
+			const FMassEntityHandle Entity = ChunkContext.GetEntity(i);
+
+			if (bPromotedChunk)
+			{
+				const APawn* Pawn = Actors[i].Actor.Get();
+				if (!Pawn)
+				{
+					Population->RequestRemove(Entity);
+					continue;
+				}
+
+				// 액터가 시뮬 중 → 거리 판정은 액터 위치로
+				Transform.Location = Pawn->GetActorLocation();
+				Transform.Yaw = Pawn->GetActorRotation().Yaw;
+			}
+
+			float MinDistSq = TNumericLimits<float>::Max();
+			for (const FVector& ViewLoc : ViewLocations)
+			{
+				MinDistSq = FMath::Min(MinDistSq, float(FVector::DistSquared(ViewLoc, Transform.Location)));
+			}
+
+			if (!bPromotedChunk && MinDistSq < PromoteDistSq)
+			{
+				Population->RequestPromote(Entity, MinDistSq);
+			}
+			else if (bPromotedChunk && MinDistSq > DemoteDistSq)
+			{
+				Population->RequestDemote(Entity);
+			}
+		}
+	});
+
+	P3DCounters::MassCycles += FPlatformTime::Cycles64() - StartCycles;
+}
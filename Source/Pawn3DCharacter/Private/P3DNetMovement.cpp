@@ -0,0 +1,307 @@
+﻿#include "P3DNetMovement.h"
+
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
+#include "P3DStats.h"
+
+// ===== 이동 입력 =====
+
+FRotator FP3DNetMoveInput::GetRotation() const
+{
+	return FRotator(
+		bFullRotation ? FRotator::DecompressAxisFromShort(Pitch) : 0.f,
+		FRotator::DecompressAxisFromShort(Yaw),
+		bFullRotation ? FRotator::DecompressAxisFromShort(Roll) : 0.f);
+}
+
+void FP3DNetMoveInput::SetMove(const FVector2D& Move)
+{
+	MoveX = P3DNet::QuantizeAxis(Move.X);
+	MoveY = P3DNet::QuantizeAxis(Move.Y);
+}
+
+void FP3DNetMoveInput::SetRotation(const FRotator& Rotation, bool bFull)
+{
+	bFullRotation = bFull;
+	Yaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+	Pitch = bFull ? FRotator::CompressAxisToShort(Rotation.Pitch) : 0;
+	Roll = bFull ? FRotator::CompressAxisToShort(Rotation.Roll) : 0;
+}
+
+bool FP3DNetMoveInput::HasSameMove(const FP3DNetMoveInput& Other) const
+{
+	return MoveX == Other.MoveX && MoveY == Other.MoveY && UpDown == Other.UpDown;
+}
+
+bool FP3DNetMoveInput::HasSameRotation(const FP3DNetMoveInput& Other) const
+{
+	return bFullRotation == Other.bFullRotation && Yaw == Other.Yaw && Pitch == Other.Pitch && Roll == Other.Roll;
+}
+
+// 입력 하나(Seq 제외). Prev가 있으면 같은 이동/회전은 1비트로 생략, 반환: 쓴 비트 수
+static int32 SerializeMoveInput(FArchive& Ar, FP3DNetMoveInput& Move, const FP3DNetMoveInput* Prev)
+{
+	int32 Bits = 16;
+	Ar << Move.DeltaTimeQ;
+
+	uint8 bSameMove = 0;
+	uint8 bSameRotation = 0;
+	if (Prev)
+	{
+		if (Ar.IsSaving())
+		{
+			bSameMove = Move.HasSameMove(*Prev) ? 1 : 0;
+			bSameRotation = Move.HasSameRotation(*Prev) ? 1 : 0;
+		}
+		Ar.SerializeBits(&bSameMove, 1);
+		Ar.SerializeBits(&bSameRotation, 1);
+		Bits += 2;
+	}
+
+	if (bSameMove)
+	{
+		Move.MoveX = Prev->MoveX;
+		Move.MoveY = Prev->MoveY;
+		Move.UpDown = Prev->UpDown;
+	}
+	else
+	{
+		Ar << Move.MoveX;
+		Ar << Move.MoveY;
+		Ar << Move.UpDown;
+		Bits += 24;
+	}
+
+	if (bSameRotation)
+	{
+		Move.bFullRotation = Prev->bFullRotation;
+		Move.Yaw = Prev->Yaw;
+		Move.Pitch = Prev->Pitch;
+		Move.Roll = Prev->Roll;
+	}
+	else
+	{
+		uint8 bFull = Move.bFullRotation ? 1 : 0;
+		Ar.SerializeBits(&bFull, 1);
+		Move.bFullRotation = (bFull != 0);
+
+		Ar << Move.Yaw;
+		Bits += 17;
+
+		if (Move.bFullRotation)
+		{
+			Ar << Move.Pitch;
+			Ar << Move.Roll;
+			Bits += 32;
+		}
+		else
+		{
+			Move.Pitch = 0;
+			Move.Roll = 0;
+		}
+	}
+
+	return Bits;
+}
+
+bool FP3DNetMoveBatch::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 NumMinusOne = 0;
+	if (Ar.IsSaving())
+	{
+		check(Moves.Num() > 0);
+		NumMinusOne = static_cast<uint8>(FMath::Min(Moves.Num(), MaxMoves) - 1);
+	}
+	Ar.SerializeBits(&NumMinusOne, 2);
+
+	if (Ar.IsLoading())
+	{
+		Moves.SetNum(NumMinusOne + 1);
+	}
+
+	int32 Bits = 2 + 16;
+	Ar << Moves[0].Seq;
+
+	for (int32 i = 0; i <= NumMinusOne; ++i)
+	{
+		// 묶음 안의 시퀀스는 연속
+		if (i > 0)
+		{
+			Moves[i].Seq = static_cast<uint16>(Moves[i - 1].Seq + 1);
+		}
+		Bits += SerializeMoveInput(Ar, Moves[i], i > 0 ? &Moves[i - 1] : nullptr);
+	}
+
+	if (Ar.IsSaving())
+	{
+		P3DCounters::NetMoveBits += Bits;
+		INC_DWORD_STAT_BY(STAT_P3D_NetMoveBytes, (Bits + 7) / 8);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+// ===== 상태 양자화 =====
+
+namespace
+{
+	enum EP3DNetStateField : uint16
+	{
+		Field_LocX = 1 << 0,
+		Field_LocY = 1 << 1,
+		Field_LocZ = 1 << 2,
+		Field_Yaw = 1 << 3,
+		Field_Pitch = 1 << 4,
+		Field_Roll = 1 << 5,
+		Field_VerticalVelocity = 1 << 6,
+		Field_Grounded = 1 << 7,
+		Field_TeleportId = 1 << 8,
+	};
+
+	constexpr int32 NumStateFieldBits = 9;
+	constexpr uint16 AllStateFields = (1 << NumStateFieldBits) - 1;
+
+	constexpr float LocationScale = 10.f;        // 0.1cm
+	constexpr float VerticalVelocityScale = 8.f; // 0.125cm/s
+
+	// 부호 있는 정수 → 작은 절대값일수록 짧은 가변 길이
+	void SerializeZigZag(FArchive& Ar, int32& Value)
+	{
+		uint32 Encoded = (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+		Ar.SerializeIntPacked(Encoded);
+		Value = static_cast<int32>(Encoded >> 1) ^ -static_cast<int32>(Encoded & 1);
+	}
+}
+
+FP3DNetQuantizedState FP3DNetQuantizedState::FromState(const FP3DNetMoveState& State, uint8 InTeleportId)
+{
+	FP3DNetQuantizedState Q;
+	Q.Location = FIntVector(
+		FMath::RoundToInt32(State.Location.X * LocationScale),
+		FMath::RoundToInt32(State.Location.Y * LocationScale),
+		FMath::RoundToInt32(State.Location.Z * LocationScale));
+	Q.Yaw = FRotator::CompressAxisToShort(State.Rotation.Yaw);
+	Q.Pitch = FRotator::CompressAxisToShort(State.Rotation.Pitch);
+	Q.Roll = FRotator::CompressAxisToShort(State.Rotation.Roll);
+	Q.VerticalVelocity = static_cast<int16>(FMath::Clamp(FMath::RoundToInt32(State.VerticalVelocity * VerticalVelocityScale), -32768, 32767));
+	Q.bGrounded = State.bGrounded;
+	Q.TeleportId = InTeleportId;
+	return Q;
+}
+
+void FP3DNetQuantizedState::ToState(FP3DNetMoveState& OutState) const
+{
+	OutState.Location = FVector(Location) / LocationScale;
+	OutState.Rotation = FRotator(
+		FRotator::DecompressAxisFromShort(Pitch),
+		FRotator::DecompressAxisFromShort(Yaw),
+		FRotator::DecompressAxisFromShort(Roll));
+	OutState.VerticalVelocity = VerticalVelocity / VerticalVelocityScale;
+	OutState.bGrounded = bGrounded;
+}
+
+uint16 FP3DNetQuantizedState::DiffMask(const FP3DNetQuantizedState* Base) const
+{
+	if (!Base) return AllStateFields;
+
+	uint16 Mask = 0;
+	if (Location.X != Base->Location.X) Mask |= Field_LocX;
+	if (Location.Y != Base->Location.Y) Mask |= Field_LocY;
+	if (Location.Z != Base->Location.Z) Mask |= Field_LocZ;
+	if (Yaw != Base->Yaw) Mask |= Field_Yaw;
+	if (Pitch != Base->Pitch) Mask |= Field_Pitch;
+	if (Roll != Base->Roll) Mask |= Field_Roll;
+	if (VerticalVelocity != Base->VerticalVelocity) Mask |= Field_VerticalVelocity;
+	if (bGrounded != Base->bGrounded) Mask |= Field_Grounded;
+	if (TeleportId != Base->TeleportId) Mask |= Field_TeleportId;
+	return Mask;
+}
+
+void FP3DNetQuantizedState::Serialize(FArchive& Ar, uint16& Mask)
+{
+	Ar.SerializeBits(&Mask, NumStateFieldBits);
+
+	if (Mask & Field_LocX) SerializeZigZag(Ar, Location.X);
+	if (Mask & Field_LocY) SerializeZigZag(Ar, Location.Y);
+	if (Mask & Field_LocZ) SerializeZigZag(Ar, Location.Z);
+	if (Mask & Field_Yaw) Ar << Yaw;
+	if (Mask & Field_Pitch) Ar << Pitch;
+	if (Mask & Field_Roll) Ar << Roll;
+	if (Mask & Field_VerticalVelocity) Ar << VerticalVelocity;
+
+	if (Mask & Field_Grounded)
+	{
+		uint8 bValue = bGrounded ? 1 : 0;
+		Ar.SerializeBits(&bValue, 1);
+		bGrounded = (bValue != 0);
+	}
+
+	if (Mask & Field_TeleportId) Ar << TeleportId;
+}
+
+// ===== 서버 상태 델타 =====
+
+// 연결별 기준: 이 연결에 마지막으로 보낸 양자화 값
+class FP3DNetStateDeltaBase : public INetDeltaBaseState
+{
+public:
+	FP3DNetQuantizedState Sent;
+
+	virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+	{
+		return Sent == static_cast<FP3DNetStateDeltaBase*>(OtherState)->Sent;
+	}
+};
+
+bool FP3DNetReplicatedState::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	if (DeltaParms.Writer)
+	{
+		const FP3DNetQuantizedState Current = FP3DNetQuantizedState::FromState(State, TeleportId);
+		const FP3DNetStateDeltaBase* OldBase = static_cast<const FP3DNetStateDeltaBase*>(DeltaParms.OldState);
+
+		uint16 Mask = Current.DiffMask(OldBase ? &OldBase->Sent : nullptr);
+		if (Mask == 0)
+		{
+			// 바뀐 게 없으면 아무것도 안 씀(기준 유지)
+			return false;
+		}
+
+		TSharedPtr<FP3DNetStateDeltaBase> NewBase = MakeShared<FP3DNetStateDeltaBase>();
+		NewBase->Sent = Current;
+		*DeltaParms.NewState = NewBase;
+
+		FBitWriter& Writer = *DeltaParms.Writer;
+		const int64 StartBits = Writer.GetNumBits();
+
+		FP3DNetQuantizedState ToSend = Current;
+		ToSend.Serialize(Writer, Mask);
+
+		const int64 Bits = Writer.GetNumBits() - StartBits;
+		P3DCounters::NetStateBits += Bits;
+		INC_DWORD_STAT_BY(STAT_P3D_NetStateBytes, static_cast<uint32>((Bits + 7) / 8));
+		return true;
+	}
+
+	if (DeltaParms.Reader)
+	{
+		FBitReader& Reader = *DeltaParms.Reader;
+
+		FP3DNetQuantizedState Next = Received;
+		uint16 Mask = 0;
+		Next.Serialize(Reader, Mask);
+
+		if (Reader.IsError())
+		{
+			return false;
+		}
+
+		Received = Next;
+		Received.ToState(State);
+		TeleportId = Received.TeleportId;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,583 @@
+﻿#include "P3DNetMovementComponent.h"
+
+#include "GameFramework/Pawn.h"
+#include "GameFramework/Controller.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "Net/UnrealNetwork.h"
+#include "HAL/IConsoleManager.h"
+#include "P3DStats.h"
+
+static TAutoConsoleVariable<int32> CVarNetRedundantMoves(
+	TEXT("p3d.Net.RedundantMoves"),
+	2,
+	TEXT("ServerMove 한 번에 최신 입력과 함께 다시 보내는 직전 입력 수(0~3, 비신뢰 RPC 유실 대비)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNetCorrectionTolerance(
+	TEXT("p3d.Net.CorrectionTolerance"),
+	2.f,
+	TEXT("예측 위치와 서버 위치 차이가 이 값(cm)을 넘으면 서버 상태로 되감고 재적용"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNetMaxMoveDeltaTime(
+	TEXT("p3d.Net.MaxMoveDeltaTime"),
+	0.1f,
+	TEXT("입력 하나의 최대 dt(초). 클라 예측과 서버가 같은 값으로 자름"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarNetMaxPendingMoves(
+	TEXT("p3d.Net.MaxPendingMoves"),
+	96,
+	TEXT("서버 확인을 기다리는 예측 입력 최대 수(넘으면 오래된 것부터 버림)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNetMaxTimeDiscrepancy(
+	TEXT("p3d.Net.MaxTimeDiscrepancy"),
+	0.25f,
+	TEXT("클라 입력 dt 합이 서버 경과 시간보다 이 값(초) 이상 앞서면 초과분 입력을 버리고 보정(스피드핵/시계 가속 방지, 0이면 끔)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNetTimeDiscrepancyCredit(
+	TEXT("p3d.Net.TimeDiscrepancyCredit"),
+	0.25f,
+	TEXT("클라가 서버보다 늦을 때 쌓아둘 수 있는 최대 여유(초). 지연 묶음 도착 후 따라잡기 허용치"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNetProxyInterpDelay(
+	TEXT("p3d.Net.ProxyInterpDelay"),
+	0.1f,
+	TEXT("다른 클라 Pawn 보간 지연(초). 클수록 부드럽고 늦음"),
+	ECVF_Default);
+
+namespace
+{
+	// 보정 판정용 수직 속도 오차(cm/s, 양자화 0.125 감안)
+	constexpr float VerticalVelocityTolerance = 10.f;
+
+	constexpr int32 MaxProxySamples = 32;
+
+	// ===== p3d.Net.Report 집계 =====
+	int32 NumServerPawns = 0;
+
+	double WindowStartSeconds = 0.0;
+	uint64 WindowStateBits = 0;
+	uint64 WindowMoveBits = 0;
+	uint64 WindowCorrections = 0;
+	uint64 WindowReplayedMoves = 0;
+	uint64 WindowRejectedMoves = 0;
+
+	void ResetNetReportWindow()
+	{
+		WindowStartSeconds = FPlatformTime::Seconds();
+		WindowStateBits = P3DCounters::NetStateBits;
+		WindowMoveBits = P3DCounters::NetMoveBits;
+		WindowCorrections = P3DCounters::NetCorrections;
+		WindowReplayedMoves = P3DCounters::NetReplayedMoves;
+		WindowRejectedMoves = P3DCounters::NetRejectedMoves;
+	}
+
+	// PIE는 서버/클라 월드가 한 프로세스 → 서버 월드의 클라 연결 수
+	int32 CountClientConnections()
+	{
+		int32 NumConnections = 0;
+		if (GEngine)
+		{
+			for (const FWorldContext& Context : GEngine->GetWorldContexts())
+			{
+				const UWorld* World = Context.World();
+				const UNetDriver* Driver = World ? World->GetNetDriver() : nullptr;
+				if (Driver && Driver->IsServer())
+				{
+					NumConnections += Driver->ClientConnections.Num();
+				}
+			}
+		}
+		return NumConnections;
+	}
+}
+
+static FAutoConsoleCommandWithArgsAndOutputDevice CmdNetReport(
+	TEXT("p3d.Net.Report"),
+	TEXT("마지막 p3d.Net.ResetStats 이후 네트워크 이동 대역폭(Pawn당 bytes/s)과 보정 횟수 출력"),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const double Seconds = FMath::Max(FPlatformTime::Seconds() - WindowStartSeconds, 0.001);
+		const double StateBytes = (P3DCounters::NetStateBits - WindowStateBits) / 8.0;
+		const double MoveBytes = (P3DCounters::NetMoveBits - WindowMoveBits) / 8.0;
+		const uint64 Corrections = P3DCounters::NetCorrections - WindowCorrections;
+		const uint64 Replayed = P3DCounters::NetReplayedMoves - WindowReplayedMoves;
+		const uint64 Rejected = P3DCounters::NetRejectedMoves - WindowRejectedMoves;
+
+		const int32 Connections = CountClientConnections();
+		const int32 Pawns = NumServerPawns;
+
+		Ar.Logf(TEXT("[P3DNet] window=%.1fs server pawns=%d client connections=%d (payload only, packet/RPC header 제외)"), Seconds, Pawns, Connections);
+		Ar.Logf(TEXT("  state  S->C: %.1f bytes/s total, %.1f bytes/s per pawn per connection"),
+			StateBytes / Seconds, StateBytes / Seconds / FMath::Max(1, Pawns) / FMath::Max(1, Connections));
+		Ar.Logf(TEXT("  input  C->S: %.1f bytes/s total, %.1f bytes/s per controlled pawn"),
+			MoveBytes / Seconds, MoveBytes / Seconds / FMath::Max(1, Connections));
+		Ar.Logf(TEXT("  corrections=%llu (%.2f/s) replayed moves=%llu rejected moves(time)=%llu"), Corrections, Corrections / Seconds, Replayed, Rejected);
+	}));
+
+static FAutoConsoleCommand CmdNetResetStats(
+	TEXT("p3d.Net.ResetStats"),
+	TEXT("p3d.Net.Report 집계 구간 초기화"),
+	FConsoleCommandDelegate::CreateStatic([]
+	{
+		ResetNetReportWindow();
+	}));
+
+static FAutoConsoleCommandWithArgsAndOutputDevice CmdNetEmulate(
+	TEXT("p3d.Net.Emulate"),
+	TEXT("패킷 지연/유실 재현(한 방향 지연 ms, 유실 %). 인자 없으면 끔. PIE에서는 서버/클라 양쪽에 걸림"),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const int32 LagMs = Args.Num() > 0 ? FMath::Max(0, FCString::Atoi(*Args[0])) : 0;
+		const int32 LossPct = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 0, 100) : 0;
+
+		// 엔진 패킷 시뮬레이션(DO_ENABLE_NET_TEST 빌드에만 있음)
+		IConsoleVariable* LagVar = IConsoleManager::Get().FindConsoleVariable(TEXT("NetEmulation.PktLag"));
+		IConsoleVariable* LossVar = IConsoleManager::Get().FindConsoleVariable(TEXT("NetEmulation.PktLoss"));
+		if (!LagVar || !LossVar)
+		{
+			Ar.Logf(TEXT("[P3DNet] 이 빌드에는 패킷 시뮬레이션이 없음"));
+			return;
+		}
+
+		LagVar->Set(LagMs);
+		LossVar->Set(LossPct);
+		ResetNetReportWindow();
+
+		Ar.Logf(TEXT("[P3DNet] emulate lag=%dms loss=%d%% (stats reset)"), LagMs, LossPct);
+	}));
+
+// 생성자 / 기본
+
+UP3DNetMovementComponent::UP3DNetMovementComponent()
+{
+	// 서버에서만 켬: 매 프레임 상태 발행(배치 시뮬/로컬 Tick 경로 모두 덮음)
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+	SetIsReplicatedByDefault(true);
+}
+
+void UP3DNetMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (IsNetworked() && GetOwnerRole() == ROLE_Authority)
+	{
+		SetComponentTickEnabled(true);
+		PublishState();
+
+		if (NumServerPawns == 0)
+		{
+			ResetNetReportWindow();
+		}
+		++NumServerPawns;
+		bCountedAsServerPawn = true;
+	}
+}
+
+void UP3DNetMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bCountedAsServerPawn)
+	{
+		--NumServerPawns;
+		bCountedAsServerPawn = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UP3DNetMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UP3DNetMovementComponent, ServerState);
+	DOREPLIFETIME_CONDITION(UP3DNetMovementComponent, ServerAckSeq, COND_AutonomousOnly);
+}
+
+void UP3DNetMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		PublishState();
+	}
+}
+
+bool UP3DNetMovementComponent::IsNetworked() const
+{
+	const AActor* Owner = GetOwner();
+	return bEnableNetMovement
+		&& Owner && Owner->GetIsReplicated()
+		&& GetNetMode() != NM_Standalone;
+}
+
+IP3DNetMovementPawn* UP3DNetMovementComponent::GetNetPawn() const
+{
+	return Cast<IP3DNetMovementPawn>(GetOwner());
+}
+
+bool UP3DNetMovementComponent::IsRemotelyControlled() const
+{
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	return Pawn && Pawn->IsPlayerControlled() && !Pawn->IsLocallyControlled();
+}
+
+void UP3DNetMovementComponent::NotifyTeleported()
+{
+	if (GetOwnerRole() != ROLE_Authority) return;
+
+	++ServerState.TeleportId;
+	PublishState();
+}
+
+// Tick (Pawn에서 호출)
+
+bool UP3DNetMovementComponent::TickNetworkedMove(float DeltaTime)
+{
+	if (!IsNetworked()) return false;
+
+	IP3DNetMovementPawn* NetPawn = GetNetPawn();
+	if (!NetPawn) return false;
+
+	// 빙의 전환 등으로 역할이 바뀌면 이전 역할의 예측/보간 기록은 버림
+	const ENetRole Role = GetOwnerRole();
+	if (Role != LastRole)
+	{
+		ResetPrediction();
+		ProxySamples.Reset();
+		LastTeleportId = ServerState.TeleportId;
+		LastRole = Role;
+	}
+
+	switch (Role)
+	{
+	case ROLE_Authority:
+		// 원격 조종 중이면 ServerMove에서만 시뮬, 아니면 로컬 경로 그대로(상태 발행은 TickComponent)
+		return IsRemotelyControlled();
+
+	case ROLE_AutonomousProxy:
+		TickAutonomous(*NetPawn, DeltaTime);
+		return true;
+
+	case ROLE_SimulatedProxy:
+		TickSimulatedProxy(*NetPawn, DeltaTime);
+		return true;
+
+	default:
+		return true;
+	}
+}
+
+// 소유 클라: 예측
+
+void UP3DNetMovementComponent::TickAutonomous(IP3DNetMovementPawn& NetPawn, float DeltaTime)
+{
+	// 이번 프레임 사이에 받은 서버 상태부터 반영(되감기 + 재적용)
+	if (bPendingReconcile)
+	{
+		bPendingReconcile = false;
+		Reconcile(NetPawn);
+	}
+
+	FSavedMove& Saved = PendingMoves.AddDefaulted_GetRef();
+	GatherMove(NetPawn, DeltaTime, Saved.Input);
+
+	NetPawn.NetSimulateMove(Saved.Input);
+	NetPawn.NetSaveState(Saved.State);
+
+	// 서버 응답이 한참 없으면 오래된 기록부터 버림(재적용 비용 상한)
+	const int32 MaxPending = FMath::Max(8, CVarNetMaxPendingMoves.GetValueOnGameThread());
+	if (PendingMoves.Num() > MaxPending)
+	{
+		PendingMoves.RemoveAt(0, PendingMoves.Num() - MaxPending, EAllowShrinking::No);
+	}
+
+	SendPendingMoves();
+
+	SET_DWORD_STAT(STAT_P3D_NetPendingMoves, PendingMoves.Num());
+}
+
+void UP3DNetMovementComponent::GatherMove(IP3DNetMovementPawn& NetPawn, float DeltaTime, FP3DNetMoveInput& OutInput)
+{
+	NetPawn.NetGatherInput(DeltaTime, OutInput);
+
+	// dt 양자화 나머지는 다음 입력으로 넘김
+	const float MaxDT = FMath::Max(CVarNetMaxMoveDeltaTime.GetValueOnGameThread(), 0.01f);
+	DeltaTimeRemainder += FMath::Min(DeltaTime, MaxDT);
+
+	const int32 Quantized = FMath::Clamp(FMath::FloorToInt32(DeltaTimeRemainder / P3DNet::DeltaTimeUnit), 1, MAX_uint16);
+	DeltaTimeRemainder = FMath::Max(DeltaTimeRemainder - Quantized * P3DNet::DeltaTimeUnit, 0.f);
+
+	OutInput.DeltaTimeQ = static_cast<uint16>(Quantized);
+	OutInput.Seq = NextSeq++;
+}
+
+void UP3DNetMovementComponent::SendPendingMoves()
+{
+	if (PendingMoves.Num() == 0) return;
+
+	const int32 Redundant = FMath::Clamp(CVarNetRedundantMoves.GetValueOnGameThread(), 0, FP3DNetMoveBatch::MaxMoves - 1);
+	const int32 NumToSend = FMath::Min(PendingMoves.Num(), 1 + Redundant);
+
+	FP3DNetMoveBatch Batch;
+	for (int32 i = PendingMoves.Num() - NumToSend; i < PendingMoves.Num(); ++i)
+	{
+		Batch.Moves.Add(PendingMoves[i].Input);
+	}
+
+	ServerMove(Batch);
+}
+
+void UP3DNetMovementComponent::Reconcile(IP3DNetMovementPawn& NetPawn)
+{
+	const FP3DNetMoveState& Server = ServerState.State;
+
+	// 서버 순간이동: 예측 기록은 의미 없음 → 서버 상태로 바로
+	if (ServerState.TeleportId != LastTeleportId)
+	{
+		LastTeleportId = ServerState.TeleportId;
+
+		FP3DNetMoveState Snapped;
+		NetPawn.NetSaveState(Snapped);
+		Snapped.CopyReplicatedFrom(Server);
+		NetPawn.NetRestoreState(Snapped);
+
+		PendingMoves.Reset();
+		return;
+	}
+
+	const uint16 Ack = ServerAckSeq;
+
+	// 서버가 아직 이번 예측 구간의 입력을 처리하지 않음(빙의 직후 등)
+	if (PendingMoves.Num() > 0 && P3DNet::IsNewerSeq(PendingMoves[0].Input.Seq, Ack))
+	{
+		return;
+	}
+
+	// 확인된 입력까지 정리, 비교 기준은 확인된 입력 직후의 예측 상태
+	int32 NumAcked = 0;
+	while (NumAcked < PendingMoves.Num() && !P3DNet::IsNewerSeq(PendingMoves[NumAcked].Input.Seq, Ack))
+	{
+		++NumAcked;
+	}
+
+	FP3DNetMoveState Expected;
+	if (NumAcked > 0 && PendingMoves[NumAcked - 1].Input.Seq == Ack)
+	{
+		Expected = PendingMoves[NumAcked - 1].State;
+	}
+	else if (NumAcked == PendingMoves.Num())
+	{
+		// 남은 예측이 없으면 현재 상태와 비교
+		NetPawn.NetSaveState(Expected);
+	}
+	else
+	{
+		PendingMoves.RemoveAt(0, NumAcked, EAllowShrinking::No);
+		return;
+	}
+
+	PendingMoves.RemoveAt(0, NumAcked, EAllowShrinking::No);
+
+	const float LocationError = FVector::Dist(Expected.Location, Server.Location);
+	const bool bMismatch = LocationError > CVarNetCorrectionTolerance.GetValueOnGameThread()
+		|| FMath::Abs(Expected.VerticalVelocity - Server.VerticalVelocity) > VerticalVelocityTolerance
+		|| Expected.bGrounded != Server.bGrounded;
+
+	if (!bMismatch) return;
+
+	// 서버 상태로 되감고(로컬 전용 값은 예측 기록 것) 아직 확인 안 된 입력 재적용
+	FP3DNetMoveState Corrected = Expected;
+	Corrected.CopyReplicatedFrom(Server);
+	NetPawn.NetRestoreState(Corrected);
+
+	for (FSavedMove& Move : PendingMoves)
+	{
+		NetPawn.NetSimulateMove(Move.Input);
+		NetPawn.NetSaveState(Move.State);
+	}
+
+	++NumCorrections;
+	++P3DCounters::NetCorrections;
+	P3DCounters::NetReplayedMoves += PendingMoves.Num();
+
+	INC_DWORD_STAT(STAT_P3D_NetCorrections);
+	INC_DWORD_STAT_BY(STAT_P3D_NetReplayedMoves, PendingMoves.Num());
+	SET_FLOAT_STAT(STAT_P3D_NetLastCorrectionCm, LocationError);
+}
+
+void UP3DNetMovementComponent::ResetPrediction()
+{
+	PendingMoves.Reset();
+	bPendingReconcile = false;
+	DeltaTimeRemainder = 0.f;
+}
+
+// 서버
+
+void UP3DNetMovementComponent::ServerMove_Implementation(const FP3DNetMoveBatch& Batch)
+{
+	IP3DNetMovementPawn* NetPawn = GetNetPawn();
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	if (!NetPawn || !Pawn) return;
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// 다른 컨트롤러가 빙의했으면 시퀀스/시간 예산 새로 시작
+	AController* Controller = Pawn->GetController();
+	if (LastMoveController.Get() != Controller)
+	{
+		LastMoveController = Controller;
+		bHasProcessedMove = false;
+		TimeDiscrepancy = 0.0;
+		LastServerMoveTime = Now;
+	}
+
+	// 시간 예산(CMC ProcessClientTimeStampForTimeDiscrepancy와 같은 역할)
+	// 클라 dt 합 - 서버 경과 시간: 양수 = 클라가 서버보다 시간을 많이 씀(시계 가속/스피드핵)
+	// 서버 시간이 흐른 만큼 갚고, 늦게 몰려온 입력을 따라잡을 여유는 Credit까지만 쌓음
+	const float MaxDiscrepancy = CVarNetMaxTimeDiscrepancy.GetValueOnGameThread();
+	const bool bCheckTime = MaxDiscrepancy > 0.f;
+	TimeDiscrepancy -= Now - LastServerMoveTime;
+	TimeDiscrepancy = FMath::Max(TimeDiscrepancy, -double(FMath::Max(CVarNetTimeDiscrepancyCredit.GetValueOnGameThread(), 0.f)));
+	LastServerMoveTime = Now;
+
+	const uint16 MaxDeltaTimeQ = static_cast<uint16>(FMath::Clamp(
+		FMath::FloorToInt32(FMath::Max(CVarNetMaxMoveDeltaTime.GetValueOnGameThread(), 0.01f) / P3DNet::DeltaTimeUnit), 1, MAX_uint16));
+
+	bool bProcessed = false;
+	int32 NumRejected = 0;
+	for (const FP3DNetMoveInput& Move : Batch.Moves)
+	{
+		// 여분으로 다시 온 입력은 건너뜀
+		if (bHasProcessedMove && !P3DNet::IsNewerSeq(Move.Seq, LastProcessedSeq)) continue;
+
+		FP3DNetMoveInput Clamped = Move;
+		Clamped.DeltaTimeQ = FMath::Clamp<uint16>(Move.DeltaTimeQ, 1, MaxDeltaTimeQ);
+
+		// 예산 초과: 시뮬 없이 처리한 것으로만 넘김 → 클라 예측과 서버 상태가 달라져서 보정됨
+		const float MoveDeltaTime = Clamped.GetDeltaTime();
+		if (bCheckTime && TimeDiscrepancy + MoveDeltaTime > MaxDiscrepancy)
+		{
+			++NumRejected;
+		}
+		else
+		{
+			TimeDiscrepancy += MoveDeltaTime;
+			NetPawn->NetSimulateMove(Clamped);
+		}
+
+		LastProcessedSeq = Move.Seq;
+		bHasProcessedMove = true;
+		bProcessed = true;
+	}
+
+	if (NumRejected > 0)
+	{
+		P3DCounters::NetRejectedMoves += NumRejected;
+		INC_DWORD_STAT_BY(STAT_P3D_NetRejectedMoves, NumRejected);
+	}
+
+	if (bProcessed)
+	{
+		ServerAckSeq = LastProcessedSeq;
+		PublishState();
+	}
+}
+
+void UP3DNetMovementComponent::PublishState()
+{
+	if (const IP3DNetMovementPawn* NetPawn = GetNetPawn())
+	{
+		NetPawn->NetSaveState(ServerState.State);
+	}
+}
+
+// 클라: 수신
+
+void UP3DNetMovementComponent::OnRep_ServerState()
+{
+	const ENetRole Role = GetOwnerRole();
+
+	if (Role == ROLE_AutonomousProxy)
+	{
+		bPendingReconcile = true;
+		return;
+	}
+
+	if (Role != ROLE_SimulatedProxy) return;
+
+	// 순간이동이면 보간하지 않고 새 위치부터
+	if (ServerState.TeleportId != LastTeleportId)
+	{
+		LastTeleportId = ServerState.TeleportId;
+		ProxySamples.Reset();
+	}
+
+	FProxySample& Sample = ProxySamples.AddDefaulted_GetRef();
+	Sample.Time = GetWorld()->GetTimeSeconds();
+	Sample.Location = ServerState.State.Location;
+	Sample.Rotation = ServerState.State.Rotation.Quaternion();
+
+	if (ProxySamples.Num() > MaxProxySamples)
+	{
+		ProxySamples.RemoveAt(0, ProxySamples.Num() - MaxProxySamples, EAllowShrinking::No);
+	}
+}
+
+void UP3DNetMovementComponent::OnRep_ServerAckSeq()
+{
+	// 가만히 있어서 상태가 안 바뀌어도 확인된 입력은 정리
+	if (GetOwnerRole() == ROLE_AutonomousProxy)
+	{
+		bPendingReconcile = true;
+	}
+}
+
+// 시뮬 프록시: 보간
+
+void UP3DNetMovementComponent::TickSimulatedProxy(IP3DNetMovementPawn& NetPawn, float DeltaTime)
+{
+	if (ProxySamples.Num() == 0) return;
+
+	const double RenderTime = GetWorld()->GetTimeSeconds() - FMath::Max(CVarNetProxyInterpDelay.GetValueOnGameThread(), 0.f);
+
+	// 렌더 시점을 감싸는 두 샘플만 남김
+	int32 NumExpired = 0;
+	while (NumExpired + 1 < ProxySamples.Num() && ProxySamples[NumExpired + 1].Time <= RenderTime)
+	{
+		++NumExpired;
+	}
+	if (NumExpired > 0)
+	{
+		ProxySamples.RemoveAt(0, NumExpired, EAllowShrinking::No);
+	}
+
+	const FProxySample& From = ProxySamples[0];
+
+	FVector Location = From.Location;
+	FQuat Rotation = From.Rotation;
+
+	// 다음 샘플이 없으면 마지막 값 유지(외삽 없음)
+	if (ProxySamples.Num() >= 2 && From.Time <= RenderTime)
+	{
+		const FProxySample& To = ProxySamples[1];
+		const double Span = To.Time - From.Time;
+		const float Alpha = (Span > UE_DOUBLE_KINDA_SMALL_NUMBER) ? static_cast<float>(FMath::Clamp((RenderTime - From.Time) / Span, 0.0, 1.0)) : 1.f;
+
+		Location = FMath::Lerp(From.Location, To.Location, Alpha);
+		Rotation = FQuat::Slerp(From.Rotation, To.Rotation, Alpha);
+	}
+
+	NetPawn.NetApplyProxyTransform(Location, Rotation.Rotator(), DeltaTime);
+}
@@ -0,0 +1,52 @@
+﻿#include "P3DPawnAnimInstance.h"
+
+#include "BasePawn.h"
+
+// ===== Proxy =====
+
+void FP3DPawnAnimInstanceProxy::InitializeObjects(UAnimInstance* InAnimInstance)
+{
+	FAnimInstanceProxy::InitializeObjects(InAnimInstance);
+
+	Pawn = Cast<ABasePawn>(InAnimInstance->TryGetPawnOwner());
+}
+
+void FP3DPawnAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	// 게임 스레드: 여기서만 Pawn을 읽음
+	if (const ABasePawn* Owner = Pawn.Get())
+	{
+		Snapshot.bIsMoving = Owner->bIsMoving;
+		Snapshot.Speed2D = Owner->CurrentSpeed2D;
+		Snapshot.bWantsInteract = Owner->bWantsInteract;
+		Snapshot.bIsInteracting = Owner->bIsInteracting;
+	}
+	else
+	{
+		Snapshot = FP3DPawnAnimSnapshot();
+	}
+}
+
+void FP3DPawnAnimInstanceProxy::ClearObjects()
+{
+	FAnimInstanceProxy::ClearObjects();
+
+	Pawn.Reset();
+}
+
+// ===== AnimInstance =====
+
+void UP3DPawnAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	// 워커 스레드 가능: 프록시 스냅샷만 사용
+	const FP3DPawnAnimSnapshot& Snapshot = GetProxyOnAnyThread<FP3DPawnAnimInstanceProxy>().GetSnapshot();
+
+	bIsMoving = Snapshot.bIsMoving;
+	CurrentSpeed2D = Snapshot.Speed2D;
+	bWantsInteract = Snapshot.bWantsInteract;
+	bIsInteracting = Snapshot.bIsInteracting;
+}
@@ -5,7 +5,47 @@
 #include "EnhancedInputSubsystems.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
 #include "DronePawn.h"
+#include "P3DStreamingSource.h"
+#include "P3DMassPopulationSubsystem.h"
+#include "P3DProfiling.h"
+#include "Misc/ScopeExit.h"
+
+static TAutoConsoleVariable<int32> CVarDroneAsyncPreload(
+    TEXT("p3d.Drone.AsyncPreload"),
+    1,
+    TEXT("1: Interact 시작 때 드론 클래스/메시 비동기 로드(기본)\n")
+    TEXT("0: BeginPlay에서 동기 로드 + 풀 미리 생성(기존 방식, 메모리/히치 비교용)"),
+    ECVF_Default);
+
+// p3d.Swarm.Formation Line|Wedge|Sphere [Spacing]
+static FAutoConsoleCommandWithWorldAndArgs CmdSwarmFormation(
+    TEXT("p3d.Swarm.Formation"),
+    TEXT("군집 대형 변경: p3d.Swarm.Formation Line|Wedge|Sphere [Spacing]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World || Args.Num() == 0) return;
+
+        const int64 Value = StaticEnum<EDroneFormation>()->GetValueByNameString(Args[0]);
+        if (Value == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[PC] Unknown formation: %s"), *Args[0]);
+            return;
+        }
+
+        for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+        {
+            if (AP3DPlayerController* PC = Cast<AP3DPlayerController>(It->Get()))
+            {
+                const float Spacing = Args.Num() > 1 ? FCString::Atof(*Args[1]) : PC->SwarmSpacing;
+                PC->SetSwarmFormation(static_cast<EDroneFormation>(Value), Spacing);
+            }
+        }
+    }));
 
 AP3DPlayerController::AP3DPlayerController()
     :
@@ -26,6 +66,28 @@ void AP3DPlayerController::BeginPlay()
     Super::BeginPlay();
     // 시작 IMC는 Ground로 (Pawn 캐시는 OnPossess에서 확정)
     ApplyIMC(PawnInputMappingContext);
+
+    // 비동기 미리 로드를 끄면 기존처럼 시작할 때 전부 로드
+    // (켜면 풀은 에셋 로드가 끝난 뒤 OnDroneAssetsLoaded에서 채움)
+    if (CVarDroneAsyncPreload.GetValueOnGameThread() == 0 && !DronePawnClass.IsNull())
+    {
+        DroneLoadStartSeconds = FPlatformTime::Seconds();
+        DroneLoadStartUsedMemory = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+
+        if (UClass* DroneClass = DronePawnClass.LoadSynchronous())
+        {
+            if (const ADronePawn* DroneCDO = DroneClass->GetDefaultObject<ADronePawn>())
+            {
+                DroneCDO->DroneMesh.LoadSynchronous();
+            }
+        }
+        OnDroneAssetsLoaded();
+    }
+    else if (DronePawnClass.Get())
+    {
+        // 이미 메모리에 있음(에디터/다른 경로에서 로드) → 첫 토글 히치 방지: 드론을 미리 만들어 꺼둠
+        PrewarmDronePool();
+    }
 }
 
 void AP3DPlayerController::OnPossess(APawn* InPawn)
@@ -34,6 +96,8 @@ void AP3DPlayerController::OnPossess(APawn* InPawn)
 
     if (!InPawn) return;
 
+    P3DCounters::AddPossessionSwitch();
+
     // 드론을 잡았으면 Drone IMC
     if (InPawn->IsA(ADronePawn::StaticClass()))
     {
@@ -46,8 +110,20 @@ void AP3DPlayerController::OnPossess(APawn* InPawn)
     ApplyIMC(PawnInputMappingContext);
 }
 
+void AP3DPlayerController::AcknowledgePossession(APawn* P)
+{
+    Super::AcknowledgePossession(P);
+
+    // 서버(리슨 서버 호스트 포함)는 OnPossess에서 이미 처리
+    if (!P || HasAuthority()) return;
+
+    ApplyIMC(P->IsA(ADronePawn::StaticClass()) ? DroneInputMappingContext : PawnInputMappingContext);
+}
+
 void AP3DPlayerController::ApplyIMC(UInputMappingContext* IMC)
 {
+    P3D_SCOPE(ApplyIMC);
+
     ULocalPlayer* LocalPlayer = GetLocalPlayer();
     if (!LocalPlayer) return;
 
@@ -55,6 +131,28 @@ void AP3DPlayerController::ApplyIMC(UInputMappingContext* IMC)
         LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>();
     if (!Subsystem) return;
 
+    if (bPreBindInputContexts)
+    {
+        // 등록은 처음 한 번, 이후 전환은 빙의 쪽 IMC 우선순위만 올림
+        if (!bContextsPreBound)
+        {
+            PreBindInputContexts(*Subsystem);
+        }
+
+        if (IMC != ActiveIMC)
+        {
+            FModifyContextOptions Options;
+            Options.bIgnoreAllPressedKeysUntilRelease = false;
+
+            // 이미 등록된 컨텍스트에 Add = 우선순위만 갱신(같은 프레임 변경은 재구성 한 번)
+            if (ActiveIMC) Subsystem->AddMappingContext(ActiveIMC, InputContextPriority, Options);
+            if (IMC)       Subsystem->AddMappingContext(IMC, InputContextPriority + 1, Options);
+
+            ActiveIMC = IMC;
+        }
+        return;
+    }
+
     //  관리하는 2개 컨텍스트만 정리
     if (PawnInputMappingContext)  Subsystem->RemoveMappingContext(PawnInputMappingContext);
     if (DroneInputMappingContext) Subsystem->RemoveMappingContext(DroneInputMappingContext);
@@ -64,11 +162,28 @@ void AP3DPlayerController::ApplyIMC(UInputMappingContext* IMC)
         // Priority 0 = 가장 높은 우선순위로 쓰는 편
         Subsystem->AddMappingContext(IMC, 0);
     }
+
+    ActiveIMC = IMC;
+    bContextsPreBound = false;
+}
+
+void AP3DPlayerController::PreBindInputContexts(UEnhancedInputLocalPlayerSubsystem& Subsystem)
+{
+    // 둘 다 낮은 우선순위로 등록 → 바로 이어지는 ApplyIMC가 빙의 쪽만 +1
+    ActiveIMC = nullptr;
+
+    FModifyContextOptions Options;
+    Options.bIgnoreAllPressedKeysUntilRelease = false;
+
+    if (PawnInputMappingContext)  Subsystem.AddMappingContext(PawnInputMappingContext, InputContextPriority, Options);
+    if (DroneInputMappingContext) Subsystem.AddMappingContext(DroneInputMappingContext, InputContextPriority, Options);
+
+    bContextsPreBound = true;
 }
 
 ADronePawn* AP3DPlayerController::SpawnDroneNear(APawn* PlayerPawn)
 {
-    if (!IsValid(PlayerPawn) || !DronePawnClass) return nullptr;
+    if (!IsValid(PlayerPawn) || !DronePawnClass.Get()) return nullptr;
 
     UWorld* World = GetWorld();
     if (!World) return nullptr;
@@ -79,15 +194,352 @@ ADronePawn* AP3DPlayerController::SpawnDroneNear(APawn* PlayerPawn)
     const FVector SpawnLoc = BaseLoc + Fwd * 200.f + FVector(0, 0, 120.f);
     const FRotator SpawnRot = PlayerPawn->GetActorRotation();
 
+    // 근처 Mass 드론이 있으면 그대로 승격해서 사용(멀어지면 다시 엔티티로)
+    if (bPossessMassDrones)
+    {
+        if (UP3DMassPopulationSubsystem* Population = World->GetSubsystem<UP3DMassPopulationSubsystem>())
+        {
+            if (ADronePawn* MassDrone = Cast<ADronePawn>(Population->PromoteNearest(BaseLoc, true, MassDroneSearchRadius)))
+            {
+                bCachedDroneFromMass = true;
+                return MassDrone;
+            }
+        }
+    }
+
+    // 풀 사용 시: 대기 중인 드론을 그 위치로 옮겨서 활성화
+    if (bUseDronePool)
+    {
+        return AcquireDrone(SpawnLoc, SpawnRot);
+    }
+
     FActorSpawnParameters Params;
     Params.Owner = this;
     Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-    return World->SpawnActor<ADronePawn>(DronePawnClass, SpawnLoc, SpawnRot, Params);
+    return World->SpawnActor<ADronePawn>(DronePawnClass.Get(), SpawnLoc, SpawnRot, Params);
+}
+
+// Drone Pool
+
+void AP3DPlayerController::PrewarmDronePool()
+{
+    if (!bUseDronePool || !DronePawnClass.Get() || !HasAuthority()) return;
+
+    const int32 TargetSize = DronePoolSize + (bSwarmMode ? SwarmFollowerCount : 0);
+    while (DronePool.Num() < TargetSize)
+    {
+        ADronePawn* Drone = SpawnPooledDrone();
+        if (!Drone) break;
+
+        DronePool.Add(Drone);
+    }
+}
+
+ADronePawn* AP3DPlayerController::SpawnPooledDrone()
+{
+    UWorld* World = GetWorld();
+    if (!World || !DronePawnClass.Get()) return nullptr;
+
+    // 위치는 활성화할 때 다시 잡으므로 충돌 검사 없이 생성
+    FActorSpawnParameters Params;
+    Params.Owner = this;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    ADronePawn* Drone = World->SpawnActor<ADronePawn>(DronePawnClass.Get(), FVector::ZeroVector, FRotator::ZeroRotator, Params);
+    if (Drone)
+    {
+        Drone->DeactivateToPool();
+    }
+    return Drone;
+}
+
+ADronePawn* AP3DPlayerController::AcquireDrone(const FVector& Location, const FRotator& Rotation)
+{
+    ADronePawn* Drone = nullptr;
+
+    while (!Drone && DronePool.Num() > 0)
+    {
+        ADronePawn* Candidate = DronePool.Pop(EAllowShrinking::No);
+        if (IsValid(Candidate)) Drone = Candidate;
+    }
+
+    // 풀이 비었으면 하나 더 만듦(풀 크기 부족 → 로그로 알림)
+    if (!Drone)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[PC] Drone pool empty -> spawning extra drone (DronePoolSize=%d)"), DronePoolSize);
+        Drone = SpawnPooledDrone();
+    }
+
+    if (Drone)
+    {
+        Drone->ActivateFromPool(Location, Rotation);
+    }
+    return Drone;
+}
+
+void AP3DPlayerController::ReleaseDrone(ADronePawn* Drone)
+{
+    if (!IsValid(Drone)) return;
+
+    Drone->DeactivateToPool();
+    DronePool.AddUnique(Drone);
+}
+
+// Drone Swarm
+
+void AP3DPlayerController::SpawnSwarm(ADronePawn* Leader)
+{
+    UDroneSwarmSubsystem* Swarm = GetWorld() ? GetWorld()->GetSubsystem<UDroneSwarmSubsystem>() : nullptr;
+    if (!Swarm || !IsValid(Leader) || SwarmFollowerCount <= 0) return;
+
+    ReleaseSwarm();
+
+    SwarmId = Swarm->CreateSwarm(Leader, SwarmFormation, SwarmSpacing);
+    if (SwarmId == INDEX_NONE) return;
+
+    // 처음부터 슬롯 자리에 놓아서 모이는 동안 겹치지 않게
+    const FRotator SpawnRot(0.f, Leader->GetActorRotation().Yaw, 0.f);
+    const FTransform LeaderFrame(SpawnRot, Leader->GetActorLocation());
+
+    SwarmFollowers.Reserve(SwarmFollowerCount);
+    for (int32 Slot = 0; Slot < SwarmFollowerCount; ++Slot)
+    {
+        const FVector Offset = UDroneSwarmSubsystem::ComputeSlotOffset(SwarmFormation, Slot, SwarmFollowerCount, SwarmSpacing);
+        const FVector SpawnLoc = LeaderFrame.TransformPosition(Offset);
+
+        ADronePawn* Follower = nullptr;
+        if (bUseDronePool)
+        {
+            Follower = AcquireDrone(SpawnLoc, SpawnRot);
+        }
+        else
+        {
+            FActorSpawnParameters Params;
+            Params.Owner = this;
+            Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+            Follower = GetWorld()->SpawnActor<ADronePawn>(DronePawnClass.Get(), SpawnLoc, SpawnRot, Params);
+        }
+        if (!Follower) continue;
+
+        Swarm->AddFollower(SwarmId, Follower);
+        SwarmFollowers.Add(Follower);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("[PC] Swarm %d: %d followers (%s)"), SwarmId, SwarmFollowers.Num(),
+        *StaticEnum<EDroneFormation>()->GetNameStringByValue(int64(SwarmFormation)));
+}
+
+void AP3DPlayerController::ReleaseSwarm()
+{
+    if (UDroneSwarmSubsystem* Swarm = GetWorld() ? GetWorld()->GetSubsystem<UDroneSwarmSubsystem>() : nullptr)
+    {
+        Swarm->DestroySwarm(SwarmId);
+    }
+    SwarmId = INDEX_NONE;
+
+    for (ADronePawn* Follower : SwarmFollowers)
+    {
+        if (!IsValid(Follower)) continue;
+
+        if (bUseDronePool)
+        {
+            ReleaseDrone(Follower);
+        }
+        else
+        {
+            Follower->Destroy();
+        }
+    }
+    SwarmFollowers.Reset();
+}
+
+void AP3DPlayerController::SetSwarmFormation(EDroneFormation Formation, float Spacing)
+{
+    SwarmFormation = Formation;
+    SwarmSpacing = FMath::Max(Spacing, 1.f);
+
+    if (UDroneSwarmSubsystem* Swarm = GetWorld() ? GetWorld()->GetSubsystem<UDroneSwarmSubsystem>() : nullptr)
+    {
+        Swarm->SetFormation(SwarmId, SwarmFormation, SwarmSpacing);
+    }
+}
+
+// World Partition 스트리밍 소스
+
+void AP3DPlayerController::GetStreamingSourceLocationAndRotation(FVector& OutLocation, FRotator& OutRotation) const
+{
+    // 회전은 카메라 그대로(셀 로드 우선순위를 보는 방향 기준으로)
+    Super::GetStreamingSourceLocationAndRotation(OutLocation, OutRotation);
+
+    // 드론 스프링암 카메라는 Pawn 뒤쪽이라 Pawn 위치가 실제 진행 경로에 가까움
+    if (const APawn* ControlledPawn = GetPawn())
+    {
+        OutLocation = ControlledPawn->GetActorLocation();
+    }
+}
+
+void AP3DPlayerController::GetStreamingSourceShapes(TArray<FStreamingSourceShape>& OutShapes) const
+{
+    const int32 NumBefore = OutShapes.Num();
+    if (const IP3DStreamingSourcePawn* SourcePawn = Cast<IP3DStreamingSourcePawn>(GetPawn()))
+    {
+        SourcePawn->GetStreamingShapes(OutShapes);
+    }
+
+    if (OutShapes.Num() == NumBefore)
+    {
+        Super::GetStreamingSourceShapes(OutShapes);
+        return;
+    }
+
+    // Pawn은 월드 축 오프셋으로 줌 → 소스 회전 기준 로컬로
+    FVector SourceLocation;
+    FRotator SourceRotation;
+    GetStreamingSourceLocationAndRotation(SourceLocation, SourceRotation);
+
+    for (int32 i = NumBefore; i < OutShapes.Num(); ++i)
+    {
+        OutShapes[i].Location = SourceRotation.UnrotateVector(OutShapes[i].Location);
+    }
+}
+
+// Drone Asset Loading
+
+void AP3DPlayerController::PreloadDroneAssets()
+{
+    if (!HasAuthority())
+    {
+        ServerPreloadDroneAssets();
+    }
+
+    RequestDroneClassLoad();
+}
+
+void AP3DPlayerController::ServerPreloadDroneAssets_Implementation()
+{
+    RequestDroneClassLoad();
+}
+
+void AP3DPlayerController::RequestDroneClassLoad()
+{
+    if (DronePawnClass.IsNull() || bDroneAssetsLoaded || DroneClassHandle.IsValid()) return;
+
+    DroneLoadStartSeconds = FPlatformTime::Seconds();
+    DroneLoadStartUsedMemory = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+
+    DroneClassHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        DronePawnClass.ToSoftObjectPath(),
+        FStreamableDelegate::CreateUObject(this, &AP3DPlayerController::OnDroneClassLoaded),
+        FStreamableManager::AsyncLoadHighPriority);
+
+    if (!DroneClassHandle.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[PC] Drone class load request failed: %s"), *DronePawnClass.ToString());
+    }
+}
+
+bool AP3DPlayerController::RequestDroneMeshLoad()
+{
+    if (DroneMeshHandle.IsValid()) return !DroneMeshHandle->HasLoadCompleted();
+
+    const UClass* DroneClass = DronePawnClass.Get();
+    const ADronePawn* DroneCDO = DroneClass ? DroneClass->GetDefaultObject<ADronePawn>() : nullptr;
+    if (!DroneCDO || DroneCDO->DroneMesh.IsNull() || DroneCDO->DroneMesh.Get()) return false;
+
+    DroneMeshHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        DroneCDO->DroneMesh.ToSoftObjectPath(),
+        FStreamableDelegate::CreateUObject(this, &AP3DPlayerController::OnDroneAssetsLoaded),
+        FStreamableManager::AsyncLoadHighPriority);
+
+    return DroneMeshHandle.IsValid();
+}
+
+void AP3DPlayerController::OnDroneClassLoaded()
+{
+    // 클래스가 먼저 있어야 CDO에서 메시 경로를 알 수 있음 → 두 단계
+    if (!RequestDroneMeshLoad())
+    {
+        OnDroneAssetsLoaded();
+    }
+}
+
+void AP3DPlayerController::OnDroneAssetsLoaded()
+{
+    if (bDroneAssetsLoaded || !DronePawnClass.Get()) return;
+    bDroneAssetsLoaded = true;
+
+    const float LoadMs = static_cast<float>((FPlatformTime::Seconds() - DroneLoadStartSeconds) * 1000.0);
+    const int64 MemoryDelta = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - DroneLoadStartUsedMemory;
+    const float MemoryMB = static_cast<float>(MemoryDelta / (1024.0 * 1024.0));
+
+    SET_FLOAT_STAT(STAT_P3D_DroneAssetLoadMs, LoadMs);
+    SET_FLOAT_STAT(STAT_P3D_DroneAssetMemoryMB, MemoryMB);
+    UE_LOG(LogTemp, Log, TEXT("[PC] Drone assets loaded %.2f ms, ~%.1f MB (%s)"), LoadMs, MemoryMB,
+        bToggleWhenDroneLoaded ? TEXT("late: toggle deferred") : TEXT("before toggle"));
+
+    PrewarmDronePool();
+
+    if (bToggleWhenDroneLoaded)
+    {
+        bToggleWhenDroneLoaded = false;
+
+        const float WaitMs = static_cast<float>((FPlatformTime::Seconds() - LateToggleStartSeconds) * 1000.0);
+        SET_FLOAT_STAT(STAT_P3D_DroneLateLoadWaitMs, WaitMs);
+
+        ToggleDrone();
+    }
+}
+
+bool AP3DPlayerController::HandleLateDroneLoad()
+{
+    // Interact 없이 토글된 경우(벤치마크/콘솔 등)는 여기서 요청 시작
+    RequestDroneClassLoad();
+
+    if (!bBlockOnLateDroneLoad)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[PC] Drone assets not loaded by interact end -> toggle deferred"));
+        bToggleWhenDroneLoaded = true;
+        LateToggleStartSeconds = FPlatformTime::Seconds();
+        return false;
+    }
+
+    const double WaitStart = FPlatformTime::Seconds();
+
+    if (DroneClassHandle.IsValid())
+    {
+        DroneClassHandle->WaitUntilComplete();
+    }
+    if (RequestDroneMeshLoad())
+    {
+        DroneMeshHandle->WaitUntilComplete();
+    }
+    OnDroneAssetsLoaded();
+
+    const float WaitMs = static_cast<float>((FPlatformTime::Seconds() - WaitStart) * 1000.0);
+    SET_FLOAT_STAT(STAT_P3D_DroneLateLoadWaitMs, WaitMs);
+    UE_LOG(LogTemp, Warning, TEXT("[PC] Drone assets not loaded by interact end -> blocked %.2f ms"), WaitMs);
+
+    return DronePawnClass.Get() != nullptr;
 }
 
 void AP3DPlayerController::ToggleDrone()
 {
+    if (!HasAuthority())
+    {
+        ServerToggleDrone();
+        return;
+    }
+
+    P3D_SCOPE(ToggleDrone);
+    const double StartTime = FPlatformTime::Seconds();
+
+    ON_SCOPE_EXIT
+    {
+        const float ToggleMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+        SET_FLOAT_STAT(STAT_P3D_LastToggleMs, ToggleMs);
+    };
+
     APawn* CurrentPawn = GetPawn();
     if (!IsValid(CurrentPawn)) return;
 
@@ -97,15 +549,25 @@ void AP3DPlayerController::ToggleDrone()
         if (!IsValid(CachedPlayerPawn))
             CachedPlayerPawn = CurrentPawn;
 
-        if (!DronePawnClass)
+        if (DronePawnClass.IsNull())
         {     
             return;
         }
+        // 보통은 Interact 애니 동안 로드가 끝나 있음(아니면 대기 또는 전환 지연)
+        if (!bDroneAssetsLoaded && !HandleLateDroneLoad())
+        {
+            return;
+        }
         if (!IsValid(CachedDronePawn))
             CachedDronePawn = SpawnDroneNear(CachedPlayerPawn);
         if (IsValid(CachedDronePawn))
         {
             Possess(CachedDronePawn);
+
+            if (bSwarmMode)
+            {
+                SpawnSwarm(CachedDronePawn);
+            }
         }
         return;
     }
@@ -114,16 +576,43 @@ void AP3DPlayerController::ToggleDrone()
     ReturnToPlayer();
 }
 
+void AP3DPlayerController::ServerToggleDrone_Implementation()
+{
+    ToggleDrone();
+}
+
 void AP3DPlayerController::ReturnToPlayer()
 {
+    if (!HasAuthority())
+    {
+        ServerReturnToPlayer();
+        return;
+    }
+
     if (!IsValid(CachedPlayerPawn)) return;
 
     Possess(CachedPlayerPawn);
 
+    ReleaseSwarm();
  
-    if (IsValid(CachedDronePawn))
+    // Mass에서 승격된 드론은 빙의만 풀고 강등은 거리 판정에 맡김
+    if (IsValid(CachedDronePawn) && !bCachedDroneFromMass)
     {
-        CachedDronePawn->Destroy();
-        CachedDronePawn = nullptr;
+        // 풀 사용 시 파괴 대신 비활성화해서 반납
+        if (bUseDronePool)
+        {
+            ReleaseDrone(CachedDronePawn);
+        }
+        else
+        {
+            CachedDronePawn->Destroy();
+        }
     }
+    CachedDronePawn = nullptr;
+    bCachedDroneFromMass = false;
+}
+
+void AP3DPlayerController::ServerReturnToPlayer_Implementation()
+{
+    ReturnToPlayer();
 }
@@ -0,0 +1,162 @@
+﻿#include "P3DProfiling.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(Pawn3D, true);
+
+static int32 GP3DScopeHistogram = 1;
+static FAutoConsoleVariableRef CVarP3DScopeHistogram(
+	TEXT("p3d.Profile.Histogram"),
+	GP3DScopeHistogram,
+	TEXT("Pawn 핫패스 함수별 롤링 히스토그램 기록(p3d.Profile.Dump)"),
+	ECVF_Default);
+
+namespace
+{
+	// 함수별 최근 샘플(us) 롤링 윈도우
+	constexpr int32 WindowSize = 1024;
+
+	// 히스토그램 구간: [0,1) [1,2) [2,4) ... us, 마지막은 그 이상
+	constexpr int32 NumBuckets = 14;
+
+	const TCHAR* ScopeNames[] =
+	{
+		TEXT("BasePawnTick"),
+		TEXT("PawnMove"),
+		TEXT("DroneActorTick"),
+		TEXT("DroneBatchTick"),
+		TEXT("DroneTickRotation"),
+		TEXT("DroneTickVertical"),
+		TEXT("DroneProbeGround"),
+		TEXT("MassPawnMove"),
+		TEXT("MassDroneMove"),
+		TEXT("MassLOD"),
+		TEXT("RollbackResim"),
+		TEXT("ToggleDrone"),
+		TEXT("ApplyIMC"),
+	};
+	static_assert(UE_ARRAY_COUNT(ScopeNames) == (int32)EP3DScope::Count, "ScopeNames must match EP3DScope");
+
+	struct FScopeWindow
+	{
+		float SamplesUs[WindowSize] = {};
+		int32 Next = 0;
+		int32 Num = 0;
+		uint64 TotalCalls = 0;
+	};
+
+	FScopeWindow Windows[(int32)EP3DScope::Count];
+
+	// 프레임 카운터 직전 값(차이 = 이번 프레임)
+	uint64 LastSceneQueries = 0;
+	uint64 LastOffsets = 0;
+	uint64 LastPossessionSwitches = 0;
+
+	void OnEndFrame()
+	{
+		const uint64 Sweeps = P3DCounters::SceneQueries - LastSceneQueries;
+		const uint64 Offsets = P3DCounters::Offsets - LastOffsets;
+		const uint64 Switches = P3DCounters::PossessionSwitches - LastPossessionSwitches;
+
+		LastSceneQueries = P3DCounters::SceneQueries;
+		LastOffsets = P3DCounters::Offsets;
+		LastPossessionSwitches = P3DCounters::PossessionSwitches;
+
+		CSV_CUSTOM_STAT(Pawn3D, Sweeps, (int32)Sweeps, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Pawn3D, Offsets, (int32)Offsets, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(Pawn3D, PossessionSwitches, (int32)Switches, ECsvCustomStatOp::Set);
+
+		SET_DWORD_STAT(STAT_P3D_SweepsPerFrame, Sweeps);
+		SET_DWORD_STAT(STAT_P3D_OffsetsPerFrame, Offsets);
+		SET_DWORD_STAT(STAT_P3D_PossessionSwitchesPerFrame, Switches);
+	}
+
+	FDelayedAutoRegisterHelper RegisterEndFrame(EDelayedRegisterRunPhase::EndOfEngineInit, []
+	{
+		FCoreDelegates::OnEndFrame.AddStatic(&OnEndFrame);
+	});
+
+	int32 BucketOf(float Us)
+	{
+		if (Us < 1.f) return 0;
+		return FMath::Min(NumBuckets - 1, 1 + FMath::FloorToInt32(FMath::Log2(Us)));
+	}
+
+	void DumpHistograms(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		Ar.Logf(TEXT("[P3DProfile] window=%d samples/function (us)"), WindowSize);
+
+		for (int32 ScopeIndex = 0; ScopeIndex < (int32)EP3DScope::Count; ++ScopeIndex)
+		{
+			const FScopeWindow& Window = Windows[ScopeIndex];
+			if (Window.Num == 0) continue;
+
+			TArray<float> Sorted(Window.SamplesUs, Window.Num);
+			Sorted.Sort();
+
+			double Sum = 0.0;
+			int32 Buckets[NumBuckets] = {};
+			for (const float Us : Sorted)
+			{
+				Sum += Us;
+				++Buckets[BucketOf(Us)];
+			}
+
+			auto Pct = [&Sorted](float P) { return Sorted[FMath::Clamp(FMath::CeilToInt32(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1)]; };
+
+			Ar.Logf(TEXT("  %-18s calls=%llu avg=%.2f p50=%.2f p95=%.2f p99=%.2f max=%.2f"),
+				ScopeNames[ScopeIndex], Window.TotalCalls, Sum / Sorted.Num(),
+				Pct(0.5f), Pct(0.95f), Pct(0.99f), Sorted.Last());
+
+			FString Line;
+			for (int32 b = 0; b < NumBuckets; ++b)
+			{
+				if (Buckets[b] == 0) continue;
+
+				const int32 Lo = (b == 0) ? 0 : (1 << (b - 1));
+				Line += (b == NumBuckets - 1)
+					? FString::Printf(TEXT(" [%d+]=%d"), Lo, Buckets[b])
+					: FString::Printf(TEXT(" [%d,%d)=%d"), Lo, (b == 0) ? 1 : (1 << b), Buckets[b]);
+			}
+			Ar.Logf(TEXT("   %s"), *Line);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithArgsAndOutputDevice CmdP3DProfileDump(
+	TEXT("p3d.Profile.Dump"),
+	TEXT("Pawn 핫패스 함수별 최근 실행 시간 히스토그램 출력"),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&DumpHistograms));
+
+static FAutoConsoleCommand CmdP3DProfileReset(
+	TEXT("p3d.Profile.Reset"),
+	TEXT("p3d.Profile.Dump 히스토그램 초기화"),
+	FConsoleCommandDelegate::CreateStatic([]
+	{
+		for (FScopeWindow& Window : Windows)
+		{
+			Window = FScopeWindow();
+		}
+	}));
+
+namespace P3DProfiling
+{
+	bool IsHistogramEnabled()
+	{
+		return GP3DScopeHistogram != 0;
+	}
+
+	void RecordScope(EP3DScope Scope, uint64 Cycles)
+	{
+		if (!IsInGameThread()) return;
+
+		FScopeWindow& Window = Windows[(int32)Scope];
+		Window.SamplesUs[Window.Next] = static_cast<float>(FPlatformTime::ToMilliseconds64(Cycles) * 1000.0);
+		Window.Next = (Window.Next + 1) % WindowSize;
+		Window.Num = FMath::Min(Window.Num + 1, WindowSize);
+		++Window.TotalCalls;
+	}
+}
@@ -0,0 +1,411 @@
+﻿#include "P3DReplay.h"
+
+#include "GameFramework/Pawn.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// 청크 크기 / 청크가 덜 차도 넘기는 간격(비정상 종료 시 잃는 양 제한)
+	constexpr int32 ChunkBytes = 64 * 1024;
+	constexpr double MaxSubmitIntervalSeconds = 1.0;
+
+	constexpr uint32 WriterWaitMs = 100;
+}
+
+int32 P3DReplay::GetNumAxes(EP3DReplayInput Input)
+{
+	switch (Input)
+	{
+	case EP3DReplayInput::Move:
+	case EP3DReplayInput::Look:
+		return 2;
+
+	case EP3DReplayInput::UpDown:
+	case EP3DReplayInput::Roll:
+		return 1;
+
+	default:
+		return 0;
+	}
+}
+
+uint32 P3DReplay::ComputeChecksum(const APawn* Pawn, FVector3f& OutLocation)
+{
+	if (!Pawn)
+	{
+		OutLocation = FVector3f::ZeroVector;
+		return 0;
+	}
+
+	FP3DNetMoveState State;
+	if (const IP3DNetMovementPawn* NetPawn = Cast<IP3DNetMovementPawn>(Pawn))
+	{
+		NetPawn->NetSaveState(State);
+	}
+	else
+	{
+		State.Location = Pawn->GetActorLocation();
+		State.Rotation = Pawn->GetActorRotation();
+	}
+
+	OutLocation = FVector3f(State.Location);
+
+	// 실행마다 같은 값이면 같은 해시(주소/포인터 섞지 않음)
+	struct FQuantized
+	{
+		int64 X, Y, Z;
+		uint16 Yaw, Pitch, Roll;
+		uint16 bGrounded;
+		int32 VerticalVelocity;
+		uint32 ClassHash;
+	};
+
+	FQuantized Q;
+	FMemory::Memzero(Q);
+	Q.X = FMath::RoundToInt64(State.Location.X * 100.0);
+	Q.Y = FMath::RoundToInt64(State.Location.Y * 100.0);
+	Q.Z = FMath::RoundToInt64(State.Location.Z * 100.0);
+	Q.Yaw = FRotator::CompressAxisToShort(State.Rotation.Yaw);
+	Q.Pitch = FRotator::CompressAxisToShort(State.Rotation.Pitch);
+	Q.Roll = FRotator::CompressAxisToShort(State.Rotation.Roll);
+	Q.bGrounded = State.bGrounded ? 1 : 0;
+	Q.VerticalVelocity = FMath::RoundToInt32(State.VerticalVelocity * 100.f);
+	Q.ClassHash = FCrc::StrCrc32(*Pawn->GetClass()->GetName());
+
+	return FCrc::MemCrc32(&Q, sizeof(Q));
+}
+
+// ===== 쓰기 =====
+
+FP3DReplayWriter::~FP3DReplayWriter()
+{
+	if (IsOpen())
+	{
+		Close(0);
+	}
+}
+
+bool FP3DReplayWriter::Open(const FString& Path, const FP3DReplayHeader& Header)
+{
+	check(!IsOpen());
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+
+	File.Reset(PlatformFile.OpenWrite(*Path));
+	if (!File) return false;
+
+	bStopping = false;
+	BytesWritten = 0;
+
+	// 청크 두 개로 시작(하나 쓰는 동안 하나 채움), 밀리면 그때 추가
+	for (int32 i = 0; i < 2; ++i)
+	{
+		TUniquePtr<TArray<uint8>>& Chunk = OwnedChunks.Add_GetRef(MakeUnique<TArray<uint8>>());
+		Chunk->Reserve(ChunkBytes + 256);
+		FreeChunks.Enqueue(Chunk.Get());
+	}
+	FreeChunks.Dequeue(Current);
+
+	// ===== 헤더 =====
+	WritePod(P3DReplay::Magic);
+	WritePod(P3DReplay::Version);
+	WritePod(Header.ChecksumInterval);
+
+	const FTCHARToUTF8 MapUtf8(*Header.MapName);
+	const uint16 MapLen = static_cast<uint16>(FMath::Min(MapUtf8.Length(), 0xFFFF));
+	WritePod(MapLen);
+	WriteBytes(MapUtf8.Get(), MapLen);
+
+	WritePod(Header.PawnKind);
+	WritePod(Header.StartState.Location.X);
+	WritePod(Header.StartState.Location.Y);
+	WritePod(Header.StartState.Location.Z);
+	WritePod(Header.StartState.Rotation.Pitch);
+	WritePod(Header.StartState.Rotation.Yaw);
+	WritePod(Header.StartState.Rotation.Roll);
+	WritePod(Header.StartState.VerticalVelocity);
+	WritePod(static_cast<uint8>(Header.StartState.bGrounded ? 1 : 0));
+
+	LastSubmitSeconds = FPlatformTime::Seconds();
+
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("P3DReplayWriter"), 0, TPri_BelowNormal);
+	if (!Thread)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+		File.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FP3DReplayWriter::Close(uint32 NumFrames)
+{
+	if (!IsOpen()) return;
+
+	WritePod(EP3DReplayRecord::End);
+	WritePod(NumFrames);
+	SubmitCurrent();
+
+	bStopping = true;
+	WakeEvent->Trigger();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	// 스레드가 멈춘 뒤 남은 것(있으면) 마저
+	WritePending();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+
+	File->Flush();
+	File.Reset();
+
+	PendingChunks.Empty();
+	FreeChunks.Empty();
+	OwnedChunks.Reset();
+	Current = nullptr;
+}
+
+void FP3DReplayWriter::WriteBytes(const void* Data, int32 Num)
+{
+	check(Current);
+	Current->Append(static_cast<const uint8*>(Data), Num);
+}
+
+void FP3DReplayWriter::WriteFrame(float DeltaTime)
+{
+	WritePod(EP3DReplayRecord::Frame);
+	WritePod(DeltaTime);
+}
+
+void FP3DReplayWriter::WriteInput(EP3DReplayInput Input, const FVector2D& Value)
+{
+	WritePod(EP3DReplayRecord::Input);
+	WritePod(Input);
+
+	const int32 NumAxes = P3DReplay::GetNumAxes(Input);
+	if (NumAxes > 0) WritePod(static_cast<float>(Value.X));
+	if (NumAxes > 1) WritePod(static_cast<float>(Value.Y));
+}
+
+void FP3DReplayWriter::WriteChecksum(uint32 Crc, const FVector3f& Location)
+{
+	WritePod(EP3DReplayRecord::Checksum);
+	WritePod(Crc);
+	WritePod(Location);
+}
+
+void FP3DReplayWriter::FlushIfNeeded()
+{
+	if (!Current || Current->Num() == 0) return;
+
+	if (Current->Num() >= ChunkBytes || FPlatformTime::Seconds() - LastSubmitSeconds >= MaxSubmitIntervalSeconds)
+	{
+		SubmitCurrent();
+	}
+}
+
+void FP3DReplayWriter::SubmitCurrent()
+{
+	PendingChunks.Enqueue(Current);
+	WakeEvent->Trigger();
+	LastSubmitSeconds = FPlatformTime::Seconds();
+
+	// 빈 청크가 없으면(쓰기가 밀림) 하나 더
+	if (!FreeChunks.Dequeue(Current))
+	{
+		TUniquePtr<TArray<uint8>>& Chunk = OwnedChunks.Add_GetRef(MakeUnique<TArray<uint8>>());
+		Chunk->Reserve(ChunkBytes + 256);
+		Current = Chunk.Get();
+	}
+}
+
+void FP3DReplayWriter::WritePending()
+{
+	TArray<uint8>* Chunk = nullptr;
+	while (PendingChunks.Dequeue(Chunk))
+	{
+		if (Chunk->Num() > 0)
+		{
+			File->Write(Chunk->GetData(), Chunk->Num());
+			BytesWritten.fetch_add(Chunk->Num(), std::memory_order_relaxed);
+		}
+
+		// 용량은 유지하고 비워서 돌려줌
+		Chunk->Reset();
+		FreeChunks.Enqueue(Chunk);
+	}
+}
+
+uint32 FP3DReplayWriter::Run()
+{
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		WakeEvent->Wait(WriterWaitMs);
+		WritePending();
+	}
+
+	WritePending();
+	return 0;
+}
+
+void FP3DReplayWriter::Stop()
+{
+	bStopping = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+// ===== 읽기 =====
+
+FP3DReplayReader::~FP3DReplayReader()
+{
+	Close();
+}
+
+bool FP3DReplayReader::Open(const FString& Path, FP3DReplayHeader& OutHeader, FString& OutError)
+{
+	Close();
+
+	auto Result = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+	if (Result.HasError())
+	{
+		OutError = FString::Printf(TEXT("cannot map %s"), *Path);
+		return false;
+	}
+
+	MappedFile = Result.StealValue();
+	const int64 FileSize = MappedFile->GetFileSize();
+	if (FileSize <= 0)
+	{
+		OutError = TEXT("empty file");
+		Close();
+		return false;
+	}
+
+	MappedRegion.Reset(MappedFile->MapRegion(0, FileSize));
+	if (!MappedRegion)
+	{
+		OutError = TEXT("cannot map region");
+		Close();
+		return false;
+	}
+
+	Data = MappedRegion->GetMappedPtr();
+	Size = MappedRegion->GetMappedSize();
+	Offset = 0;
+
+	// ===== 헤더 =====
+	uint32 FileMagic = 0;
+	uint16 FileVersion = 0;
+	if (!ReadPod(FileMagic) || FileMagic != P3DReplay::Magic || !ReadPod(FileVersion) || FileVersion != P3DReplay::Version)
+	{
+		OutError = TEXT("not a P3D replay or version mismatch");
+		Close();
+		return false;
+	}
+
+	uint16 MapLen = 0;
+	if (!ReadPod(OutHeader.ChecksumInterval) || !ReadPod(MapLen) || Offset + MapLen > Size)
+	{
+		OutError = TEXT("truncated header");
+		Close();
+		return false;
+	}
+
+	OutHeader.MapName = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Data + Offset), MapLen));
+	Offset += MapLen;
+
+	uint8 bGrounded = 0;
+	FP3DNetMoveState& State = OutHeader.StartState;
+	const bool bHeaderOk = ReadPod(OutHeader.PawnKind)
+		&& ReadPod(State.Location.X) && ReadPod(State.Location.Y) && ReadPod(State.Location.Z)
+		&& ReadPod(State.Rotation.Pitch) && ReadPod(State.Rotation.Yaw) && ReadPod(State.Rotation.Roll)
+		&& ReadPod(State.VerticalVelocity) && ReadPod(bGrounded);
+	if (!bHeaderOk)
+	{
+		OutError = TEXT("truncated header");
+		Close();
+		return false;
+	}
+	State.bGrounded = (bGrounded != 0);
+
+	return true;
+}
+
+void FP3DReplayReader::Close()
+{
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	Data = nullptr;
+	Size = 0;
+	Offset = 0;
+}
+
+bool FP3DReplayReader::ReadBytes(void* Out, int64 Num)
+{
+	if (!Data || Offset + Num > Size) return false;
+
+	FMemory::Memcpy(Out, Data + Offset, Num);
+	Offset += Num;
+	return true;
+}
+
+bool FP3DReplayReader::PeekRecord(EP3DReplayRecord& OutRecord) const
+{
+	if (IsAtEnd()) return false;
+
+	OutRecord = static_cast<EP3DReplayRecord>(Data[Offset]);
+	return true;
+}
+
+bool FP3DReplayReader::ReadTag(EP3DReplayRecord Expected)
+{
+	EP3DReplayRecord Tag;
+	return PeekRecord(Tag) && Tag == Expected && ReadPod(Tag);
+}
+
+bool FP3DReplayReader::ReadFrame(float& OutDeltaTime)
+{
+	return ReadTag(EP3DReplayRecord::Frame) && ReadPod(OutDeltaTime);
+}
+
+bool FP3DReplayReader::ReadInput(EP3DReplayInput& OutInput, FVector2D& OutValue)
+{
+	if (!ReadTag(EP3DReplayRecord::Input) || !ReadPod(OutInput) || OutInput >= EP3DReplayInput::Count)
+	{
+		return false;
+	}
+
+	float Axes[2] = { 0.f, 0.f };
+	const int32 NumAxes = P3DReplay::GetNumAxes(OutInput);
+	for (int32 i = 0; i < NumAxes; ++i)
+	{
+		if (!ReadPod(Axes[i])) return false;
+	}
+
+	OutValue = FVector2D(Axes[0], Axes[1]);
+	return true;
+}
+
+bool FP3DReplayReader::ReadChecksum(uint32& OutCrc, FVector3f& OutLocation)
+{
+	return ReadTag(EP3DReplayRecord::Checksum) && ReadPod(OutCrc) && ReadPod(OutLocation);
+}
+
+bool FP3DReplayReader::ReadEnd(uint32& OutNumFrames)
+{
+	return ReadTag(EP3DReplayRecord::End) && ReadPod(OutNumFrames);
+}
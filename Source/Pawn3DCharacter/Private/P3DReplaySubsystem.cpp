@@ -0,0 +1,427 @@
+﻿#include "P3DReplaySubsystem.h"
+
+#include "BasePawn.h"
+#include "DronePawn.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<int32> CVarReplayChecksumInterval(
+	TEXT("p3d.Replay.ChecksumInterval"),
+	30,
+	TEXT("녹화 시 로컬 Pawn 상태 체크섬을 남기는 간격(프레임, 0이면 안 남김)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarReplayUseRecordedDeltaTime(
+	TEXT("p3d.Replay.UseRecordedDeltaTime"),
+	1,
+	TEXT("재생 시 프레임 dt를 녹화 값으로 고정(고정 스텝). 끄면 실시간 dt → 체크섬이 어긋날 수 있음"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarReplayStopOnDivergence(
+	TEXT("p3d.Replay.StopOnDivergence"),
+	0,
+	TEXT("1이면 체크섬이 처음 어긋난 프레임에서 재생 중단"),
+	ECVF_Default);
+
+// ===== 콘솔 명령 =====
+
+static FAutoConsoleCommandWithWorldAndArgs CmdReplayRecord(
+	TEXT("p3d.Replay.Record"),
+	TEXT("로컬 플레이어 입력 녹화 시작. 인자: 이름(기본 Replay_날짜), Saved/Replays/<이름>.p3dr"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UP3DReplaySubsystem* Replay = World ? World->GetSubsystem<UP3DReplaySubsystem>() : nullptr)
+		{
+			Replay->StartRecording(Args.Num() > 0 ? Args[0] : FString());
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdReplayPlay(
+	TEXT("p3d.Replay.Play"),
+	TEXT("녹화 파일 재생. 인자: 이름 또는 경로"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		UP3DReplaySubsystem* Replay = World ? World->GetSubsystem<UP3DReplaySubsystem>() : nullptr;
+		if (Replay && Args.Num() > 0)
+		{
+			Replay->StartPlayback(Args[0]);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdReplayStop(
+	TEXT("p3d.Replay.Stop"),
+	TEXT("녹화/재생 중지(녹화 파일은 여기서 닫힘)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UP3DReplaySubsystem* Replay = World ? World->GetSubsystem<UP3DReplaySubsystem>() : nullptr)
+		{
+			Replay->Stop();
+		}
+	}));
+
+// ===== Subsystem =====
+
+bool UP3DReplaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UP3DReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UP3DReplaySubsystem::HandlePreActorTick);
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UP3DReplaySubsystem::HandlePostActorTick);
+}
+
+void UP3DReplaySubsystem::Deinitialize()
+{
+	Stop();
+
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	Super::Deinitialize();
+}
+
+void UP3DReplaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 헤드리스 재생(-P3DReplay=...): 끝나면 어긋남 여부를 종료 코드로
+	FString ReplayArg;
+	if (FParse::Value(FCommandLine::Get(), TEXT("P3DReplay="), ReplayArg))
+	{
+		StartPlayback(ReplayArg, FParse::Param(FCommandLine::Get(), TEXT("P3DReplayQuit")));
+	}
+}
+
+FString UP3DReplaySubsystem::ResolvePath(const FString& NameOrPath)
+{
+	if (FPaths::GetExtension(NameOrPath).IsEmpty() && FPaths::GetPath(NameOrPath).IsEmpty())
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Replays"), NameOrPath + TEXT(".p3dr"));
+	}
+
+	return FPaths::IsRelative(NameOrPath) ? FPaths::Combine(FPaths::ProjectDir(), NameOrPath) : NameOrPath;
+}
+
+APawn* UP3DReplaySubsystem::GetLocalPawn() const
+{
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	return PC ? PC->GetPawn() : nullptr;
+}
+
+// 녹화
+
+bool UP3DReplaySubsystem::StartRecording(const FString& Name)
+{
+	if (Mode != EMode::None)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[P3DReplay] Already %s"), IsRecording() ? TEXT("recording") : TEXT("playing"));
+		return false;
+	}
+
+	const FString FileName = Name.IsEmpty() ? FString::Printf(TEXT("Replay_%s"), *FDateTime::Now().ToString()) : Name;
+	ActivePath = ResolvePath(FileName);
+
+	Mode = EMode::Recording;
+	bPendingStart = true;
+	FrameIndex = 0;
+	ChecksumInterval = static_cast<uint16>(FMath::Clamp(CVarReplayChecksumInterval.GetValueOnGameThread(), 0, 0xFFFF));
+
+	UE_LOG(LogTemp, Log, TEXT("[P3DReplay] Recording -> %s"), *ActivePath);
+	return true;
+}
+
+void UP3DReplaySubsystem::BeginRecordingFrame(float DeltaSeconds)
+{
+	if (bPendingStart)
+	{
+		bPendingStart = false;
+
+		const APawn* Pawn = GetLocalPawn();
+
+		Header = FP3DReplayHeader();
+		Header.ChecksumInterval = ChecksumInterval;
+		Header.MapName = GetWorld()->GetMapName();
+		Header.PawnKind = Cast<ADronePawn>(Pawn) ? 2 : (Cast<ABasePawn>(Pawn) ? 1 : 0);
+
+		if (const IP3DNetMovementPawn* NetPawn = Cast<IP3DNetMovementPawn>(Pawn))
+		{
+			NetPawn->NetSaveState(Header.StartState);
+		}
+
+		if (!Writer.Open(ActivePath, Header))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[P3DReplay] Cannot open %s"), *ActivePath);
+			Mode = EMode::None;
+			return;
+		}
+	}
+
+	Writer.WriteFrame(DeltaSeconds);
+}
+
+bool UP3DReplaySubsystem::HandleLiveInput(EP3DReplayInput Input, const FVector2D& Value)
+{
+	switch (Mode)
+	{
+	case EMode::Playing:
+		return bFeedingInput;
+
+	case EMode::Recording:
+		if (Writer.IsOpen())
+		{
+			Writer.WriteInput(Input, Value);
+		}
+		return true;
+
+	default:
+		return true;
+	}
+}
+
+// 재생
+
+bool UP3DReplaySubsystem::StartPlayback(const FString& NameOrPath, bool bInQuitWhenDone)
+{
+	if (Mode != EMode::None)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[P3DReplay] Already %s"), IsRecording() ? TEXT("recording") : TEXT("playing"));
+		return false;
+	}
+
+	ActivePath = ResolvePath(NameOrPath);
+	bQuitWhenDone = bInQuitWhenDone;
+
+	FString Error;
+	float FirstDeltaTime = 0.f;
+	if (!Reader.Open(ActivePath, Header, Error) || !Reader.ReadFrame(FirstDeltaTime))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[P3DReplay] Cannot play %s: %s"), *ActivePath, Error.IsEmpty() ? TEXT("no frames") : *Error);
+		Reader.Close();
+
+		if (bQuitWhenDone)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 2);
+		}
+		return false;
+	}
+
+	if (Header.MapName != GetWorld()->GetMapName())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[P3DReplay] Recorded on %s, playing on %s"), *Header.MapName, *GetWorld()->GetMapName());
+	}
+
+	Mode = EMode::Playing;
+	bPendingStart = true;
+	StartFrameCounter = GFrameCounter;
+	FrameIndex = 0;
+	ChecksumInterval = Header.ChecksumInterval;
+
+	NumChecksums = 0;
+	NumDivergences = 0;
+	FirstDivergenceFrame = INDEX_NONE;
+	MaxDivergenceCm = 0.f;
+
+	bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+	SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+
+	// 첫 프레임 dt는 다음 엔진 프레임부터
+	if (CVarReplayUseRecordedDeltaTime.GetValueOnGameThread() != 0)
+	{
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(FirstDeltaTime);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[P3DReplay] Playing %s (%lld bytes)"), *ActivePath, Reader.GetSize());
+	return true;
+}
+
+void UP3DReplaySubsystem::BeginPlaybackFrame()
+{
+	if (bPendingStart)
+	{
+		bPendingStart = false;
+		PlaybackStartSeconds = FPlatformTime::Seconds();
+
+		APawn* Pawn = GetLocalPawn();
+		const uint8 PawnKind = Cast<ADronePawn>(Pawn) ? 2 : (Cast<ABasePawn>(Pawn) ? 1 : 0);
+		if (PawnKind != Header.PawnKind)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[P3DReplay] Start pawn differs from recording (kind %d vs %d)"), PawnKind, Header.PawnKind);
+		}
+		else if (IP3DNetMovementPawn* NetPawn = Cast<IP3DNetMovementPawn>(Pawn))
+		{
+			NetPawn->NetRestoreState(Header.StartState);
+		}
+	}
+
+	// 이번 프레임 입력을 Pawn Tick 전에 콜백으로(녹화 때도 컨트롤러 Tick에서 Pawn Tick 전에 들어옴)
+	EP3DReplayRecord Record;
+	while (Reader.PeekRecord(Record) && Record == EP3DReplayRecord::Input)
+	{
+		EP3DReplayInput Input;
+		FVector2D Value;
+		if (!Reader.ReadInput(Input, Value))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[P3DReplay] Corrupt input record at %lld"), Reader.GetOffset());
+			FinishPlayback();
+			return;
+		}
+
+		// 빙의가 바뀌면(Interact → 드론 전환 등) 그때의 Pawn으로
+		if (IP3DReplayInputTarget* Target = Cast<IP3DReplayInputTarget>(GetLocalPawn()))
+		{
+			TGuardValue<bool> Feeding(bFeedingInput, true);
+			Target->ReplayInput(Input, Value);
+		}
+	}
+}
+
+void UP3DReplaySubsystem::EndPlaybackFrame()
+{
+	EP3DReplayRecord Record;
+	if (Reader.PeekRecord(Record) && Record == EP3DReplayRecord::Checksum)
+	{
+		uint32 ExpectedCrc = 0;
+		FVector3f ExpectedLocation;
+		Reader.ReadChecksum(ExpectedCrc, ExpectedLocation);
+
+		FVector3f Location;
+		const uint32 Crc = P3DReplay::ComputeChecksum(GetLocalPawn(), Location);
+		++NumChecksums;
+
+		if (Crc != ExpectedCrc)
+		{
+			const float DistanceCm = FVector3f::Dist(Location, ExpectedLocation);
+			MaxDivergenceCm = FMath::Max(MaxDivergenceCm, DistanceCm);
+
+			if (NumDivergences++ == 0)
+			{
+				FirstDivergenceFrame = FrameIndex;
+				UE_LOG(LogTemp, Warning, TEXT("[P3DReplay] Diverged at frame %u (%.3f cm from recording)"), FrameIndex, DistanceCm);
+			}
+
+			if (CVarReplayStopOnDivergence.GetValueOnGameThread() != 0)
+			{
+				FinishPlayback();
+				return;
+			}
+		}
+	}
+
+	++FrameIndex;
+
+	if (!ScheduleNextDeltaTime())
+	{
+		FinishPlayback();
+	}
+}
+
+bool UP3DReplaySubsystem::ScheduleNextDeltaTime()
+{
+	float DeltaTime = 0.f;
+	if (!Reader.ReadFrame(DeltaTime))
+	{
+		// End 레코드 또는 잘린 파일(녹화 중 비정상 종료)
+		return false;
+	}
+
+	if (FApp::UseFixedTimeStep() && CVarReplayUseRecordedDeltaTime.GetValueOnGameThread() != 0)
+	{
+		FApp::SetFixedDeltaTime(DeltaTime);
+	}
+	return true;
+}
+
+void UP3DReplaySubsystem::FinishPlayback()
+{
+	const double Seconds = FPlatformTime::Seconds() - PlaybackStartSeconds;
+
+	uint32 RecordedFrames = 0;
+	EP3DReplayRecord Record;
+	if (Reader.PeekRecord(Record) && Record == EP3DReplayRecord::End)
+	{
+		Reader.ReadEnd(RecordedFrames);
+	}
+	Reader.Close();
+
+	FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+
+	Mode = EMode::None;
+
+	UE_LOG(LogTemp, Log, TEXT("[P3DReplay] Done: frames=%u/%u checksums=%u divergences=%u first=%lld max=%.3fcm wall=%.2fs (%.3f ms/frame)"),
+		FrameIndex, RecordedFrames, NumChecksums, NumDivergences, FirstDivergenceFrame, MaxDivergenceCm,
+		Seconds, FrameIndex > 0 ? Seconds * 1000.0 / FrameIndex : 0.0);
+
+	if (bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, NumDivergences > 0 ? 1 : 0);
+	}
+}
+
+void UP3DReplaySubsystem::Stop()
+{
+	if (IsRecording())
+	{
+		if (Writer.IsOpen())
+		{
+			Writer.Close(FrameIndex);
+			UE_LOG(LogTemp, Log, TEXT("[P3DReplay] Saved %s (%u frames, %llu bytes)"), *ActivePath, FrameIndex, Writer.GetBytesWritten());
+		}
+		Mode = EMode::None;
+	}
+	else if (IsPlaying())
+	{
+		FinishPlayback();
+	}
+}
+
+// 프레임 경계
+
+void UP3DReplaySubsystem::HandlePreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld()) return;
+
+	if (IsRecording())
+	{
+		BeginRecordingFrame(DeltaSeconds);
+	}
+	else if (IsPlaying())
+	{
+		// 고정 dt가 걸린 다음 엔진 프레임부터
+		if (bPendingStart && GFrameCounter == StartFrameCounter) return;
+
+		BeginPlaybackFrame();
+	}
+}
+
+void UP3DReplaySubsystem::HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld != GetWorld()) return;
+
+	if (IsRecording() && Writer.IsOpen())
+	{
+		if (ChecksumInterval > 0 && FrameIndex % ChecksumInterval == 0)
+		{
+			FVector3f Location;
+			const uint32 Crc = P3DReplay::ComputeChecksum(GetLocalPawn(), Location);
+			Writer.WriteChecksum(Crc, Location);
+		}
+
+		++FrameIndex;
+		Writer.FlushIfNeeded();
+	}
+	else if (IsPlaying() && !bPendingStart)
+	{
+		EndPlaybackFrame();
+	}
+}
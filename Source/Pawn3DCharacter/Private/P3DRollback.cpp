@@ -0,0 +1,108 @@
+﻿#include "P3DRollback.h"
+
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarRollbackRecord(
+	TEXT("p3d.Rollback.Record"),
+	0,
+	TEXT("1이면 Pawn마다 프레임별 상태/입력 스냅샷을 링 버퍼에 기록(롤백 재시뮬용)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarRollbackFrames(
+	TEXT("p3d.Rollback.Frames"),
+	128,
+	TEXT("Pawn당 기록할 최대 프레임 수(링 버퍼 용량, 첫 기록 때 한 번 할당)"),
+	ECVF_Default);
+
+namespace
+{
+	uint32 GetSnapshotFrame(const FP3DPawnSnapshot& Snapshot)
+	{
+		return Snapshot.Frame;
+	}
+}
+
+bool P3DRollback::IsRecording()
+{
+	return CVarRollbackRecord.GetValueOnGameThread() != 0;
+}
+
+void P3DRollback::RecordFrame(IP3DRollbackPawn& Pawn, float DeltaTime)
+{
+	if (!IsRecording()) return;
+
+	FP3DSnapshotHistory& History = Pawn.GetSnapshotHistory();
+	if (!History.IsInitialized())
+	{
+		History.Init(FMath::Clamp(CVarRollbackFrames.GetValueOnGameThread(), 2, 4096));
+	}
+
+	// 같은 프레임에 두 번 Tick되는 경우(수동 Tick 등)는 덮어씀
+	const uint32 Frame = static_cast<uint32>(GFrameCounter);
+	FP3DPawnSnapshot& Snapshot = (History.Num() > 0 && History.Last().Frame >= Frame)
+		? History[History.Num() - 1]
+		: History.Push();
+
+	Pawn.CaptureSnapshot(Snapshot);
+	Snapshot.Frame = Frame;
+	Snapshot.DeltaTime = DeltaTime;
+}
+
+bool P3DRollback::RestoreFrame(IP3DRollbackPawn& Pawn, uint32 Frame, uint32* OutRestoredFrame)
+{
+	FP3DSnapshotHistory& History = Pawn.GetSnapshotHistory();
+
+	const int32 Index = History.LowerBound(Frame, GetSnapshotFrame);
+	if (Index == INDEX_NONE) return false;
+
+	const FP3DPawnSnapshot& Snapshot = History[Index];
+	Pawn.RestoreSnapshotState(Snapshot);
+	Pawn.ApplySnapshotInput(Snapshot);
+
+	if (OutRestoredFrame)
+	{
+		*OutRestoredFrame = Snapshot.Frame;
+	}
+
+	// 되돌린 프레임부터는 다음 Tick이 새로 기록
+	History.TruncateFrom(Index);
+	return true;
+}
+
+int32 P3DRollback::Resimulate(IP3DRollbackPawn& Pawn, uint32 Frame, bool bRewriteHistory, float& InOutMaxErrorCm)
+{
+	FP3DSnapshotHistory& History = Pawn.GetSnapshotHistory();
+
+	const int32 StartIndex = History.LowerBound(Frame, GetSnapshotFrame);
+	if (StartIndex == INDEX_NONE) return 0;
+
+	// 재시뮬 끝 비교 기준 + 이번 프레임 입력 캐시(끝나고 되돌림)
+	FP3DPawnSnapshot Live;
+	Pawn.CaptureSnapshot(Live);
+
+	Pawn.RestoreSnapshotState(History[StartIndex]);
+
+	const int32 NumFrames = History.Num() - StartIndex;
+	for (int32 i = StartIndex; i < History.Num(); ++i)
+	{
+		const FP3DPawnSnapshot& Input = History[i];
+		Pawn.ApplySnapshotInput(Input);
+		Pawn.ResimulateFrame(Input.DeltaTime, Input.bInputEnabled);
+
+		// 다음 프레임 시작 상태(마지막이면 현재 상태)와 비교
+		const bool bHasNext = (i + 1 < History.Num());
+		const FP3DNetMoveState& Recorded = bHasNext ? History[i + 1].State : Live.State;
+
+		FP3DPawnSnapshot Result;
+		Pawn.CaptureSnapshot(Result);
+		InOutMaxErrorCm = FMath::Max(InOutMaxErrorCm, static_cast<float>(FVector::Dist(Result.State.Location, Recorded.Location)));
+
+		if (bRewriteHistory && bHasNext)
+		{
+			History[i + 1].State = Result.State;
+		}
+	}
+
+	Pawn.ApplySnapshotInput(Live);
+	return NumFrames;
+}
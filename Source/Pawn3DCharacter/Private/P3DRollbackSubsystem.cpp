@@ -0,0 +1,109 @@
+﻿#include "P3DRollbackSubsystem.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "P3DProfiling.h"
+
+// ===== 콘솔 명령 =====
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRollbackResim(
+	TEXT("p3d.Rollback.Resim"),
+	TEXT("최근 N 프레임(기본 30)을 되돌려 기록된 입력으로 재시뮬. 두 번째 인자 1이면 기록 상태도 갱신. p3d.Rollback.Record 1 필요"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		UP3DRollbackSubsystem* Rollback = World ? World->GetSubsystem<UP3DRollbackSubsystem>() : nullptr;
+		if (!Rollback) return;
+
+		const int32 FramesBack = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 30;
+		const bool bRewrite = Args.Num() > 1 && FCString::Atoi(*Args[1]) != 0;
+
+		const FP3DResimResult Result = Rollback->ResimulateFrom(Rollback->GetFrameBefore(FramesBack), bRewrite);
+		UE_LOG(LogTemp, Log, TEXT("[P3DRollback] pawns=%d frames=%d %.3fms (%.1f pawn-frames/ms) max error=%.4fcm"),
+			Result.NumPawns, Result.NumFrames, Result.Ms,
+			Result.Ms > 0.0 ? Result.NumFrames / Result.Ms : 0.0, Result.MaxErrorCm);
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRollbackRestore(
+	TEXT("p3d.Rollback.Restore"),
+	TEXT("최근 N 프레임(기본 30) 전 상태로 되돌림(재시뮬 없음, 이후 기록 버림)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		UP3DRollbackSubsystem* Rollback = World ? World->GetSubsystem<UP3DRollbackSubsystem>() : nullptr;
+		if (!Rollback) return;
+
+		const int32 FramesBack = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 30;
+		const uint32 Frame = Rollback->GetFrameBefore(FramesBack);
+		const int32 NumPawns = Rollback->RestoreFrame(Frame);
+		UE_LOG(LogTemp, Log, TEXT("[P3DRollback] restored %d pawns to frame %u"), NumPawns, Frame);
+	}));
+
+// 조회
+
+template<typename Func>
+void UP3DRollbackSubsystem::ForEachRollbackPawn(Func&& Callback) const
+{
+	for (TActorIterator<APawn> It(GetWorld()); It; ++It)
+	{
+		IP3DRollbackPawn* RollbackPawn = Cast<IP3DRollbackPawn>(*It);
+		if (RollbackPawn && RollbackPawn->GetSnapshotHistory().Num() > 0)
+		{
+			Callback(*RollbackPawn);
+		}
+	}
+}
+
+uint32 UP3DRollbackSubsystem::GetLatestFrame() const
+{
+	uint32 Latest = 0;
+	ForEachRollbackPawn([&Latest](IP3DRollbackPawn& Pawn)
+	{
+		Latest = FMath::Max(Latest, Pawn.GetSnapshotHistory().Last().Frame);
+	});
+	return Latest;
+}
+
+uint32 UP3DRollbackSubsystem::GetFrameBefore(int32 FramesBack) const
+{
+	const uint32 Latest = GetLatestFrame();
+	const uint32 Back = static_cast<uint32>(FMath::Max(FramesBack, 1) - 1);
+	return Latest > Back ? Latest - Back : 0;
+}
+
+// 되돌리기 / 재시뮬
+
+int32 UP3DRollbackSubsystem::RestoreFrame(uint32 Frame)
+{
+	int32 NumPawns = 0;
+	ForEachRollbackPawn([Frame, &NumPawns](IP3DRollbackPawn& Pawn)
+	{
+		if (P3DRollback::RestoreFrame(Pawn, Frame))
+		{
+			++NumPawns;
+		}
+	});
+	return NumPawns;
+}
+
+FP3DResimResult UP3DRollbackSubsystem::ResimulateFrom(uint32 Frame, bool bRewriteHistory)
+{
+	P3D_SCOPE(RollbackResim);
+
+	FP3DResimResult Result;
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	ForEachRollbackPawn([Frame, bRewriteHistory, &Result](IP3DRollbackPawn& Pawn)
+	{
+		const int32 NumFrames = P3DRollback::Resimulate(Pawn, Frame, bRewriteHistory, Result.MaxErrorCm);
+		if (NumFrames > 0)
+		{
+			++Result.NumPawns;
+			Result.NumFrames += NumFrames;
+		}
+	});
+
+	Result.Ms = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	INC_DWORD_STAT_BY(STAT_P3D_RollbackResimFrames, Result.NumFrames);
+	return Result;
+}
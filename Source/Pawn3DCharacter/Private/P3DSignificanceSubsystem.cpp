@@ -0,0 +1,382 @@
+﻿#include "P3DSignificanceSubsystem.h"
+
+#include "P3DStats.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "IAnimationBudgetAllocator.h"
+#include "AnimationBudgetAllocatorParameters.h"
+#include "SkeletalMeshComponentBudgeted.h"
+
+static TAutoConsoleVariable<int32> CVarSignificanceEnable(
+	TEXT("p3d.Significance.Enable"),
+	1,
+	TEXT("Pawn 중요도 기반 Tick 간격 조절 사용 여부"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceUpdateInterval(
+	TEXT("p3d.Significance.UpdateInterval"),
+	0.25f,
+	TEXT("중요도 재평가 주기(초)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceNearDistance(
+	TEXT("p3d.Significance.NearDistance"),
+	1500.f,
+	TEXT("High 단계 최대 거리(cm)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceFarDistance(
+	TEXT("p3d.Significance.FarDistance"),
+	5000.f,
+	TEXT("Medium 단계 최대 거리(cm). 이보다 멀면 Low/Dormant"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceMediumHz(
+	TEXT("p3d.Significance.MediumHz"),
+	30.f,
+	TEXT("Medium 단계 Tick 주파수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceLowHz(
+	TEXT("p3d.Significance.LowHz"),
+	10.f,
+	TEXT("Low 단계 Tick 주파수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAnimBudgetEnable(
+	TEXT("p3d.Anim.Budget"),
+	1,
+	TEXT("Pawn 메시 애니메이션을 AnimationBudgetAllocator 예산으로 관리"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAnimBudgetMs(
+	TEXT("p3d.Anim.BudgetMs"),
+	1.5f,
+	TEXT("게임 스레드 애니메이션 예산(ms). 넘으면 먼 Pawn부터 포즈 평가를 건너뛰고 보간"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAnimFreezeIdle(
+	TEXT("p3d.Anim.FreezeIdle"),
+	1,
+	TEXT("조종 중이 아니고 가만히 있는 Pawn은 포즈 고정(애님 Tick 정지)"),
+	ECVF_Default);
+
+TStatId UP3DSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UP3DSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+// 등록 / 해제
+
+void UP3DSignificanceSubsystem::RegisterPawn(APawn* Pawn)
+{
+	if (!IsValid(Pawn) || EntryIndex.Contains(Pawn)) return;
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Pawn = Pawn;
+	Entry.Tier = EP3DSignificanceTier::High;
+	Entry.DefaultTickInterval = Pawn->GetActorTickInterval();
+
+	EntryIndex.Add(Pawn, Entries.Num() - 1);
+}
+
+void UP3DSignificanceSubsystem::UnregisterPawn(APawn* Pawn)
+{
+	int32 Index = INDEX_NONE;
+	if (!EntryIndex.RemoveAndCopyValue(Pawn, Index)) return;
+
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// 뒤에서 당겨온 항목 인덱스 갱신
+	if (Entries.IsValidIndex(Index))
+	{
+		if (APawn* Moved = Entries[Index].Pawn.Get())
+		{
+			EntryIndex.Add(Moved, Index);
+		}
+	}
+}
+
+void UP3DSignificanceSubsystem::WakePawn(APawn* Pawn)
+{
+	const int32* Index = EntryIndex.Find(Pawn);
+	if (!Index) return;
+
+	FEntry& Entry = Entries[*Index];
+
+	// 움직이기 시작 → 포즈 고정은 단계와 무관하게 바로 풀기
+	SetAnimFrozen(Entry, false);
+
+	if (Entry.Tier == EP3DSignificanceTier::Critical || Entry.Tier == EP3DSignificanceTier::High) return;
+
+	ApplyTier(Entry, Pawn->IsLocallyControlled() ? EP3DSignificanceTier::Critical : EP3DSignificanceTier::High);
+}
+
+EP3DSignificanceTier UP3DSignificanceSubsystem::GetTier(const APawn* Pawn) const
+{
+	const int32* Index = EntryIndex.Find(Pawn);
+	return Index ? Entries[*Index].Tier : EP3DSignificanceTier::Critical;
+}
+
+void UP3DSignificanceSubsystem::ReportTickCost(uint64 Cycles)
+{
+	const float Us = static_cast<float>(FPlatformTime::ToMilliseconds64(Cycles) * 1000.0);
+
+	// 튀는 값 완화
+	AvgTickCostUs = (AvgTickCostUs <= 0.f) ? Us : FMath::Lerp(AvgTickCostUs, Us, 0.05f);
+}
+
+void UP3DSignificanceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	ApplyAnimBudgetParameters();
+}
+
+// Tick: 주기적으로만 재평가
+
+void UP3DSignificanceSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_P3D_SignificanceUpdate);
+
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate <= 0.f)
+	{
+		TimeUntilUpdate = FMath::Max(0.f, CVarSignificanceUpdateInterval.GetValueOnGameThread());
+		UpdateSignificance();
+	}
+
+	PublishStats(DeltaTime);
+}
+
+void UP3DSignificanceSubsystem::UpdateSignificance()
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	ApplyAnimBudgetParameters();
+
+	// 로컬 플레이어 시점 모음(분할 화면 대비)
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC || !PC->IsLocalController()) continue;
+
+		FVector ViewLoc;
+		FRotator ViewRot;
+		PC->GetPlayerViewPoint(ViewLoc, ViewRot);
+		ViewLocations.Add(ViewLoc);
+	}
+
+	for (int32 i = Entries.Num() - 1; i >= 0; --i)
+	{
+		FEntry& Entry = Entries[i];
+		APawn* Pawn = Entry.Pawn.Get();
+
+		if (!Pawn)
+		{
+			// 등록 해제 없이 사라진 Pawn 정리
+			Entries.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		float AnimSignificance = 1.f;
+		ApplyTier(Entry, EvaluateTier(Pawn, ViewLocations, AnimSignificance));
+		ApplyAnimSignificance(Entry, AnimSignificance);
+	}
+
+	// 정리로 인덱스가 흔들렸을 수 있으니 다시 구성
+	EntryIndex.Reset();
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		if (APawn* Pawn = Entries[i].Pawn.Get())
+		{
+			EntryIndex.Add(Pawn, i);
+		}
+	}
+}
+
+EP3DSignificanceTier UP3DSignificanceSubsystem::EvaluateTier(const APawn* Pawn, const TArray<FVector, TInlineAllocator<4>>& ViewLocations, float& OutAnimSignificance) const
+{
+	OutAnimSignificance = 1.f;
+
+	if (CVarSignificanceEnable.GetValueOnGameThread() == 0) return EP3DSignificanceTier::High;
+
+	if (Pawn->IsLocallyControlled()) return EP3DSignificanceTier::Critical;
+
+	// 시점이 없으면(전용 서버 등) 거리 판단 불가 → 중간
+	if (ViewLocations.Num() == 0)
+	{
+		OutAnimSignificance = 0.5f;
+		return EP3DSignificanceTier::Medium;
+	}
+
+	float MinDistSq = TNumericLimits<float>::Max();
+	for (const FVector& ViewLoc : ViewLocations)
+	{
+		MinDistSq = FMath::Min(MinDistSq, static_cast<float>(FVector::DistSquared(ViewLoc, Pawn->GetActorLocation())));
+	}
+
+	const float NearDist = CVarSignificanceNearDistance.GetValueOnGameThread();
+	const float FarDist = CVarSignificanceFarDistance.GetValueOnGameThread();
+
+	const bool bOnScreen = Pawn->WasRecentlyRendered(0.25f);
+
+	// 애님 중요도: 가까울수록 1, FarDist에서 0. 화면 밖은 크게 낮춤
+	const float DistAlpha = 1.f - FMath::Clamp(FMath::Sqrt(MinDistSq) / FMath::Max(FarDist, 1.f), 0.f, 1.f);
+	OutAnimSignificance = bOnScreen ? (0.25f + 0.75f * DistAlpha) : (0.1f * DistAlpha);
+
+	if (MinDistSq <= FMath::Square(NearDist))
+	{
+		return bOnScreen ? EP3DSignificanceTier::High : EP3DSignificanceTier::Medium;
+	}
+
+	if (MinDistSq <= FMath::Square(FarDist))
+	{
+		return bOnScreen ? EP3DSignificanceTier::Medium : EP3DSignificanceTier::Low;
+	}
+
+	const IP3DSignificanceTarget* Target = Cast<IP3DSignificanceTarget>(Pawn);
+	const bool bIdle = Target && Target->IsSignificanceIdle();
+
+	return (!bOnScreen && bIdle) ? EP3DSignificanceTier::Dormant : EP3DSignificanceTier::Low;
+}
+
+float UP3DSignificanceSubsystem::GetTierTickInterval(const FEntry& Entry, EP3DSignificanceTier Tier) const
+{
+	switch (Tier)
+	{
+	case EP3DSignificanceTier::Medium:
+		return FMath::Max(Entry.DefaultTickInterval, 1.f / FMath::Max(1.f, CVarSignificanceMediumHz.GetValueOnGameThread()));
+	case EP3DSignificanceTier::Low:
+	case EP3DSignificanceTier::Dormant:
+		return FMath::Max(Entry.DefaultTickInterval, 1.f / FMath::Max(1.f, CVarSignificanceLowHz.GetValueOnGameThread()));
+	default:
+		return Entry.DefaultTickInterval;
+	}
+}
+
+void UP3DSignificanceSubsystem::ApplyTier(FEntry& Entry, EP3DSignificanceTier NewTier)
+{
+	APawn* Pawn = Entry.Pawn.Get();
+	if (!Pawn) return;
+
+	const EP3DSignificanceTier OldTier = Entry.Tier;
+	Entry.Tier = NewTier;
+
+	// 배치 시뮬/풀 대기 중이면 Tick은 다른 곳에서 관리
+	const IP3DSignificanceTarget* Target = Cast<IP3DSignificanceTarget>(Pawn);
+	if (Target && !Target->AllowsSignificanceTickControl()) return;
+
+	if (NewTier == EP3DSignificanceTier::Dormant)
+	{
+		Pawn->SetActorTickEnabled(false);
+		return;
+	}
+
+	if (OldTier == EP3DSignificanceTier::Dormant)
+	{
+		Pawn->SetActorTickEnabled(true);
+	}
+
+	Pawn->SetActorTickInterval(GetTierTickInterval(Entry, NewTier));
+}
+
+// ===== Animation Budget =====
+
+void UP3DSignificanceSubsystem::ApplyAnimBudgetParameters()
+{
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (!Allocator) return;
+
+	const int32 bEnabled = CVarAnimBudgetEnable.GetValueOnGameThread() != 0 ? 1 : 0;
+	const float BudgetMs = FMath::Max(0.1f, CVarAnimBudgetMs.GetValueOnGameThread());
+
+	if (bEnabled == AppliedAnimBudgetEnabled && BudgetMs == AppliedAnimBudgetMs) return;
+
+	AppliedAnimBudgetEnabled = bEnabled;
+	AppliedAnimBudgetMs = BudgetMs;
+
+	FAnimationBudgetAllocatorParameters Parameters;
+	Parameters.BudgetInMs = BudgetMs;
+	Allocator->SetParameters(Parameters);
+	Allocator->SetEnabled(bEnabled != 0);
+}
+
+void UP3DSignificanceSubsystem::ApplyAnimSignificance(FEntry& Entry, float Significance)
+{
+	APawn* Pawn = Entry.Pawn.Get();
+	const IP3DSignificanceTarget* Target = Cast<IP3DSignificanceTarget>(Pawn);
+	USkeletalMeshComponentBudgeted* Mesh = Target ? Target->GetSignificanceAnimMesh() : nullptr;
+	if (!Mesh) return;
+
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (!Allocator) return;
+
+	const bool bCritical = (Entry.Tier == EP3DSignificanceTier::Critical);
+
+	// 조종 중인 Pawn은 절대 건너뛰지 않음, 나머지는 예산 안에서 건너뛰기/보간
+	Allocator->SetComponentSignificance(Mesh, Significance, bCritical);
+
+	// 가만히 있는 Pawn: 포즈 평가 자체를 멈춤(마지막 포즈 유지)
+	const bool bFreeze = !bCritical
+		&& CVarAnimFreezeIdle.GetValueOnGameThread() != 0
+		&& Target->IsSignificanceIdle();
+
+	SetAnimFrozen(Entry, bFreeze);
+}
+
+void UP3DSignificanceSubsystem::SetAnimFrozen(FEntry& Entry, bool bFrozen)
+{
+	if (Entry.bAnimFrozen == bFrozen) return;
+
+	const IP3DSignificanceTarget* Target = Cast<IP3DSignificanceTarget>(Entry.Pawn.Get());
+	USkeletalMeshComponentBudgeted* Mesh = Target ? Target->GetSignificanceAnimMesh() : nullptr;
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (!Mesh || !Allocator) return;
+
+	// 할당기가 메시 Tick을 관리하므로 할당기를 통해서 켜고 끔
+	Allocator->SetComponentTickEnabled(Mesh, !bFrozen);
+	Entry.bAnimFrozen = bFrozen;
+}
+
+void UP3DSignificanceSubsystem::PublishStats(float DeltaTime)
+{
+	uint32 TierCounts[(int32)EP3DSignificanceTier::MAX] = {};
+	uint32 NumAnimFrozen = 0;
+	float SavedUs = 0.f;
+
+	for (const FEntry& Entry : Entries)
+	{
+		++TierCounts[(int32)Entry.Tier];
+		NumAnimFrozen += Entry.bAnimFrozen ? 1 : 0;
+
+		// 이번 프레임 Tick 횟수 추정(간격이 프레임보다 길면 일부 프레임만 Tick)
+		float TicksPerFrame = 1.f;
+		if (Entry.Tier == EP3DSignificanceTier::Dormant)
+		{
+			TicksPerFrame = 0.f;
+		}
+		else
+		{
+			const float Interval = GetTierTickInterval(Entry, Entry.Tier);
+			if (Interval > DeltaTime && Interval > 0.f)
+			{
+				TicksPerFrame = DeltaTime / Interval;
+			}
+		}
+
+		SavedUs += (1.f - TicksPerFrame) * AvgTickCostUs;
+	}
+
+	SET_DWORD_STAT(STAT_P3D_SigCritical, TierCounts[(int32)EP3DSignificanceTier::Critical]);
+	SET_DWORD_STAT(STAT_P3D_SigHigh, TierCounts[(int32)EP3DSignificanceTier::High]);
+	SET_DWORD_STAT(STAT_P3D_SigMedium, TierCounts[(int32)EP3DSignificanceTier::Medium]);
+	SET_DWORD_STAT(STAT_P3D_SigLow, TierCounts[(int32)EP3DSignificanceTier::Low]);
+	SET_DWORD_STAT(STAT_P3D_SigDormant, TierCounts[(int32)EP3DSignificanceTier::Dormant]);
+	SET_FLOAT_STAT(STAT_P3D_SigSavedMs, SavedUs / 1000.f);
+	SET_DWORD_STAT(STAT_P3D_SigAnimFrozen, NumAnimFrozen);
+}
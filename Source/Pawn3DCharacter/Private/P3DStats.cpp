@@ -0,0 +1,130 @@
+﻿#include "P3DStats.h"
+
+// ===== Pawn Tick =====
+DEFINE_STAT(STAT_P3D_BasePawnTick);
+
+// ===== Pawn Movement =====
+DEFINE_STAT(STAT_P3D_PawnMove);
+DEFINE_STAT(STAT_P3D_PawnMoveSweeps);
+DEFINE_STAT(STAT_P3D_PawnFloorQueries);
+DEFINE_STAT(STAT_P3D_PawnFloorCacheHit);
+
+// ===== Drone Simulation =====
+DEFINE_STAT(STAT_P3D_DroneActorTick);
+DEFINE_STAT(STAT_P3D_DroneBatchTick);
+DEFINE_STAT(STAT_P3D_DroneTickRotation);
+DEFINE_STAT(STAT_P3D_DroneTickVertical);
+DEFINE_STAT(STAT_P3D_DroneProbeGround);
+DEFINE_STAT(STAT_P3D_DroneMoveSweeps);
+DEFINE_STAT(STAT_P3D_NumActorDrones);
+DEFINE_STAT(STAT_P3D_NumBatchedDrones);
+DEFINE_STAT(STAT_P3D_DroneActorCostPerDrone);
+DEFINE_STAT(STAT_P3D_DroneBatchCostPerDrone);
+
+// ===== Drone Ground Probe =====
+DEFINE_STAT(STAT_P3D_GroundProbeSync);
+DEFINE_STAT(STAT_P3D_GroundProbeAsync);
+DEFINE_STAT(STAT_P3D_GroundProbeAsyncFallback);
+
+// ===== Drone Ground Cache =====
+DEFINE_STAT(STAT_P3D_GroundCacheHit);
+DEFINE_STAT(STAT_P3D_GroundCacheMiss);
+DEFINE_STAT(STAT_P3D_GroundCacheCells);
+DEFINE_STAT(STAT_P3D_GroundCacheAvoidedPerSec);
+
+// ===== Drone Baked Heightfield =====
+DEFINE_STAT(STAT_P3D_GroundHeightfieldHit);
+DEFINE_STAT(STAT_P3D_GroundHeightfieldFallback);
+DEFINE_STAT(STAT_P3D_GroundHeightfieldKB);
+
+// ===== Mass Population =====
+DEFINE_STAT(STAT_P3D_MassPawnMove);
+DEFINE_STAT(STAT_P3D_MassDroneMove);
+DEFINE_STAT(STAT_P3D_MassLOD);
+DEFINE_STAT(STAT_P3D_MassPopulationTick);
+DEFINE_STAT(STAT_P3D_MassFloorQueries);
+DEFINE_STAT(STAT_P3D_MassEntities);
+DEFINE_STAT(STAT_P3D_MassPromoted);
+DEFINE_STAT(STAT_P3D_MassBytesPerEntity);
+
+// ===== Network Movement =====
+DEFINE_STAT(STAT_P3D_NetStateBytes);
+DEFINE_STAT(STAT_P3D_NetMoveBytes);
+DEFINE_STAT(STAT_P3D_NetCorrections);
+DEFINE_STAT(STAT_P3D_NetReplayedMoves);
+DEFINE_STAT(STAT_P3D_NetRejectedMoves);
+DEFINE_STAT(STAT_P3D_NetPendingMoves);
+DEFINE_STAT(STAT_P3D_NetLastCorrectionCm);
+
+// ===== Rollback =====
+DEFINE_STAT(STAT_P3D_RollbackResim);
+DEFINE_STAT(STAT_P3D_RollbackResimFrames);
+
+// ===== Possession / Toggle =====
+DEFINE_STAT(STAT_P3D_ToggleDrone);
+DEFINE_STAT(STAT_P3D_ApplyIMC);
+DEFINE_STAT(STAT_P3D_LastToggleMs);
+DEFINE_STAT(STAT_P3D_DroneAssetLoadMs);
+DEFINE_STAT(STAT_P3D_DroneAssetMemoryMB);
+DEFINE_STAT(STAT_P3D_DroneLateLoadWaitMs);
+
+// ===== World Partition Streaming =====
+DEFINE_STAT(STAT_P3D_StreamingLookAheadCm);
+
+// ===== Drone Navigation =====
+DEFINE_STAT(STAT_P3D_DroneNavDispatch);
+DEFINE_STAT(STAT_P3D_DroneNavPending);
+DEFINE_STAT(STAT_P3D_DroneNavInFlight);
+DEFINE_STAT(STAT_P3D_DroneNavCompleted);
+DEFINE_STAT(STAT_P3D_DroneNavSearchMs);
+DEFINE_STAT(STAT_P3D_DroneNavLatencyMs);
+DEFINE_STAT(STAT_P3D_DroneNavOctreeKB);
+
+// ===== Drone Avoidance =====
+DEFINE_STAT(STAT_P3D_DroneAvoidance);
+DEFINE_STAT(STAT_P3D_AvoidRaysPerFrame);
+DEFINE_STAT(STAT_P3D_AvoidDronesSensed);
+DEFINE_STAT(STAT_P3D_AvoidDronesOverBudget);
+DEFINE_STAT(STAT_P3D_AvoidMs);
+
+// ===== Drone Swarm =====
+DEFINE_STAT(STAT_P3D_DroneSwarm);
+DEFINE_STAT(STAT_P3D_SwarmFollowers);
+DEFINE_STAT(STAT_P3D_SwarmNeighborChecks);
+DEFINE_STAT(STAT_P3D_SwarmOverlapPairs);
+DEFINE_STAT(STAT_P3D_SwarmSolverMs);
+DEFINE_STAT(STAT_P3D_SwarmSlotErrorCm);
+
+// ===== Frame Counters =====
+DEFINE_STAT(STAT_P3D_SweepsPerFrame);
+DEFINE_STAT(STAT_P3D_OffsetsPerFrame);
+DEFINE_STAT(STAT_P3D_PossessionSwitchesPerFrame);
+
+// ===== Significance =====
+DEFINE_STAT(STAT_P3D_SignificanceUpdate);
+DEFINE_STAT(STAT_P3D_SigCritical);
+DEFINE_STAT(STAT_P3D_SigHigh);
+DEFINE_STAT(STAT_P3D_SigMedium);
+DEFINE_STAT(STAT_P3D_SigLow);
+DEFINE_STAT(STAT_P3D_SigDormant);
+DEFINE_STAT(STAT_P3D_SigSavedMs);
+DEFINE_STAT(STAT_P3D_SigAnimFrozen);
+
+// ===== Input =====
+DEFINE_STAT(STAT_P3D_LookSamples);
+DEFINE_STAT(STAT_P3D_InputSamplesDropped);
+DEFINE_STAT(STAT_P3D_LookLatencyMs);
+
+namespace P3DCounters
+{
+	uint64 SceneQueries = 0;
+	uint64 Offsets = 0;
+	uint64 PossessionSwitches = 0;
+	uint64 PawnTickCycles = 0;
+	uint64 MassCycles = 0;
+	uint64 NetStateBits = 0;
+	uint64 NetMoveBits = 0;
+	uint64 NetCorrections = 0;
+	uint64 NetReplayedMoves = 0;
+	uint64 NetRejectedMoves = 0;
+}
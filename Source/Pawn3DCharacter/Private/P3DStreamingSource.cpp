@@ -0,0 +1,38 @@
+﻿#include "P3DStreamingSource.h"
+
+float P3DStreaming::BuildPredictiveShapes(const FP3DStreamingPrediction& Settings, const FVector& Velocity,
+	const FVector& ViewDirection, TArray<FStreamingSourceShape>& OutShapes)
+{
+	const float Speed = Velocity.Size();
+	if (!Settings.bEnabled || Speed < Settings.MinPredictionSpeed)
+	{
+		return 0.f;
+	}
+
+	// 속도 방향 + 시선 방향(시선만 돌리고 아직 안 움직인 쪽도 미리)
+	const FVector Direction = FMath::Lerp(Velocity / Speed, ViewDirection.GetSafeNormal(), Settings.ViewDirectionWeight).GetSafeNormal();
+	if (Direction.IsNearlyZero())
+	{
+		return 0.f;
+	}
+
+	const float LookAhead = FMath::Min(Speed * Settings.LookAheadSeconds, Settings.MaxLookAheadDistance);
+	const float SpeedAlpha = FMath::Clamp(Speed / Settings.FullPredictionSpeed, 0.f, 1.f);
+
+	// 현재 위치: 빠를수록 범위를 줄여서 지나간 셀이 일찍 빠지게
+	FStreamingSourceShape& Current = OutShapes.AddDefaulted_GetRef();
+	Current.bUseGridLoadingRange = true;
+	Current.LoadingRangeScale = FMath::Lerp(1.f, Settings.BehindLoadingRangeScale, SpeedAlpha);
+
+	// 앞쪽: 예측 경로를 따라 그리드 로딩 범위 그대로
+	const int32 NumAhead = FMath::Clamp(Settings.NumAheadShapes, 1, 4);
+	for (int32 i = 1; i <= NumAhead; ++i)
+	{
+		FStreamingSourceShape& Ahead = OutShapes.AddDefaulted_GetRef();
+		Ahead.bUseGridLoadingRange = true;
+		Ahead.LoadingRangeScale = 1.f;
+		Ahead.Location = Direction * (LookAhead * i / NumAhead);
+	}
+
+	return LookAhead;
+}
@@ -0,0 +1,250 @@
+﻿#include "P3DWorldBlockers.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+
+// 판정
+
+bool FP3DWorldBlockerTracker::IsBlocker(const UPrimitiveComponent& Component)
+{
+	if (Component.Mobility == EComponentMobility::Movable) return false;
+	if (!Component.IsQueryCollisionEnabled()) return false;
+
+	// 내비 옥트리 막힘 판정(MakeWorldBlockedTest)과 같은 오브젝트 타입
+	const ECollisionChannel ObjectType = Component.GetCollisionObjectType();
+	return ObjectType == ECC_WorldStatic || ObjectType == ECC_WorldDynamic;
+}
+
+FBox FP3DWorldBlockerTracker::GetBlockerBounds(const AActor& Actor, bool& bOutMovable)
+{
+	FBox Bounds(ForceInit);
+	bOutMovable = false;
+
+	if (Actor.IsA<APawn>() || !Actor.GetActorEnableCollision()) return Bounds;
+
+	// 등록 해제 중(파괴/레벨 제거)에도 마지막 바운드가 남아 있으므로 Bounds 멤버를 그대로 씀
+	Actor.ForEachComponent<UPrimitiveComponent>(false, [&Bounds, &bOutMovable](const UPrimitiveComponent* Component)
+	{
+		if (!IsBlocker(*Component)) return;
+
+		Bounds += Component->Bounds.GetBox();
+		bOutMovable |= Component->Mobility == EComponentMobility::Stationary;
+	});
+
+	return Bounds;
+}
+
+// 시작 / 정지
+
+void FP3DWorldBlockerTracker::Start(UWorld& InWorld, FOnChanged InOnChanged)
+{
+	Stop();
+
+	World = &InWorld;
+	OnChanged = MoveTemp(InOnChanged);
+
+	SpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FP3DWorldBlockerTracker::HandleActorSpawned));
+	DestroyedHandle = InWorld.AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FP3DWorldBlockerTracker::HandleActorDestroyed));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FP3DWorldBlockerTracker::HandleLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FP3DWorldBlockerTracker::HandleLevelRemoved);
+
+	// 이미 있는 지형은 생성/로드 결과에 들어가 있음 → 추적만
+	for (const ULevel* Level : InWorld.GetLevels())
+	{
+		if (Level)
+		{
+			AddLevel(*Level);
+		}
+	}
+}
+
+void FP3DWorldBlockerTracker::Stop()
+{
+	if (UWorld* OldWorld = World.Get())
+	{
+		OldWorld->RemoveOnActorSpawnedHandler(SpawnedHandle);
+		OldWorld->RemoveOnActorDestroyededHandler(DestroyedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	SpawnedHandle.Reset();
+	DestroyedHandle.Reset();
+	LevelAddedHandle.Reset();
+	LevelRemovedHandle.Reset();
+
+	for (const TPair<TWeakObjectPtr<AActor>, FTracked>& Pair : Tracked)
+	{
+		if (USceneComponent* Root = Pair.Value.Root.Get())
+		{
+			Root->TransformUpdated.Remove(Pair.Value.MovedHandle);
+		}
+	}
+	Tracked.Reset();
+	Moved.Reset();
+
+	World.Reset();
+	OnChanged = nullptr;
+}
+
+void FP3DWorldBlockerTracker::Flush()
+{
+	if (Moved.Num() == 0) return;
+
+	for (const TWeakObjectPtr<AActor>& WeakActor : Moved)
+	{
+		const AActor* Actor = WeakActor.Get();
+		FTracked* Entry = Actor ? Tracked.Find(Actor) : nullptr;
+		if (!Entry) continue;
+
+		bool bMovable = false;
+		const FBox NewBounds = GetBlockerBounds(*Actor, bMovable);
+
+		// 멀리 움직였으면 합보다 두 박스가 작음
+		Notify(Entry->Bounds);
+		if (NewBounds.IsValid && !(NewBounds == Entry->Bounds))
+		{
+			Notify(NewBounds);
+		}
+		Entry->Bounds = NewBounds;
+	}
+	Moved.Reset();
+}
+
+// 이벤트
+
+void FP3DWorldBlockerTracker::HandleActorSpawned(AActor* Actor)
+{
+	if (!Actor) return;
+
+	bool bMovable = false;
+	const FBox Bounds = GetBlockerBounds(*Actor, bMovable);
+	if (!Bounds.IsValid) return;
+
+	if (bMovable)
+	{
+		Track(*Actor, Bounds);
+	}
+	Notify(Bounds);
+}
+
+void FP3DWorldBlockerTracker::HandleActorDestroyed(AActor* Actor)
+{
+	if (!Actor) return;
+
+	bool bMovable = false;
+	const FBox Bounds = GetBlockerBounds(*Actor, bMovable);
+	Notify(Bounds);
+
+	// 아직 Flush 안 된 이동이 있으면 추적 중이던 옛 자리도
+	FBox TrackedBounds(ForceInit);
+	if (Untrack(*Actor, TrackedBounds) && !(TrackedBounds == Bounds))
+	{
+		Notify(TrackedBounds);
+	}
+}
+
+void FP3DWorldBlockerTracker::HandleLevelAdded(ULevel* Level, UWorld* InWorld)
+{
+	if (!Level || InWorld != World.Get()) return;
+
+	const FBox Bounds = AddLevel(*Level);
+	if (Bounds.IsValid)
+	{
+		Notify(Bounds);
+	}
+}
+
+void FP3DWorldBlockerTracker::HandleLevelRemoved(ULevel* Level, UWorld* InWorld)
+{
+	// Level == nullptr → 월드 정리 중(전체 제거)
+	if (!Level || InWorld != World.Get()) return;
+
+	FBox Bounds(ForceInit);
+	for (const AActor* Actor : Level->Actors)
+	{
+		if (!Actor) continue;
+
+		bool bMovable = false;
+		Bounds += GetBlockerBounds(*Actor, bMovable);
+
+		FBox TrackedBounds(ForceInit);
+		if (Untrack(*Actor, TrackedBounds))
+		{
+			Bounds += TrackedBounds;
+		}
+	}
+
+	if (Bounds.IsValid)
+	{
+		Notify(Bounds);
+	}
+}
+
+void FP3DWorldBlockerTracker::HandleRootMoved(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport)
+{
+	// 자식 컴포넌트 바운드까지 갱신된 뒤에 읽도록 Flush로 미룸
+	if (AActor* Owner = Component ? Component->GetOwner() : nullptr)
+	{
+		Moved.Add(Owner);
+	}
+}
+
+// 추적
+
+FBox FP3DWorldBlockerTracker::AddLevel(const ULevel& Level)
+{
+	FBox Bounds(ForceInit);
+	for (AActor* Actor : Level.Actors)
+	{
+		if (!Actor) continue;
+
+		bool bMovable = false;
+		const FBox ActorBounds = GetBlockerBounds(*Actor, bMovable);
+		if (!ActorBounds.IsValid) continue;
+
+		if (bMovable)
+		{
+			Track(*Actor, ActorBounds);
+		}
+		Bounds += ActorBounds;
+	}
+	return Bounds;
+}
+
+void FP3DWorldBlockerTracker::Track(AActor& Actor, const FBox& Bounds)
+{
+	USceneComponent* Root = Actor.GetRootComponent();
+	if (!Root || Tracked.Contains(&Actor)) return;
+
+	FTracked& Entry = Tracked.Add(&Actor);
+	Entry.Bounds = Bounds;
+	Entry.Root = Root;
+	Entry.MovedHandle = Root->TransformUpdated.AddRaw(this, &FP3DWorldBlockerTracker::HandleRootMoved);
+}
+
+bool FP3DWorldBlockerTracker::Untrack(const AActor& Actor, FBox& OutBounds)
+{
+	FTracked Entry;
+	if (!Tracked.RemoveAndCopyValue(&Actor, Entry)) return false;
+
+	if (USceneComponent* Root = Entry.Root.Get())
+	{
+		Root->TransformUpdated.Remove(Entry.MovedHandle);
+	}
+	Moved.Remove(&Actor);
+
+	OutBounds = Entry.Bounds;
+	return true;
+}
+
+void FP3DWorldBlockerTracker::Notify(const FBox& Bounds) const
+{
+	if (OnChanged && Bounds.IsValid)
+	{
+		OnChanged(Bounds);
+	}
+}
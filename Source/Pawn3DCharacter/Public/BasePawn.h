@@ -4,9 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "P3DSignificanceSubsystem.h"
+#include "P3DInputBuffer.h"
+#include "P3DNetMovement.h"
+#include "P3DRollback.h"
+#include "P3DReplay.h"
 #include "BasePawn.generated.h"
 
 class UCapsuleComponent;
+class UBasePawnMovementComponent;
+class UP3DNetMovementComponent;
+class UP3DReplaySubsystem;
 class USkeletalMeshComponent;
 class USpringArmComponent; // 스프링 암 관련 클래스 헤더
 class UCameraComponent; // 카메라 관련 클래스 전방 선언
@@ -18,7 +26,7 @@ class UEnhancedInputComponent;
 struct FInputActionValue;
 
 UCLASS()
-class PAWN3DCHARACTER_API ABasePawn : public APawn
+class PAWN3DCHARACTER_API ABasePawn : public APawn, public IP3DSignificanceTarget, public IP3DNetMovementPawn, public IP3DRollbackPawn, public IP3DReplayInputTarget
 {
 	GENERATED_BODY()
 
@@ -29,15 +37,45 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void PossessedBy(AController* NewController) override;
+	virtual void NotifyActorBeginOverlap(AActor* OtherActor) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	// 빙의 해제 시 입력 컴포넌트를 유지 → 재빙의 때 SetupPlayerInputComponent 재바인딩 생략
+	virtual void DestroyPlayerInputComponent() override;
+
 public:	
 	virtual void Tick(float DeltaTime) override;
+
+	// ===== IP3DSignificanceTarget =====
+	virtual bool IsSignificanceIdle() const override;
+	virtual USkeletalMeshComponentBudgeted* GetSignificanceAnimMesh() const override;
+
+	// ===== IP3DNetMovementPawn =====
+	virtual void NetGatherInput(float DeltaTime, FP3DNetMoveInput& OutInput) override;
+	virtual void NetSimulateMove(const FP3DNetMoveInput& Input) override;
+	virtual void NetSaveState(FP3DNetMoveState& OutState) const override;
+	virtual void NetRestoreState(const FP3DNetMoveState& State) override;
+	virtual void NetApplyProxyTransform(const FVector& Location, const FRotator& Rotation, float DeltaTime) override;
+
+	// ===== IP3DRollbackPawn =====
+	// (카메라 피치는 로컬 전용이라 재시뮬에서 제외)
+	virtual FP3DSnapshotHistory& GetSnapshotHistory() override { return SnapshotHistory; }
+	virtual void CaptureSnapshot(FP3DPawnSnapshot& Out) const override;
+	virtual void RestoreSnapshotState(const FP3DPawnSnapshot& Snapshot) override;
+	virtual void ApplySnapshotInput(const FP3DPawnSnapshot& Snapshot) override;
+	virtual void ResimulateFrame(float DeltaTime, bool bInputEnabled) override;
+
+	// ===== IP3DReplayInputTarget =====
+	virtual void ReplayInput(EP3DReplayInput Input, const FVector2D& Value) override;
+
 	// ===== 충돌 캡슐 =====
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UCapsuleComponent* CapsuleComp;
 
 	// ===== 스켈레탈 메시 =====
+	// (USkeletalMeshComponentBudgeted: 애님 Tick은 AnimationBudgetAllocator가 예산 안에서 관리)
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USkeletalMeshComponent* MeshComp;
 	// 스프링 암 컴포넌트
@@ -46,10 +84,22 @@ public:
 	// 카메라 컴포넌트
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera")
 	UCameraComponent* CameraComp;
+
+	// 캡슐 스윕 이동(미끄러짐/계단/바닥 캐시) - CharacterMovementComponent 대신
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UBasePawnMovementComponent* MovementComp;
+
+	// 네트워크 게임: 서버 권한 이동 + 클라 예측/보정 + 프록시 보간(독립 실행이면 아무것도 안 함)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UP3DNetMovementComponent* NetMovement;
 	
 	UPROPERTY(EditAnywhere, Category = "Move")
 	float NormalSpeed = 600.f;
 
+	// 끄면 기존 방식(스윕 없는 AddActorLocalOffset, 속도는 위치 차이로 계산)
+	UPROPERTY(EditAnywhere, Category = "Move")
+	bool bUseMovementComponent = true;
+
 	UPROPERTY(EditAnywhere, Category = "Look")
 	float MouseSensitivity = 1.2f;
 
@@ -62,6 +112,14 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Look")
 	float PitchMax = 20.f;
 
+	// 프레임 안에 누적된 마우스 델타에 거는 스무딩(기본: 없음)
+	UPROPERTY(EditAnywhere, Category = "Look")
+	FP3DLookSmoothingSettings LookSmoothing;
+
+	// 드론 ↔ 캐릭터 전환 시 입력 바인딩 캐시(재빙의 스파이크 제거)
+	UPROPERTY(EditAnywhere, Category = "Input")
+	bool bCacheInputBindings = true;
+
 	// ===== 애니용 =====
 	UPROPERTY(BlueprintReadOnly, Category = "Anim")
 	bool bIsMoving = false;
@@ -83,6 +141,13 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void Notify_InteractEnd();
 
+	// ===== Scripted Input (벤치마크/자동화) =====
+	// 켜져 있으면 빙의 없이도 입력 적용(IsLocallyControlled 조건 대신)
+	void SetScriptedInputEnabled(bool bEnable) { bScriptedInput = bEnable; }
+
+	// Enhanced Input 콜백과 같은 샘플 버퍼로 주입
+	void InjectScriptedInput(const FP3DScriptedInput& Input);
+
 private:
 
 	// ===== Input Callbacks (FInputActionValue 사용) =====
@@ -94,5 +159,42 @@ private:
 	// ===== Cached Input =====
 	FVector2D CachedMoveInput = FVector2D::ZeroVector;
 	FVector2D CachedLookInput = FVector2D::ZeroVector;
+
+	// 기존 방식(bUseMovementComponent=false)의 속도 계산용
 	FVector PrevLocation = FVector::ZeroVector;
+
+	// 입력 콜백 → Tick 사이 샘플 버퍼(Look 누적, Move 순서 보존)
+	FP3DPawnInputBuffer InputBuffer;
+
+	// 아직 적용 안 된 Look 중 가장 오래된 입력 시각(지연 측정)
+	double PendingLookTimestamp = 0.0;
+
+	bool bScriptedInput = false;
+
+	// 롤백용 프레임별 상태/입력(p3d.Rollback.Record)
+	FP3DSnapshotHistory SnapshotHistory;
+
+	void ConsumeBufferedInput(float DeltaTime);
+
+	// 이번 프레임 이동/회전 입력 적용 여부(조종 중이거나 스크립트 입력, Interact 중 아님)
+	bool CanApplyMoveInput() const { return (IsLocallyControlled() || bScriptedInput) && !bIsInteracting; }
+
+	// 한 프레임 이동/회전(로컬 Tick과 네트워크 입력 시뮬 공용)
+	void SimulateMove(float DeltaTime, bool bCanControl);
+
+	// CurrentSpeed2D 기준 bIsMoving 히스테리시스
+	void UpdateMovingState();
+
+	// 카메라 피치(스프링 암, 로컬 전용)
+	void AddArmPitch(float PitchDelta);
+
+	// 중요도(Tick 간격/Dormant) 관리
+	UPROPERTY(Transient)
+	TObjectPtr<UP3DSignificanceSubsystem> SignificanceSubsystem = nullptr;
+
+	void WakeSignificance();
+
+	// 입력 녹화/재생(콜백 첫 줄에서 FilterInput)
+	UPROPERTY(Transient)
+	TObjectPtr<UP3DReplaySubsystem> ReplaySubsystem = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,103 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "BasePawnMovementComponent.generated.h"
+
+// =========================================================
+// BasePawn 이동 컴포넌트 (캡슐, 키네마틱)
+// - CharacterMovementComponent 대신 쓰는 가벼운 지상 이동: 스윕 + 미끄러짐 + 계단 오르기 + 중력 낙하
+// - 바닥 캐시: 같은 프리미티브 위에서 일정 거리 미만으로 움직이는 동안은 바닥 재탐색 생략
+// - 네트워크 예측은 UP3DNetMovementComponent가 MoveStep을 입력 단위로 다시 돌리는 방식, 루트모션/물리 상호작용 없음
+// =========================================================
+
+// 마지막으로 찾은 바닥
+struct FP3DPawnFloor
+{
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+
+	FVector Normal = FVector::UpVector;
+
+	// 캡슐 바닥 ~ 바닥면 거리
+	float Distance = 0.f;
+
+	bool bBlockingHit = false;
+	bool bWalkable = false;
+
+	// 캐시 판정용: 탐색 시점의 바닥 프리미티브 위치, 탐색 이후 누적 이동 거리
+	FVector ComponentLocation = FVector::ZeroVector;
+	float TraveledSinceQuery = 0.f;
+
+	void Clear() { *this = FP3DPawnFloor(); }
+};
+
+UCLASS(ClassGroup = Movement, meta = (BlueprintSpawnableComponent))
+class PAWN3DCHARACTER_API UBasePawnMovementComponent : public UPawnMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UBasePawnMovementComponent();
+
+	// 한 프레임 이동(ABasePawn::Tick에서 직접 호출, 자체 Tick 없음)
+	// DesiredDelta: 입력으로 원하는 수평 이동량(월드). 0이어도 중력/바닥 처리를 위해 매 프레임 호출
+	void MoveStep(const FVector& DesiredDelta, float DeltaTime);
+
+	bool IsOnGround() const { return bOnGround; }
+	float GetSpeed2D() const { return Velocity.Size2D(); }
+	const FP3DPawnFloor& GetFloor() const { return Floor; }
+
+	// 텔레포트 등 외부에서 위치를 바꿨으면 호출(다음 프레임 바닥 재탐색)
+	void InvalidateFloor();
+
+	float GetVerticalSpeed() const { return VerticalSpeed; }
+
+	// 네트워크 보정(서버 상태로 되감기): 수직 속도/접지 복원 + 바닥 재탐색
+	void RestoreMoveState(float InVerticalSpeed, bool bInOnGround);
+
+	// 이 높이 이하의 턱은 올라감
+	UPROPERTY(EditAnywhere, Category = "Floor")
+	float MaxStepHeight = 45.f;
+
+	// 걸을 수 있는 바닥 노멀 Z (0.71 ≒ 45도)
+	UPROPERTY(EditAnywhere, Category = "Floor")
+	float WalkableFloorZ = 0.71f;
+
+	// 바닥 위에 띄워두는 간격(떨림 방지)
+	UPROPERTY(EditAnywhere, Category = "Floor")
+	float FloorGap = 2.f;
+
+	// 바닥 캐시: 같은 프리미티브 위에서 마지막 탐색 이후 이 거리 미만이면 재탐색 생략(0이면 매 프레임 탐색)
+	UPROPERTY(EditAnywhere, Category = "Floor")
+	float FloorCacheDistance = 25.f;
+
+	UPROPERTY(EditAnywhere, Category = "Falling")
+	float MaxFallSpeed = 4000.f;
+
+protected:
+	// SafeMove/Slide/Depenetration이 전부 이곳을 지나감 → 스윕 수 집계
+	virtual bool MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit = nullptr, ETeleportType Teleport = ETeleportType::None) override;
+
+private:
+	// 경사 바닥 위에서는 수평 이동을 바닥면에 투영(수평 속도 유지)
+	FVector ProjectToFloor(const FVector& Delta) const;
+
+	// 벽에 막힌 뒤 남은 이동: 턱이면 올라가고 아니면 미끄러짐(올라갔으면 true, 바닥도 갱신됨)
+	bool ResolveBlockingHit(const FVector& Delta, const FHitResult& Hit);
+	bool StepUp(const FVector& Delta, const FHitResult& WallHit);
+
+	bool CanReuseFloor() const;
+	void FindFloor();
+	void SetFloorFromHit(const FHitResult& Hit, float Distance);
+
+	// 바닥에 붙이기 / 낙하
+	void UpdateVertical(float DeltaTime);
+
+	bool IsWalkable(const FHitResult& Hit) const;
+
+	FP3DPawnFloor Floor;
+	bool bOnGround = false;
+
+	// 낙하/착지용 수직 속도(지면 위에서는 0)
+	float VerticalSpeed = 0.f;
+};
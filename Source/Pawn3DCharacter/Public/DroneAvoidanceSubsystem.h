@@ -0,0 +1,89 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DroneAvoidanceSubsystem.generated.h"
+
+class ADronePawn;
+
+// =========================================================
+// 드론 장애물 회피 감지 (AI/군집 드론 공용)
+// - 등록된 드론마다 진행 방향 기준 레이 팬(정면, 좌우 대각, 측면, 위/아래 대각)을 모아서
+//   프레임당 한 번 ParallelFor로 라인트레이스(월드 Tick 그룹이 끝난 뒤라 물리 결과 고정, 씬 질의는 읽기 전용)
+// - 레이 길이 = 속도 x p3d.DroneAvoid.LookAheadSeconds (MinRayLength~MaxRayLength)
+// - 프레임 예산 p3d.DroneAvoid.RayBudget: 우선순위(속도 x 근접도 + 오래 못 본 프레임) 순으로
+//   전체 팬 → 축소 팬(정면 3개) → 이번 프레임 생략(지난 보정을 천천히 줄이며 유지)
+// - 결과: 드론별 월드 방향 회피 보정(크기 0~1) → ADronePawn이 다음 입력 소비 때 이동/상하 입력에 섞음
+// - 디버그: p3d.DroneAvoid.Debug 1 (맞은 레이 빨강, 빈 레이 초록)
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UDroneAvoidanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterDrone(ADronePawn* Drone);
+	void UnregisterDrone(ADronePawn* Drone);
+
+	bool IsRegistered(const ADronePawn* Drone) const { return Drones.Contains(Drone); }
+	int32 GetNumDrones() const { return Drones.Num(); }
+
+	// 마지막 Tick 집계(벤치마크용)
+	struct FFrameStats
+	{
+		int32 Rays = 0;
+		int32 DronesSensed = 0;
+		int32 DronesOverBudget = 0;
+		double Ms = 0.0;
+	};
+
+	const FFrameStats& GetLastFrameStats() const { return LastFrame; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FRay
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector Dir = FVector::ForwardVector;
+		float Length = 0.f;
+		int32 Slot = INDEX_NONE;
+		uint8 FanIndex = 0;
+	};
+
+	// 1) 속도/우선순위 → 2) 예산 안에서 레이 배정 → 3) 병렬 트레이스 → 4) 드론별 보정
+	void UpdateKinematics(float DeltaTime);
+	void BuildRays();
+	void TraceRays();
+	void ResolveCorrections(float DeltaTime);
+	void DrawDebugRays() const;
+
+	void RemoveSlot(int32 Slot);
+
+	// ===== 등록 드론(SoA) =====
+	UPROPERTY()
+	TArray<TObjectPtr<ADronePawn>> Drones;
+
+	TArray<float> Radius;
+	TArray<FVector> LastLocation;
+	TArray<FVector> Velocity;
+	TArray<FVector> Correction;
+	TArray<float> Urgency;            // 지난 감지의 가장 가까운 장애물 근접도(0~1)
+	TArray<uint16> FramesSinceSensed;
+
+	// ===== 프레임 스크래치(용량 유지) =====
+	TArray<float> Priority;
+	TArray<int32> Order;
+	TArray<uint8> FanSize;            // 0 = 이번 프레임 생략
+	TArray<int32> FirstRay;
+	TArray<FRay> Rays;
+	TArray<float> HitDistance;        // 안 맞으면 FRay::Length
+
+	FFrameStats LastFrame;
+};
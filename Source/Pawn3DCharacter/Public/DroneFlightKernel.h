@@ -0,0 +1,72 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+// =========================================================
+// 드론 비행 적분 커널
+// - ADronePawn의 튜닝 값/상태를 액터 없이 다루기 위한 POD 묶음
+// - 개별 Tick 경로와 배치 시뮬(UDroneSimSubsystem)이 같은 식을 공유
+// =========================================================
+
+// ADronePawn UPROPERTY에서 복사해오는 튜닝 파라미터
+struct FDroneFlightParams
+{
+	bool  bEnableGravity = true;
+	float GravityAccel = -980.f;
+
+	float GroundProbeDistance = 12.f;
+	float GroundSnapMax = 20.f;
+	float GroundStickForce = 2500.f;
+	float CoyoteTime = 0.08f;
+	float GroundedTolerance = 2.0f;
+	float WalkableFloorZ = 0.6f;
+
+	float ThrustAccel = 2200.f;
+	float ThrustDrag = 6.0f;
+	float MaxRiseSpeed = 900.f;
+	float MaxFallSpeed = 2200.f;
+
+	float NormalSpeed = 900.f;
+	float AirControlMultiplier = 0.4f;
+};
+
+// 프레임 간에 유지되는 비행 상태
+struct FDroneFlightState
+{
+	float VerticalVelocity = 0.f;     // cm/s
+	bool  bGrounded = false;
+	float TimeSinceGrounded = 999.f;  // 코요테 누적
+};
+
+// 바닥 탐색 결과 요약(FHitResult 전체 대신 적분에 필요한 값만)
+struct FDroneGroundSample
+{
+	bool  bHitGround = false;
+	bool  bIsFloor = false;
+	float Gap = 999999.f;             // 스피어 표면 ~ 바닥 틈(근사)
+
+	// Gap + 바닥 노멀 기준 "진짜 접지"
+	bool IsActuallyGrounded(const FDroneFlightParams& Params) const
+	{
+		return bHitGround && bIsFloor && (Gap <= Params.GroundedTolerance);
+	}
+};
+
+namespace P3DDroneFlight
+{
+	// 접지 확정 + 코요테 타임 갱신
+	PAWN3DCHARACTER_API void UpdateGrounded(const FDroneFlightParams& Params, const FDroneGroundSample& Ground, float DeltaTime, FDroneFlightState& State);
+
+	// 공중이면 AirControlMultiplier가 적용된 수평 속도
+	PAWN3DCHARACTER_API float GetHorizontalSpeed(const FDroneFlightParams& Params, const FDroneFlightState& State);
+
+	// 중력 + 추진(가속/감속) + 스틱/스냅 → 이번 스텝의 월드 DeltaZ
+	PAWN3DCHARACTER_API float IntegrateVertical(const FDroneFlightParams& Params, const FDroneGroundSample& Ground, float DeltaTime, float UpDownInput, FDroneFlightState& State);
+
+	// 공중에서 중력과 맞서는 UpDown 입력(-GravityAccel / ThrustAccel, 0~1)
+	// 스크립트 조종(경로 따라가기/군집/벤치마크)의 고도 제어 피드포워드
+	PAWN3DCHARACTER_API float GetHoverInput(const FDroneFlightParams& Params);
+
+	// 수직 이동이 막혔을 때(바닥/천장) 상태 정리
+	PAWN3DCHARACTER_API void OnVerticalBlocked(const FDroneFlightParams& Params, float ImpactNormalZ, FDroneFlightState& State);
+}
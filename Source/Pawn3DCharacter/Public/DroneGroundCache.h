@@ -0,0 +1,76 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+class UPrimitiveComponent;
+struct FHitResult;
+
+// =========================================================
+// 드론 바닥 탐색 캐시 (XY 격자 셀 단위)
+// - 정적(Mobility Static + WorldStatic 채널) 지오메트리에서 얻은 "바닥" Hit만 저장
+// - 셀 안에서는 바닥을 평면으로 보고 높이를 외삽해서 Hit를 재구성
+// - 조회 때 컴포넌트가 움직일 수 있게 바뀌었거나 수명(MaxEntryAge)이 지났으면 버리고 재탐색
+// - 블로커 스폰/파괴/이동, 레벨 추가/제거(UDroneSimSubsystem → InvalidateBox) 또는 명시적 무효화 시 비움
+// =========================================================
+struct FDroneGroundCell
+{
+	// 스윕 중심이 바닥에 닿은 위치(Hit.Location) + 바닥 노멀
+	FVector ContactLocation = FVector::ZeroVector;
+	FVector ImpactPoint = FVector::ZeroVector;
+	FVector ImpactNormal = FVector::UpVector;
+
+	// 어떤 탐색 모양으로 얻은 값인지(반지름이 다르면 재사용 불가)
+	float ProbeRadius = 0.f;
+
+	// WalkableFloorZ 기준 분류
+	bool bWalkable = false;
+
+	// 저장 시각(FDroneGroundCache::Advance 누적 시간)
+	double StoredTime = 0.0;
+
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+};
+
+class PAWN3DCHARACTER_API FDroneGroundCache
+{
+public:
+	// 캐시 조회 결과
+	enum class ELookup : uint8
+	{
+		Miss,       // 셀 없음/조건 불만족 → 실제 탐색 필요
+		Hit,        // 탐색 범위 안에 바닥
+		NoGround,   // 셀 바닥이 탐색 범위 밖(=탐색해도 miss)
+	};
+
+	void SetCellSize(float InCellSize);
+	float GetCellSize() const { return CellSize; }
+
+	// 셀 수명(초, 0 이하 = 무제한) / 캐시 시계 진행(소유자 Tick에서)
+	void SetMaxEntryAge(float InMaxEntryAge) { MaxEntryAge = InMaxEntryAge; }
+	void Advance(float DeltaTime) { Now += DeltaTime; }
+
+	// Start에서 아래로 TraceLen 만큼 탐색했을 때의 결과를 캐시로 재구성
+	// MaxVerticalDrift: 셀 바닥에서 이만큼 넘게 떨어져 있으면 재탐색
+	// 쓸 수 없게 된 셀(바닥 사라짐/움직일 수 있게 바뀜/수명 초과)은 여기서 제거
+	ELookup Lookup(const FVector& Start, float TraceLen, float ProbeRadius, float MaxVerticalDrift, FHitResult& OutHit);
+
+	// 실제 탐색 결과 저장(정적 + 바닥 Hit만)
+	void Store(const FHitResult& Hit, float ProbeRadius, float WalkableFloorZ);
+
+	void Invalidate();
+	void InvalidateBox(const FBox& Box);
+
+	int32 Num() const { return Cells.Num(); }
+
+private:
+	FIntPoint ToCell(const FVector& Location) const;
+
+	// 움직이지 않는 월드 지오메트리인가(저장/조회 공통 기준)
+	static bool IsStaticGround(const UPrimitiveComponent& Component);
+
+	TMap<FIntPoint, FDroneGroundCell> Cells;
+	float CellSize = 50.f;
+
+	float MaxEntryAge = 0.f;
+	double Now = 0.0;
+};
@@ -0,0 +1,122 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "DroneGroundCache.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+struct FHitResult;
+
+// =========================================================
+// 오프라인 베이크 바닥 높이맵 (UP3DBakeGroundCommandlet → Content/Baked/Heightfields/<맵>.p3dh)
+// - XY 셀마다 위에서 아래로 드론 탐색 모양(스피어)을 스윕한 결과: 접촉 높이 + 양자화 노멀 + 플래그
+// - 타일(TileSize x TileSize 셀) 단위로 저장, 바닥이 없는 타일은 생략(타일 테이블에 INDEX_NONE)
+// - 런타임: 파일을 메모리 매핑(pak 안이면 통째로 읽음) → 셀 조회 O(1), 스윕 없음
+// - Dynamic(움직이는 물체)/Ambiguous(겹친 층/경사 급변) 셀과 높이맵 아래로 내려간 경우는 실제 스윕
+// =========================================================
+
+// 셀 플래그
+enum class EDroneHeightCellFlags : uint8
+{
+	None      = 0,
+	Ground    = 1 << 0,   // 바닥 있음(없으면 아래로 끝까지 빈 곳)
+	Walkable  = 1 << 1,   // 노멀 Z >= WalkableFloorZ
+	Dynamic   = 1 << 2,   // 맞은 물체가 Static이 아님 → 런타임 스윕
+	Ambiguous = 1 << 3,   // 아래에 층이 더 있음/셀 안 높이 차가 큼 → 런타임 스윕
+};
+ENUM_CLASS_FLAGS(EDroneHeightCellFlags);
+
+// 셀 1개 = 6바이트
+struct FDroneHeightCell
+{
+	uint16 Height = 0;    // 타일 BaseZ + Height * HeightStep
+	int8 NormalX = 0;     // 노멀 XY * 127 (Z는 복원, 바닥이라 항상 위쪽)
+	int8 NormalY = 0;
+	uint8 Flags = 0;
+	uint8 Pad = 0;
+};
+static_assert(sizeof(FDroneHeightCell) == 6, "FDroneHeightCell은 파일 포맷");
+
+// 파일 헤더(고정 크기) 다음에 타일 테이블(int32 x NumTilesX*NumTilesY), 그 다음 타일들
+struct FDroneHeightfieldHeader
+{
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	uint16 TileSize = 0;          // 타일 한 변 셀 수
+	float CellSize = 0.f;         // cm
+	float HeightStep = 0.f;       // cm
+	float ProbeRadius = 0.f;      // 베이크한 스윕 반지름(런타임 탐색 모양과 같아야 사용)
+	float WalkableFloorZ = 0.f;
+	float TopZ = 0.f;             // 베이크 스윕 시작 높이(레벨 바운드 위)
+	int32 MinCellX = 0;           // 첫 타일의 첫 셀 좌표
+	int32 MinCellY = 0;
+	int32 NumTilesX = 0;
+	int32 NumTilesY = 0;
+	int32 NumStoredTiles = 0;
+};
+
+// 타일 = BaseZ + 셀 배열
+struct FDroneHeightTileHeader
+{
+	float BaseZ = 0.f;
+	uint32 Pad = 0;
+};
+
+class PAWN3DCHARACTER_API FDroneGroundHeightfield
+{
+public:
+	using ELookup = FDroneGroundCache::ELookup;
+
+	static constexpr uint32 Magic = 0x48443350; // "P3DH"
+	static constexpr uint16 Version = 1;
+
+	FDroneGroundHeightfield() = default;
+	~FDroneGroundHeightfield();
+
+	FDroneGroundHeightfield(const FDroneGroundHeightfield&) = delete;
+	FDroneGroundHeightfield& operator=(const FDroneGroundHeightfield&) = delete;
+
+	// 맵 이름 → Content/Baked/Heightfields/<맵>.p3dh
+	static FString GetPathForMap(const FString& MapName);
+
+	// 메모리 매핑, 안 되면(pak 등) 통째로 읽기
+	bool Load(const FString& Path, FString& OutError);
+	void Unload();
+
+	bool IsLoaded() const { return Data != nullptr; }
+	bool IsMemoryMapped() const { return MappedRegion.IsValid(); }
+	int64 GetSizeBytes() const { return Size; }
+	const FDroneHeightfieldHeader& GetHeader() const { return Header; }
+
+	// FDroneGroundCache::Lookup과 같은 의미(Miss = 실제 스윕 필요)
+	// Start 아래 TraceLen 안의 바닥을 셀 평면으로 재구성(Component는 비움: 정적 월드 지오메트리)
+	ELookup Lookup(const FVector& Start, float TraceLen, float ProbeRadius, FHitResult& OutHit) const;
+
+	// ===== 베이크(커맨들릿) =====
+	// 셀 배열(행 우선, NumCellsX x NumCellsY) → 타일 분할/양자화해서 파일로
+	struct FBakeCell
+	{
+		float Z = 0.f;
+		FVector3f Normal = FVector3f::UpVector;
+		EDroneHeightCellFlags Flags = EDroneHeightCellFlags::None;
+	};
+
+	static bool Save(const FString& Path, FDroneHeightfieldHeader InHeader, int32 NumCellsX, int32 NumCellsY,
+		const TArray<FBakeCell>& Cells, int64& OutBytes, FString& OutError);
+
+private:
+	// 범위 밖이면 nullptr, 생략된 타일이면 빈 셀
+	const FDroneHeightCell* FindCell(const FVector& Location, float& OutBaseZ, FVector2D& OutCenter) const;
+
+	FDroneHeightfieldHeader Header;
+	const int32* TileTable = nullptr;
+	const uint8* Tiles = nullptr;
+	int32 TileStride = 0;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray64<uint8> Loaded;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+};
@@ -0,0 +1,29 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "DroneMovementComponent.generated.h"
+
+// =========================================================
+// 드론 이동 컴포넌트
+// - 서브스텝마다 회전 + 3D 변위를 SafeMoveUpdatedComponent 한 번으로 적용
+// - 막히면 충돌면을 따라 남은 이동량만큼 미끄러짐, 미끄러지다 또 막히면 TwoWallAdjust 후 한 번 더(두 벽 모서리)
+// - 시작부터 겹쳐 있으면 SafeMove가 밀어냄(depenetration)
+// - 비행 상태/입력은 ADronePawn(+DroneFlightKernel)이 들고, 여기는 "움직이기"만 담당
+// =========================================================
+UCLASS(ClassGroup = Movement, meta = (BlueprintSpawnableComponent))
+class PAWN3DCHARACTER_API UDroneMovementComponent : public UPawnMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	UDroneMovementComponent();
+
+	// 한 서브스텝 이동
+	// OutHit: 첫 이동의 충돌, OutSlideHit: 미끄러지는 중 마지막 충돌(모서리 재미끄러짐 포함, 없으면 bBlockingHit=false)
+	void MoveStep(const FVector& Delta, const FQuat& NewRotation, float DeltaTime, FHitResult& OutHit, FHitResult& OutSlideHit);
+
+protected:
+	// SafeMove/Slide/Depenetration이 전부 이곳을 지나감 → 스윕 수 집계
+	virtual bool MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit = nullptr, ETeleportType Teleport = ETeleportType::None) override;
+};
@@ -0,0 +1,177 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+// =========================================================
+// 드론 비행용 희소 복셀 옥트리 (3D 내비게이션)
+// - 레이어 0 노드 = 4x4x4 복셀(비트마스크 uint64, 1 = 막힘), 레이어가 하나 오를 때마다 한 변 2배
+// - 노드 상태: Free(통째로 비어 있음) / Blocked(통째로 막힘) / Mixed(자식으로 나뉨)
+//   빈 공간은 큰 노드 하나로 남음 → 탐색 그래프가 작음
+// - 막힘 판정은 에이전트 반지름만큼 부풀린 박스 겹침(WorldStatic/WorldDynamic) → 복셀 중심만 지나가면 됨
+// - 생성: UP3DBakeNavCommandlet(오프라인, Content/Baked/NavOctree/<맵>.p3dn) 또는 런타임 Build
+//   변경: RebuildBox로 박스에 걸친 노드만 다시 분류(예전 자식은 버려짐, NumStaleNodes로 집계)
+// - 탐색(FindPath)은 const + 공유 상태 없음 → 옥트리가 바뀌지 않는 동안 워커 스레드에서 동시에 실행 가능
+// =========================================================
+
+enum class EDroneNavNodeState : uint8
+{
+	Free,
+	Blocked,
+	Mixed,
+};
+
+struct FDroneNavNode
+{
+	// Mixed: 레이어 0이면 LeafMasks 인덱스, 그 위면 아래 레이어에서 8개 연속 자식의 첫 인덱스
+	int32 FirstChild = INDEX_NONE;
+	uint16 X = 0;                  // 레이어 안 좌표
+	uint16 Y = 0;
+	uint16 Z = 0;
+	EDroneNavNodeState State = EDroneNavNodeState::Free;
+	uint8 Pad = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FDroneNavNode& Node)
+	{
+		Ar << Node.FirstChild << Node.X << Node.Y << Node.Z << Node.State;
+		return Ar;
+	}
+};
+
+// 탐색 그래프 정점 = 빈 노드 통째로 또는 레이어 0 노드 안의 빈 복셀 하나
+struct FDroneNavRef
+{
+	static constexpr uint8 WholeNode = 0xFF;
+
+	int32 Index = INDEX_NONE;
+	uint8 Layer = 0;
+	uint8 Voxel = WholeNode;       // 0..63 (x + 4y + 16z)
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	uint64 GetKey() const { return (uint64(Layer) << 40) | (uint64(Voxel) << 32) | uint32(Index); }
+
+	bool operator==(const FDroneNavRef& Other) const { return GetKey() == Other.GetKey(); }
+	friend uint32 GetTypeHash(const FDroneNavRef& Ref) { return ::GetTypeHash(Ref.GetKey()); }
+};
+
+enum class EDroneNavPathResult : uint8
+{
+	Success,
+	NotReady,          // 옥트리 없음
+	StartBlocked,      // 시작/목표가 막힌 곳이거나 범위 밖
+	GoalBlocked,
+	NoPath,            // 열린 목록이 빔(연결 안 됨)
+	ExpansionLimit,    // MaxExpansions 초과(예산)
+};
+
+struct FDroneNavQuery
+{
+	FVector Start = FVector::ZeroVector;
+	FVector Goal = FVector::ZeroVector;
+
+	// Theta*: 부모의 부모와 직선이 보이면 바로 연결(임의 각도 경로, 가시선 검사 비용)
+	bool bThetaStar = false;
+
+	// A* 결과를 가시선으로 당겨서 꺾임 제거
+	bool bSmooth = true;
+
+	int32 MaxExpansions = 20000;
+};
+
+struct FDroneNavPath
+{
+	EDroneNavPathResult Result = EDroneNavPathResult::NotReady;
+	TArray<FVector> Points;        // Start ... Goal
+	int32 Expansions = 0;
+};
+
+class PAWN3DCHARACTER_API FDroneNavOctree
+{
+public:
+	static constexpr uint32 Magic = 0x4E443350; // "P3DN"
+	static constexpr int32 Version = 1;
+
+	// 박스가 막혔는지(워커 스레드에서 동시에 불림)
+	using FBlockedTest = TFunction<bool(const FBox&)>;
+
+	struct FBuildSettings
+	{
+		FBox Bounds = FBox(ForceInit);
+		float VoxelSize = 50.f;
+		float AgentRadius = 45.f;
+	};
+
+	// 맵 이름 → Content/Baked/NavOctree/<맵>.p3dn
+	static FString GetPathForMap(const FString& MapName);
+
+	// 월드 겹침 검사(WorldStatic/WorldDynamic, 에이전트 반지름만큼 부풀림)
+	static FBlockedTest MakeWorldBlockedTest(const UWorld* World, float AgentRadius);
+
+	// ===== 생성/변경 =====
+	void Build(const FBuildSettings& Settings, const FBlockedTest& IsBlocked);
+
+	// 박스에 걸친 노드만 다시 분류(반환: 다시 분류한 노드 수)
+	// Box는 영향 범위 그대로 씀 → 지오메트리 바운드면 호출 쪽에서 AgentRadius만큼 넓혀서
+	int32 RebuildBox(const FBox& Box, const FBlockedTest& IsBlocked);
+
+	void Reset();
+
+	bool Save(const FString& Path, FString& OutError) const;
+	bool Load(const FString& Path, FString& OutError);
+
+	// ===== 조회 =====
+	bool IsValid() const { return Layers.Num() > 0; }
+	FBox GetBounds() const;
+	const FBox& GetSourceBounds() const { return SourceBounds; }   // 생성에 쓴 레벨 바운드(루트는 이를 덮는 정육면체)
+	float GetVoxelSize() const { return VoxelSize; }
+	float GetAgentRadius() const { return AgentRadius; }
+	int32 GetNumNodes() const;
+	int32 GetNumLeafMasks() const { return LeafMasks.Num(); }
+	int32 GetNumStaleNodes() const { return NumStaleNodes; }
+	SIZE_T GetAllocatedSize() const;
+
+	// 점이 들어 있는 빈 정점(막혔거나 범위 밖이면 무효)
+	FDroneNavRef FindRef(const FVector& Location) const;
+	bool IsBlocked(const FVector& Location) const { return !FindRef(Location).IsValid(); }
+
+	FVector GetRefCenter(const FDroneNavRef& Ref) const;
+
+	// 옥트리 노드를 건너뛰며 선분 검사
+	bool LineOfSight(const FVector& From, const FVector& To) const;
+
+	FDroneNavPath FindPath(const FDroneNavQuery& Query) const;
+
+private:
+	float GetNodeSize(int32 Layer) const { return LeafNodeSize * float(1 << Layer); }
+	FBox GetNodeBox(int32 Layer, const FDroneNavNode& Node) const;
+	FBox GetRefBox(const FDroneNavRef& Ref) const;
+
+	// Coord(레이어 안 좌표)를 덮는 가장 깊은 노드(범위 밖이면 false)
+	bool FindNode(int32 Layer, const FIntVector& Coord, int32& OutLayer, int32& OutIndex) const;
+
+	void GetNeighbors(const FDroneNavRef& Ref, TArray<FDroneNavRef>& OutNeighbors) const;
+
+	// Mixed 노드에서 Dir 쪽 면에 닿은 빈 자식/복셀을 모두 추가
+	void AddFaceChildren(int32 Layer, int32 Index, const FIntVector& Dir, TArray<FDroneNavRef>& OutNeighbors) const;
+
+	// StartNodes(같은 레이어)를 다시 분류하고 필요하면 자식까지 아래로 채움(너비 우선, 레이어마다 병렬)
+	void BuildFrom(int32 Layer, TArray<int32> StartNodes, const FBlockedTest& IsBlocked);
+
+	void SmoothPath(TArray<FVector>& Points) const;
+
+	// 매직/버전 다음 본문(저장/로드 공용)
+	void Serialize(FArchive& Ar);
+
+	FVector Origin = FVector::ZeroVector;
+	FBox SourceBounds = FBox(ForceInit);
+	float VoxelSize = 50.f;
+	float LeafNodeSize = 200.f;
+	float AgentRadius = 45.f;
+
+	// Layers[0] = 잎(4x4x4 복셀), Layers.Last() = 루트 하나
+	TArray<TArray<FDroneNavNode>> Layers;
+	TArray<uint64> LeafMasks;
+
+	int32 NumStaleNodes = 0;
+};
@@ -0,0 +1,130 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/Queue.h"
+#include "Tasks/Task.h"
+#include "DroneNavOctree.h"
+#include "P3DWorldBlockers.h"
+#include "DroneNavSubsystem.generated.h"
+
+DECLARE_DELEGATE_OneParam(FOnDronePathReady, const FDroneNavPath& /*Path*/);
+
+// =========================================================
+// 드론 3D 경로 탐색 (FDroneNavOctree + 워커 스레드 A*/Theta*)
+// - BeginPlay에서 베이크 파일(Content/Baked/NavOctree/<맵>.p3dn) 로드
+//   없으면 p3d.DroneNav.BuildMissing=1일 때 현재 레벨 충돌로 런타임 생성(또는 p3d.DroneNav.Build)
+// - RequestPath → 대기열 → 프레임마다 p3d.DroneNav.MaxDispatchPerFrame개까지 태스크로 발송
+//   (동시 실행 p3d.DroneNav.MaxInFlight개) → 결과는 다음 Tick에 게임 스레드에서 콜백
+// - 옥트리는 실행 중인 탐색이 하나도 없을 때만 게임 스레드에서 바뀜(잠금 없음)
+//   InvalidateNavBox → 새 발송을 멈추고 실행 중 탐색이 끝나면 부분 재생성 → 다시 발송
+// - 블로커 스폰/파괴/Stationary 이동/레벨 추가·제거(FP3DWorldBlockerTracker)는 자동으로 InvalidateNavBox
+// - 부하 테스트: p3d.DroneNav.Stress [N] (빈 점 사이 N개 동시 요청 → 지연 p50/p95/p99, 처리량)
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UDroneNavSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 반환: 요청 ID(옥트리가 없으면 INDEX_NONE, 콜백은 NotReady로 바로 불림)
+	int32 RequestPath(const FVector& Start, const FVector& Goal, FOnDronePathReady OnReady);
+
+	// 아직 안 끝난 요청의 콜백만 끊음(실행 중 탐색은 끝까지 돎)
+	void CancelPath(int32 RequestId);
+
+	// 지형이 바뀌었을 때 해당 영역 재생성 예약(Box = 바뀐 지오메트리 바운드, 에이전트 반지름만큼 넓혀서 대기열에)
+	// 월드 이벤트로 잡히지 않는 변경(Movable → 정지 등)만 직접 부르면 됨
+	UFUNCTION(BlueprintCallable, Category = "Drone|Navigation")
+	void InvalidateNavBox(const FBox& Box);
+
+	// 현재 레벨 충돌 바운드로 동기 생성(실행 중 탐색은 기다림)
+	bool BuildNavOctree();
+
+	bool IsNavReady() const { return Octree.IsValid(); }
+
+	// 게임 스레드 전용(옥트리는 게임 스레드에서만 바뀜)
+	const FDroneNavOctree& GetOctree() const { return Octree; }
+
+	int32 GetNumPending() const { return Pending.Num(); }
+	int32 GetNumInFlight() const { return NumInFlight; }
+
+	// ===== 부하 테스트 (p3d.DroneNav.Stress, 벤치마크 Nav_Paths_N) =====
+	struct FStressStats
+	{
+		int32 Requested = 0;
+		int32 Completed = 0;
+		int32 Succeeded = 0;
+		double WallMs = 0.0;          // 첫 요청 ~ 마지막 콜백
+		double SearchMsSum = 0.0;     // 워커에서 탐색에 쓴 시간 합
+		int64 Expansions = 0;
+		TArray<double> LatencyMs;     // 요청 ~ 콜백
+	};
+
+	// Count개 요청을 한 번에 넣음(시작/목표 = 생성 바운드 안 임의의 빈 점)
+	bool StartStressTest(int32 Count, int32 Seed = 0);
+	bool IsStressTestRunning() const { return StressIds.Num() > 0; }
+	const FStressStats& GetStressStats() const { return Stress; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FRequest
+	{
+		FOnDronePathReady OnReady;
+		double SubmitTime = 0.0;
+	};
+
+	struct FPendingRequest
+	{
+		int32 Id = INDEX_NONE;
+		FDroneNavQuery Query;
+	};
+
+	struct FCompletedRequest
+	{
+		int32 Id = INDEX_NONE;
+		FDroneNavPath Path;
+		double SearchMs = 0.0;
+	};
+
+	void LoadOrBuild();
+	void DispatchRequests();
+	void DeliverResults();
+	void ApplyDirtyBoxes();
+	void WaitForInFlight();
+
+	void RecordStress(int32 Id, const FCompletedRequest& Result, double LatencyMs);
+	void LogStressResult() const;
+
+	void PublishStats();
+
+	FDroneNavOctree Octree;
+
+	TMap<int32, FRequest> Requests;
+	TArray<FPendingRequest> Pending;
+	TQueue<FCompletedRequest, EQueueMode::Mpsc> Completed;
+	TArray<UE::Tasks::FTask> InFlightTasks;
+	int32 NumInFlight = 0;
+	int32 NextRequestId = 1;
+
+	TArray<FBox> DirtyBoxes;
+	FP3DWorldBlockerTracker Blockers;
+
+	// 프레임 stat
+	int32 CompletedThisFrame = 0;
+	double SearchMsThisFrame = 0.0;
+	double LatencyMsThisFrame = 0.0;
+
+	// 부하 테스트
+	TSet<int32> StressIds;
+	FStressStats Stress;
+	double StressStartTime = 0.0;
+};
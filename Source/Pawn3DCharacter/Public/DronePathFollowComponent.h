@@ -0,0 +1,85 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "DroneNavOctree.h"
+#include "DronePathFollowComponent.generated.h"
+
+class ADronePawn;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDroneMoveFinished, bool, bSuccess);
+
+// =========================================================
+// 드론 경로 따라가기 (UDroneNavSubsystem 경로 → 스크립트 입력)
+// - MoveToLocation: 비동기 경로 요청 → 결과가 오면 웨이포인트를 차례로 따라감
+// - 매 Tick 입력만 만들어서 ADronePawn::InjectScriptedInput으로 넣음(비행 물리/충돌은 드론 그대로)
+//   수평: 목표 쪽으로 회전(TurnRateDegPerSec) + 기체 기준 이동 축, 마지막 점 근처에서 감속
+//   수직: 호버 입력(중력 상쇄) + 고도 차 P 제어 + 수직 속도 감쇠 → UpDown 축
+// - 이동 중이 아닐 때는 Tick 꺼짐
+// =========================================================
+UCLASS(ClassGroup = Movement, meta = (BlueprintSpawnableComponent))
+class PAWN3DCHARACTER_API UDronePathFollowComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UDronePathFollowComponent();
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// 이전 이동은 취소(OnMoveFinished 안 불림)
+	UFUNCTION(BlueprintCallable, Category = "Drone|Navigation")
+	void MoveToLocation(const FVector& Goal);
+
+	UFUNCTION(BlueprintCallable, Category = "Drone|Navigation")
+	void StopMovement();
+
+	// 경로 대기 중 포함
+	UFUNCTION(BlueprintPure, Category = "Drone|Navigation")
+	bool IsFollowingPath() const { return PathRequestId != INDEX_NONE || Points.Num() > 0; }
+
+	const TArray<FVector>& GetPathPoints() const { return Points; }
+
+	UPROPERTY(BlueprintAssignable, Category = "Drone|Navigation")
+	FOnDroneMoveFinished OnMoveFinished;
+
+	// 마지막 점 도착 판정 거리
+	UPROPERTY(EditAnywhere, Category = "Drone|Navigation")
+	float AcceptanceRadius = 100.f;
+
+	// 중간 점 통과 판정 거리
+	UPROPERTY(EditAnywhere, Category = "Drone|Navigation")
+	float WaypointRadius = 150.f;
+
+	// 마지막 점까지 이 거리 안이면 수평 입력을 비례해서 줄임
+	UPROPERTY(EditAnywhere, Category = "Drone|Navigation")
+	float SlowDownDistance = 300.f;
+
+	UPROPERTY(EditAnywhere, Category = "Drone|Navigation")
+	float TurnRateDegPerSec = 180.f;
+
+	// UpDown = 호버 입력 + AltitudeGain * 고도 차(cm) - VerticalDamping * 수직 속도(cm/s)
+	UPROPERTY(EditAnywhere, Category = "Drone|Navigation")
+	float AltitudeGain = 0.01f;
+
+	UPROPERTY(EditAnywhere, Category = "Drone|Navigation")
+	float VerticalDamping = 0.004f;
+
+	// 끄면 기수 방향은 그대로 두고 옆/뒤로도 이동
+	UPROPERTY(EditAnywhere, Category = "Drone|Navigation")
+	bool bFaceMovementDirection = true;
+
+private:
+	void OnPathReady(const FDroneNavPath& Path);
+	void Finish(bool bSuccess);
+	void CancelPendingRequest();
+
+	ADronePawn* GetDrone() const;
+
+	TArray<FVector> Points;
+	int32 CurrentIndex = 0;
+	int32 PathRequestId = INDEX_NONE;
+
+	FVector LastLocation = FVector::ZeroVector;
+};
@@ -2,39 +2,115 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "DroneFlightKernel.h"
+#include "P3DSignificanceSubsystem.h"
+#include "P3DInputBuffer.h"
+#include "P3DNetMovement.h"
+#include "P3DRollback.h"
+#include "P3DReplay.h"
+#include "P3DStreamingSource.h"
 #include "DronePawn.generated.h"
 
 class USphereComponent;
+class USceneComponent;
 class UStaticMeshComponent;
+class UStaticMesh;
 class USpringArmComponent;
 class UCameraComponent;
+class UDroneSimSubsystem;
+class UDroneAvoidanceSubsystem;
+class UDroneMovementComponent;
+class UDronePathFollowComponent;
+class UP3DNetMovementComponent;
+class UP3DReplaySubsystem;
 
 // Enhanced Input에서 액션 값을 받을 때 사용하는 구조체
 struct FInputActionValue;
 
 UCLASS()
-class PAWN3DCHARACTER_API ADronePawn : public APawn
+class PAWN3DCHARACTER_API ADronePawn : public APawn, public IP3DSignificanceTarget, public IP3DNetMovementPawn, public IP3DRollbackPawn, public IP3DReplayInputTarget, public IP3DStreamingSourcePawn
 {
 	GENERATED_BODY()
 
+	// 배치 시뮬레이션이 입력/상태/내부 스텝 함수에 직접 접근
+	friend class UDroneSimSubsystem;
+
+	// Mass 승격/강등 시 비행 상태/파라미터 주고받기
+	friend class UP3DMassPopulationSubsystem;
+
+	// 회피 설정(세기/플레이어 조종 중 여부) 읽기
+	friend class UDroneAvoidanceSubsystem;
+
 public:
 	ADronePawn();
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void PossessedBy(AController* NewController) override;
+	virtual void NotifyActorBeginOverlap(AActor* OtherActor) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	// 빙의 해제 시 입력 컴포넌트를 유지 → 재빙의 때 SetupPlayerInputComponent 재바인딩 생략
+	virtual void DestroyPlayerInputComponent() override;
+
+#if WITH_EDITOR
+	// PIE 중 디테일 패널 튜닝 → 배치 슬롯 파라미터 갱신 표시
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 public:
 	virtual void Tick(float DeltaTime) override;
 
+	// ===== IP3DSignificanceTarget =====
+	virtual bool IsSignificanceIdle() const override;
+	virtual bool AllowsSignificanceTickControl() const override;
+
+	// ===== IP3DNetMovementPawn =====
+	// (예측/재적용이 같은 결과가 되려면 bUseAsyncGroundProbe는 끈 상태로)
+	virtual void NetGatherInput(float DeltaTime, FP3DNetMoveInput& OutInput) override;
+	virtual void NetSimulateMove(const FP3DNetMoveInput& Input) override;
+	virtual void NetSaveState(FP3DNetMoveState& OutState) const override;
+	virtual void NetRestoreState(const FP3DNetMoveState& State) override;
+	virtual void NetApplyProxyTransform(const FVector& Location, const FRotator& Rotation, float DeltaTime) override;
+
+	// ===== IP3DRollbackPawn =====
+	// (배치 시뮬 중에는 기록 안 함, 풀 출입 시 기록 비움)
+	virtual FP3DSnapshotHistory& GetSnapshotHistory() override { return SnapshotHistory; }
+	virtual void CaptureSnapshot(FP3DPawnSnapshot& Out) const override;
+	virtual void RestoreSnapshotState(const FP3DPawnSnapshot& Snapshot) override;
+	virtual void ApplySnapshotInput(const FP3DPawnSnapshot& Snapshot) override;
+	virtual void ResimulateFrame(float DeltaTime, bool bInputEnabled) override;
+
+	// ===== IP3DReplayInputTarget =====
+	virtual void ReplayInput(EP3DReplayInput Input, const FVector2D& Value) override;
+
+	// ===== IP3DStreamingSourcePawn =====
+	// 빙의 중일 때 월드 파티션 스트리밍 영역을 비행 방향으로 당겨옴
+	virtual void GetStreamingShapes(TArray<FStreamingSourceShape>& OutShapes) const override;
+
 	// ===== Root Collision =====
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	USphereComponent* SphereComp = nullptr;
 
+	// ===== Visual Root =====
+	// 메시/스프링암이 붙는 시각 전용 노드(충돌 없음)
+	// 고정 스텝 렌더 보간은 이 노드의 상대 오프셋으로만 → 루트 충돌/오버랩은 항상 시뮬 위치
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	USceneComponent* VisualRoot = nullptr;
+
 	// ===== Mesh =====
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	UStaticMeshComponent* MeshComp = nullptr;
 
+	// 메시 소프트 참조(BeginPlay에서 MeshComp에 적용)
+	// 쓰려면 BP의 MeshComp 메시는 비워둘 것 → 드론 클래스만 로드해도 메시/텍스처가 딸려오지 않음
+	// AP3DPlayerController가 Interact 때 클래스와 함께 미리 비동기 로드
+	UPROPERTY(EditDefaultsOnly, Category = "Components")
+	TSoftObjectPtr<UStaticMesh> DroneMesh;
+
 	// ===== Camera =====
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera")
 	USpringArmComponent* SpringArmComp = nullptr;
@@ -42,6 +118,18 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera")
 	UCameraComponent* CameraComp = nullptr;
 
+	// ===== Movement =====
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UDroneMovementComponent* MovementComp = nullptr;
+
+	// 네트워크 게임: 서버 권한 이동 + 클라 예측/보정 + 프록시 보간(독립 실행이면 아무것도 안 함)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UP3DNetMovementComponent* NetMovement = nullptr;
+
+	// 3D 내비 경로 따라가기(MoveToLocation 전에는 Tick 꺼짐)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UDronePathFollowComponent* PathFollowComp = nullptr;
+
 	// =========================================================
 	// Gravity / Ground / Thrust / Move  튜닝 파라미터
 	// =========================================================
@@ -74,6 +162,21 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Drone|Ground")
 	bool bUseSphereSweep = true;
 
+	// 바닥 탐색을 비동기 트레이스로 한 프레임 먼저 던지고 다음 Tick에 사용
+	// (그 사이 이동량이 GroundProbeDistance를 넘으면 동기 탐색으로 대체)
+	UPROPERTY(EditAnywhere, Category = "Drone|Ground")
+	bool bUseAsyncGroundProbe = false;
+
+	// 정적 바닥은 XY 셀 캐시(UDroneSimSubsystem)로 재사용
+	// 셀이 바뀌거나 캐시 높이에서 GroundSnapMax 이상 벗어나거나 셀 수명(p3d.Drone.GroundCacheMaxAge)이 지나면 다시 스윕
+	UPROPERTY(EditAnywhere, Category = "Drone|Ground")
+	bool bUseGroundCache = true;
+
+	// 오프라인 베이크 높이맵(UP3DBakeGroundCommandlet)이 있으면 캐시/스윕보다 먼저 조회
+	// 움직이는 물체/겹친 층 셀은 베이크에서 표시돼 실제 스윕으로 넘어감
+	UPROPERTY(EditAnywhere, Category = "Drone|Ground")
+	bool bUseGroundHeightfield = true;
+
 	//  "진짜 접지" 확정용: 반지름 때문에 떠 있는데 접지로 오판정되는 문제 제거
 	// Gap = (Hit.Distance - SphereRadius) 가 이 값 이하일 때만 접지 확정
 	UPROPERTY(EditAnywhere, Category = "Drone|Ground")
@@ -104,6 +207,50 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Drone|Move")
 	float AirControlMultiplier = 0.4f; // 0.3~0.5 권장
 
+	// ===== World Partition Streaming =====
+	// 속도/시선 방향 예측 영역(월드 파티션 맵에서 플레이어가 빙의했을 때만)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Streaming")
+	FP3DStreamingPrediction StreamingPrediction;
+
+	// ===== Simulation (고정 스텝) =====
+	// 프레임레이트와 무관하게 같은 궤적이 나오도록 고정 dt로 비행을 적분
+	UPROPERTY(EditAnywhere, Category = "Drone|Simulation")
+	bool bUseFixedTimestep = true;
+
+	UPROPERTY(EditAnywhere, Category = "Drone|Simulation", meta = (ClampMin = "10.0", ClampMax = "480.0"))
+	float FixedStepHz = 120.f;
+
+	// 히치 프레임에서 몰아서 처리할 최대 서브스텝 수(초과분은 버림)
+	UPROPERTY(EditAnywhere, Category = "Drone|Simulation", meta = (ClampMin = "1", ClampMax = "32"))
+	int32 MaxSubstepsPerFrame = 8;
+
+	// 렌더용: 직전/현재 시뮬 트랜스폼 사이를 보간해서 VisualRoot(메시/카메라)에만 적용
+	UPROPERTY(EditAnywhere, Category = "Drone|Simulation")
+	bool bInterpolateRender = true;
+
+	// 서브스텝마다 회전 + 수평 + 수직을 UDroneMovementComponent 한 번의 스윕으로(막히면 미끄러짐)
+	// 자식(메시/스프링암/카메라) 트랜스폼 갱신도 프레임당 한 번으로 묶음
+	// false면 기존 방식(회전/수평/수직을 각각 이동, 막히면 정지)
+	UPROPERTY(EditAnywhere, Category = "Drone|Simulation")
+	bool bUseMovementComponent = true;
+
+	// AI/군집 드론: 개별 Tick 대신 UDroneSimSubsystem에서 일괄 시뮬
+	UPROPERTY(EditAnywhere, Category = "Drone|Simulation")
+	bool bUseBatchedSimulation = false;
+
+	// ===== Avoidance =====
+	// AI/군집 드론: 주변 레이 팬으로 장애물을 감지해서 이동/상하 입력에 회피 보정을 섞음
+	UPROPERTY(EditAnywhere, Category = "Drone|Avoidance")
+	bool bUseAvoidance = false;
+
+	// 0 = 섞지 않음, 1 = 장애물 쪽 입력 제거 + 보정만큼 밀어내기
+	UPROPERTY(EditAnywhere, Category = "Drone|Avoidance", meta = (ClampMin = "0.0", ClampMax = "2.0"))
+	float AvoidanceStrength = 1.f;
+
+	// 플레이어가 조종 중일 때도 보정(기본은 AI만)
+	UPROPERTY(EditAnywhere, Category = "Drone|Avoidance")
+	bool bAvoidWhenPlayerControlled = false;
+
 	// ===== Debug =====
 	UPROPERTY(EditAnywhere, Category = "Drone|Debug")
 	bool bDrawGroundDebug = false;
@@ -121,12 +268,61 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Drone|Look")
 	float PitchMax = 80.f;
 
+	// 프레임 안에 누적된 마우스 델타에 거는 스무딩(기본: 없음)
+	UPROPERTY(EditAnywhere, Category = "Drone|Look")
+	FP3DLookSmoothingSettings LookSmoothing;
+
 	UPROPERTY(EditAnywhere, Category = "Drone|Roll")
 	float RollSpeedDegPerSec = 140.f;
 
 	UPROPERTY(EditAnywhere, Category = "Drone|Roll")
 	float RollMaxAbs = 65.f;
 
+	// 캐릭터 ↔ 드론 전환 시 입력 바인딩 캐시(풀에 들어가도 유지)
+	UPROPERTY(EditAnywhere, Category = "Drone|Input")
+	bool bCacheInputBindings = true;
+
+public:
+	// ===== Pool (AP3DPlayerController) =====
+	// 위치 이동(겹침 보정) + 상태 초기화 + 보이기/충돌/Tick 켜기
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+
+	// 숨김 + 충돌/Tick 끄기 + 상태 초기화
+	void DeactivateToPool();
+
+	bool IsInPool() const { return bInPool; }
+
+	// 비행 상태/입력/서브스텝 누적 초기화
+	void ResetFlightState();
+
+	// ===== Scripted Input (벤치마크/자동화) =====
+	// Enhanced Input 콜백과 같은 샘플 버퍼로 주입(UpDown은 축 값 그대로)
+	void InjectScriptedInput(const FP3DScriptedInput& Input);
+
+	// 고정 스텝 시뮬 결과(렌더 보간 전) / 개별 Tick 경로에서 진행한 스텝 수
+	const FTransform& GetSimTransform() const { return CurrSimTransform; }
+	uint64 GetSimStepCount() const { return SimStepCount; }
+
+	// ===== Avoidance =====
+	// 켜면 UDroneAvoidanceSubsystem에 등록(BeginPlay/풀 복귀 때는 bUseAvoidance 기준으로 자동)
+	void SetAvoidanceEnabled(bool bEnabled);
+
+	// 서브시스템이 매 프레임 갱신(월드 방향, 크기 0~1) → 다음 입력 소비 때 섞음
+	void SetAvoidanceCorrection(const FVector& InCorrection) { AvoidanceCorrection = InCorrection; }
+	const FVector& GetAvoidanceCorrection() const { return AvoidanceCorrection; }
+
+	// ===== Offline Tools (베이크/스윕 커맨들릿이 CDO로 같은 값 사용) =====
+	// UPROPERTY 튜닝 값 → 커널 파라미터
+	FDroneFlightParams GetFlightParams() const;
+
+	// 튜닝 값을 코드에서 바꾼 뒤 호출 → 배치 시뮬(UDroneSimSubsystem)이 다음 Tick에 다시 읽음
+	void MarkFlightParamsDirty() { bFlightParamsDirty = true; }
+
+	// 바닥 탐색 스피어 반지름(라인트레이스면 0)
+	float GetGroundProbeRadius() const;
+	float GetGroundTraceLength() const;
+	float GetWalkableFloorZ() const { return WalkableFloorZ; }
+
 private:
 	// ===== Input Callbacks =====
 	void Move2D(const FInputActionValue& Value);        // Axis2D: WASD
@@ -142,27 +338,145 @@ private:
 	FVector2D CachedLookInput = FVector2D::ZeroVector; // X=Yaw, Y=Pitch
 	float     CachedRollInput = 0.f;                   // Roll 입력(축)
 
+	// 입력 콜백 → Tick 사이 샘플 버퍼(Look 누적, Move/Roll 순서 보존)
+	FP3DPawnInputBuffer InputBuffer;
+
+	// 아직 적용 안 된 Look 중 가장 오래된 입력 시각(지연 측정)
+	double PendingLookTimestamp = 0.0;
+
+	// 서브스텝 전에 한 번: 버퍼 → Cached*Input (+ 회피 보정)
+	void ConsumeBufferedInput(float DeltaTime);
+
+	// 회피 보정: 섞기 전 입력을 보관했다가 다음 소비 전에 되돌림(그 사이 새 입력이 온 축은 그대로)
+	FVector AvoidanceCorrection = FVector::ZeroVector;
+	FVector2D PreAvoidanceMove = FVector2D::ZeroVector;
+	float PreAvoidanceUpDown = 0.f;
+	FVector2D BlendedMove = FVector2D::ZeroVector;
+	float BlendedUpDown = 0.f;
+	bool bAvoidanceBlended = false;
+
+	void BlendAvoidance();
+	void UnblendAvoidance();
+
+	// 네트워크 입력의 목표 회전(Look/Roll 대신 다음 스텝에서 그대로 적용)
+	TOptional<FRotator> PendingNetRotation;
+
+	// 롤백용 프레임별 상태/입력(p3d.Rollback.Record)
+	FP3DSnapshotHistory SnapshotHistory;
+
 private:
 	// ===== State =====
-	float VerticalVelocity = 0.f;     // cm/s
-	bool  bGrounded = false;
-	float TimeSinceGrounded = 999.f; // 코요테 누적
+	// VerticalVelocity / bGrounded / TimeSinceGrounded
+	FDroneFlightState FlightState;
+
+	// 스트리밍 예측용 속도(렌더 위치 변화, 스무딩) - 플레이어가 빙의했을 때만 갱신
+	FVector StreamingVelocity = FVector::ZeroVector;
+	FVector LastStreamingLocation = FVector::ZeroVector;
+	bool bHasStreamingLocation = false;
+
+	void UpdateStreamingVelocity(float DeltaTime);
+
+private:
+	// ===== Fixed Step =====
+	float StepAccumulator = 0.f;
+	uint64 SimStepCount = 0;
+
+	// 보간 기준: 마지막 두 시뮬 결과(루트는 항상 CurrSimTransform, 다르면 외부에서 옮긴 것)
+	FTransform PrevSimTransform = FTransform::Identity;
+	FTransform CurrSimTransform = FTransform::Identity;
+	bool bHasSimTransform = false;
+
+	bool bInPool = false;
+
+	// UDroneSimSubsystem 슬롯(INDEX_NONE = 개별 Tick)
+	int32 BatchIndex = INDEX_NONE;
+
+	// 배치 슬롯에 복사해 둔 FDroneFlightParams가 낡았음
+	bool bFlightParamsDirty = false;
+
+	// 배치 시뮬 / 바닥 캐시 / 비용 집계
+	UPROPERTY(Transient)
+	TObjectPtr<UDroneSimSubsystem> SimSubsystem = nullptr;
+
+	// 중요도(Tick 간격/Dormant) 관리
+	UPROPERTY(Transient)
+	TObjectPtr<UP3DSignificanceSubsystem> SignificanceSubsystem = nullptr;
+
+	// 장애물 회피 감지(bUseAvoidance)
+	UPROPERTY(Transient)
+	TObjectPtr<UDroneAvoidanceSubsystem> AvoidanceSubsystem = nullptr;
+
+	void WakeSignificance();
+
+	// 입력 녹화/재생(콜백 첫 줄에서 FilterInput)
+	UPROPERTY(Transient)
+	TObjectPtr<UP3DReplaySubsystem> ReplaySubsystem = nullptr;
+
+	// DroneMesh가 로드돼 있으면 바로, 아니면 비동기 로드 후 적용
+	void ApplyDroneMesh();
+
+private:
+	// ===== Async Ground Probe =====
+	struct FAsyncGroundProbeResult
+	{
+		bool bValid = false;
+		bool bHit = false;
+		FHitResult Hit;
+		FVector Start = FVector::ZeroVector; // 던질 때 위치(보정 기준)
+	};
+
+	FTraceHandle PendingGroundProbe;
+	FVector PendingGroundProbeStart = FVector::ZeroVector;
+	FAsyncGroundProbeResult AsyncGroundProbe;
 
 private:
 	// ===== Internals =====
+	// 한 프레임: 고정 스텝 누적 → 서브스텝 → 렌더 보간 (로컬 Tick과 네트워크 입력 시뮬 공용)
+	void AdvanceSimulation(float DeltaTime);
+
+	// 한 스텝(회전 + 바닥 + 수평 + 수직) 진행
+	void SimulateStep(float StepDT);
+
+	// 외부 텔레포트 등으로 시뮬 기준이 어긋났을 때 현재 액터 트랜스폼으로 재동기화
+	void ResetSimTransform();
+
+	// 시각 노드만 RenderTransform(월드)에 두기: 루트(액터) 기준 상대 오프셋으로 기록
+	void ApplyRenderTransform(const FTransform& RenderTransform);
+
 	void TickRotation(float DeltaTime);
 
+	// 이번 스텝의 목표 회전(Look 소비 + Roll) - 적용은 호출 쪽에서
+	FRotator ComputeStepRotation(float DeltaTime);
+
+	// Cur에 Look(소비) + Roll 적용
+	FRotator ApplyLookAndRoll(FRotator Cur, float DeltaTime);
+
 	// 수직(월드 Z): 중력 + 추진(가속/감속) + 스냅/떨림 방지
-	// 접지 오판정 제거/이륙 허용/스냅 정밀화를 위해 Gap/바닥노멀 정보도 받음
-	void TickVertical_World(
-		float DeltaTime,
-		const struct FHitResult& GroundHit,
-		bool bHitGround,
-		float Gap,
-		bool bIsFloor,
-		bool bActuallyGrounded
-	);
+	// 접지 오판정 제거/이륙 허용/스냅 정밀화를 위해 Gap/바닥노멀 요약을 받음
+	void TickVertical_World(float DeltaTime, const FDroneGroundSample& Ground);
+
+	// 기존 경로: 수직만 따로 이동(중력 OFF면 즉시형)
+	void SimulateVerticalLegacy(float DeltaTime, const FDroneGroundSample& Ground);
+
+	// 단일 스윕 경로: 회전 + 3D 변위를 한 번에 이동하고 수직 막힘을 커널에 알림
+	void MoveCombined(const FVector& Delta, const FRotator& NewRotation, float DeltaTime, const FDroneFlightParams& Params);
+
+	void DrawStepDebug(const FDroneGroundSample& Ground) const;
+
+	// 바닥 Hit → Gap/바닥 판정 요약
+	FDroneGroundSample MakeGroundSample(const struct FHitResult& GroundHit, bool bHitGround) const;
+
+	// Yaw 기준 수평 이동량(Z=0)
+	FVector ComputeHorizontalDelta(float DeltaTime, float Speed, float Yaw) const;
 
 	// Ground probe
-	bool ProbeGround(struct FHitResult& OutHit) const;
+	bool ProbeGround(FHitResult& OutHit);
+	bool ProbeGroundSync(FHitResult& OutHit) const;
+
+	FCollisionShape GetGroundProbeShape() const;
+
+	// Async ground probe
+	void IssueAsyncGroundProbe(const FVector& Start);
+	void PollAsyncGroundProbe();
+	bool ConsumeAsyncGroundProbe(FHitResult& OutHit, bool& bOutHit) const;
 };
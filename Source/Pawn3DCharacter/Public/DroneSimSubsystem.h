@@ -0,0 +1,136 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DroneFlightKernel.h"
+#include "DroneGroundCache.h"
+#include "DroneGroundHeightfield.h"
+#include "P3DWorldBlockers.h"
+#include "DroneSimSubsystem.generated.h"
+
+class ADronePawn;
+
+// =========================================================
+// 다수 드론 배치 시뮬레이션
+// - 등록된 드론은 액터 Tick을 끄고, 여기서 한 번에 적분
+// - 비행 상태/입력은 SoA(필드별 연속 배열)로 보관
+// - 단계: Gather(입력/목표 회전/바닥) → Integrate(순수 연산) → Move(회전 + 이동 스윕 한 번, bUseMovementComponent면 UDroneMovementComponent)
+//   → Writeback(프레임당 한 번, 드론 VisualRoot 보간 오프셋만. 루트 충돌은 항상 시뮬 위치)
+// - 월드 공용 바닥 캐시(FDroneGroundCache)도 여기서 보관/무효화
+//   (블로커 스폰/파괴/Stationary 이동/레벨 추가·제거 → FP3DWorldBlockerTracker → InvalidateGroundCacheInBox)
+// - 오프라인 베이크 높이맵(FDroneGroundHeightfield)이 있으면 BeginPlay에서 로드
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UDroneSimSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 등록 시 드론의 현재 비행 상태/파라미터를 가져오고, 해제 시 상태를 되돌려줌
+	// 파라미터는 드론이 MarkFlightParamsDirty()로 표시하면 다음 Tick에 다시 읽음
+	void RegisterDrone(ADronePawn* Drone);
+	void UnregisterDrone(ADronePawn* Drone);
+
+	bool IsRegistered(const ADronePawn* Drone) const;
+	int32 GetNumBatchedDrones() const { return Drones.Num(); }
+
+	// 개별 Tick 경로 비용 집계(1대당 비용 stat 비교용)
+	void ReportActorTickCycles(uint64 Cycles);
+
+	// ===== Ground Cache =====
+	FDroneGroundCache& GetGroundCache() { return GroundCache; }
+
+	// 조회 결과 집계(bAvoidedSweep = 캐시로 스윕을 건너뜀)
+	void RecordGroundCacheLookup(bool bAvoidedSweep);
+
+	// 지형이 바뀌었을 때 해당 영역 캐시 비우기(월드 이벤트로 잡히는 변경은 자동)
+	UFUNCTION(BlueprintCallable, Category = "Drone|Ground")
+	void InvalidateGroundCacheInBox(const FBox& Box);
+
+	UFUNCTION(BlueprintCallable, Category = "Drone|Ground")
+	void InvalidateGroundCache();
+
+	// ===== Baked Heightfield =====
+	// 로드돼 있고 p3d.Drone.GroundHeightfield가 켜져 있을 때만(아니면 nullptr)
+	const FDroneGroundHeightfield* GetGroundHeightfield() const;
+
+private:
+	// ===== SoA Storage =====
+	UPROPERTY()
+	TArray<TObjectPtr<ADronePawn>> Drones;
+
+	TArray<FDroneFlightParams> Params;
+
+	TArray<float> VerticalVelocity;
+	TArray<uint8> Grounded;
+	TArray<float> TimeSinceGrounded;
+
+	TArray<FVector2D> MoveInput;
+	TArray<float>     UpDownInput;
+
+	// 스텝 중간 결과
+	TArray<FRotator>           StepRotation;
+	TArray<FDroneGroundSample> Ground;
+	TArray<FVector>            PendingDelta;
+
+	// 렌더 보간용
+	TArray<FTransform> PrevSimTransform;
+	TArray<FTransform> CurrSimTransform;
+
+	float StepAccumulator = 0.f;
+
+	// Tick 도중 해제된 슬롯은 끝나고 정리
+	bool bIsTicking = false;
+	bool bHasPendingRemovals = false;
+
+	// 개별 Tick 경로 집계(프레임 단위)
+	uint64 ActorTickCycles = 0;
+	uint32 ActorTickCount = 0;
+
+	// ===== Ground Cache =====
+	FDroneGroundCache GroundCache;
+
+	// 내비 옥트리와 같은 블로커 변경 이벤트
+	FP3DWorldBlockerTracker GroundBlockers;
+
+	uint32 GroundCacheHits = 0;
+	uint32 GroundCacheMisses = 0;
+
+	// 초당 절약한 스윕 수(1초 창)
+	uint32 AvoidedSweepsInWindow = 0;
+	float  AvoidedSweepWindowTime = 0.f;
+	float  AvoidedSweepsPerSec = 0.f;
+
+	// 퍼시스턴트 레벨 기준 베이크 → 서브레벨이 붙으면 그 바닥은 모름(사용 중지)
+	FDroneGroundHeightfield GroundHeightfield;
+	bool bHeightfieldValid = false;
+
+	void LoadGroundHeightfield();
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+	void PublishGroundCacheStats(float DeltaTime);
+
+private:
+	void SimulateBatchStep(float StepDT);
+
+	void GatherPhase(float StepDT);
+	void IntegratePhase(float StepDT);
+	void MovePhase(float StepDT);
+
+	FDroneFlightState ReadState(int32 Index) const;
+	void WriteState(int32 Index, const FDroneFlightState& State);
+
+	void RemoveAtSwap(int32 Index);
+	void CompactRemovedSlots();
+	void PublishCostStats(uint64 BatchCycles);
+};
@@ -0,0 +1,134 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DroneSwarmSubsystem.generated.h"
+
+class ADronePawn;
+
+// 군집 대형(리더 기준 로컬 슬롯: X=앞, Y=오른쪽, Z=위)
+UENUM(BlueprintType)
+enum class EDroneFormation : uint8
+{
+	Line,      // 리더 좌우로 한 줄(횡대)
+	Wedge,     // 리더 뒤로 V자
+	Sphere,    // 리더를 감싸는 구면(피보나치 분포, 슬롯 간격 ≈ Spacing)
+};
+
+// =========================================================
+// 드론 군집(리더 1 + 팔로워 N) 대형 솔버
+// - 리더는 플레이어가 조종, 팔로워는 여기서 만든 스크립트 입력으로 따라옴
+// - 프레임당 한 번 모든 군집의 팔로워를 SoA(성분별 float 배열)로 처리(팔로워별 로직/Tick 없음)
+//   1) Gather: 팔로워 위치/속도(지난 프레임 위치 차), 군집별 리더 위치/Yaw/속도
+//   2) Slot: 리더 기준 슬롯 오프셋(대형/인원 바뀔 때만 계산) → Yaw 회전 → 월드 목표
+//   3) Separation: 균일 격자 해시(카운팅 정렬)로 주변 칸만 검사 → 겹침 방지 밀어내기(군집 구분 없음, 리더 포함)
+//   4) Steer: 목표 속도 = 리더 속도 + 위치 오차 x p3d.Swarm.PositionGain + 분리 → 기체 기준 Move/Look
+//      UpDown = 호버 입력 + 고도 차 P 제어 - 리더 대비 수직 속도 감쇠 + 분리
+// - 입력은 ADronePawn::InjectScriptedInput → 드론이 다음 입력 소비 때 반영(한 프레임 늦음)
+// - 팔로워 스폰/반납은 호출한 쪽(AP3DPlayerController 풀) 몫, 파괴된 팔로워는 여기서 자동 정리
+// - 디버그: p3d.Swarm.Debug 1 (슬롯 점 + 현재 위치 선)
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UDroneSwarmSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 리더는 입력을 받지 않음(조종은 컨트롤러) → 군집 핸들
+	int32 CreateSwarm(ADronePawn* Leader, EDroneFormation Formation, float Spacing);
+
+	// 팔로워 등록만 해제(드론 반납/파괴는 호출한 쪽)
+	void DestroySwarm(int32 SwarmId);
+
+	void AddFollower(int32 SwarmId, ADronePawn* Drone);
+	void RemoveFollower(ADronePawn* Drone);
+
+	void SetFormation(int32 SwarmId, EDroneFormation Formation, float Spacing);
+
+	bool IsValidSwarm(int32 SwarmId) const { return Swarms.IsValidIndex(SwarmId) && Swarms[SwarmId].bActive; }
+	int32 GetNumFollowers() const { return Followers.Num(); }
+
+	// 리더 기준 로컬 슬롯 오프셋(스폰 위치 잡기용으로도 사용)
+	static FVector ComputeSlotOffset(EDroneFormation Formation, int32 Slot, int32 NumSlots, float Spacing);
+
+	// 마지막 Tick 집계(벤치마크용)
+	struct FFrameStats
+	{
+		int32 Followers = 0;
+		int32 NeighborChecks = 0;
+		int32 OverlapPairs = 0;      // 분리 반경 절반 안으로 들어온 쌍
+		double SlotErrorCm = 0.0;    // 슬롯까지 평균 거리
+		double SolverMs = 0.0;
+	};
+
+	const FFrameStats& GetLastFrameStats() const { return LastFrame; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FSwarm
+	{
+		TWeakObjectPtr<ADronePawn> Leader;
+		EDroneFormation Formation = EDroneFormation::Wedge;
+		float Spacing = 250.f;
+		int32 NumFollowers = 0;
+		bool bActive = false;
+		bool bSlotsDirty = true;
+
+		// Gather에서 갱신
+		bool bLeaderValid = false;
+		FVector LeaderLocation = FVector::ZeroVector;
+		FVector LeaderVelocity = FVector::ZeroVector;
+		FVector LastLeaderLocation = FVector::ZeroVector;
+		float LeaderYaw = 0.f;
+	};
+
+	// 1) 슬롯 → 2) 위치/속도/목표 → 3) 격자 + 분리 → 4) 입력
+	void UpdateSlots();
+	void Gather(float DeltaTime);
+	void BuildGrid(float CellSize);
+	void Separate(float Radius);
+	void Steer(float DeltaTime);
+	void DrawDebugSlots() const;
+
+	void RemoveSlot(int32 Index);
+
+	TArray<FSwarm> Swarms;
+
+	// ===== 팔로워(SoA) =====
+	UPROPERTY()
+	TArray<TObjectPtr<ADronePawn>> Followers;
+
+	TArray<int32> SwarmOf;
+	TArray<float> MaxSpeed;           // 공중 수평 속도(NormalSpeed x AirControlMultiplier)
+	TArray<float> InvLookSensitivity; // Yaw 각도 → Look.X
+	TArray<float> HoverInput;         // 중력과 맞서는 UpDown(P3DDroneFlight::GetHoverInput)
+
+	// 리더 기준 로컬 슬롯(UpdateSlots)
+	TArray<float> SlotX, SlotY, SlotZ;
+
+	TArray<float> PosX, PosY, PosZ;
+	TArray<float> LastX, LastY, LastZ;
+	TArray<float> VelX, VelY, VelZ;
+	TArray<float> Yaw;
+
+	// 월드 목표 / 분리
+	TArray<float> TargetX, TargetY, TargetZ;
+	TArray<float> SepX, SepY, SepZ;
+
+	// ===== 격자 스크래치(용량 유지) =====
+	TArray<int32> CellOf;             // 팔로워 → 버킷
+	TArray<int32> CellStart;          // 버킷 → CellItems 시작(NumBuckets + 1)
+	TArray<int32> CellItems;          // 버킷 순서로 정렬한 팔로워
+	TArray<int32> CellCoord;          // 팔로워 격자 좌표(x, y, z) x 3
+	int32 BucketMask = 0;
+	float InvCellSize = 0.f;
+
+	FFrameStats LastFrame;
+};
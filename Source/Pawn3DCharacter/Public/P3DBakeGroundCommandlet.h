@@ -0,0 +1,32 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "P3DBakeGroundCommandlet.generated.h"
+
+class UWorld;
+class ADronePawn;
+
+// =========================================================
+// 드론 바닥 높이맵 오프라인 베이크 → Content/Baked/Heightfields/<맵>.p3dh
+// - 퍼시스턴트 레벨만 로드(스트리밍 서브레벨/월드 파티션 셀은 제외)
+// - XY 셀 중심마다 위에서 드론 탐색 스피어를 ECC_Visibility로 스윕(런타임 ProbeGroundSync와 같은 채널/모양)
+//   모서리 4곳도 스윕해서 셀 평면과 안 맞으면 Ambiguous, 맞은 물체가 Static이 아니거나 Pawn이면 Dynamic
+// - -Compare=N: 임의 위치 N개에서 높이맵 조회 vs 실제 스윕 시간/오차 비교
+//
+// UnrealEditor-Cmd <프로젝트> -run=P3DBakeGround -Map=/Game/Maps/L_StartMap
+//   [-CellSize=50] [-TileSize=32] [-HeightStep=1] [-DroneClass=<경로>] [-Compare=100000]
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DBakeGroundCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UP3DBakeGroundCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void CompareWithSweeps(UWorld* World, const FString& Path, const FBox& Bounds, const ADronePawn* Drone, int32 NumQueries) const;
+};
@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "P3DBakeNavCommandlet.generated.h"
+
+class FDroneNavOctree;
+
+// =========================================================
+// 드론 3D 내비 옥트리 오프라인 베이크 → Content/Baked/NavOctree/<맵>.p3dn
+// - 퍼시스턴트 레벨만 로드, 충돌 있는 액터 바운드를 덮는 옥트리 생성
+//   막힘 = 드론 충돌 반지름만큼 부풀린 박스가 WorldStatic/WorldDynamic과 겹침
+// - -Bench=N: 바운드 안 임의의 빈 점 사이 N개 경로를 워커 스레드에서 탐색(A* / Theta* 각각)
+//
+// UnrealEditor-Cmd <프로젝트> -run=P3DBakeNav -Map=/Game/Maps/L_StartMap
+//   [-VoxelSize=50] [-AgentRadius=<cm>] [-DroneClass=<경로>] [-Bench=1000]
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DBakeNavCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UP3DBakeNavCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void RunBenchmark(const FDroneNavOctree& Octree, int32 NumQueries) const;
+};
@@ -0,0 +1,20 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+// =========================================================
+// 커맨들릿용 월드 로드(렌더링 없음)
+// - 퍼시스턴트 레벨만, 충돌 질의용 물리 씬까지 만들고 바디를 질의 구조에 반영
+// - 질의(스윕/트레이스)는 읽기 전용이라 워커 스레드에서 동시에 써도 됨
+// =========================================================
+namespace P3DCommandletWorld
+{
+	// 실패하면 nullptr(루트에 붙여서 돌려줌 → Release로 정리)
+	PAWN3DCHARACTER_API UWorld* Load(const FString& MapPath);
+	PAWN3DCHARACTER_API void Release(UWorld* World);
+
+	// 충돌 있는 액터 바운드(Pawn 제외)
+	PAWN3DCHARACTER_API FBox ComputeCollisionBounds(const UWorld* World);
+}
@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "P3DFlightSweepCommandlet.generated.h"
+
+// =========================================================
+// 헤드리스 드론 비행 파라미터 스윕(렌더링/실시간 없음)
+// - 맵을 충돌 질의용으로만 로드, 드론은 액터 없이 위치 + FDroneFlightState만 가진 가상 드론
+//   바닥 탐색/적분은 런타임과 같은 식(ProbeGroundSync 채널/모양 + DroneFlightKernel)
+//   이동은 충돌 스피어 스윕 + 한 번 미끄러짐(UDroneMovementComponent::MoveStep 근사, 겹침 밀어내기는 단순화)
+// - 파라미터 조합 x 입력 프로파일(Land/Hop/Cruise/Dive) 실행을 워커 스레드에 나눠서 고정 스텝으로 돌림
+//   실행끼리 공유 상태 없음(씬 질의는 읽기 전용) → 코어 수에 거의 비례
+// - 결과: Saved/FlightSweep/FlightSweep_<맵>_<시간>.csv
+//   LandingJitterCm / GroundFlicker / TimeToHoverS / HoverSinkCmS / TunnelIncidents
+//
+// UnrealEditor-Cmd <프로젝트> -run=P3DFlightSweep -Map=/Game/Maps/L_StartMap
+//   -Sweep="GroundSnapMax=10:30:5;CoyoteTime=0.04,0.08,0.12" [-Profiles=Land,Hop] [-Hz=120]
+//   [-DroneClass=<경로>] [-Spawn=X,Y,Z] [-MaxRuns=200000] [-Serial]
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DFlightSweepCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UP3DFlightSweepCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,149 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include "P3DInputBuffer.generated.h"
+
+// =========================================================
+// 입력 샘플 버퍼
+// - 입력 콜백은 타임스탬프를 붙여 링버퍼에 쌓기만 함(덮어쓰기 X)
+// - Tick에서 한 번에 소비: Look은 누적(+선택적 스무딩), Move/Roll은 마지막 값
+// - 프레임 안에 여러 번 들어온 마우스 샘플이 유실되지 않게 하는 게 목적
+// =========================================================
+
+// 단일 생산자/단일 소비자 lock-free 링버퍼(고정 용량, 힙 할당 없음)
+template<typename T, uint32 Capacity>
+class TP3DInputRing
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	// 가득 차면 새 샘플을 버리고 false(소비가 밀렸다는 뜻)
+	bool Push(const T& Item)
+	{
+		const uint32 H = Head.load(std::memory_order_relaxed);
+		const uint32 Tl = Tail.load(std::memory_order_acquire);
+		if (H - Tl >= Capacity) return false;
+
+		Items[H & (Capacity - 1)] = Item;
+		Head.store(H + 1, std::memory_order_release);
+		return true;
+	}
+
+	// 쌓인 샘플을 오래된 순서로 전부 꺼냄
+	template<typename FuncType>
+	int32 Drain(FuncType&& Func)
+	{
+		const uint32 H = Head.load(std::memory_order_acquire);
+		uint32 Tl = Tail.load(std::memory_order_relaxed);
+
+		int32 Count = 0;
+		for (; Tl != H; ++Tl, ++Count)
+		{
+			Func(Items[Tl & (Capacity - 1)]);
+		}
+
+		Tail.store(Tl, std::memory_order_release);
+		return Count;
+	}
+
+	// 소비 쪽에서 남은 샘플 버리기
+	void Discard()
+	{
+		Tail.store(Head.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+private:
+	T Items[Capacity];
+	std::atomic<uint32> Head{ 0 };
+	std::atomic<uint32> Tail{ 0 };
+};
+
+// 타임스탬프가 붙은 입력 샘플
+struct FP3DInputSample
+{
+	double Timestamp = 0.0;      // FPlatformTime::Seconds()
+	FVector2D Value = FVector2D::ZeroVector;
+};
+
+UENUM(BlueprintType)
+enum class EP3DLookSmoothing : uint8
+{
+	None,          // 누적값 그대로
+	Exponential,   // 시간 상수 기반 지수 평활
+	OneEuro,       // 속도에 따라 컷오프가 바뀌는 1€ 필터(느릴 땐 부드럽게, 빠를 땐 지연 적게)
+};
+
+USTRUCT(BlueprintType)
+struct FP3DLookSmoothingSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Look|Smoothing")
+	EP3DLookSmoothing Mode = EP3DLookSmoothing::None;
+
+	// Exponential: 시간 상수(초). 클수록 부드럽고 느림
+	UPROPERTY(EditAnywhere, Category = "Look|Smoothing", meta = (ClampMin = "0.001", EditCondition = "Mode == EP3DLookSmoothing::Exponential"))
+	float SmoothingTime = 0.03f;
+
+	// OneEuro: 최소 컷오프(Hz) / 속도 민감도
+	UPROPERTY(EditAnywhere, Category = "Look|Smoothing", meta = (ClampMin = "0.01", EditCondition = "Mode == EP3DLookSmoothing::OneEuro"))
+	float MinCutoff = 1.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Look|Smoothing", meta = (ClampMin = "0.0", EditCondition = "Mode == EP3DLookSmoothing::OneEuro"))
+	float Beta = 0.007f;
+
+	UPROPERTY(EditAnywhere, Category = "Look|Smoothing", meta = (ClampMin = "0.01", EditCondition = "Mode == EP3DLookSmoothing::OneEuro"))
+	float DerivativeCutoff = 1.0f;
+};
+
+// 한 프레임에 소비한 결과
+struct FP3DInputFrame
+{
+	FVector2D Look = FVector2D::ZeroVector;   // 누적(+스무딩) 회전량
+	double OldestLookTimestamp = 0.0;         // 지연 측정용(0 = 이번 프레임 Look 없음)
+
+	bool bHasMove = false;
+	FVector2D Move = FVector2D::ZeroVector;   // 마지막 Move 값
+
+	bool bHasRoll = false;
+	float Roll = 0.f;                         // 마지막 Roll 값
+};
+
+// 벤치마크/자동화에서 Enhanced Input 대신 주입하는 한 프레임 입력
+struct FP3DScriptedInput
+{
+	FVector2D Move = FVector2D::ZeroVector;
+	FVector2D Look = FVector2D::ZeroVector;
+	float UpDown = 0.f;   // 드론 전용
+	float Roll = 0.f;     // 드론 전용
+};
+
+class PAWN3DCHARACTER_API FP3DPawnInputBuffer
+{
+public:
+	void PushLook(const FVector2D& Value);
+	void PushMove(const FVector2D& Value);
+	void PushRoll(float Value);
+
+	// 쌓인 샘플을 소비(DeltaTime은 스무딩 필터용)
+	FP3DInputFrame Consume(float DeltaTime, const FP3DLookSmoothingSettings& Settings);
+
+	void DiscardMove() { MoveRing.Discard(); }
+	void Reset();
+
+	// 입력 타임스탬프 → 실제 회전 적용까지 지연 보고
+	static void ReportLookLatency(double InputTimestamp);
+
+private:
+	TP3DInputRing<FP3DInputSample, 64> LookRing;
+	TP3DInputRing<FP3DInputSample, 16> MoveRing;
+	TP3DInputRing<FP3DInputSample, 16> RollRing;
+
+	// 스무딩 상태(초당 회전량 기준)
+	FVector2D FilteredRate = FVector2D::ZeroVector;
+	FVector2D FilteredRateDeriv = FVector2D::ZeroVector;
+	bool bFilterPrimed = false;
+
+	FVector2D ApplySmoothing(const FVector2D& Look, float DeltaTime, const FP3DLookSmoothingSettings& Settings);
+};
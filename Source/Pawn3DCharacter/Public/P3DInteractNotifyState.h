@@ -0,0 +1,23 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "P3DInteractNotifyState.generated.h"
+
+// =========================================================
+// Interact 구간 노티파이 (Interact 애니/몽타주에 배치)
+// - Begin → ABasePawn::Notify_InteractStart, End → Notify_InteractEnd
+// - BP 이벤트(AnimNotify_*) 없이 C++로 바로 호출
+// - 몽타주가 중간에 끊겨도 End가 불림 → Interact 락이 남지 않음
+// =========================================================
+UCLASS(meta = (DisplayName = "P3D Interact"))
+class PAWN3DCHARACTER_API UP3DInteractNotifyState : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+
+	virtual FString GetNotifyName_Implementation() const override;
+};
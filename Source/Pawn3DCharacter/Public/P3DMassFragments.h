@@ -0,0 +1,122 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "DroneFlightKernel.h"
+#include "P3DMassFragments.generated.h"
+
+class APawn;
+
+// =========================================================
+// 원거리 Pawn/드론의 Mass 표현 (UP3DMassPopulationSubsystem)
+// - 액터 대신 엔티티당 프래그먼트 몇 개만 유지(컴포넌트/Tick/충돌 없음)
+// - 가까워지거나 빙의 대상이 되면 액터로 승격(Promoted 태그), 멀어지면 강등
+// =========================================================
+
+// 위치(액터 루트 기준: 캡슐/스피어 중심) + Yaw
+USTRUCT()
+struct FP3DMassTransformFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.f;
+};
+
+// 배회 입력(벤치마크 스크립트 입력과 같은 식, 엔티티마다 위상만 다름)
+USTRUCT()
+struct FP3DMassMoveFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector2D MoveInput = FVector2D::ZeroVector; // X=Right, Y=Forward
+	float UpDownInput = 0.f;                     // 드론 전용
+	float TurnInput = 0.f;                       // Yaw deg/s
+
+	float WanderTime = 0.f;
+	float WanderPhase = 0.f;
+};
+
+// BasePawn 지상 이동: 바닥 높이 캐시 + 낙하
+USTRUCT()
+struct FP3DMassGroundFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	float FloorZ = 0.f;
+	float VerticalSpeed = 0.f;
+
+	// 마지막 바닥 탐색 이후 수평 누적 이동(캐시 거리 넘으면 재탐색)
+	float TraveledSinceQuery = 0.f;
+
+	bool bOnGround = false;
+	bool bHasFloor = false;
+};
+
+// 드론 비행 상태(DroneFlightKernel 그대로)
+USTRUCT()
+struct FP3DMassDroneFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FDroneFlightState FlightState;
+};
+
+// 승격 중인 액터(강등 시 상태를 되돌려받음)
+USTRUCT()
+struct FP3DMassActorFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<APawn> Actor;
+};
+
+USTRUCT()
+struct FP3DMassPawnTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+USTRUCT()
+struct FP3DMassDroneTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+// 액터가 시뮬 중 → 이동 프로세서는 건너뜀
+USTRUCT()
+struct FP3DMassPromotedTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+// BasePawn 클래스 기본값에서 뽑은 지상 이동 파라미터(UBasePawnMovementComponent 규칙의 축약판)
+struct FP3DMassPawnParams
+{
+	float NormalSpeed = 600.f;
+	float HalfHeight = 96.f;
+	float MaxStepHeight = 45.f;
+	float WalkableFloorZ = 0.71f;
+	float FloorGap = 2.f;
+	float MaxFallSpeed = 4000.f;
+	float GravityZ = -980.f;
+
+	// 원거리라서 액터(FloorCacheDistance)보다 느슨하게
+	float FloorCacheDistance = 200.f;
+};
+
+namespace P3DMass
+{
+	// 시간 + 위상만으로 정해지는 배회 입력(엔티티/승격 액터 공용)
+	inline void AdvanceWander(FP3DMassMoveFragment& Move, float DeltaTime)
+	{
+		Move.WanderTime += DeltaTime;
+
+		const float T = Move.WanderTime;
+		const float Phase = Move.WanderPhase;
+
+		Move.MoveInput = FVector2D(FMath::Sin(T * 0.7f + Phase), FMath::Cos(T * 0.5f + Phase));
+		Move.UpDownInput = FMath::Sin(T * 0.4f + Phase);
+		Move.TurnInput = 30.f * FMath::Sin(T * 1.3f + Phase);
+	}
+}
@@ -0,0 +1,117 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "DroneFlightKernel.h"
+#include "P3DMassFragments.h"
+#include "P3DMassPopulationSubsystem.generated.h"
+
+class APawn;
+struct FMassEntityManager;
+
+// =========================================================
+// 배경 Pawn/드론 군중 (MassEntity)
+// - 멀리 있는 개체는 엔티티(프래그먼트)로만 존재: 이동은 P3DMassProcessors가 일괄 처리
+// - 로컬 뷰 근처(p3d.Mass.PromoteDistance)에 들어오면 실제 액터로 승격, 벗어나면(DemoteDistance) 강등
+//   (두 거리 사이는 유지 → 경계에서 스폰/파괴 반복 방지)
+// - 승격/강등 시 위치/Yaw/바닥/비행 상태를 주고받음, 플레이어가 조종 중인 액터는 강등하지 않음
+// - 빙의 흐름에서 바로 쓸 액터가 필요하면 PromoteNearest
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DMassPopulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// PawnClass(ABasePawn/ADronePawn 계열) 엔티티를 Center 주변 격자에 배치
+	// 반환: 이번에 만든 엔티티 수(메모리는 GetBytesPerEntity)
+	int32 SpawnPopulation(TSubclassOf<APawn> PawnClass, int32 Count, const FVector& Center, float Spacing = 300.f);
+
+	// 엔티티 + 승격 액터 전부 제거(플레이어가 조종 중인 액터는 남김)
+	void DestroyPopulation();
+
+	// 빙의 등: 즉시 액터로 승격(이미 승격돼 있으면 그 액터)
+	APawn* PromoteEntity(FMassEntityHandle Entity);
+
+	// Location에서 MaxDistance 안의 가장 가까운 엔티티를 승격(없으면 nullptr)
+	APawn* PromoteNearest(const FVector& Location, bool bDrone, float MaxDistance);
+
+	int32 GetNumEntities() const { return Entities.Num(); }
+	int32 GetNumPromoted() const { return Promoted.Num(); }
+
+	// 마지막 SpawnPopulation 기준 엔티티당 EntityManager 메모리(바이트)
+	double GetBytesPerEntity() const { return BytesPerEntity; }
+
+	// ===== 프로세서용 =====
+	const FP3DMassPawnParams& GetPawnParams() const { return PawnParams; }
+	const FDroneFlightParams& GetDroneParams() const { return DroneParams; }
+	float GetDroneRadius() const { return DroneRadius; }
+
+	// 이번 프레임에 승격/강등 후보를 모을지(재평가 주기)
+	bool IsEvaluatingLOD() const { return bEvaluateLOD; }
+	const TArray<FVector, TInlineAllocator<4>>& GetViewLocations() const { return ViewLocations; }
+	float GetPromoteDistSq() const { return PromoteDistSq; }
+	float GetDemoteDistSq() const { return DemoteDistSq; }
+
+	void RequestPromote(FMassEntityHandle Entity, float DistSq);
+	void RequestDemote(FMassEntityHandle Entity);
+
+	// 승격 액터가 외부에서 사라짐(엔티티도 제거)
+	void RequestRemove(FMassEntityHandle Entity);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPromoteRequest
+	{
+		FMassEntityHandle Entity;
+		float DistSq = 0.f;
+	};
+
+	TArray<FMassEntityHandle> Entities;
+	TArray<FMassEntityHandle> Promoted;
+
+	TArray<FPromoteRequest> PromoteRequests;
+	TArray<FMassEntityHandle> DemoteRequests;
+	TArray<FMassEntityHandle> RemoveRequests;
+
+	UPROPERTY(Transient)
+	TSubclassOf<APawn> BasePawnClass;
+
+	UPROPERTY(Transient)
+	TSubclassOf<APawn> DronePawnClass;
+
+	FP3DMassPawnParams PawnParams;
+	FDroneFlightParams DroneParams;
+	float DroneRadius = 30.f;
+
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	float PromoteDistSq = 0.f;
+	float DemoteDistSq = 0.f;
+	float TimeUntilUpdate = 0.f;
+	bool bEvaluateLOD = false;
+
+	double BytesPerEntity = 0.0;
+
+	FMassEntityManager* GetEntityManager() const;
+	SIZE_T GetEntityManagerBytes() const;
+
+	void GatherViewLocations();
+	void ApplyLODRequests();
+	void DrivePromotedActors(float DeltaTime);
+
+	// 엔티티 → 액터(상태 복사 후 Promoted 태그)
+	APawn* SpawnActorFor(FMassEntityManager& EntityManager, FMassEntityHandle Entity);
+
+	// 액터 → 엔티티(상태 복사 후 액터 파괴, 태그 제거)
+	void Demote(FMassEntityManager& EntityManager, FMassEntityHandle Entity);
+
+	void CacheClassParams(TSubclassOf<APawn> PawnClass, bool bDrone);
+};
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "P3DMassProcessors.generated.h"
+
+// =========================================================
+// 원거리 Pawn 이동 (액터 없는 엔티티)
+// - 배회 입력 → Yaw 방향 수평 이동(벽 스윕 없음)
+// - 바닥: FloorCacheDistance마다 라인 트레이스 한 번, 그 사이엔 바닥 높이 유지
+// - 바닥이 없거나 턱보다 높으면 중력 낙하(UBasePawnMovementComponent와 같은 규칙)
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DMassPawnMoveProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UP3DMassPawnMoveProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+// =========================================================
+// 원거리 드론 비행 (액터 없는 엔티티)
+// - DroneFlightKernel(접지/코요테/추진/중력) 그대로 사용
+// - 바닥은 UDroneSimSubsystem 공용 바닥 캐시 우선, miss면 라인 트레이스 후 저장
+// - 수평 이동은 스윕 없음(원거리 표현)
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DMassDroneProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UP3DMassDroneProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+// =========================================================
+// 승격/강등 후보 수집 (UP3DMassPopulationSubsystem 재평가 주기에만)
+// - 승격된 엔티티는 액터 위치를 트랜스폼에 반영(거리 판정용)
+// - 실제 스폰/파괴/태그 변경은 서브시스템 Tick에서(처리 도중 구조 변경 금지)
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DMassLODProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UP3DMassLODProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
@@ -0,0 +1,193 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Engine/NetSerialization.h"
+#include "P3DNetMovement.generated.h"
+
+// =========================================================
+// 네트워크 이동 공용 타입 (UP3DNetMovementComponent)
+// - 입력: 축은 int8(±127), 회전은 FRotator 압축 short, dt는 0.1ms 단위 uint16
+// - 서버 상태: 지난번 이 연결에 보낸 값과 달라진 필드만(마스크 + 양자화 값)
+// =========================================================
+
+namespace P3DNet
+{
+	// uint16 시퀀스 비교(래핑 고려): A가 B보다 뒤인지
+	FORCEINLINE bool IsNewerSeq(uint16 A, uint16 B)
+	{
+		return static_cast<int16>(A - B) > 0;
+	}
+
+	FORCEINLINE int8 QuantizeAxis(float Value)
+	{
+		return static_cast<int8>(FMath::RoundToInt32(FMath::Clamp(Value, -1.f, 1.f) * 127.f));
+	}
+
+	FORCEINLINE float DequantizeAxis(int8 Value)
+	{
+		return static_cast<float>(Value) / 127.f;
+	}
+
+	// 이동 입력 dt 단위(초)
+	constexpr float DeltaTimeUnit = 0.0001f;
+}
+
+// 클라 → 서버 이동 입력 한 개(양자화된 값이 곧 시뮬 입력: 클라 예측과 서버가 같은 값으로 시뮬)
+struct PAWN3DCHARACTER_API FP3DNetMoveInput
+{
+	uint16 Seq = 0;
+	uint16 DeltaTimeQ = 0;
+
+	int8 MoveX = 0;    // Right
+	int8 MoveY = 0;    // Forward
+	int8 UpDown = 0;   // 드론 전용
+
+	// 이번 입력을 적용한 뒤의 회전(Look/Roll은 클라에서 회전으로 바꿔 보냄)
+	uint16 Yaw = 0;
+	uint16 Pitch = 0;
+	uint16 Roll = 0;
+
+	// false면 Yaw만 유효(BasePawn)
+	bool bFullRotation = false;
+
+	float GetDeltaTime() const { return DeltaTimeQ * P3DNet::DeltaTimeUnit; }
+	FVector2D GetMove() const { return FVector2D(P3DNet::DequantizeAxis(MoveX), P3DNet::DequantizeAxis(MoveY)); }
+	float GetUpDown() const { return P3DNet::DequantizeAxis(UpDown); }
+	FRotator GetRotation() const;
+
+	void SetMove(const FVector2D& Move);
+	void SetUpDown(float Value) { UpDown = P3DNet::QuantizeAxis(Value); }
+	void SetRotation(const FRotator& Rotation, bool bFull);
+
+	bool HasSameMove(const FP3DNetMoveInput& Other) const;
+	bool HasSameRotation(const FP3DNetMoveInput& Other) const;
+};
+
+// 서버 RPC 한 번에 실어 보내는 입력 묶음(최신 입력 + 직전 입력 몇 개: 비신뢰 RPC 유실 대비)
+// - 시퀀스는 첫 입력만 전체, 나머지는 +1 연속
+// - 직전 입력과 이동/회전이 같으면 1비트로 생략
+USTRUCT()
+struct PAWN3DCHARACTER_API FP3DNetMoveBatch
+{
+	GENERATED_BODY()
+
+	static constexpr int32 MaxMoves = 4;
+
+	TArray<FP3DNetMoveInput, TInlineAllocator<MaxMoves>> Moves;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FP3DNetMoveBatch> : public TStructOpsTypeTraitsBase2<FP3DNetMoveBatch>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+// 이동 상태(저장/복원/비교용)
+struct FP3DNetMoveState
+{
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	float VerticalVelocity = 0.f;
+	bool bGrounded = false;
+
+	// ===== 로컬 전용(전송 안 함): 재적용 시 예측 기록 값을 이어서 씀 =====
+	float TimeSinceGrounded = 0.f;
+	float StepAccumulator = 0.f;
+
+	// 전송되는 필드만 Other에서 복사
+	void CopyReplicatedFrom(const FP3DNetMoveState& Other)
+	{
+		Location = Other.Location;
+		Rotation = Other.Rotation;
+		VerticalVelocity = Other.VerticalVelocity;
+		bGrounded = Other.bGrounded;
+	}
+};
+
+// 전송 단위(위치 0.1cm, 회전 short, 수직 속도 0.125cm/s)
+struct FP3DNetQuantizedState
+{
+	FIntVector Location = FIntVector::ZeroValue;
+	uint16 Yaw = 0;
+	uint16 Pitch = 0;
+	uint16 Roll = 0;
+	int16 VerticalVelocity = 0;
+	bool bGrounded = false;
+
+	// 서버가 순간이동시킬 때마다 증가(받는 쪽은 보간/예측을 버리고 스냅)
+	uint8 TeleportId = 0;
+
+	static FP3DNetQuantizedState FromState(const FP3DNetMoveState& State, uint8 InTeleportId);
+	void ToState(FP3DNetMoveState& OutState) const;
+
+	// Base와 다른 필드 마스크(Base 없으면 전부)
+	uint16 DiffMask(const FP3DNetQuantizedState* Base) const;
+
+	// 마스크 + 마스크에 해당하는 필드만
+	void Serialize(FArchive& Ar, uint16& Mask);
+
+	bool operator==(const FP3DNetQuantizedState& Other) const
+	{
+		return DiffMask(&Other) == 0;
+	}
+};
+
+// 서버 → 클라 상태(연결별 지난번 전송 값 기준 변경 필드만)
+// - 기준(INetDeltaBaseState)은 엔진이 연결별로 보관, 패킷 유실(NAK) 시 확인된 기준으로 되돌림
+// - 바뀐 필드 값은 절대값으로 보냄: 기준이 어긋나도 다음 전송에서 스스로 복구
+USTRUCT()
+struct PAWN3DCHARACTER_API FP3DNetReplicatedState
+{
+	GENERATED_BODY()
+
+	// 서버: 보낼 상태 / 클라: 받은 상태(역양자화)
+	FP3DNetMoveState State;
+	uint8 TeleportId = 0;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+private:
+	// 클라: 마지막으로 받은 양자화 값(마스크에 없는 필드는 이 값 유지)
+	FP3DNetQuantizedState Received;
+};
+
+template<>
+struct TStructOpsTypeTraits<FP3DNetReplicatedState> : public TStructOpsTypeTraitsBase2<FP3DNetReplicatedState>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UP3DNetMovementPawn : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// UP3DNetMovementComponent가 붙는 Pawn이 구현
+// - 같은 입력이면 클라 예측/서버/재적용 어디서든 같은 결과가 나와야 함(NetSimulateMove 안에서 로컬 입력 캐시 사용 금지)
+class PAWN3DCHARACTER_API IP3DNetMovementPawn
+{
+	GENERATED_BODY()
+
+public:
+	// 이번 프레임에 소비한 로컬 입력 → 이동 입력(Look/Roll은 목표 회전으로 변환, 카메라 피치 등 로컬 전용은 여기서 적용)
+	virtual void NetGatherInput(float DeltaTime, FP3DNetMoveInput& OutInput) = 0;
+
+	// 양자화된 입력 하나만큼 시뮬
+	virtual void NetSimulateMove(const FP3DNetMoveInput& Input) = 0;
+
+	virtual void NetSaveState(FP3DNetMoveState& OutState) const = 0;
+	virtual void NetRestoreState(const FP3DNetMoveState& State) = 0;
+
+	// 시뮬 프록시: 보간된 트랜스폼을 그대로 적용(스윕/시뮬 없음)
+	virtual void NetApplyProxyTransform(const FVector& Location, const FRotator& Rotation, float DeltaTime) = 0;
+};
@@ -0,0 +1,125 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "P3DNetMovement.h"
+#include "P3DNetMovementComponent.generated.h"
+
+// =========================================================
+// 서버 권한 이동 + 클라 예측 (ABasePawn/ADronePawn 공용, IP3DNetMovementPawn 필요)
+// - 소유 클라(AutonomousProxy): 입력을 양자화해서 바로 예측 시뮬 → 기록 → 비신뢰 RPC로 최근 입력 몇 개를 묶어 전송
+//   서버 상태 + 처리한 마지막 시퀀스를 받으면 해당 예측 기록과 비교, 오차가 크면 서버 상태로 되감고 남은 입력 재적용
+// - 서버: 원격 조종 Pawn은 받은 입력으로만 시뮬(새 시퀀스만, dt 제한), 나머지는 로컬 Tick 그대로
+//   클라 dt 합이 서버 경과 시간 + p3d.Net.MaxTimeDiscrepancy를 넘으면 초과 입력은 버림(→ 클라 보정)
+//   매 프레임 상태를 FP3DNetReplicatedState로 발행(바뀐 필드만 전송)
+// - 다른 클라(SimulatedProxy): 받은 상태를 버퍼에 쌓고 조금 과거 시점으로 보간해서 표시
+// - 독립 실행(NM_Standalone)이면 아무것도 안 함 → 기존 로컬 경로
+// - 지연/유실 재현: p3d.Net.Emulate <지연ms> <유실%>, 측정: p3d.Net.Report
+// =========================================================
+UCLASS(ClassGroup = Movement, meta = (BlueprintSpawnableComponent))
+class PAWN3DCHARACTER_API UP3DNetMovementComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UP3DNetMovementComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Pawn Tick에서 입력 소비 직후 호출
+	// 네트워크 게임이면 역할별로 이동까지 처리하고 true(호출 쪽은 로컬 시뮬 생략), 독립 실행이면 false
+	bool TickNetworkedMove(float DeltaTime);
+
+	// 서버: 순간이동(풀 활성화 등) 알림 → 프록시는 보간 없이 스냅, 소유 클라는 예측 기록 폐기
+	void NotifyTeleported();
+
+	bool IsNetworked() const;
+
+	int32 GetNumPendingMoves() const { return PendingMoves.Num(); }
+	uint32 GetNumCorrections() const { return NumCorrections; }
+
+	// 끄면 네트워크 게임에서도 로컬 경로(엔진 기본 이동 복제 등 다른 방식을 쓸 때)
+	UPROPERTY(EditAnywhere, Category = "Net")
+	bool bEnableNetMovement = true;
+
+protected:
+	UFUNCTION(Server, Unreliable)
+	void ServerMove(const FP3DNetMoveBatch& Batch);
+
+	UFUNCTION()
+	void OnRep_ServerState();
+
+	UFUNCTION()
+	void OnRep_ServerAckSeq();
+
+private:
+	// 서버 → 모두: 이동 상태
+	UPROPERTY(ReplicatedUsing = OnRep_ServerState)
+	FP3DNetReplicatedState ServerState;
+
+	// 서버 → 소유 클라: ServerState에 반영된 마지막 입력 시퀀스
+	UPROPERTY(ReplicatedUsing = OnRep_ServerAckSeq)
+	uint16 ServerAckSeq = 0;
+
+	// ===== 소유 클라: 예측 =====
+	struct FSavedMove
+	{
+		FP3DNetMoveInput Input;
+		FP3DNetMoveState State; // 이 입력 적용 직후
+	};
+
+	TArray<FSavedMove> PendingMoves;
+	uint16 NextSeq = 1;
+	bool bPendingReconcile = false;
+
+	// dt 양자화 나머지(예측 시간이 실제 시간에서 밀리지 않게)
+	float DeltaTimeRemainder = 0.f;
+
+	// ===== 서버 =====
+	TWeakObjectPtr<AController> LastMoveController;
+	uint16 LastProcessedSeq = 0;
+	bool bHasProcessedMove = false;
+
+	// 시간 예산: 처리한 클라 dt 합 - 서버 경과 시간(초), 컨트롤러가 바뀌면 초기화
+	double TimeDiscrepancy = 0.0;
+	double LastServerMoveTime = 0.0;
+
+	// ===== 시뮬 프록시: 보간 버퍼 =====
+	struct FProxySample
+	{
+		double Time = 0.0;
+		FVector Location = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+	};
+
+	TArray<FProxySample> ProxySamples;
+	uint8 LastTeleportId = 0;
+
+	ENetRole LastRole = ROLE_None;
+	uint32 NumCorrections = 0;
+
+	// p3d.Net.Report의 서버 Pawn 수 집계에 포함됐는지
+	bool bCountedAsServerPawn = false;
+
+	IP3DNetMovementPawn* GetNetPawn() const;
+
+	// 서버에서 원격 클라가 조종 중(ServerMove로만 시뮬)
+	bool IsRemotelyControlled() const;
+
+	void TickAutonomous(IP3DNetMovementPawn& NetPawn, float DeltaTime);
+	void TickSimulatedProxy(IP3DNetMovementPawn& NetPawn, float DeltaTime);
+
+	// 로컬 입력 → 양자화 입력(dt 나머지 누적)
+	void GatherMove(IP3DNetMovementPawn& NetPawn, float DeltaTime, FP3DNetMoveInput& OutInput);
+
+	void SendPendingMoves();
+	void Reconcile(IP3DNetMovementPawn& NetPawn);
+
+	// 서버: 현재 상태 → ServerState
+	void PublishState();
+
+	void ResetPrediction();
+};
@@ -0,0 +1,89 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "P3DPawnAnimInstance.generated.h"
+
+class ABasePawn;
+
+// 애님 업데이트에 쓰는 Pawn 상태(프레임당 한 번 복사)
+USTRUCT(BlueprintType)
+struct FP3DPawnAnimSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Anim")
+	bool bIsMoving = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Anim")
+	float Speed2D = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Anim")
+	bool bWantsInteract = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Anim")
+	bool bIsInteracting = false;
+};
+
+// =========================================================
+// 게임 스레드 → 워커 스레드 전달용 프록시
+// - PreUpdate(게임 스레드): Pawn 필드를 스냅샷으로 복사(이때만 Pawn 접근)
+// - 이후 애님 업데이트(워커 스레드)는 스냅샷만 읽음
+// =========================================================
+USTRUCT()
+struct FP3DPawnAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FP3DPawnAnimInstanceProxy() = default;
+	explicit FP3DPawnAnimInstanceProxy(UAnimInstance* InAnimInstance) : FAnimInstanceProxy(InAnimInstance) {}
+
+	const FP3DPawnAnimSnapshot& GetSnapshot() const { return Snapshot; }
+
+protected:
+	virtual void InitializeObjects(UAnimInstance* InAnimInstance) override;
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void ClearObjects() override;
+
+private:
+	TWeakObjectPtr<ABasePawn> Pawn;
+	FP3DPawnAnimSnapshot Snapshot;
+};
+
+// =========================================================
+// ABasePawn 전용 AnimInstance (ABP_BasePawn 부모 클래스)
+// - 이벤트 그래프/BP 프로퍼티 접근 없이 스냅샷 값을 AnimGraph에 노출
+// - NativeThreadSafeUpdateAnimation에서 갱신 → 멀티스레드 애님 업데이트 가능
+// - Interact 시작/끝은 UP3DInteractNotifyState가 C++로 직접 전달
+// =========================================================
+UCLASS(Transient)
+class PAWN3DCHARACTER_API UP3DPawnAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Anim")
+	bool bIsMoving = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Anim")
+	float CurrentSpeed2D = 0.f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Anim")
+	bool bWantsInteract = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Anim")
+	bool bIsInteracting = false;
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &Proxy; }
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
+
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+
+private:
+	UPROPERTY(Transient)
+	FP3DPawnAnimInstanceProxy Proxy;
+
+	friend struct FP3DPawnAnimInstanceProxy;
+};
@@ -4,11 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "Engine/StreamableManager.h"
+#include "DroneSwarmSubsystem.h"
 #include "P3DPlayerController.generated.h"
 
 
 class UInputMappingContext; // IMC 관련 전방 선언
 class UInputAction; // IA 관련 전방 선언
+class UEnhancedInputLocalPlayerSubsystem;
 class ADronePawn;
 
 UCLASS()
@@ -20,6 +23,9 @@ protected:
 
 	// Possess가 바뀔 때마다 IMC를 맞춰 끼우기 위해 오버라이드
 	virtual void OnPossess(APawn* InPawn) override;
+
+	// 원격 클라: OnPossess는 서버에서만 불림 → 빙의 확인 시점에 IMC 교체
+	virtual void AcknowledgePossession(APawn* P) override;
 public:
 	AP3DPlayerController();
 
@@ -54,17 +60,94 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input|Drone")
     UInputAction* ReturnToPlayerAction;
 
+    // 전환 모드: 두 IMC를 계속 등록해 두고 빙의 쪽 IMC만 우선순위를 한 단계 올림(빼고 다시 끼우지 않음)
+    // - 두 IMC가 같은 키를 쓰면 우선순위가 높은 쪽(빙의한 Pawn)이 키를 소비
+    // - 각 Pawn은 자기 액션만 바인딩 → 빙의 안 한 쪽 IMC의 나머지 액션은 발동해도 받는 쪽이 없음
+    // - 우선순위 변경 두 번은 한 번의 지연 재구성으로 합쳐짐(제거 + 추가 + 누른 키 무시 없음)
+    // (false면 기존처럼 전환마다 둘 다 빼고 하나를 다시 끼움)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+    bool bPreBindInputContexts = true;
+
+    // 전환 모드에서 빙의 안 한 쪽 IMC 우선순위(빙의 쪽은 +1)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+    int32 InputContextPriority = 0;
+
     // 드론 Pawn BP/클래스 지정(에디터에서)
+    // 소프트 참조: 드론을 안 쓰는 플레이어는 드론 에셋을 메모리에 올리지 않음
+    // Interact 요청(bWantsInteract) 때 비동기 로드 시작 → Interact 애니(Start~End) 동안 로드
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone")
-    TSubclassOf<ADronePawn> DronePawnClass;
+    TSoftClassPtr<ADronePawn> DronePawnClass;
+
+    // Interact 애니가 끝났는데 로드가 안 끝났을 때
+    // true: 그 자리에서 로드 완료까지 대기(히치, 바로 전환) / false: 로드 완료 시 전환(지연)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Loading")
+    bool bBlockOnLateDroneLoad = false;
+
+    // 드론 풀: 토글마다 Spawn/Destroy 대신 미리 만들어둔 드론을 켜고 끔
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Pool")
+    bool bUseDronePool = true;
+
+    // BeginPlay에서 미리 만들어둘 드론 수
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Pool", meta = (ClampMin = "0"))
+    int32 DronePoolSize = 1;
+
+    // 드론 전환 시 주변 Mass 드론 엔티티가 있으면 그걸 승격해서 빙의(풀/스폰보다 우선)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Mass")
+    bool bPossessMassDrones = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Mass", meta = (ClampMin = "0.0", EditCondition = "bPossessMassDrones"))
+    float MassDroneSearchRadius = 2000.f;
+
+    // 군집 모드: 드론 전환 시 빙의한 드론(리더) 주변에 팔로워를 풀에서 꺼내 대형 유지(UDroneSwarmSubsystem)
+    // 풀 사용 시 BeginPlay/로드 완료 때 DronePoolSize + SwarmFollowerCount만큼 미리 만듦
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Swarm")
+    bool bSwarmMode = false;
 
-    // 호출용: E를 눌렀을 때
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Swarm", meta = (ClampMin = "0", EditCondition = "bSwarmMode"))
+    int32 SwarmFollowerCount = 16;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Swarm", meta = (EditCondition = "bSwarmMode"))
+    EDroneFormation SwarmFormation = EDroneFormation::Wedge;
+
+    // 슬롯 간격(cm, p3d.Swarm.SeparationRadius보다 크게)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone|Swarm", meta = (ClampMin = "1.0", EditCondition = "bSwarmMode"))
+    float SwarmSpacing = 250.f;
+
+    // 호출용: E를 눌렀을 때 (클라이언트면 서버에 요청: 드론 풀/스폰/빙의는 서버에서)
     UFUNCTION(BlueprintCallable, Category = "Drone")
     void ToggleDrone();
 
     UFUNCTION(BlueprintCallable, Category = "Drone")
     void ReturnToPlayer();
 
+    // 드론 클래스/메시 비동기 로드 요청(이미 로드/요청됐으면 무시)
+    // 클라면 서버에도 요청(스폰은 서버, 복제된 드론 생성은 클라)
+    UFUNCTION(BlueprintCallable, Category = "Drone")
+    void PreloadDroneAssets();
+
+    bool AreDroneAssetsLoaded() const { return bDroneAssetsLoaded; }
+
+    // 대형 변경(군집 중이면 바로 적용, 아니면 다음 군집부터) - 서버에서
+    UFUNCTION(BlueprintCallable, Category = "Drone|Swarm")
+    void SetSwarmFormation(EDroneFormation Formation, float Spacing);
+
+    int32 GetNumSwarmFollowers() const { return SwarmFollowers.Num(); }
+
+    // ===== World Partition 스트리밍 소스 =====
+    // 위치는 카메라 대신 빙의한 Pawn, Pawn이 IP3DStreamingSourcePawn이면 그 모양(비행 방향 예측 영역)
+    virtual void GetStreamingSourceLocationAndRotation(FVector& OutLocation, FRotator& OutRotation) const override;
+    virtual void GetStreamingSourceShapes(TArray<FStreamingSourceShape>& OutShapes) const override;
+
+protected:
+    UFUNCTION(Server, Reliable)
+    void ServerToggleDrone();
+
+    UFUNCTION(Server, Reliable)
+    void ServerReturnToPlayer();
+
+    UFUNCTION(Server, Unreliable)
+    void ServerPreloadDroneAssets();
+
 private:
     // 현재 “원래 플레이어 Pawn”을 기억해뒀다가 복귀에 사용
     UPROPERTY()
@@ -73,8 +156,64 @@ private:
     UPROPERTY()
     ADronePawn* CachedDronePawn = nullptr;
 
+    // CachedDronePawn이 Mass 엔티티에서 승격된 드론(복귀 시 풀 대신 UP3DMassPopulationSubsystem에 맡김)
+    bool bCachedDroneFromMass = false;
+
+    // 현재 빙의한 Pawn 쪽 IMC
+    UPROPERTY()
+    UInputMappingContext* ActiveIMC = nullptr;
+
+    bool bContextsPreBound = false;
+
+    // 비활성(숨김/충돌 OFF/Tick OFF) 상태로 대기 중인 드론
+    UPROPERTY()
+    TArray<ADronePawn*> DronePool;
+
+    // ===== Drone Swarm =====
+    // 리더(CachedDronePawn)를 따라가는 팔로워(복귀 시 풀에 반납)
+    UPROPERTY()
+    TArray<ADronePawn*> SwarmFollowers;
+
+    int32 SwarmId = INDEX_NONE;
+
+    // ===== Drone Asset Loading =====
+    // 핸들을 들고 있는 동안 로드된 에셋 유지
+    TSharedPtr<FStreamableHandle> DroneClassHandle;
+    TSharedPtr<FStreamableHandle> DroneMeshHandle;
+
+    bool bDroneAssetsLoaded = false;
+
+    // 로드가 늦어서 전환을 미룬 상태(로드 완료 시 ToggleDrone)
+    bool bToggleWhenDroneLoaded = false;
+
+    double DroneLoadStartSeconds = 0.0;
+    double LateToggleStartSeconds = 0.0;
+    int64 DroneLoadStartUsedMemory = 0;
+
 private:
     void ApplyIMC(UInputMappingContext* IMC);
+    void PreBindInputContexts(UEnhancedInputLocalPlayerSubsystem& Subsystem);
 
     ADronePawn* SpawnDroneNear(APawn* PlayerPawn);
+
+    // ===== Drone Pool =====
+    void PrewarmDronePool();
+    ADronePawn* SpawnPooledDrone();
+    ADronePawn* AcquireDrone(const FVector& Location, const FRotator& Rotation);
+    void ReleaseDrone(ADronePawn* Drone);
+
+    // ===== Drone Swarm =====
+    // 리더 기준 슬롯 위치에 팔로워 배치 + UDroneSwarmSubsystem 등록
+    void SpawnSwarm(ADronePawn* Leader);
+    void ReleaseSwarm();
+
+    // ===== Drone Asset Loading =====
+    void RequestDroneClassLoad();
+    // 드론 CDO의 DroneMesh 로드 요청, 기다릴 메시가 있으면 true
+    bool RequestDroneMeshLoad();
+    void OnDroneClassLoaded();
+    void OnDroneAssetsLoaded();
+
+    // 로드가 안 끝난 채로 토글됐을 때: 대기하거나 전환을 미룸, 지금 전환해도 되면 true
+    bool HandleLateDroneLoad();
 };
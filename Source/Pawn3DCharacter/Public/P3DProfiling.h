@@ -0,0 +1,68 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "P3DStats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// =========================================================
+// Pawn 핫패스 계측
+// - P3D_SCOPE(Name) 하나로: stat 사이클(STAT_P3D_Name) + Insights 트레이스 + 롤링 히스토그램
+// - 히스토그램은 stat/트레이스가 빠진 빌드(Shipping 등)에서도 동작 → p3d.Profile.Dump
+// - 프레임 카운터(스윕/오프셋/빙의 전환)는 프레임 끝에 CSV_CUSTOM_STAT(Pawn3D, ...)로 기록
+// =========================================================
+
+// 히스토그램 대상 함수(P3D_SCOPE 이름과 같게)
+enum class EP3DScope : uint8
+{
+	BasePawnTick,
+	PawnMove,
+	DroneActorTick,
+	DroneBatchTick,
+	DroneTickRotation,
+	DroneTickVertical,
+	DroneProbeGround,
+	MassPawnMove,
+	MassDroneMove,
+	MassLOD,
+	RollbackResim,
+	ToggleDrone,
+	ApplyIMC,
+
+	Count
+};
+
+namespace P3DProfiling
+{
+	// 게임 스레드에서만 기록(다른 스레드 호출은 무시)
+	PAWN3DCHARACTER_API void RecordScope(EP3DScope Scope, uint64 Cycles);
+
+	PAWN3DCHARACTER_API bool IsHistogramEnabled();
+}
+
+// 스코프 길이를 히스토그램에 기록
+class FP3DScopeTimer
+{
+public:
+	explicit FP3DScopeTimer(EP3DScope InScope)
+		: Scope(InScope)
+		, StartCycles(P3DProfiling::IsHistogramEnabled() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FP3DScopeTimer()
+	{
+		if (StartCycles != 0)
+		{
+			P3DProfiling::RecordScope(Scope, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	EP3DScope Scope;
+	uint64 StartCycles;
+};
+
+#define P3D_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_P3D_##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(P3D_##Name); \
+	FP3DScopeTimer P3DScopeTimer_##Name(EP3DScope::Name)
@@ -0,0 +1,171 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include "P3DNetMovement.h"
+#include <atomic>
+#include "P3DReplay.generated.h"
+
+class FRunnableThread;
+class FEvent;
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// =========================================================
+// 입력 녹화/재생 파일 (.p3dr, 리틀 엔디언)
+// - 헤더: 매직/버전/체크섬 주기/맵 이름/시작 Pawn 상태
+// - 본문: 레코드 나열(태그 1바이트 + 값)
+//   Frame(dt) → 그 프레임 입력 콜백들 → (주기마다) Checksum → 다음 Frame ...
+// - 값은 콜백이 받은 float 그대로(양자화 없음 → 같은 dt면 같은 결과)
+// =========================================================
+
+// 녹화 대상 입력 콜백
+enum class EP3DReplayInput : uint8
+{
+	Move,            // BasePawn::Move / DronePawn::Move2D
+	MoveCompleted,   // BasePawn::MoveCompleted
+	Look,
+	UpDown,          // 드론 전용
+	Roll,            // 드론 전용
+	Interact,        // BasePawn
+	ReturnToPlayer,  // DronePawn
+
+	Count
+};
+
+enum class EP3DReplayRecord : uint8
+{
+	Frame,     // float DeltaTime
+	Input,     // uint8 EP3DReplayInput + 축 값(0~2 float)
+	Checksum,  // uint32 Crc + FVector3f 위치(어긋난 거리 보고용)
+	End,       // uint32 프레임 수
+};
+
+namespace P3DReplay
+{
+	constexpr uint32 Magic = 0x52443350; // "P3DR"
+	constexpr uint16 Version = 1;
+
+	// 입력 종류별 float 개수
+	PAWN3DCHARACTER_API int32 GetNumAxes(EP3DReplayInput Input);
+
+	// Pawn 이동 상태 요약(위치 0.01cm, 회전 short, 수직 속도 0.01cm/s, 클래스)
+	PAWN3DCHARACTER_API uint32 ComputeChecksum(const APawn* Pawn, FVector3f& OutLocation);
+}
+
+// 녹화 시작 시점 정보
+struct FP3DReplayHeader
+{
+	uint16 ChecksumInterval = 0;
+	FString MapName;
+
+	// 0 = 기타, 1 = ABasePawn, 2 = ADronePawn
+	uint8 PawnKind = 0;
+	FP3DNetMoveState StartState;
+};
+
+// 레코드 버퍼를 백그라운드 스레드가 파일로 흘려보냄
+// - 게임 스레드: Write*로 현재 청크에 추가, 청크가 차거나 일정 시간이 지나면 큐로 넘김
+// - 청크는 재사용(쓰기 스레드 → 빈 청크 큐)
+class PAWN3DCHARACTER_API FP3DReplayWriter final : public FRunnable
+{
+public:
+	~FP3DReplayWriter();
+
+	bool Open(const FString& Path, const FP3DReplayHeader& Header);
+	// 남은 청크를 전부 쓰고 스레드 종료
+	void Close(uint32 NumFrames);
+
+	bool IsOpen() const { return Thread != nullptr; }
+
+	void WriteFrame(float DeltaTime);
+	void WriteInput(EP3DReplayInput Input, const FVector2D& Value);
+	void WriteChecksum(uint32 Crc, const FVector3f& Location);
+
+	// 현재 청크가 조건을 넘었으면 쓰기 스레드로(프레임 끝에서 호출)
+	void FlushIfNeeded();
+
+	uint64 GetBytesWritten() const { return BytesWritten.load(std::memory_order_relaxed); }
+
+private:
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	void WriteBytes(const void* Data, int32 Num);
+
+	template<typename T>
+	void WritePod(const T& Value) { WriteBytes(&Value, sizeof(T)); }
+
+	void SubmitCurrent();
+	void WritePending();
+
+	TUniquePtr<IFileHandle> File;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+
+	TQueue<TArray<uint8>*, EQueueMode::Spsc> PendingChunks;
+	TQueue<TArray<uint8>*, EQueueMode::Spsc> FreeChunks;
+	TArray<TUniquePtr<TArray<uint8>>> OwnedChunks;
+	TArray<uint8>* Current = nullptr;
+
+	double LastSubmitSeconds = 0.0;
+
+	std::atomic<bool> bStopping{ false };
+	std::atomic<uint64> BytesWritten{ 0 };
+};
+
+// 메모리 매핑한 녹화 파일을 앞에서부터 읽음(복사 없음)
+class PAWN3DCHARACTER_API FP3DReplayReader
+{
+public:
+	~FP3DReplayReader();
+
+	bool Open(const FString& Path, FP3DReplayHeader& OutHeader, FString& OutError);
+	void Close();
+
+	bool IsOpen() const { return Data != nullptr; }
+	bool IsAtEnd() const { return !Data || Offset >= Size; }
+
+	// 다음 레코드 태그(읽지 않음), 끝이면 false
+	bool PeekRecord(EP3DReplayRecord& OutRecord) const;
+
+	bool ReadFrame(float& OutDeltaTime);
+	bool ReadInput(EP3DReplayInput& OutInput, FVector2D& OutValue);
+	bool ReadChecksum(uint32& OutCrc, FVector3f& OutLocation);
+	bool ReadEnd(uint32& OutNumFrames);
+
+	int64 GetOffset() const { return Offset; }
+	int64 GetSize() const { return Size; }
+
+private:
+	bool ReadBytes(void* Out, int64 Num);
+
+	template<typename T>
+	bool ReadPod(T& Out) { return ReadBytes(&Out, sizeof(T)); }
+
+	bool ReadTag(EP3DReplayRecord Expected);
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+	int64 Offset = 0;
+};
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UP3DReplayInputTarget : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// 재생 입력을 받는 Pawn이 구현: 실제 Enhanced Input 콜백으로 그대로 전달
+class PAWN3DCHARACTER_API IP3DReplayInputTarget
+{
+	GENERATED_BODY()
+
+public:
+	virtual void ReplayInput(EP3DReplayInput Input, const FVector2D& Value) = 0;
+};
@@ -0,0 +1,106 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "P3DReplay.h"
+#include "P3DReplaySubsystem.generated.h"
+
+class APawn;
+
+// =========================================================
+// 입력 녹화/재생 (재현 가능한 프로파일링/회귀 실행)
+// - 녹화: 로컬 플레이어 Pawn의 Enhanced Input 콜백 값 + 프레임 dt + 주기적 상태 체크섬 → .p3dr
+//   파일 쓰기는 FP3DReplayWriter 스레드(게임 스레드는 버퍼에 붙이기만)
+// - 재생: 파일을 메모리 매핑해서 프레임마다 같은 콜백으로 입력 주입, dt는 고정 스텝으로 녹화 값 그대로
+//   체크섬이 다르면 어긋남으로 기록(처음 어긋난 프레임/거리 로그)
+// - 재생 중에는 실제 장치 입력을 막음
+// - 시작 상태는 로컬 Pawn 이동 상태만 복원(다른 액터/Mass/AI는 맵 초기 상태에 의존)
+//
+// 콘솔: p3d.Replay.Record [이름] / p3d.Replay.Stop / p3d.Replay.Play <이름|경로>
+// 헤드리스: -P3DReplay=<이름|경로> [-P3DReplayQuit] (어긋나면 종료 코드 1)
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DReplaySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	bool StartRecording(const FString& Name);
+	bool StartPlayback(const FString& NameOrPath, bool bInQuitWhenDone = false);
+	void Stop();
+
+	bool IsRecording() const { return Mode == EMode::Recording; }
+	bool IsPlaying() const { return Mode == EMode::Playing; }
+
+	// 입력 콜백 첫 줄에서 호출: 녹화 중이면 기록, 재생 중 실제 장치 입력이면 false(무시)
+	static bool FilterInput(UP3DReplaySubsystem* Replay, EP3DReplayInput Input, const FVector2D& Value = FVector2D::ZeroVector)
+	{
+		return !Replay || Replay->HandleLiveInput(Input, Value);
+	}
+
+	static FString ResolvePath(const FString& NameOrPath);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class EMode : uint8
+	{
+		None,
+		Recording,
+		Playing,
+	};
+
+	EMode Mode = EMode::None;
+
+	// 다음 PreActorTick에서 헤더 기록/시작 상태 복원(프레임 경계에서 시작)
+	bool bPendingStart = false;
+	uint64 StartFrameCounter = 0;
+
+	// 재생 입력을 콜백으로 넣는 중(FilterInput 통과)
+	bool bFeedingInput = false;
+
+	bool bQuitWhenDone = false;
+
+	FP3DReplayWriter Writer;
+	FP3DReplayReader Reader;
+	FP3DReplayHeader Header;
+	FString ActivePath;
+
+	uint32 FrameIndex = 0;
+	uint16 ChecksumInterval = 0;
+
+	// ===== 재생 결과 =====
+	uint32 NumChecksums = 0;
+	uint32 NumDivergences = 0;
+	int64 FirstDivergenceFrame = INDEX_NONE;
+	float MaxDivergenceCm = 0.f;
+	double PlaybackStartSeconds = 0.0;
+
+	// 재생 전 고정 스텝 설정(끝나면 되돌림)
+	bool bSavedUseFixedTimeStep = false;
+	double SavedFixedDeltaTime = 0.0;
+
+	FDelegateHandle PreActorTickHandle;
+	FDelegateHandle PostActorTickHandle;
+
+	void HandlePreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+	void HandlePostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	bool HandleLiveInput(EP3DReplayInput Input, const FVector2D& Value);
+
+	APawn* GetLocalPawn() const;
+
+	void BeginRecordingFrame(float DeltaSeconds);
+	void BeginPlaybackFrame();
+	void EndPlaybackFrame();
+
+	// 다음 프레임 dt를 녹화 값으로 고정(다음 레코드가 Frame이 아니면 재생 끝)
+	bool ScheduleNextDeltaTime();
+
+	void FinishPlayback();
+};
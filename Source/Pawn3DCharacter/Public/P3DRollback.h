@@ -0,0 +1,161 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "P3DNetMovement.h"
+#include <type_traits>
+#include "P3DRollback.generated.h"
+
+// =========================================================
+// 롤백: 프레임별 이동 상태 + 입력 기록 → 과거 프레임 복원 후 기록된 입력으로 재시뮬
+// - 스냅샷은 POD(memcpy 가능), 링 버퍼는 처음 한 번만 할당(기록 중 프레임당 힙 할당 없음)
+// - 기록: p3d.Rollback.Record 1 (Pawn Tick에서 입력 소비 직후, 시뮬 전에 한 장)
+// - 재시뮬: UP3DRollbackSubsystem::ResimulateFrom / p3d.Rollback.Resim <프레임 수>
+// =========================================================
+
+// 한 프레임 시작 시점 상태 + 그 프레임에 소비한 입력
+struct FP3DPawnSnapshot
+{
+	uint32 Frame = 0;      // GFrameCounter(중요도 Tick 간격 때문에 연속이 아닐 수 있음)
+	float DeltaTime = 0.f; // 그 프레임 Tick dt
+
+	// 시뮬 전 상태(드론은 렌더 보간 전 시뮬 트랜스폼 기준)
+	FP3DNetMoveState State;
+
+	// ===== 입력 =====
+	FVector2D MoveInput = FVector2D::ZeroVector;
+	FVector2D LookInput = FVector2D::ZeroVector;
+	float UpDownInput = 0.f;
+	float RollInput = 0.f;
+	bool bInputEnabled = true; // BasePawn: 조종 가능 여부(빙의/스크립트/Interact)
+};
+
+static_assert(std::is_trivially_copyable_v<FP3DPawnSnapshot>, "FP3DPawnSnapshot must stay POD");
+
+// 고정 용량 링 버퍼(가장 오래된 것부터 덮어씀)
+// - Init에서 한 번만 할당, Push는 다음 칸 참조만 돌려줌
+// - 인덱스 0 = 가장 오래된 것
+template<typename T>
+class TP3DSnapshotRing
+{
+	static_assert(std::is_trivially_copyable_v<T>, "TP3DSnapshotRing needs a POD element");
+
+public:
+	void Init(int32 InCapacity)
+	{
+		Items.SetNumUninitialized(FMath::Max(InCapacity, 1));
+		Start = 0;
+		Count = 0;
+	}
+
+	bool IsInitialized() const { return Items.Num() > 0; }
+	int32 Num() const { return Count; }
+	int32 Capacity() const { return Items.Num(); }
+	void Reset() { Start = 0; Count = 0; }
+
+	// 새 칸(가득 차면 가장 오래된 것 자리)
+	T& Push()
+	{
+		check(IsInitialized());
+		if (Count < Items.Num())
+		{
+			return Items[(Start + Count++) % Items.Num()];
+		}
+
+		T& Slot = Items[Start];
+		Start = (Start + 1) % Items.Num();
+		return Slot;
+	}
+
+	T& operator[](int32 Index) { check(Index >= 0 && Index < Count); return Items[(Start + Index) % Items.Num()]; }
+	const T& operator[](int32 Index) const { check(Index >= 0 && Index < Count); return Items[(Start + Index) % Items.Num()]; }
+
+	const T& Last() const { return (*this)[Count - 1]; }
+
+	// Index 이후(포함) 전부 버림(되돌린 뒤 다시 기록할 때)
+	void TruncateFrom(int32 Index)
+	{
+		Count = FMath::Clamp(Index, 0, Count);
+	}
+
+	// Key(T)가 Frame 이상인 첫 인덱스(기록 순서 = 키 오름차순), 없으면 INDEX_NONE
+	template<typename KeyFunc>
+	int32 LowerBound(uint32 Frame, KeyFunc GetKey) const
+	{
+		int32 Lo = 0;
+		int32 Hi = Count;
+		while (Lo < Hi)
+		{
+			const int32 Mid = (Lo + Hi) / 2;
+			if (GetKey((*this)[Mid]) < Frame)
+			{
+				Lo = Mid + 1;
+			}
+			else
+			{
+				Hi = Mid;
+			}
+		}
+		return Lo < Count ? Lo : INDEX_NONE;
+	}
+
+private:
+	TArray<T> Items;
+	int32 Start = 0;
+	int32 Count = 0;
+};
+
+using FP3DSnapshotHistory = TP3DSnapshotRing<FP3DPawnSnapshot>;
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UP3DRollbackPawn : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// 롤백 대상 Pawn이 구현
+class PAWN3DCHARACTER_API IP3DRollbackPawn
+{
+	GENERATED_BODY()
+
+public:
+	virtual FP3DSnapshotHistory& GetSnapshotHistory() = 0;
+
+	// 현재 상태 + 입력 캐시(Frame/DeltaTime은 호출 쪽이 채움)
+	virtual void CaptureSnapshot(FP3DPawnSnapshot& Out) const = 0;
+
+	// 상태만 복원(입력 캐시는 그대로)
+	virtual void RestoreSnapshotState(const FP3DPawnSnapshot& Snapshot) = 0;
+
+	// 입력 캐시만 덮어씀
+	virtual void ApplySnapshotInput(const FP3DPawnSnapshot& Snapshot) = 0;
+
+	// 현재 입력 캐시로 한 프레임 로컬 시뮬(Tick의 시뮬 부분과 같은 경로, 네트워크/지연 측정 없음)
+	virtual void ResimulateFrame(float DeltaTime, bool bInputEnabled) = 0;
+};
+
+// 재시뮬 결과
+struct FP3DResimResult
+{
+	int32 NumPawns = 0;
+	int32 NumFrames = 0;       // Pawn별 재시뮬 프레임 합
+	double Ms = 0.0;
+	float MaxErrorCm = 0.f;    // 재시뮬 위치 vs 기록 위치 최대 차이
+};
+
+namespace P3DRollback
+{
+	PAWN3DCHARACTER_API bool IsRecording();
+
+	// Pawn Tick: 입력 소비 직후, 시뮬 전에 호출(기록 꺼져 있으면 아무것도 안 함)
+	PAWN3DCHARACTER_API void RecordFrame(IP3DRollbackPawn& Pawn, float DeltaTime);
+
+	// Frame(없으면 그 뒤 첫 기록) 시작 상태 + 입력으로 되돌리고 그 이후 기록은 버림
+	// 반환: 기록이 없으면 false(OutRestoredFrame: 실제로 되돌린 프레임)
+	PAWN3DCHARACTER_API bool RestoreFrame(IP3DRollbackPawn& Pawn, uint32 Frame, uint32* OutRestoredFrame = nullptr);
+
+	// Frame 시작 상태로 되돌리고 기록된 입력으로 최신 프레임까지 다시 시뮬(입력 캐시는 호출 전 값으로 복구)
+	// bRewriteHistory면 재시뮬 결과로 이후 기록 상태를 갱신(과거 상태를 고친 뒤 다시 돌릴 때)
+	// 반환: 재시뮬 프레임 수(기록 없으면 0)
+	PAWN3DCHARACTER_API int32 Resimulate(IP3DRollbackPawn& Pawn, uint32 Frame, bool bRewriteHistory, float& InOutMaxErrorCm);
+}
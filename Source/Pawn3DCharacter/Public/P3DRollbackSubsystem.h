@@ -0,0 +1,35 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "P3DRollback.h"
+#include "P3DRollbackSubsystem.generated.h"
+
+// =========================================================
+// 월드 전체 롤백(IP3DRollbackPawn 구현 Pawn 전부)
+// - 기록은 각 Pawn Tick에서(P3DRollback::RecordFrame), 여기서는 되돌리기/재시뮬만
+// - 배치 시뮬/풀 대기 드론은 기록이 없으니 건너뜀
+// - 콘솔: p3d.Rollback.Resim <프레임 수> [rewrite], p3d.Rollback.Restore <프레임 수>
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DRollbackSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 기록된 가장 최근 프레임(기록 없으면 0)
+	uint32 GetLatestFrame() const;
+
+	// 최근 FramesBack 프레임 전 프레임 번호
+	uint32 GetFrameBefore(int32 FramesBack) const;
+
+	// 모든 Pawn을 Frame 시작 상태로(이후 기록 버림), 반환: 되돌린 Pawn 수
+	int32 RestoreFrame(uint32 Frame);
+
+	// 모든 Pawn을 Frame 시작 상태로 되돌리고 기록된 입력으로 최신 프레임까지 재시뮬
+	FP3DResimResult ResimulateFrom(uint32 Frame, bool bRewriteHistory = false);
+
+private:
+	template<typename Func>
+	void ForEachRollbackPawn(Func&& Callback) const;
+};
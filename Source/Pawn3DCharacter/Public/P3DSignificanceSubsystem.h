@@ -0,0 +1,110 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "P3DSignificanceSubsystem.generated.h"
+
+class USkeletalMeshComponentBudgeted;
+
+// 중요도 단계(낮을수록 중요)
+UENUM(BlueprintType)
+enum class EP3DSignificanceTier : uint8
+{
+	Critical,   // 로컬 조종 중 → 매 프레임
+	High,       // 가깝고 화면 안
+	Medium,     // 중간 거리 또는 화면 밖
+	Low,        // 멀리
+	Dormant,    // 멀고/안 보이고/가만히 있음 → Tick 정지(입력/오버랩 시 깨움)
+
+	MAX UMETA(Hidden)
+};
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UP3DSignificanceTarget : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// 중요도 시스템에 등록되는 Pawn이 구현
+class PAWN3DCHARACTER_API IP3DSignificanceTarget
+{
+	GENERATED_BODY()
+
+public:
+	// 움직임/상호작용 없이 가만히 있는지(Dormant 후보)
+	virtual bool IsSignificanceIdle() const = 0;
+
+	// false면 Tick 간격을 건드리지 않음(배치 시뮬/풀 대기 등 다른 곳에서 Tick 관리)
+	virtual bool AllowsSignificanceTickControl() const { return true; }
+
+	// 애니메이션 예산(AnimationBudgetAllocator)에 맡길 메시(없으면 nullptr)
+	virtual USkeletalMeshComponentBudgeted* GetSignificanceAnimMesh() const { return nullptr; }
+};
+
+// =========================================================
+// 거리/화면 노출/로컬 조종 여부로 Pawn 중요도를 매기고 Tick 간격을 조절
+// - 일정 주기로만 재평가(매 프레임 X)
+// - Dormant는 Tick 자체를 끄고, WakePawn(입력/오버랩/빙의)으로 복귀
+// - 같은 거리/노출 값으로 AnimationBudgetAllocator 중요도도 갱신
+//   (예산 안에서 먼 Pawn은 포즈 평가를 건너뛰고 보간, 가만히 있는 Pawn은 포즈 고정)
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTER_API UP3DSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterPawn(APawn* Pawn);
+	void UnregisterPawn(APawn* Pawn);
+
+	// Dormant/저빈도 Pawn을 즉시 최고 단계로(다음 재평가까지 유지)
+	void WakePawn(APawn* Pawn);
+
+	// 각 Pawn Tick 비용 보고(절약량 추정용)
+	void ReportTickCost(uint64 Cycles);
+
+	EP3DSignificanceTier GetTier(const APawn* Pawn) const;
+
+	// p3d.Anim.* CVar를 AnimationBudgetAllocator에 바로 반영(평소엔 재평가 때 반영)
+	void ApplyAnimBudgetParameters();
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<APawn> Pawn;
+		EP3DSignificanceTier Tier = EP3DSignificanceTier::High;
+		float DefaultTickInterval = 0.f;
+
+		// 애님 포즈 고정 중(예산 할당기에서 Tick 끔)
+		bool bAnimFrozen = false;
+	};
+
+	TArray<FEntry> Entries;
+	TMap<TObjectKey<APawn>, int32> EntryIndex;
+
+	float TimeUntilUpdate = 0.f;
+
+	// Tick 비용 평균(us, 지수 이동 평균)
+	float AvgTickCostUs = 0.f;
+
+	// 마지막으로 할당기에 넘긴 예산(CVar 변경 감지)
+	float AppliedAnimBudgetMs = -1.f;
+	int32 AppliedAnimBudgetEnabled = -1;
+
+	void UpdateSignificance();
+	// OutAnimSignificance: 0(가장 덜 중요) ~ 1, AnimationBudgetAllocator용
+	EP3DSignificanceTier EvaluateTier(const APawn* Pawn, const TArray<FVector, TInlineAllocator<4>>& ViewLocations, float& OutAnimSignificance) const;
+	void ApplyTier(FEntry& Entry, EP3DSignificanceTier NewTier);
+
+	// ===== Animation Budget =====
+	void ApplyAnimSignificance(FEntry& Entry, float Significance);
+	void SetAnimFrozen(FEntry& Entry, bool bFrozen);
+
+	float GetTierTickInterval(const FEntry& Entry, EP3DSignificanceTier Tier) const;
+	void PublishStats(float DeltaTime);
+};
@@ -0,0 +1,167 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+// =========================================================
+// Pawn3D 모듈 공용 stat 그룹 (콘솔: stat Pawn3D)
+// =========================================================
+DECLARE_STATS_GROUP(TEXT("Pawn3D"), STATGROUP_Pawn3D, STATCAT_Advanced);
+
+// ===== Pawn Tick =====
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BasePawn Tick"), STAT_P3D_BasePawnTick, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Pawn Movement (UBasePawnMovementComponent) =====
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BasePawn Move"), STAT_P3D_PawnMove, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pawn Move Sweeps"), STAT_P3D_PawnMoveSweeps, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pawn Floor Queries"), STAT_P3D_PawnFloorQueries, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pawn Floor Cache Hit"), STAT_P3D_PawnFloorCacheHit, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Drone Simulation =====
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drone Tick (Actor)"), STAT_P3D_DroneActorTick, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drone Batch Tick"), STAT_P3D_DroneBatchTick, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drone TickRotation"), STAT_P3D_DroneTickRotation, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drone TickVertical_World"), STAT_P3D_DroneTickVertical, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drone ProbeGround"), STAT_P3D_DroneProbeGround, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// 이동 스윕 수(개별 Tick 경로) - 이동 컴포넌트 단일 스윕 vs 기존 축별 이동 비교용
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Drone Move Sweeps"), STAT_P3D_DroneMoveSweeps, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Drones (Actor Tick)"), STAT_P3D_NumActorDrones, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Drones (Batched)"), STAT_P3D_NumBatchedDrones, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// 드론 1대당 비용(us) - 개별 Tick 경로 vs 배치 경로 비교용
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Drone Cost us/drone (Actor)"), STAT_P3D_DroneActorCostPerDrone, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Drone Cost us/drone (Batched)"), STAT_P3D_DroneBatchCostPerDrone, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Drone Ground Probe =====
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Probe (Sync)"), STAT_P3D_GroundProbeSync, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Probe (Async Used)"), STAT_P3D_GroundProbeAsync, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Probe (Async Fallback)"), STAT_P3D_GroundProbeAsyncFallback, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Drone Ground Cache =====
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Cache Hit"), STAT_P3D_GroundCacheHit, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Cache Miss"), STAT_P3D_GroundCacheMiss, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Ground Cache Cells"), STAT_P3D_GroundCacheCells, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Ground Cache Avoided Sweeps/s"), STAT_P3D_GroundCacheAvoidedPerSec, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Drone Baked Heightfield =====
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Heightfield Hit"), STAT_P3D_GroundHeightfieldHit, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Heightfield Fallback"), STAT_P3D_GroundHeightfieldFallback, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Heightfield KB"), STAT_P3D_GroundHeightfieldKB, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Mass Population (원거리 엔티티) =====
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mass Pawn Move"), STAT_P3D_MassPawnMove, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mass Drone Move"), STAT_P3D_MassDroneMove, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mass LOD"), STAT_P3D_MassLOD, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mass Population Tick"), STAT_P3D_MassPopulationTick, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Mass Floor Queries"), STAT_P3D_MassFloorQueries, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Mass Entities"), STAT_P3D_MassEntities, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Mass Promoted Actors"), STAT_P3D_MassPromoted, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Mass Bytes/Entity"), STAT_P3D_MassBytesPerEntity, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Network Movement (UP3DNetMovementComponent) =====
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net State Bytes Sent"), STAT_P3D_NetStateBytes, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net Move Bytes Sent"), STAT_P3D_NetMoveBytes, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net Corrections"), STAT_P3D_NetCorrections, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net Replayed Moves"), STAT_P3D_NetReplayedMoves, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Net Rejected Moves (time)"), STAT_P3D_NetRejectedMoves, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Net Pending Moves"), STAT_P3D_NetPendingMoves, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Net Last Correction cm"), STAT_P3D_NetLastCorrectionCm, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Rollback (P3DRollback) =====
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rollback Resim"), STAT_P3D_RollbackResim, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Rollback Resim Frames"), STAT_P3D_RollbackResimFrames, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Possession / Toggle =====
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ToggleDrone"), STAT_P3D_ToggleDrone, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ApplyIMC"), STAT_P3D_ApplyIMC, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Toggle ms"), STAT_P3D_LastToggleMs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// 드론 클래스/메시 로드(요청 → 완료), 로드 전후 사용 메모리 차이(대략), 애니 안에 못 끝나서 토글이 기다린 시간
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Drone Asset Load ms"), STAT_P3D_DroneAssetLoadMs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Drone Asset Memory MB"), STAT_P3D_DroneAssetMemoryMB, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Drone Late Load Wait ms"), STAT_P3D_DroneLateLoadWaitMs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== World Partition Streaming =====
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Streaming Look-Ahead cm"), STAT_P3D_StreamingLookAheadCm, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Drone Navigation =====
+// 대기/실행 중 요청 수, 이번 프레임에 받은 결과의 평균 탐색 시간(워커)과 요청~콜백 지연
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drone Nav Dispatch"), STAT_P3D_DroneNavDispatch, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Drone Nav Pending"), STAT_P3D_DroneNavPending, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Drone Nav In Flight"), STAT_P3D_DroneNavInFlight, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Drone Nav Completed"), STAT_P3D_DroneNavCompleted, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Drone Nav Search ms (avg)"), STAT_P3D_DroneNavSearchMs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Drone Nav Latency ms (avg)"), STAT_P3D_DroneNavLatencyMs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Drone Nav Octree KB"), STAT_P3D_DroneNavOctreeKB, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Drone Avoidance =====
+// 프레임당 회피 레이 수, 감지한/예산 초과로 생략한 드론 수, 배정~보정까지 걸린 시간
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drone Avoidance"), STAT_P3D_DroneAvoidance, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Avoid Rays/frame"), STAT_P3D_AvoidRaysPerFrame, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Avoid Drones Sensed"), STAT_P3D_AvoidDronesSensed, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Avoid Drones Over Budget"), STAT_P3D_AvoidDronesOverBudget, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Avoid ms"), STAT_P3D_AvoidMs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Drone Swarm =====
+// 대형 솔버(전체 팔로워 한 번에): 팔로워 수, 이웃 검사/겹침 쌍, 슬롯 오차, 솔버 시간
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drone Swarm Solver"), STAT_P3D_DroneSwarm, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Swarm Followers"), STAT_P3D_SwarmFollowers, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Swarm Neighbor Checks"), STAT_P3D_SwarmNeighborChecks, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Swarm Overlap Pairs"), STAT_P3D_SwarmOverlapPairs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Swarm Solver ms"), STAT_P3D_SwarmSolverMs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Swarm Slot Error cm"), STAT_P3D_SwarmSlotErrorCm, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Frame Counters (P3DCounters 프레임 차이) =====
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sweeps/frame"), STAT_P3D_SweepsPerFrame, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Offsets/frame"), STAT_P3D_OffsetsPerFrame, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Possession Switches/frame"), STAT_P3D_PossessionSwitchesPerFrame, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Significance =====
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Significance Update"), STAT_P3D_SignificanceUpdate, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sig Tier Critical"), STAT_P3D_SigCritical, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sig Tier High"), STAT_P3D_SigHigh, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sig Tier Medium"), STAT_P3D_SigMedium, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sig Tier Low"), STAT_P3D_SigLow, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sig Tier Dormant"), STAT_P3D_SigDormant, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Sig Tick ms Saved (est)"), STAT_P3D_SigSavedMs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sig Anim Frozen (idle)"), STAT_P3D_SigAnimFrozen, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// ===== Input =====
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Look Samples"), STAT_P3D_LookSamples, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Input Samples Dropped"), STAT_P3D_InputSamplesDropped, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Look Latency ms (input -> rotation)"), STAT_P3D_LookLatencyMs, STATGROUP_Pawn3D, PAWN3DCHARACTER_API);
+
+// =========================================================
+// stat 빌드 여부와 무관하게 집계되는 누적 카운터(벤치마크/자동화용)
+// - 게임 스레드에서만 증가, 읽는 쪽이 프레임 간 차이로 사용
+// =========================================================
+namespace P3DCounters
+{
+	// 스윕/트레이스(동기 + 비동기 발행 + 스윕 이동) 횟수
+	extern PAWN3DCHARACTER_API uint64 SceneQueries;
+
+	// Add*Offset 등 액터 위치 이동 호출 횟수
+	extern PAWN3DCHARACTER_API uint64 Offsets;
+
+	// 컨트롤러 빙의 전환 횟수
+	extern PAWN3DCHARACTER_API uint64 PossessionSwitches;
+
+	// Pawn Tick(개별 Tick 경로) 누적 사이클
+	extern PAWN3DCHARACTER_API uint64 PawnTickCycles;
+
+	// Mass 프로세서(이동/LOD) 누적 사이클
+	extern PAWN3DCHARACTER_API uint64 MassCycles;
+
+	// 네트워크 이동: 보낸 상태/입력 비트, 클라 보정/재적용 횟수, 서버가 시간 초과로 버린 입력 수
+	extern PAWN3DCHARACTER_API uint64 NetStateBits;
+	extern PAWN3DCHARACTER_API uint64 NetMoveBits;
+	extern PAWN3DCHARACTER_API uint64 NetCorrections;
+	extern PAWN3DCHARACTER_API uint64 NetReplayedMoves;
+	extern PAWN3DCHARACTER_API uint64 NetRejectedMoves;
+
+	inline void AddSceneQuery(uint64 Count = 1) { SceneQueries += Count; }
+	inline void AddOffset(uint64 Count = 1) { Offsets += Count; }
+	inline void AddPossessionSwitch() { ++PossessionSwitches; }
+}
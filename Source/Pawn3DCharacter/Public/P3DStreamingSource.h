@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
+#include "P3DStreamingSource.generated.h"
+
+// =========================================================
+// 월드 파티션 스트리밍 소스 예측
+// - 스트리밍 소스 위치 = 빙의한 Pawn(AP3DPlayerController가 카메라 대신 Pawn 기준으로 알려줌)
+// - IP3DStreamingSourcePawn을 구현한 Pawn은 영역 모양을 직접 정함
+//   현재 위치 구 + 속도/시선 방향으로 앞쪽 구들
+//   빠를수록 앞쪽은 멀리, 현재 위치 구는 좁게 → 앞 셀은 먼저 로드, 지나간 셀은 빨리 언로드
+// - 월드 파티션이 아닌 맵(L_StartMap 등)에서는 영향 없음
+// =========================================================
+
+USTRUCT(BlueprintType)
+struct PAWN3DCHARACTER_API FP3DStreamingPrediction
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming")
+	bool bEnabled = true;
+
+	// 이 시간(초) 뒤 예상 위치까지 앞쪽 영역
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float LookAheadSeconds = 3.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float MaxLookAheadDistance = 12000.f;
+
+	// 앞쪽 방향 = 속도 방향과 시선 방향을 섞음(0 = 속도만, 1 = 시선만)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float ViewDirectionWeight = 0.3f;
+
+	// 앞쪽 구 개수(예측 경로를 따라 균등 배치)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "1", ClampMax = "4"))
+	int32 NumAheadShapes = 2;
+
+	// FullPredictionSpeed에서 현재 위치 구의 로딩 범위 배율(지나간 셀 언로드를 앞당김)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "0.1", ClampMax = "1.0"))
+	float BehindLoadingRangeScale = 0.6f;
+
+	// 이 속도(cm/s)에서 BehindLoadingRangeScale까지 줄임(그 아래는 비례)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "1.0"))
+	float FullPredictionSpeed = 2000.f;
+
+	// 이보다 느리면 예측 없음(컨트롤러 기본 영역)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Streaming", meta = (ClampMin = "0.0"))
+	float MinPredictionSpeed = 150.f;
+};
+
+namespace P3DStreaming
+{
+	// Pawn 위치 기준 오프셋(월드 축)으로 모양 추가, 예측 거리(cm) 반환(예측 안 하면 0, 모양도 없음)
+	PAWN3DCHARACTER_API float BuildPredictiveShapes(const FP3DStreamingPrediction& Settings, const FVector& Velocity,
+		const FVector& ViewDirection, TArray<FStreamingSourceShape>& OutShapes);
+}
+
+UINTERFACE(meta = (CannotImplementInterfaceInBlueprint))
+class UP3DStreamingSourcePawn : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// 스트리밍 영역을 직접 정하는 Pawn
+class PAWN3DCHARACTER_API IP3DStreamingSourcePawn
+{
+	GENERATED_BODY()
+
+public:
+	// Pawn 위치 기준 오프셋(월드 축) 모양, 안 넣으면 컨트롤러 기본(그리드 로딩 범위 구 하나)
+	virtual void GetStreamingShapes(TArray<FStreamingSourceShape>& OutShapes) const = 0;
+};
@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class AActor;
+class ULevel;
+class UPrimitiveComponent;
+class USceneComponent;
+class UWorld;
+
+// =========================================================
+// 월드 정적 지형 변경 감지 (내비 옥트리/바닥 캐시 무효화 공용)
+// - 블로커 = Static/Stationary + 질의 충돌 + WorldStatic/WorldDynamic 오브젝트 타입 프리미티브 (Pawn 제외)
+// - 액터 스폰/파괴: 스폰 시점에 블로커 컴포넌트가 있는 액터의 바운드
+// - Stationary 블로커 이동(문 등): 루트 TransformUpdated → Flush에서 옛 바운드 + 새 바운드
+// - 레벨 추가/제거(FWorldDelegates): 그 레벨 블로커 바운드 합
+// - 콜백 인자는 부풀리지 않은 월드 바운드(에이전트 반지름 등은 받는 쪽에서)
+// =========================================================
+class PAWN3DCHARACTER_API FP3DWorldBlockerTracker : public FNoncopyable
+{
+public:
+	using FOnChanged = TFunction<void(const FBox& /*Bounds*/)>;
+
+	~FP3DWorldBlockerTracker() { Stop(); }
+
+	// 시작 시 이미 있는 Stationary 블로커는 이동 추적만 걸고 통지는 안 함
+	void Start(UWorld& InWorld, FOnChanged InOnChanged);
+	void Stop();
+
+	// 이번 프레임에 움직인 Stationary 블로커 통지(소유자 Tick에서)
+	void Flush();
+
+	bool IsStarted() const { return World.IsValid(); }
+	int32 GetNumTracked() const { return Tracked.Num(); }
+
+	static bool IsBlocker(const UPrimitiveComponent& Component);
+
+	// 블로커 컴포넌트 바운드 합(없으면 IsValid == false), Stationary가 하나라도 있으면 bOutMovable
+	static FBox GetBlockerBounds(const AActor& Actor, bool& bOutMovable);
+
+private:
+	struct FTracked
+	{
+		FBox Bounds = FBox(ForceInit);
+		TWeakObjectPtr<USceneComponent> Root;
+		FDelegateHandle MovedHandle;
+	};
+
+	void HandleActorSpawned(AActor* Actor);
+	void HandleActorDestroyed(AActor* Actor);
+	void HandleLevelAdded(ULevel* Level, UWorld* InWorld);
+	void HandleLevelRemoved(ULevel* Level, UWorld* InWorld);
+	void HandleRootMoved(USceneComponent* Component, EUpdateTransformFlags Flags, ETeleportType Teleport);
+
+	// 레벨의 블로커 바운드 합(Stationary는 추적 시작)
+	FBox AddLevel(const ULevel& Level);
+
+	void Track(AActor& Actor, const FBox& Bounds);
+	bool Untrack(const AActor& Actor, FBox& OutBounds);
+
+	void Notify(const FBox& Bounds) const;
+
+	TWeakObjectPtr<UWorld> World;
+	FOnChanged OnChanged;
+
+	TMap<TWeakObjectPtr<AActor>, FTracked> Tracked;
+	TSet<TWeakObjectPtr<AActor>> Moved;
+
+	FDelegateHandle SpawnedHandle;
+	FDelegateHandle DestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
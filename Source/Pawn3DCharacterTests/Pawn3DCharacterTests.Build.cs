@@ -0,0 +1,17 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// 헤드리스 벤치마크(UP3DBenchmarkSubsystem) + 자동화 테스트(Automation RunTests Pawn3D)
+// 게임 모듈(Pawn3DCharacter)의 공개 API만 사용, 에디터/개발 빌드에서만 로드(DeveloperTool)
+public class Pawn3DCharacterTests : ModuleRules
+{
+	public Pawn3DCharacterTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "Pawn3DCharacter" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json", "RenderCore", "InputCore", "EnhancedInput", "NetCore", "MassEntity" });
+	}
+}
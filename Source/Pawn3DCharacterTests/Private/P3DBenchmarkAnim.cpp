@@ -0,0 +1,119 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+#include "BasePawn.h"
+#include "P3DSignificanceSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	// 애님 업데이트 비용 확인용(메시/ABP 포함 BP Pawn)
+	constexpr int32 AnimCrowdCount = 200;
+
+	// 애니메이션 예산 준수 확인용 Pawn 수
+	const int32 AnimBudgetCounts[] = { 100, 500 };
+}
+
+void UP3DBenchmarkSubsystem::AddAnimScenarios()
+{
+	Scenarios.Add({ FString::Printf(TEXT("Anim_Base_%d"), AnimCrowdCount), EScenarioKind::Soak, false, false, AnimCrowdCount });
+
+	// 같은 N끼리 NoAnim → NoBudget → Budget 순서(Budget 끝에서 비교)
+	for (const int32 Count : AnimBudgetCounts)
+	{
+		Scenarios.Add({ FString::Printf(TEXT("Anim_NoAnim_%d"), Count), EScenarioKind::Soak, false, false, Count, EMover::Default, EAnimMode::NoAnim });
+		Scenarios.Add({ FString::Printf(TEXT("Anim_NoBudget_%d"), Count), EScenarioKind::Soak, false, false, Count, EMover::Default, EAnimMode::NoBudget });
+		Scenarios.Add({ FString::Printf(TEXT("Anim_Budget_%d"), Count), EScenarioKind::Soak, false, false, Count, EMover::Default, EAnimMode::Budget });
+	}
+}
+
+// 애니메이션 예산
+
+void UP3DBenchmarkSubsystem::ApplyAnimMode(EAnimMode Mode)
+{
+	if (Mode == EAnimMode::Default) return;
+
+	IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p3d.Anim.Budget"));
+	if (!CVar) return;
+
+	if (SavedAnimBudget == INDEX_NONE)
+	{
+		SavedAnimBudget = CVar->GetInt();
+	}
+
+	CVar->Set(Mode == EAnimMode::Budget ? 1 : 0, ECVF_SetByCode);
+
+	// 재평가 주기를 기다리지 않고 스폰 전에 반영
+	if (UP3DSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UP3DSignificanceSubsystem>())
+	{
+		Significance->ApplyAnimBudgetParameters();
+	}
+}
+
+void UP3DBenchmarkSubsystem::RestoreAnimMode()
+{
+	if (SavedAnimBudget == INDEX_NONE) return;
+
+	if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p3d.Anim.Budget")))
+	{
+		CVar->Set(SavedAnimBudget, ECVF_SetByCode);
+	}
+	SavedAnimBudget = INDEX_NONE;
+
+	if (UP3DSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UP3DSignificanceSubsystem>())
+	{
+		Significance->ApplyAnimBudgetParameters();
+	}
+}
+
+int32 UP3DBenchmarkSubsystem::CountAnimTicked() const
+{
+	int32 Ticked = 0;
+	for (const APawn* Pawn : SpawnedPawns)
+	{
+		const ABasePawn* Base = Cast<ABasePawn>(Pawn);
+		if (Base && Base->MeshComp && Base->MeshComp->PoseTickedThisFrame())
+		{
+			++Ticked;
+		}
+	}
+	return Ticked;
+}
+
+void UP3DBenchmarkSubsystem::AddAnimBudgetComparison(const FScenario& Scenario)
+{
+	auto FindGameThreadMs = [this](const FString& Name, double& OutMs)
+	{
+		const FScenarioResult* Result = Results.FindByPredicate([&Name](const FScenarioResult& Entry) { return Entry.Name == Name; });
+		const double* Ms = Result ? Result->Find(TEXT("GameThreadMsAvg")) : nullptr;
+		OutMs = Ms ? *Ms : 0.0;
+		return Ms != nullptr;
+	};
+
+	double NoAnimMs = 0.0, NoBudgetMs = 0.0, BudgetMs = 0.0;
+	if (!FindGameThreadMs(FString::Printf(TEXT("Anim_NoAnim_%d"), Scenario.Count), NoAnimMs)
+		|| !FindGameThreadMs(FString::Printf(TEXT("Anim_NoBudget_%d"), Scenario.Count), NoBudgetMs)
+		|| !FindGameThreadMs(Scenario.Name, BudgetMs))
+	{
+		return;
+	}
+
+	const IConsoleVariable* BudgetCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p3d.Anim.BudgetMs"));
+	const double TargetMs = BudgetCVar ? BudgetCVar->GetFloat() : 0.0;
+
+	// 애님 비용 = 같은 N에서 메시 Tick을 끈 기준선과의 게임 스레드 차이
+	const double FullAnimMs = FMath::Max(0.0, NoBudgetMs - NoAnimMs);
+	const double BudgetAnimMs = FMath::Max(0.0, BudgetMs - NoAnimMs);
+
+	FScenarioResult& Result = Results.AddDefaulted_GetRef();
+	Result.Name = FString::Printf(TEXT("Anim_Compare_%d"), Scenario.Count);
+	Result.Add(TEXT("BudgetMs"), TargetMs);
+	Result.Add(TEXT("AnimMsNoBudget"), FullAnimMs);
+	Result.Add(TEXT("AnimMsBudget"), BudgetAnimMs);
+	Result.Add(TEXT("AnimMsSaved"), FullAnimMs - BudgetAnimMs);
+	Result.Add(TEXT("AnimBudgetOverMs"), FMath::Max(0.0, BudgetAnimMs - TargetMs));
+
+	UE_LOG(LogTemp, Log, TEXT("[Bench] %s: anim %.2f ms -> %.2f ms (budget %.2f ms)"),
+		*Result.Name, FullAnimMs, BudgetAnimMs, TargetMs);
+}
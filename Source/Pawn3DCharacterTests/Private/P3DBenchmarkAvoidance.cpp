@@ -0,0 +1,36 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+namespace
+{
+	// 장애물 회피 감지: 드론 수(기본 레이 예산 1024 기준 100 = 전체 팬, 500 = 예산 초과)
+	const int32 AvoidCounts[] = { 100, 500 };
+}
+
+void UP3DBenchmarkSubsystem::AddAvoidanceScenarios()
+{
+	for (const int32 Count : AvoidCounts)
+	{
+		Scenarios.Add({ FString::Printf(TEXT("Avoid_Drone_%d"), Count), EScenarioKind::Soak, true, false, Count, EMover::Default, EAnimMode::Default, false, true });
+	}
+}
+
+// 회피 감지 비용(배정 + 병렬 트레이스 + 보정, 게임 스레드 기준)
+
+void UP3DBenchmarkSubsystem::SummarizeAvoidance(FScenarioResult& OutResult) const
+{
+	const int32 Num = FMath::Max(1, Samples.Num());
+	const double Count = FMath::Max(1, SpawnedPawns.Num());
+
+	double RaySum = 0.0, AvoidMsSum = 0.0, OverBudgetSum = 0.0;
+	for (const FFrameSample& Sample : Samples)
+	{
+		RaySum += Sample.AvoidRays;
+		AvoidMsSum += Sample.AvoidMs;
+		OverBudgetSum += Sample.AvoidOverBudget;
+	}
+
+	OutResult.Add(TEXT("AvoidRaysPerFrame"), RaySum / Num);
+	OutResult.Add(TEXT("AvoidMsAvg"), AvoidMsSum / Num);
+	OutResult.Add(TEXT("AvoidUsPerDrone"), AvoidMsSum / Num / Count * 1000.0);
+	OutResult.Add(TEXT("AvoidOverBudgetPerFrame"), OverBudgetSum / Num);
+}
@@ -0,0 +1,81 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+#include "DronePawn.h"
+#include "Engine/World.h"
+
+namespace
+{
+	// 결정성 시나리오: 총 시뮬 시간(초)
+	constexpr float DeterminismSeconds = 3.f;
+}
+
+void UP3DBenchmarkSubsystem::AddDeterminismScenarios()
+{
+	Scenarios.Add({ TEXT("Determinism_Drone"), EScenarioKind::Determinism, true, false, 1 });
+}
+
+// 결정성: 같은 입력을 서로 다른 프레임 간격으로 돌려서 같은 스텝 번호의 시뮬 위치 비교
+
+void UP3DBenchmarkSubsystem::RunDeterminism(FScenarioResult& OutResult)
+{
+	UWorld* World = GetWorld();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const FVector Start = GetSpawnOrigin() + FVector(0.f, 600.f, 300.f);
+	ADronePawn* Drone = World->SpawnActor<ADronePawn>(GetDronePawnClass(), Start, FRotator::ZeroRotator, SpawnParams);
+	if (!Drone)
+	{
+		OutResult.Add(TEXT("Skipped"), 1.0);
+		return;
+	}
+
+	SpawnedPawns.Add(Drone);
+
+	// 엔진 Tick은 끄고 직접 Tick(비동기 탐색/보간은 비교 대상 아님)
+	Drone->SetActorTickEnabled(false);
+	Drone->bUseFixedTimestep = true;
+	Drone->bUseAsyncGroundProbe = false;
+	Drone->bInterpolateRender = false;
+
+	FP3DScriptedInput Input;
+	Input.Move = FVector2D(0.3f, 1.f);
+	Input.UpDown = 0.5f;
+
+	auto RunSequence = [&](const TArray<float>& FrameDTs, TMap<uint64, FVector>& OutSteps)
+	{
+		Drone->SetActorLocationAndRotation(Start, FRotator::ZeroRotator, false, nullptr, ETeleportType::TeleportPhysics);
+		Drone->ResetFlightState();
+		Drone->InjectScriptedInput(Input);
+
+		float Elapsed = 0.f;
+		for (int32 Frame = 0; Elapsed < DeterminismSeconds; ++Frame)
+		{
+			const float DT = FrameDTs[Frame % FrameDTs.Num()];
+			Drone->Tick(DT);
+			Elapsed += DT;
+
+			OutSteps.Add(Drone->GetSimStepCount(), Drone->GetSimTransform().GetLocation());
+		}
+	};
+
+	TMap<uint64, FVector> StepsA;
+	TMap<uint64, FVector> StepsB;
+	RunSequence({ 1.f / 30.f }, StepsA);
+	RunSequence({ 1.f / 144.f, 1.f / 60.f, 1.f / 23.f, 1.f / 90.f }, StepsB);
+
+	double MaxDeviation = 0.0;
+	int32 Compared = 0;
+	for (const TPair<uint64, FVector>& Pair : StepsB)
+	{
+		if (const FVector* Other = StepsA.Find(Pair.Key))
+		{
+			MaxDeviation = FMath::Max(MaxDeviation, FVector::Dist(*Other, Pair.Value));
+			++Compared;
+		}
+	}
+
+	OutResult.Add(TEXT("ComparedSteps"), Compared);
+	OutResult.Add(TEXT("MaxDeviationCm"), MaxDeviation);
+}
@@ -0,0 +1,72 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+#include "P3DBenchmarkShared.h"
+#include "P3DMassPopulationSubsystem.h"
+#include "Engine/World.h"
+
+namespace
+{
+	// Mass 원거리 군중 엔티티 수
+	const int32 MassCounts[] = { 10000, 30000 };
+}
+
+void UP3DBenchmarkSubsystem::AddMassScenarios()
+{
+	for (const int32 Count : MassCounts)
+	{
+		Scenarios.Add({ FString::Printf(TEXT("Mass_Pawn_%d"), Count), EScenarioKind::Mass, false, false, Count });
+		Scenarios.Add({ FString::Printf(TEXT("Mass_Drone_%d"), Count), EScenarioKind::Mass, true, false, Count });
+	}
+}
+
+// Mass: 엔티티는 스스로 배회(스크립트 입력 구동 없음) → 엔티티당 프로세서 시간/메모리
+
+bool UP3DBenchmarkSubsystem::BeginMassPopulation(const FScenario& Scenario)
+{
+	UP3DMassPopulationSubsystem* Population = GetWorld()->GetSubsystem<UP3DMassPopulationSubsystem>();
+	const TSubclassOf<APawn> PawnClass = Scenario.bDrone ? GetDronePawnClass() : GetBasePawnClass();
+	const FVector Center = GetSpawnOrigin() + FVector(0.f, 0.f, Scenario.bDrone ? 300.f : 0.f);
+
+	return Population && Population->SpawnPopulation(PawnClass, Scenario.Count, Center) > 0;
+}
+
+void UP3DBenchmarkSubsystem::SummarizeMass(FScenarioResult& OutResult) const
+{
+	const UP3DMassPopulationSubsystem* Population = GetWorld()->GetSubsystem<UP3DMassPopulationSubsystem>();
+	const int32 Num = FMath::Max(1, Samples.Num());
+	const double Count = FMath::Max(1, Population ? Population->GetNumEntities() : 0);
+
+	TArray<double> MassMs;
+	MassMs.Reserve(Samples.Num());
+
+	double GameThreadSum = 0.0, MassSum = 0.0, PromotedSum = 0.0, AllocSum = 0.0, QuerySum = 0.0;
+	for (const FFrameSample& Sample : Samples)
+	{
+		GameThreadSum += Sample.GameThreadMs;
+		MassSum += Sample.MassMs;
+		PromotedSum += Sample.MassPromoted;
+		AllocSum += Sample.Allocs;
+		QuerySum += Sample.SceneQueries;
+		MassMs.Add(Sample.MassMs);
+	}
+
+	OutResult.Add(TEXT("Entities"), Count);
+	OutResult.Add(TEXT("Frames"), Samples.Num());
+	OutResult.Add(TEXT("BytesPerEntity"), Population ? Population->GetBytesPerEntity() : 0.0);
+	OutResult.Add(TEXT("GameThreadMsAvg"), GameThreadSum / Num);
+	OutResult.Add(TEXT("MassMsAvg"), MassSum / Num);
+	OutResult.Add(TEXT("MassMsP95"), P3DBench::Percentile(MassMs, 0.95));
+	OutResult.Add(TEXT("MassUsPerEntity"), MassSum / Num / Count * 1000.0);
+	OutResult.Add(TEXT("PromotedAvg"), PromotedSum / Num);
+	OutResult.Add(TEXT("AllocsPerFrame"), AllocSum / Num);
+	OutResult.Add(TEXT("SceneQueriesPerFrame"), QuerySum / Num);
+}
+
+void UP3DBenchmarkSubsystem::DestroyMassPopulation()
+{
+	UP3DMassPopulationSubsystem* Population = GetWorld() ? GetWorld()->GetSubsystem<UP3DMassPopulationSubsystem>() : nullptr;
+	if (Population && Population->GetNumEntities() > 0)
+	{
+		Population->DestroyPopulation();
+	}
+}
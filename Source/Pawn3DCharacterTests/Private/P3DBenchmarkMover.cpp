@@ -0,0 +1,46 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+namespace
+{
+	// 이동 컴포넌트 비교(키네마틱 vs CMC)용 Pawn 수
+	const int32 MoverCounts[] = { 100, 500 };
+}
+
+void UP3DBenchmarkSubsystem::AddMoverScenarios()
+{
+	// 같은 N끼리 Kinematic → Character 순서(Character 끝에서 비교)
+	for (const int32 Count : MoverCounts)
+	{
+		Scenarios.Add({ FString::Printf(TEXT("Mover_Kinematic_%d"), Count), EScenarioKind::Soak, false, false, Count, EMover::Kinematic });
+		Scenarios.Add({ FString::Printf(TEXT("Mover_Character_%d"), Count), EScenarioKind::Soak, false, false, Count, EMover::Character });
+	}
+}
+
+// 이동 컴포넌트: 같은 N의 키네마틱/CMC 소크 결과 비교
+
+void UP3DBenchmarkSubsystem::AddMoverComparison(const FScenario& Scenario)
+{
+	const FString KinematicName = FString::Printf(TEXT("Mover_Kinematic_%d"), Scenario.Count);
+
+	const FScenarioResult* Kinematic = Results.FindByPredicate([&KinematicName](const FScenarioResult& Result) { return Result.Name == KinematicName; });
+	const FScenarioResult* Character = Results.Num() > 0 ? &Results.Last() : nullptr;
+	if (!Kinematic || !Character) return;
+
+	const double* KinematicMs = Kinematic->Find(TEXT("GameThreadMsPerPawn"));
+	const double* CharacterMs = Character->Find(TEXT("GameThreadMsPerPawn"));
+	if (!KinematicMs || !CharacterMs || *CharacterMs <= 0.0) return;
+
+	// Results에 추가하기 전에 값 복사(재할당)
+	const double KinematicUs = *KinematicMs * 1000.0;
+	const double CharacterUs = *CharacterMs * 1000.0;
+	const double Ratio = KinematicUs / CharacterUs;
+
+	FScenarioResult& Result = Results.AddDefaulted_GetRef();
+	Result.Name = FString::Printf(TEXT("Mover_Compare_%d"), Scenario.Count);
+	Result.Add(TEXT("KinematicUsPerPawn"), KinematicUs);
+	Result.Add(TEXT("CharacterUsPerPawn"), CharacterUs);
+	Result.Add(TEXT("KinematicToCMCRatio"), Ratio);
+
+	UE_LOG(LogTemp, Log, TEXT("[Bench] %s: kinematic %.2f us/pawn vs CMC %.2f us/pawn (x%.2f)"),
+		*Result.Name, KinematicUs, CharacterUs, Ratio);
+}
@@ -0,0 +1,59 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+#include "P3DBenchmarkShared.h"
+#include "DroneNavSubsystem.h"
+#include "Engine/World.h"
+
+namespace
+{
+	// 경로 탐색: 동시 요청 수 / 측정 프레임(다 못 받으면 NavIncomplete) / 시작·목표 시드
+	constexpr int32 NavPathCount = 500;
+	constexpr int32 NavMeasureFrames = 600;
+	constexpr int32 NavStressSeed = 1234;
+}
+
+void UP3DBenchmarkSubsystem::AddNavigationScenarios()
+{
+	FScenario& Paths = Scenarios.Add_GetRef({ FString::Printf(TEXT("Nav_Paths_%d"), NavPathCount), EScenarioKind::Navigation, true, false, NavPathCount });
+	Paths.MeasureFrames = NavMeasureFrames;
+}
+
+// 경로 탐색: 동시 요청 → 게임 스레드 콜백까지 지연
+
+bool UP3DBenchmarkSubsystem::BeginNavigationStress()
+{
+	UDroneNavSubsystem* Nav = GetWorld()->GetSubsystem<UDroneNavSubsystem>();
+	if (!Nav) return false;
+
+	// 베이크 안 한 맵이면 여기서 생성(워밍업 전이라 측정에는 안 들어감)
+	return Nav->IsNavReady() || Nav->BuildNavOctree();
+}
+
+void UP3DBenchmarkSubsystem::StartNavigationRequests(int32 Count)
+{
+	GetWorld()->GetSubsystem<UDroneNavSubsystem>()->StartStressTest(Count, NavStressSeed);
+}
+
+void UP3DBenchmarkSubsystem::SummarizeNavigation(FScenarioResult& OutResult) const
+{
+	const UDroneNavSubsystem* Nav = GetWorld()->GetSubsystem<UDroneNavSubsystem>();
+	if (!Nav)
+	{
+		OutResult.Add(TEXT("Skipped"), 1.0);
+		return;
+	}
+
+	const UDroneNavSubsystem::FStressStats& Stress = Nav->GetStressStats();
+	const int32 Completed = FMath::Max(Stress.Completed, 1);
+
+	OutResult.Add(TEXT("NavRequests"), Stress.Requested);
+	OutResult.Add(TEXT("NavIncomplete"), Stress.Requested - Stress.Completed);
+	OutResult.Add(TEXT("NavSuccessPct"), 100.0 * Stress.Succeeded / Completed);
+	OutResult.Add(TEXT("NavLatencyMsP50"), P3DBench::Percentile(Stress.LatencyMs, 0.50));
+	OutResult.Add(TEXT("NavLatencyMsP95"), P3DBench::Percentile(Stress.LatencyMs, 0.95));
+	OutResult.Add(TEXT("NavLatencyMsP99"), P3DBench::Percentile(Stress.LatencyMs, 0.99));
+	OutResult.Add(TEXT("NavPathsPerSec"), Stress.WallMs > 0.0 ? Stress.Completed * 1000.0 / Stress.WallMs : 0.0);
+	OutResult.Add(TEXT("NavSearchMsAvg"), Stress.SearchMsSum / Completed);
+	OutResult.Add(TEXT("NavExpansionsAvg"), double(Stress.Expansions) / Completed);
+	OutResult.Add(TEXT("NavOctreeKB"), Nav->GetOctree().GetAllocatedSize() / 1024.0);
+}
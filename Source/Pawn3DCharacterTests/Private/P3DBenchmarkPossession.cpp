@@ -0,0 +1,115 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+#include "P3DBenchmarkShared.h"
+#include "DronePawn.h"
+#include "P3DPlayerController.h"
+
+namespace
+{
+	// Possession 시나리오: 전환 간격(프레임) / 전환 횟수 / 장시간 반복(전반·후반 비교) 횟수
+	constexpr int32 ToggleIntervalFrames = 5;
+	constexpr int32 NumPossessionToggles = 40;
+	constexpr int32 NumSoakToggles = 1000;
+
+	// [Begin, End) 평균
+	double RangeAvg(const TArray<double>& Values, int32 Begin, int32 End)
+	{
+		double Sum = 0.0;
+		for (int32 i = Begin; i < End; ++i)
+		{
+			Sum += Values[i];
+		}
+		return End > Begin ? Sum / (End - Begin) : 0.0;
+	}
+}
+
+void UP3DBenchmarkSubsystem::AddPossessionScenarios()
+{
+	FScenario& Toggle = Scenarios.Add_GetRef({ TEXT("Possession_Toggle"), EScenarioKind::Possession, false, false, NumPossessionToggles });
+	Toggle.MeasureFrames = ToggleIntervalFrames * NumPossessionToggles;
+
+	// 전환을 계속 반복해도 프레임 시간/할당이 늘지 않아야 함(컨텍스트 재등록·바인딩 누적 등)
+	FScenario& Soak = Scenarios.Add_GetRef({ FString::Printf(TEXT("Possession_Soak_%d"), NumSoakToggles), EScenarioKind::Possession, false, false, NumSoakToggles });
+	Soak.MeasureFrames = ToggleIntervalFrames * NumSoakToggles;
+}
+
+// 빙의 전환: 로컬 컨트롤러의 ToggleDrone을 일정 간격으로 반복(전환 1회 ms/할당 수)
+
+bool UP3DBenchmarkSubsystem::BeginPossessionToggle()
+{
+	BenchController = FindLocalController();
+	return BenchController.IsValid();
+}
+
+void UP3DBenchmarkSubsystem::RunPossessionFrame()
+{
+	AP3DPlayerController* PC = BenchController.Get();
+	if (!PC || PhaseFrame % ToggleIntervalFrames != 0) return;
+
+	const uint64 AllocsBefore = P3DBench::GetNumAllocs();
+	const double StartTime = FPlatformTime::Seconds();
+
+	PC->ToggleDrone();
+
+	ToggleMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	ToggleAllocs.Add(double(P3DBench::GetNumAllocs() - AllocsBefore));
+}
+
+void UP3DBenchmarkSubsystem::SummarizePossession(FScenarioResult& OutResult) const
+{
+	double Sum = 0.0;
+	double Max = 0.0;
+	for (const double Ms : ToggleMs)
+	{
+		Sum += Ms;
+		Max = FMath::Max(Max, Ms);
+	}
+
+	OutResult.Add(TEXT("Toggles"), ToggleMs.Num());
+	OutResult.Add(TEXT("ToggleMsAvg"), ToggleMs.Num() > 0 ? Sum / ToggleMs.Num() : 0.0);
+	OutResult.Add(TEXT("ToggleMsP95"), P3DBench::Percentile(ToggleMs, 0.95));
+	OutResult.Add(TEXT("ToggleMsMax"), Max);
+	OutResult.Add(TEXT("AllocsPerToggle"), RangeAvg(ToggleAllocs, 0, ToggleAllocs.Num()));
+
+	// 첫 토글 = 에셋 로드/풀 준비가 안 돼 있으면 히치가 나는 지점(p3d.Drone.AsyncPreload 0/1 비교)
+	OutResult.Add(TEXT("FirstToggleMs"), ToggleMs.Num() > 0 ? ToggleMs[0] : 0.0);
+
+	// 평탄성: 전반 vs 후반(첫 토글 히치는 제외), 후반 - 전반이 0 근처여야 함
+	const int32 NumToggles = ToggleAllocs.Num();
+	if (NumToggles < 4 || Samples.Num() < 2) return;
+
+	const int32 ToggleMid = 1 + (NumToggles - 1) / 2;
+	const double AllocsFirst = RangeAvg(ToggleAllocs, 1, ToggleMid);
+	const double AllocsSecond = RangeAvg(ToggleAllocs, ToggleMid, NumToggles);
+
+	TArray<double> FrameMs;
+	FrameMs.Reserve(Samples.Num());
+	for (const FFrameSample& Sample : Samples)
+	{
+		FrameMs.Add(Sample.FrameMs);
+	}
+
+	const int32 FrameMid = FrameMs.Num() / 2;
+	const double FrameFirst = RangeAvg(FrameMs, 0, FrameMid);
+	const double FrameSecond = RangeAvg(FrameMs, FrameMid, FrameMs.Num());
+
+	OutResult.Add(TEXT("SoakFrameMsFirstHalf"), FrameFirst);
+	OutResult.Add(TEXT("SoakFrameMsSecondHalf"), FrameSecond);
+	OutResult.Add(TEXT("SoakFrameMsDrift"), FrameSecond - FrameFirst);
+	OutResult.Add(TEXT("SoakToggleMsDrift"), RangeAvg(ToggleMs, ToggleMid, NumToggles) - RangeAvg(ToggleMs, 1, ToggleMid));
+	OutResult.Add(TEXT("SoakAllocsPerToggleFirstHalf"), AllocsFirst);
+	OutResult.Add(TEXT("SoakAllocsPerToggleSecondHalf"), AllocsSecond);
+	OutResult.Add(TEXT("SoakAllocsPerToggleDrift"), AllocsSecond - AllocsFirst);
+}
+
+void UP3DBenchmarkSubsystem::EndPossessionToggle()
+{
+	// 원래 Pawn으로 돌려놓기
+	if (AP3DPlayerController* PC = BenchController.Get())
+	{
+		if (Cast<ADronePawn>(PC->GetPawn()))
+		{
+			PC->ReturnToPlayer();
+		}
+	}
+}
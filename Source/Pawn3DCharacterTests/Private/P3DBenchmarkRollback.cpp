@@ -0,0 +1,94 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+#include "P3DBenchmarkShared.h"
+#include "P3DRollbackSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	// 롤백 시나리오: 드론 수 / 되돌릴 프레임 수 / 반복 횟수
+	constexpr int32 RollbackCount = 100;
+	constexpr int32 RollbackResimFrames = 60;
+	constexpr int32 RollbackResimPasses = 10;
+}
+
+void UP3DBenchmarkSubsystem::AddRollbackScenarios()
+{
+	Scenarios.Add({ FString::Printf(TEXT("Rollback_Drone_%d"), RollbackCount), EScenarioKind::Rollback, true, false, RollbackCount });
+}
+
+// 롤백: 측정 구간에 기록된 최근 프레임을 되돌려 재시뮬(같은 구간 반복)
+
+void UP3DBenchmarkSubsystem::RunRollbackResim(FScenarioResult& OutResult)
+{
+	UP3DRollbackSubsystem* Rollback = GetWorld()->GetSubsystem<UP3DRollbackSubsystem>();
+	if (!Rollback || Rollback->GetLatestFrame() == 0)
+	{
+		OutResult.Add(TEXT("ResimSkipped"), 1.0);
+		return;
+	}
+
+	const uint32 FromFrame = Rollback->GetFrameBefore(RollbackResimFrames);
+
+	int32 Pawns = 0;
+	int64 PawnFrames = 0;
+	double TotalMs = 0.0;
+	float MaxErrorCm = 0.f;
+
+	const uint64 AllocsBefore = P3DBench::GetNumAllocs();
+
+	for (int32 Pass = 0; Pass < RollbackResimPasses; ++Pass)
+	{
+		const FP3DResimResult Resim = Rollback->ResimulateFrom(FromFrame);
+		Pawns = FMath::Max(Pawns, Resim.NumPawns);
+		PawnFrames += Resim.NumFrames;
+		TotalMs += Resim.Ms;
+		MaxErrorCm = FMath::Max(MaxErrorCm, Resim.MaxErrorCm);
+	}
+
+	const uint64 Allocs = P3DBench::GetNumAllocs() - AllocsBefore;
+	if (Pawns == 0 || PawnFrames == 0)
+	{
+		OutResult.Add(TEXT("ResimSkipped"), 1.0);
+		return;
+	}
+
+	// 월드 프레임 = 드론 N대 전부 한 프레임
+	const double WorldFrames = double(PawnFrames) / Pawns;
+
+	OutResult.Add(TEXT("ResimPawns"), Pawns);
+	OutResult.Add(TEXT("ResimFramesPerPass"), WorldFrames / RollbackResimPasses);
+	OutResult.Add(TEXT("ResimFramesPerMs"), TotalMs > 0.0 ? WorldFrames / TotalMs : 0.0);
+	OutResult.Add(TEXT("ResimUsPerPawnFrame"), TotalMs * 1000.0 / PawnFrames);
+	OutResult.Add(TEXT("ResimMaxErrorCm"), MaxErrorCm);
+	OutResult.Add(TEXT("ResimAllocsPerFrame"), double(Allocs) / WorldFrames);
+	OutResult.Add(TEXT("SnapshotBytes"), sizeof(FP3DPawnSnapshot));
+
+	UE_LOG(LogTemp, Log, TEXT("[Bench] %s: %.1f frames/ms for %d drones (%.2f us/drone-frame), max error %.4f cm"),
+		*OutResult.Name, TotalMs > 0.0 ? WorldFrames / TotalMs : 0.0, Pawns, TotalMs * 1000.0 / PawnFrames, MaxErrorCm);
+}
+
+void UP3DBenchmarkSubsystem::SetRollbackRecording(bool bRecord)
+{
+	IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p3d.Rollback.Record"));
+	if (!CVar) return;
+
+	if (SavedRollbackRecord == INDEX_NONE)
+	{
+		SavedRollbackRecord = CVar->GetInt();
+	}
+
+	CVar->Set(bRecord ? 1 : 0, ECVF_SetByCode);
+}
+
+void UP3DBenchmarkSubsystem::RestoreRollbackRecording()
+{
+	if (SavedRollbackRecord == INDEX_NONE) return;
+
+	if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p3d.Rollback.Record")))
+	{
+		CVar->Set(SavedRollbackRecord, ECVF_SetByCode);
+	}
+	SavedRollbackRecord = INDEX_NONE;
+}
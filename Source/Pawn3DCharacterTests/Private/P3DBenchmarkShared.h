@@ -0,0 +1,16 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+// =========================================================
+// 벤치마크 시나리오 파일(P3DBenchmark*.cpp)끼리 공유하는 도구
+// - 정의는 P3DBenchmarkSubsystem.cpp
+// =========================================================
+namespace P3DBench
+{
+	// 설치 후 누적 할당 횟수(p3d.Bench.CountAllocs 0이면 항상 0)
+	uint64 GetNumAllocs();
+
+	// Pct = 0..1 (복사본을 정렬)
+	double Percentile(TArray<double> Values, double Pct);
+}
@@ -0,0 +1,138 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+#include "P3DBenchmarkShared.h"
+#include "DronePawn.h"
+#include "P3DPlayerController.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionRuntimeCell.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+
+namespace
+{
+	// 스트리밍 비행: 프레임 수 / 기본 소스 비행 레인 간격(같은 셀 재사용 방지) / 대기 판정 반경 / 히치 기준
+	constexpr int32 StreamingFlightFrames = 3600;
+	constexpr float StreamingLaneOffset = 50000.f;
+	constexpr float StreamingStallRadius = 2000.f;
+	constexpr double StreamingHitchMs = 50.0;
+}
+
+void UP3DBenchmarkSubsystem::AddStreamingScenarios()
+{
+	FScenario& Default = Scenarios.Add_GetRef({ TEXT("Streaming_Flight_Default"), EScenarioKind::Streaming, true, false, 1, EMover::Default, EAnimMode::Default, false });
+	Default.MeasureFrames = StreamingFlightFrames;
+
+	FScenario& Predictive = Scenarios.Add_GetRef({ TEXT("Streaming_Flight_Predictive"), EScenarioKind::Streaming, true, false, 1, EMover::Default, EAnimMode::Default, true });
+	Predictive.MeasureFrames = StreamingFlightFrames;
+}
+
+// 스트리밍: 월드 파티션 맵에서 플레이어가 빙의한 드론으로 최고 속도 직선 비행
+// - 워밍업 동안은 제자리(시작 셀 로드), 측정 구간 동안 앞으로
+// - 대기 프레임 = 드론 주변 셀이 아직 활성화 안 된 프레임(셀이 비행을 못 따라옴)
+// - 기본 소스/예측 소스는 서로 다른 레인으로(앞 시나리오가 올려둔 셀 재사용 방지)
+bool UP3DBenchmarkSubsystem::BeginStreamingFlight(const FScenario& Scenario)
+{
+	UWorld* World = GetWorld();
+	AP3DPlayerController* PC = FindLocalController();
+	if (!World->GetWorldPartition() || !PC) return false;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	StreamingStart = GetSpawnOrigin() + FVector(0.f, Scenario.bPredictiveStreaming ? StreamingLaneOffset : 0.f, 500.f);
+	ADronePawn* Drone = World->SpawnActor<ADronePawn>(GetDronePawnClass(), StreamingStart, FRotator::ZeroRotator, SpawnParams);
+	if (!Drone) return false;
+
+	Drone->StreamingPrediction.bEnabled = Scenario.bPredictiveStreaming;
+	SpawnedPawns.Add(Drone);
+
+	BenchController = PC;
+	StreamingSavedPawn = PC->GetPawn();
+	PC->Possess(Drone);
+
+	StreamStallFrames = 0;
+	StreamHitchFrames = 0;
+	StreamPeakLoadedCells = 0;
+	StreamStartUsedMemory = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+	StreamPeakUsedMemory = StreamStartUsedMemory;
+	return true;
+}
+
+void UP3DBenchmarkSubsystem::RunStreamingFrame(float DeltaTime)
+{
+	ADronePawn* Drone = SpawnedPawns.Num() > 0 ? Cast<ADronePawn>(SpawnedPawns[0]) : nullptr;
+	if (!IsValid(Drone)) return;
+
+	FP3DScriptedInput Input;
+	Input.Move = FVector2D(0.f, 1.f);
+	Drone->InjectScriptedInput(Input);
+
+	UWorld* World = GetWorld();
+	if (const UWorldPartitionSubsystem* WorldPartition = World->GetSubsystem<UWorldPartitionSubsystem>())
+	{
+		FWorldPartitionStreamingQuerySource Query;
+		Query.Location = Drone->GetActorLocation();
+		Query.Radius = StreamingStallRadius;
+		Query.bUseGridLoadingRange = false;
+
+		if (!WorldPartition->IsStreamingCompleted(EWorldPartitionRuntimeCellState::Activated, { Query }, false))
+		{
+			++StreamStallFrames;
+		}
+	}
+
+	if (DeltaTime * 1000.0 > StreamingHitchMs)
+	{
+		++StreamHitchFrames;
+	}
+
+	int32 LoadedCells = 0;
+	for (const ULevelStreaming* Level : World->GetStreamingLevels())
+	{
+		if (Level && Level->IsLevelLoaded())
+		{
+			++LoadedCells;
+		}
+	}
+	StreamPeakLoadedCells = FMath::Max(StreamPeakLoadedCells, LoadedCells);
+	StreamPeakUsedMemory = FMath::Max(StreamPeakUsedMemory, static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical));
+}
+
+void UP3DBenchmarkSubsystem::SummarizeStreaming(FScenarioResult& OutResult) const
+{
+	constexpr double BytesToMB = 1.0 / (1024.0 * 1024.0);
+
+	const APawn* Drone = SpawnedPawns.Num() > 0 ? SpawnedPawns[0].Get() : nullptr;
+	const double DistanceM = IsValid(Drone) ? FVector::Dist2D(Drone->GetActorLocation(), StreamingStart) / 100.0 : 0.0;
+	const int64 EndUsedMemory = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+
+	TArray<double> FrameMs;
+	FrameMs.Reserve(Samples.Num());
+	for (const FFrameSample& Sample : Samples)
+	{
+		FrameMs.Add(Sample.FrameMs);
+	}
+
+	OutResult.Add(TEXT("FlightDistanceM"), DistanceM);
+	OutResult.Add(TEXT("StreamStallFrames"), StreamStallFrames);
+	OutResult.Add(TEXT("StreamStallPct"), Samples.Num() > 0 ? 100.0 * StreamStallFrames / Samples.Num() : 0.0);
+	OutResult.Add(TEXT("StreamHitchFrames"), StreamHitchFrames);
+	OutResult.Add(TEXT("FrameMsP99"), P3DBench::Percentile(MoveTemp(FrameMs), 0.99));
+	OutResult.Add(TEXT("LoadedCellsPeak"), StreamPeakLoadedCells);
+	OutResult.Add(TEXT("ResidentMBPeak"), (StreamPeakUsedMemory - StreamStartUsedMemory) * BytesToMB);
+	OutResult.Add(TEXT("ResidentMBEnd"), (EndUsedMemory - StreamStartUsedMemory) * BytesToMB);
+}
+
+void UP3DBenchmarkSubsystem::EndStreamingFlight()
+{
+	AP3DPlayerController* PC = BenchController.Get();
+	APawn* SavedPawn = StreamingSavedPawn.Get();
+	StreamingSavedPawn = nullptr;
+
+	if (PC && IsValid(SavedPawn) && PC->GetPawn() != SavedPawn)
+	{
+		PC->Possess(SavedPawn);
+	}
+}
@@ -0,0 +1,1013 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+#include "P3DBenchmarkShared.h"
+#include "BasePawn.h"
+#include "DroneAvoidanceSubsystem.h"
+#include "DronePawn.h"
+#include "P3DMassPopulationSubsystem.h"
+#include "P3DPlayerController.h"
+#include "P3DStats.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "RenderCore.h"
+#include <atomic>
+
+static TAutoConsoleVariable<int32> CVarBenchWarmupFrames(
+	TEXT("p3d.Bench.WarmupFrames"),
+	60,
+	TEXT("시나리오마다 측정 전에 버리는 프레임 수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarBenchMeasureFrames(
+	TEXT("p3d.Bench.MeasureFrames"),
+	300,
+	TEXT("시나리오마다 측정하는 프레임 수"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarBenchRegressionPct(
+	TEXT("p3d.Bench.RegressionPct"),
+	10.f,
+	TEXT("기준 대비 이 비율(%) 이상 나빠지면 회귀로 판정"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<FString> CVarBenchBaseline(
+	TEXT("p3d.Bench.Baseline"),
+	TEXT("Benchmarks/P3DBaseline.json"),
+	TEXT("비교 기준 JSON 경로(상대 경로면 프로젝트 폴더 기준)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarBenchCountAllocs(
+	TEXT("p3d.Bench.CountAllocs"),
+	1,
+	TEXT("벤치마크 시작 시 할당 횟수 집계용 GMalloc 프록시 설치(한 번 설치하면 유지)"),
+	ECVF_Default);
+
+namespace
+{
+	// 소크 시나리오 Pawn 수 기본값
+	const int32 DefaultCounts[] = { 1, 10, 100, 1000 };
+
+	// 드론 바닥 탐색 동기/비동기 비교용 드론 수
+	const int32 ProbeCounts[] = { 1, 50, 500 };
+
+	// 회귀 판정 대상(값이 작을수록 좋음) + 0 근처 잡음 허용치
+	struct FGatedMetric
+	{
+		const TCHAR* Key;
+		double AbsSlack;
+	};
+
+	const FGatedMetric GatedMetrics[] =
+	{
+		{ TEXT("GameThreadMsPerPawn"),  0.001 },
+		{ TEXT("PawnTickUsPerPawn"),    0.5 },
+		{ TEXT("AllocsPerFrame"),       2.0 },
+		{ TEXT("SceneQueriesPerFrame"), 1.0 },
+		{ TEXT("ToggleMsAvg"),          0.05 },
+		{ TEXT("SoakFrameMsDrift"),     0.5 },
+		{ TEXT("SoakAllocsPerToggleDrift"), 1.0 },
+		{ TEXT("MaxDeviationCm"),       0.1 },
+		{ TEXT("KinematicToCMCRatio"),  0.05 },
+		{ TEXT("AnimBudgetOverMs"),     0.25 },
+		{ TEXT("MassUsPerEntity"),      0.02 },
+		{ TEXT("BytesPerEntity"),       16.0 },
+		{ TEXT("ResimUsPerPawnFrame"),  0.5 },
+		{ TEXT("ResimMaxErrorCm"),      0.1 },
+		{ TEXT("StreamStallFrames"),    2.0 },
+		{ TEXT("NavLatencyMsP95"),      1.0 },
+		{ TEXT("AvoidUsPerDrone"),      0.5 },
+		{ TEXT("SwarmSolverMsAvg"),     0.05 },
+		{ TEXT("SwarmFrameMsP95"),      1.0 },
+	};
+
+	// 할당 횟수만 세는 GMalloc 프록시(설치 후 프로세스 끝까지 유지)
+	class FP3DCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FP3DCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		uint64 GetNumAllocs() const { return NumAllocs.load(std::memory_order_relaxed); }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocs.fetch_add(1, std::memory_order_relaxed);
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0) NumAllocs.fetch_add(1, std::memory_order_relaxed);
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("P3DCountingMalloc"); }
+
+	private:
+		FMalloc* Inner;
+		std::atomic<uint64> NumAllocs{ 0 };
+	};
+
+	FP3DCountingMalloc* GCountingMalloc = nullptr;
+
+	void InstallCountingMalloc()
+	{
+		if (GCountingMalloc || CVarBenchCountAllocs.GetValueOnGameThread() == 0) return;
+
+		// 기존 할당은 그대로 Inner로 해제되므로 도중 교체해도 안전(일부러 해제하지 않음)
+		GCountingMalloc = new FP3DCountingMalloc(GMalloc);
+		GMalloc = GCountingMalloc;
+	}
+
+	FString ResolveBaselinePath()
+	{
+		FString Path = CVarBenchBaseline.GetValueOnGameThread();
+		if (FPaths::IsRelative(Path))
+		{
+			Path = FPaths::Combine(FPaths::ProjectDir(), Path);
+		}
+		return Path;
+	}
+}
+
+uint64 P3DBench::GetNumAllocs()
+{
+	return GCountingMalloc ? GCountingMalloc->GetNumAllocs() : 0;
+}
+
+double P3DBench::Percentile(TArray<double> Values, double Pct)
+{
+	if (Values.Num() == 0) return 0.0;
+
+	Values.Sort();
+	const int32 Index = FMath::Clamp(FMath::CeilToInt32(Pct * Values.Num()) - 1, 0, Values.Num() - 1);
+	return Values[Index];
+}
+
+// ===== 콘솔 명령 =====
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchRun(
+	TEXT("p3d.Bench.Run"),
+	TEXT("Pawn 벤치마크 실행. 인자: Pawn 수 목록(기본 1 10 100 1000)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		UP3DBenchmarkSubsystem* Bench = World ? World->GetSubsystem<UP3DBenchmarkSubsystem>() : nullptr;
+		if (!Bench) return;
+
+		TArray<int32> Counts;
+		for (const FString& Arg : Args)
+		{
+			const int32 Count = FCString::Atoi(*Arg);
+			if (Count > 0) Counts.Add(Count);
+		}
+
+		Bench->StartBenchmark(Counts, false);
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchStop(
+	TEXT("p3d.Bench.Stop"),
+	TEXT("진행 중인 Pawn 벤치마크 중단(결과는 저장하지 않음)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UP3DBenchmarkSubsystem* Bench = World ? World->GetSubsystem<UP3DBenchmarkSubsystem>() : nullptr)
+		{
+			Bench->StopBenchmark();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdBenchSaveBaseline(
+	TEXT("p3d.Bench.SaveBaseline"),
+	TEXT("마지막 벤치마크 결과를 기준 파일(p3d.Bench.Baseline)로 복사"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UP3DBenchmarkSubsystem* Bench = World ? World->GetSubsystem<UP3DBenchmarkSubsystem>() : nullptr)
+		{
+			Bench->SaveLastResultAsBaseline();
+		}
+	}));
+
+// ===== Subsystem =====
+
+bool UP3DBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UP3DBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UP3DBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UP3DBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 커맨드라인 실행(-P3DBench): 끝나면 회귀 여부를 종료 코드로 돌려줌
+	if (!FParse::Param(FCommandLine::Get(), TEXT("P3DBench"))) return;
+
+	TArray<int32> Counts;
+	FString CountsArg;
+	if (FParse::Value(FCommandLine::Get(), TEXT("P3DBenchCounts="), CountsArg))
+	{
+		TArray<FString> Parts;
+		CountsArg.ParseIntoArray(Parts, TEXT(","));
+		for (const FString& Part : Parts)
+		{
+			const int32 Count = FCString::Atoi(*Part);
+			if (Count > 0) Counts.Add(Count);
+		}
+	}
+
+	StartBenchmark(Counts, true);
+}
+
+void UP3DBenchmarkSubsystem::Deinitialize()
+{
+	DestroyPawns();
+	Super::Deinitialize();
+}
+
+void UP3DBenchmarkSubsystem::StartBenchmark(const TArray<int32>& Counts, bool bInQuitWhenDone)
+{
+	if (IsRunning())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Bench] Already running"));
+		return;
+	}
+
+	InstallCountingMalloc();
+
+	BuildScenarios(Counts);
+	Results.Reset();
+
+	bQuitWhenDone = bInQuitWhenDone;
+	CurrentIndex = 0;
+	Phase = EPhase::Setup;
+	PhaseFrame = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("[Bench] Start: %d scenarios"), Scenarios.Num());
+}
+
+void UP3DBenchmarkSubsystem::StopBenchmark()
+{
+	if (!IsRunning()) return;
+
+	EndSwarm();
+	DestroyPawns();
+	DestroyMassPopulation();
+	RestoreAnimMode();
+	RestoreRollbackRecording();
+	CurrentIndex = INDEX_NONE;
+
+	UE_LOG(LogTemp, Warning, TEXT("[Bench] Stopped"));
+}
+
+void UP3DBenchmarkSubsystem::BuildScenarios(const TArray<int32>& Counts)
+{
+	Scenarios.Reset();
+
+	TArray<int32> SoakCounts = Counts;
+	if (SoakCounts.Num() == 0)
+	{
+		SoakCounts.Append(DefaultCounts, UE_ARRAY_COUNT(DefaultCounts));
+	}
+
+	for (const int32 Count : SoakCounts)
+	{
+		Scenarios.Add({ FString::Printf(TEXT("Soak_Base_%d"), Count), EScenarioKind::Soak, false, false, Count });
+		Scenarios.Add({ FString::Printf(TEXT("Soak_Drone_%d"), Count), EScenarioKind::Soak, true, false, Count });
+	}
+
+	AddAnimScenarios();
+
+	for (const int32 Count : ProbeCounts)
+	{
+		Scenarios.Add({ FString::Printf(TEXT("Probe_Sync_%d"), Count), EScenarioKind::Soak, true, false, Count });
+		Scenarios.Add({ FString::Printf(TEXT("Probe_Async_%d"), Count), EScenarioKind::Soak, true, true, Count });
+	}
+
+	// 기능별 시나리오(P3DBenchmark<기능>.cpp)
+	AddMoverScenarios();
+	AddMassScenarios();
+	AddAvoidanceScenarios();
+	AddRollbackScenarios();
+	AddStreamingScenarios();
+	AddNavigationScenarios();
+	AddSwarmScenarios();
+	AddDeterminismScenarios();
+	AddPossessionScenarios();
+}
+
+// Tick: 시나리오 단계 진행
+
+void UP3DBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	if (!IsRunning()) return;
+
+	if (!Scenarios.IsValidIndex(CurrentIndex))
+	{
+		Finish();
+		return;
+	}
+
+	const FScenario& Scenario = Scenarios[CurrentIndex];
+
+	switch (Phase)
+	{
+	case EPhase::Setup:
+		BeginScenario(Scenario);
+		break;
+
+	case EPhase::Warmup:
+	case EPhase::Measure:
+		TickScenario(Scenario);
+		if (Phase == EPhase::Measure)
+		{
+			RecordFrame(DeltaTime);
+		}
+		break;
+
+	case EPhase::Teardown:
+		EndStreamingFlight();
+		EndSwarm();
+		DestroyPawns();
+		DestroyMassPopulation();
+		RestoreAnimMode();
+		RestoreRollbackRecording();
+		++CurrentIndex;
+		Phase = EPhase::Setup;
+		break;
+	}
+
+	++PhaseFrame;
+
+	const int32 WarmupFrames = FMath::Max(0, CVarBenchWarmupFrames.GetValueOnGameThread());
+	const int32 MeasureFrames = GetMeasureFrames(Scenario);
+
+	if (Phase == EPhase::Warmup && PhaseFrame >= WarmupFrames)
+	{
+		ResetCounters();
+		Phase = EPhase::Measure;
+		PhaseFrame = 0;
+	}
+	else if (Phase == EPhase::Measure && PhaseFrame >= MeasureFrames)
+	{
+		EndScenario(Scenario);
+		Phase = EPhase::Teardown;
+		PhaseFrame = 0;
+	}
+}
+
+void UP3DBenchmarkSubsystem::BeginScenario(const FScenario& Scenario)
+{
+	UE_LOG(LogTemp, Log, TEXT("[Bench] %s"), *Scenario.Name);
+
+	Samples.Reset();
+	Samples.Reserve(GetMeasureFrames(Scenario));
+	ToggleMs.Reset();
+	ToggleAllocs.Reset();
+
+	Phase = EPhase::Warmup;
+	PhaseFrame = 0;
+
+	switch (Scenario.Kind)
+	{
+	case EScenarioKind::Soak:
+		ApplyAnimMode(Scenario.Anim);
+		SpawnPawns(Scenario);
+
+		// 기준선: 메시 Tick 자체를 끔(예산 할당기는 위에서 꺼둠)
+		if (Scenario.Anim == EAnimMode::NoAnim)
+		{
+			for (APawn* Pawn : SpawnedPawns)
+			{
+				if (ABasePawn* Base = Cast<ABasePawn>(Pawn))
+				{
+					Base->MeshComp->SetComponentTickEnabled(false);
+				}
+			}
+		}
+		break;
+
+	case EScenarioKind::Rollback:
+		// 스폰 전에 켜야 첫 Tick부터 기록(링 버퍼는 첫 기록 때 한 번 할당 → 워밍업 중)
+		SetRollbackRecording(true);
+		SpawnPawns(Scenario);
+		break;
+
+	case EScenarioKind::Determinism:
+	{
+		// 한 프레임 안에서 끝남
+		FScenarioResult& Result = Results.AddDefaulted_GetRef();
+		Result.Name = Scenario.Name;
+		RunDeterminism(Result);
+		Phase = EPhase::Teardown;
+		break;
+	}
+
+	case EScenarioKind::Possession:
+		if (!BeginPossessionToggle())
+		{
+			FScenarioResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Scenario.Name;
+			Result.Add(TEXT("Skipped"), 1.0);
+			Phase = EPhase::Teardown;
+		}
+		break;
+
+	case EScenarioKind::Streaming:
+		if (!BeginStreamingFlight(Scenario))
+		{
+			FScenarioResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Scenario.Name;
+			Result.Add(TEXT("Skipped"), 1.0);
+			Phase = EPhase::Teardown;
+		}
+		break;
+
+	case EScenarioKind::Navigation:
+		if (!BeginNavigationStress())
+		{
+			FScenarioResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Scenario.Name;
+			Result.Add(TEXT("Skipped"), 1.0);
+			Phase = EPhase::Teardown;
+		}
+		break;
+
+	case EScenarioKind::Swarm:
+		if (!BeginSwarm(Scenario))
+		{
+			FScenarioResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Scenario.Name;
+			Result.Add(TEXT("Skipped"), 1.0);
+			Phase = EPhase::Teardown;
+		}
+		break;
+
+	case EScenarioKind::Mass:
+		if (!BeginMassPopulation(Scenario))
+		{
+			FScenarioResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Scenario.Name;
+			Result.Add(TEXT("Skipped"), 1.0);
+			Phase = EPhase::Teardown;
+		}
+		break;
+	}
+}
+
+void UP3DBenchmarkSubsystem::TickScenario(const FScenario& Scenario)
+{
+	if (Scenario.Kind == EScenarioKind::Soak || Scenario.Kind == EScenarioKind::Rollback)
+	{
+		DriveScriptedInput(PhaseFrame);
+	}
+	else if (Scenario.Kind == EScenarioKind::Possession && Phase == EPhase::Measure)
+	{
+		RunPossessionFrame();
+	}
+	else if (Scenario.Kind == EScenarioKind::Streaming && Phase == EPhase::Measure)
+	{
+		RunStreamingFrame(GetWorld()->GetDeltaSeconds());
+	}
+	else if (Scenario.Kind == EScenarioKind::Swarm)
+	{
+		RunSwarmFrame(PhaseFrame);
+	}
+	else if (Scenario.Kind == EScenarioKind::Navigation && Phase == EPhase::Measure && PhaseFrame == 0)
+	{
+		// 측정 첫 프레임에 한 번에 넣음(워밍업 동안은 생성/로드 히치만 흘려보냄)
+		StartNavigationRequests(Scenario.Count);
+	}
+}
+
+void UP3DBenchmarkSubsystem::EndScenario(const FScenario& Scenario)
+{
+	FScenarioResult& Result = Results.AddDefaulted_GetRef();
+	Result.Name = Scenario.Name;
+
+	if (Scenario.Kind == EScenarioKind::Soak)
+	{
+		SummarizeSoak(Scenario, Result);
+
+		if (Scenario.Mover == EMover::Character)
+		{
+			AddMoverComparison(Scenario);
+		}
+		else if (Scenario.Anim == EAnimMode::Budget)
+		{
+			AddAnimBudgetComparison(Scenario);
+		}
+		return;
+	}
+
+	if (Scenario.Kind == EScenarioKind::Mass)
+	{
+		SummarizeMass(Result);
+		return;
+	}
+
+	if (Scenario.Kind == EScenarioKind::Streaming)
+	{
+		SummarizeStreaming(Result);
+		return;
+	}
+
+	if (Scenario.Kind == EScenarioKind::Navigation)
+	{
+		SummarizeNavigation(Result);
+		return;
+	}
+
+	if (Scenario.Kind == EScenarioKind::Swarm)
+	{
+		SummarizeSwarm(Result);
+		return;
+	}
+
+	if (Scenario.Kind == EScenarioKind::Rollback)
+	{
+		// 측정 구간 = 기록 켠 상태의 소크(기록 비용/프레임당 할당 포함)
+		SummarizeSoak(Scenario, Result);
+		RunRollbackResim(Result);
+		return;
+	}
+
+	if (Scenario.Kind == EScenarioKind::Possession)
+	{
+		SummarizePossession(Result);
+		EndPossessionToggle();
+	}
+}
+
+int32 UP3DBenchmarkSubsystem::GetMeasureFrames(const FScenario& Scenario) const
+{
+	return Scenario.MeasureFrames > 0 ? Scenario.MeasureFrames : FMath::Max(1, CVarBenchMeasureFrames.GetValueOnGameThread());
+}
+
+// Pawn 배치 / 스크립트 입력
+
+FVector UP3DBenchmarkSubsystem::GetSpawnOrigin() const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			return Pawn->GetActorLocation();
+		}
+	}
+
+	return FVector(0.f, 0.f, 200.f);
+}
+
+TSubclassOf<APawn> UP3DBenchmarkSubsystem::GetBasePawnClass() const
+{
+	// 맵/게임모드에서 실제로 쓰는 BP가 있으면 그걸로(메시/애님 비용 포함)
+	if (const AGameModeBase* GameMode = GetWorld()->GetAuthGameMode())
+	{
+		if (GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(ABasePawn::StaticClass()))
+		{
+			return GameMode->DefaultPawnClass;
+		}
+	}
+
+	return ABasePawn::StaticClass();
+}
+
+TSubclassOf<APawn> UP3DBenchmarkSubsystem::GetDronePawnClass() const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const AP3DPlayerController* PC = Cast<AP3DPlayerController>(It->Get());
+		// 소프트 참조: 벤치마크는 측정 전에 동기 로드
+		if (PC && !PC->DronePawnClass.IsNull())
+		{
+			return PC->DronePawnClass.LoadSynchronous();
+		}
+	}
+
+	return ADronePawn::StaticClass();
+}
+
+void UP3DBenchmarkSubsystem::SpawnPawns(const FScenario& Scenario)
+{
+	UWorld* World = GetWorld();
+
+	TSubclassOf<APawn> PawnClass;
+	switch (Scenario.Mover)
+	{
+	case EMover::Kinematic: PawnClass = ABasePawn::StaticClass(); break;
+	case EMover::Character: PawnClass = ACharacter::StaticClass(); break;
+	default:                PawnClass = Scenario.bDrone ? GetDronePawnClass() : GetBasePawnClass(); break;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// 플레이어 주변 격자 배치(플레이어 자리는 비움)
+	constexpr float Spacing = 300.f;
+	const int32 Side = FMath::CeilToInt32(FMath::Sqrt(float(Scenario.Count)));
+	const FVector Origin = GetSpawnOrigin() + FVector(Spacing, -0.5f * Side * Spacing, Scenario.bDrone ? 300.f : 0.f);
+
+	SpawnedPawns.Reserve(Scenario.Count);
+
+	for (int32 i = 0; i < Scenario.Count; ++i)
+	{
+		const FVector Location = Origin + FVector((i / Side) * Spacing, (i % Side) * Spacing, 0.f);
+
+		APawn* Pawn = World->SpawnActor<APawn>(PawnClass, Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Pawn) continue;
+
+		if (ABasePawn* Base = Cast<ABasePawn>(Pawn))
+		{
+			Base->SetScriptedInputEnabled(true);
+		}
+		else if (ADronePawn* Drone = Cast<ADronePawn>(Pawn))
+		{
+			Drone->bUseAsyncGroundProbe = Scenario.bAsyncProbe;
+			if (Scenario.bAvoidance)
+			{
+				Drone->SetAvoidanceEnabled(true);
+			}
+		}
+		else if (ACharacter* Character = Cast<ACharacter>(Pawn))
+		{
+			// ABasePawn과 같은 캡슐/속도, 컨트롤러 없이도 이동
+			Character->GetCapsuleComponent()->InitCapsuleSize(42.f, 96.f);
+			Character->GetCharacterMovement()->MaxWalkSpeed = GetDefault<ABasePawn>()->NormalSpeed;
+			Character->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+		}
+
+		SpawnedPawns.Add(Pawn);
+	}
+}
+
+void UP3DBenchmarkSubsystem::DestroyPawns()
+{
+	for (APawn* Pawn : SpawnedPawns)
+	{
+		if (IsValid(Pawn))
+		{
+			Pawn->Destroy();
+		}
+	}
+	SpawnedPawns.Reset();
+}
+
+void UP3DBenchmarkSubsystem::DriveScriptedInput(int32 Frame)
+{
+	// 프레임 번호 + Pawn 인덱스만으로 정해지는 입력(실행마다 동일)
+	const float T = Frame / 60.f;
+
+	for (int32 i = 0; i < SpawnedPawns.Num(); ++i)
+	{
+		APawn* Pawn = SpawnedPawns[i];
+		if (!IsValid(Pawn)) continue;
+
+		const float Phase = i * 0.37f;
+
+		FP3DScriptedInput Input;
+		Input.Move = FVector2D(FMath::Sin(T * 0.7f + Phase), FMath::Cos(T * 0.5f + Phase));
+		Input.Look = FVector2D(0.5f * FMath::Sin(T * 1.3f + Phase), 0.2f * FMath::Sin(T * 0.9f + Phase));
+		Input.UpDown = FMath::Sin(T * 0.4f + Phase);
+		Input.Roll = 0.3f * FMath::Sin(T * 0.6f + Phase);
+
+		if (ABasePawn* Base = Cast<ABasePawn>(Pawn))
+		{
+			Base->InjectScriptedInput(Input);
+		}
+		else if (ADronePawn* Drone = Cast<ADronePawn>(Pawn))
+		{
+			Drone->InjectScriptedInput(Input);
+		}
+		else if (ACharacter* Character = Cast<ACharacter>(Pawn))
+		{
+			// ABasePawn::Tick과 같은 해석(로컬 X=앞, Y=오른쪽, Look.X만큼 Yaw)
+			Character->AddActorLocalRotation(FRotator(0.f, Input.Look.X * GetDefault<ABasePawn>()->MouseSensitivity, 0.f));
+			Character->AddMovementInput(Character->GetActorRotation().RotateVector(FVector(Input.Move.Y, Input.Move.X, 0.f)));
+		}
+	}
+}
+
+AP3DPlayerController* UP3DBenchmarkSubsystem::FindLocalController() const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		AP3DPlayerController* PC = Cast<AP3DPlayerController>(It->Get());
+		if (PC && PC->IsLocalController() && PC->GetPawn())
+		{
+			return PC;
+		}
+	}
+	return nullptr;
+}
+
+// 측정
+
+void UP3DBenchmarkSubsystem::ResetCounters()
+{
+	LastAllocs = P3DBench::GetNumAllocs();
+	LastSceneQueries = P3DCounters::SceneQueries;
+	LastPawnTickCycles = P3DCounters::PawnTickCycles;
+	LastMassCycles = P3DCounters::MassCycles;
+}
+
+void UP3DBenchmarkSubsystem::RecordFrame(float DeltaTime)
+{
+	const uint64 Allocs = P3DBench::GetNumAllocs();
+
+	FFrameSample& Sample = Samples.AddDefaulted_GetRef();
+	Sample.FrameMs = DeltaTime * 1000.0;
+	Sample.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Sample.PawnTickMs = FPlatformTime::ToMilliseconds64(P3DCounters::PawnTickCycles - LastPawnTickCycles);
+	Sample.Allocs = Allocs - LastAllocs;
+	Sample.SceneQueries = P3DCounters::SceneQueries - LastSceneQueries;
+	Sample.AnimTicked = CountAnimTicked();
+	Sample.MassMs = FPlatformTime::ToMilliseconds64(P3DCounters::MassCycles - LastMassCycles);
+
+	if (const UP3DMassPopulationSubsystem* Population = GetWorld()->GetSubsystem<UP3DMassPopulationSubsystem>())
+	{
+		Sample.MassPromoted = Population->GetNumPromoted();
+	}
+
+	if (const UDroneAvoidanceSubsystem* Avoidance = GetWorld()->GetSubsystem<UDroneAvoidanceSubsystem>())
+	{
+		const UDroneAvoidanceSubsystem::FFrameStats& AvoidStats = Avoidance->GetLastFrameStats();
+		Sample.AvoidRays = AvoidStats.Rays;
+		Sample.AvoidOverBudget = AvoidStats.DronesOverBudget;
+		Sample.AvoidMs = AvoidStats.Ms;
+	}
+
+	if (const UDroneSwarmSubsystem* Swarm = GetWorld()->GetSubsystem<UDroneSwarmSubsystem>())
+	{
+		const UDroneSwarmSubsystem::FFrameStats& SwarmStats = Swarm->GetLastFrameStats();
+		Sample.SwarmSolverMs = SwarmStats.SolverMs;
+		Sample.SwarmSlotErrorCm = SwarmStats.SlotErrorCm;
+		Sample.SwarmOverlapPairs = SwarmStats.OverlapPairs;
+	}
+
+	LastAllocs = Allocs;
+	LastSceneQueries = P3DCounters::SceneQueries;
+	LastPawnTickCycles = P3DCounters::PawnTickCycles;
+	LastMassCycles = P3DCounters::MassCycles;
+}
+void UP3DBenchmarkSubsystem::SummarizeSoak(const FScenario& Scenario, FScenarioResult& OutResult) const
+{
+	const int32 Num = FMath::Max(1, Samples.Num());
+	const double Count = FMath::Max(1, SpawnedPawns.Num());
+
+	TArray<double> GameThreadMs;
+	GameThreadMs.Reserve(Samples.Num());
+
+	double FrameSum = 0.0, GameThreadSum = 0.0, PawnTickSum = 0.0, AllocSum = 0.0, QuerySum = 0.0, AnimTickedSum = 0.0;
+	for (const FFrameSample& Sample : Samples)
+	{
+		AnimTickedSum += Sample.AnimTicked;
+		FrameSum += Sample.FrameMs;
+		GameThreadSum += Sample.GameThreadMs;
+		PawnTickSum += Sample.PawnTickMs;
+		AllocSum += Sample.Allocs;
+		QuerySum += Sample.SceneQueries;
+		GameThreadMs.Add(Sample.GameThreadMs);
+	}
+
+	OutResult.Add(TEXT("Pawns"), SpawnedPawns.Num());
+	OutResult.Add(TEXT("Frames"), Samples.Num());
+	OutResult.Add(TEXT("FrameMsAvg"), FrameSum / Num);
+	OutResult.Add(TEXT("GameThreadMsAvg"), GameThreadSum / Num);
+	OutResult.Add(TEXT("GameThreadMsP95"), P3DBench::Percentile(GameThreadMs, 0.95));
+	OutResult.Add(TEXT("GameThreadMsPerPawn"), GameThreadSum / Num / Count);
+	OutResult.Add(TEXT("PawnTickUsPerPawn"), PawnTickSum / Num / Count * 1000.0);
+	OutResult.Add(TEXT("AllocsPerFrame"), AllocSum / Num);
+	OutResult.Add(TEXT("SceneQueriesPerFrame"), QuerySum / Num);
+
+	// 포즈 평가한 메시 비율(예산 할당기가 건너뛴 만큼 줄어듦)
+	if (AnimTickedSum > 0.0 || Scenario.Anim != EAnimMode::Default)
+	{
+		OutResult.Add(TEXT("AnimTickedPerFrame"), AnimTickedSum / Num);
+		OutResult.Add(TEXT("AnimTickedPct"), AnimTickedSum / Num / Count * 100.0);
+	}
+
+	if (Scenario.bAvoidance)
+	{
+		SummarizeAvoidance(OutResult);
+	}
+}
+
+// 결과 저장 / 기준 비교
+
+const double* UP3DBenchmarkSubsystem::FScenarioResult::Find(const FString& Key) const
+{
+	for (const TPair<FString, double>& Pair : Metrics)
+	{
+		if (Pair.Key == Key) return &Pair.Value;
+	}
+	return nullptr;
+}
+
+void UP3DBenchmarkSubsystem::Finish()
+{
+	int32 Regressions = 0;
+	LastResultPath = WriteResults(Regressions);
+
+	CurrentIndex = INDEX_NONE;
+	Scenarios.Reset();
+
+	UE_LOG(LogTemp, Log, TEXT("[Bench] Done: %s (regressions=%d)"), *LastResultPath, Regressions);
+
+	if (bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, Regressions > 0 ? 1 : 0);
+	}
+}
+
+FString UP3DBenchmarkSubsystem::WriteResults(int32& OutRegressions)
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("Version"), 1);
+	Root->SetStringField(TEXT("Map"), GetWorld()->GetMapName());
+	Root->SetStringField(TEXT("BuildConfig"), LexToString(FApp::GetBuildConfiguration()));
+	Root->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetBoolField(TEXT("CanRender"), FApp::CanEverRender());
+	Root->SetBoolField(TEXT("CountAllocs"), GCountingMalloc != nullptr);
+
+	TArray<TSharedPtr<FJsonValue>> ScenarioValues;
+	for (const FScenarioResult& Result : Results)
+	{
+		TSharedRef<FJsonObject> Metrics = MakeShared<FJsonObject>();
+		for (const TPair<FString, double>& Pair : Result.Metrics)
+		{
+			Metrics->SetNumberField(Pair.Key, Pair.Value);
+		}
+
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("Name"), Result.Name);
+		Entry->SetObjectField(TEXT("Metrics"), Metrics);
+		ScenarioValues.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+	Root->SetArrayField(TEXT("Scenarios"), ScenarioValues);
+
+	OutRegressions = CompareWithBaseline(Root);
+
+	// 기준 파일과 무관한 조건: 키네마틱 이동이 CMC보다 싸야 함
+	for (const FScenarioResult& Result : Results)
+	{
+		const double* Ratio = Result.Find(TEXT("KinematicToCMCRatio"));
+		if (Ratio && *Ratio >= 1.0)
+		{
+			++OutRegressions;
+			UE_LOG(LogTemp, Warning, TEXT("[Bench] %s: kinematic mover is not cheaper than CMC (x%.2f)"), *Result.Name, *Ratio);
+		}
+	}
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"),
+		FString::Printf(TEXT("P3DBench_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+
+	if (!FFileHelper::SaveStringToFile(Json, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Bench] Failed to write %s"), *Path);
+	}
+
+	return Path;
+}
+
+int32 UP3DBenchmarkSubsystem::CompareWithBaseline(const TSharedRef<FJsonObject>& Root) const
+{
+	const FString BaselinePath = ResolveBaselinePath();
+
+	FString Json;
+	TSharedPtr<FJsonObject> Baseline;
+	if (!FFileHelper::LoadFileToString(Json, *BaselinePath)
+		|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Baseline)
+		|| !Baseline.IsValid())
+	{
+		// 커맨드라인(게이트) 실행에서 기준 없이 통과하면 회귀를 못 잡음 → 실패로 셈
+		if (bQuitWhenDone)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[Bench] No baseline at %s (p3d.Bench.SaveBaseline to create)"), *BaselinePath);
+			Root->SetStringField(TEXT("BaselineMissing"), BaselinePath);
+			return 1;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("[Bench] No baseline at %s (p3d.Bench.SaveBaseline to create)"), *BaselinePath);
+		return 0;
+	}
+
+	Root->SetStringField(TEXT("Baseline"), BaselinePath);
+
+	const double Tolerance = 1.0 + FMath::Max(0.f, CVarBenchRegressionPct.GetValueOnGameThread()) / 100.0;
+
+	// 기준 시나리오 이름 → Metrics
+	TMap<FString, TSharedPtr<FJsonObject>> BaseMetrics;
+	const TArray<TSharedPtr<FJsonValue>>* BaseScenarios = nullptr;
+	if (Baseline->TryGetArrayField(TEXT("Scenarios"), BaseScenarios))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *BaseScenarios)
+		{
+			const TSharedPtr<FJsonObject> Entry = Value->AsObject();
+			if (Entry.IsValid() && Entry->HasTypedField<EJson::Object>(TEXT("Metrics")))
+			{
+				BaseMetrics.Add(Entry->GetStringField(TEXT("Name")), Entry->GetObjectField(TEXT("Metrics")));
+			}
+		}
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Regressions;
+	TArray<TSharedPtr<FJsonValue>> Unbaselined;
+	for (const FScenarioResult& Result : Results)
+	{
+		const TSharedPtr<FJsonObject>* Base = BaseMetrics.Find(Result.Name);
+
+		for (const FGatedMetric& Gate : GatedMetrics)
+		{
+			const double* Current = Result.Find(Gate.Key);
+			if (!Current) continue;
+
+			// 측정은 했는데 기준 값이 없음 → 비교 없이 통과하면 게이트가 의미 없음
+			double BaseValue = 0.0;
+			if (!Base || !(*Base)->TryGetNumberField(Gate.Key, BaseValue))
+			{
+				Unbaselined.Add(MakeShared<FJsonValueString>(FString::Printf(TEXT("%s.%s"), *Result.Name, Gate.Key)));
+				continue;
+			}
+
+			if (*Current > BaseValue * Tolerance + Gate.AbsSlack)
+			{
+				TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+				Entry->SetStringField(TEXT("Scenario"), Result.Name);
+				Entry->SetStringField(TEXT("Metric"), Gate.Key);
+				Entry->SetNumberField(TEXT("Baseline"), BaseValue);
+				Entry->SetNumberField(TEXT("Current"), *Current);
+				Regressions.Add(MakeShared<FJsonValueObject>(Entry));
+
+				UE_LOG(LogTemp, Warning, TEXT("[Bench] REGRESSION %s.%s: %.4f -> %.4f"), *Result.Name, Gate.Key, BaseValue, *Current);
+			}
+		}
+	}
+
+	Root->SetArrayField(TEXT("Regressions"), Regressions);
+	Root->SetArrayField(TEXT("Unbaselined"), Unbaselined);
+
+	// 커맨드라인(게이트) 실행은 기준 없는 지표를 실패로 셈(시나리오 추가 시 기준도 다시 기록)
+	if (Unbaselined.Num() > 0 && bQuitWhenDone)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[Bench] %d gated metrics have no baseline value in %s (p3d.Bench.SaveBaseline to re-record)"), Unbaselined.Num(), *BaselinePath);
+		return Regressions.Num() + Unbaselined.Num();
+	}
+
+	if (Unbaselined.Num() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Bench] %d gated metrics have no baseline value in %s (p3d.Bench.SaveBaseline to re-record)"), Unbaselined.Num(), *BaselinePath);
+	}
+
+	return Regressions.Num();
+}
+
+bool UP3DBenchmarkSubsystem::SaveLastResultAsBaseline() const
+{
+	if (LastResultPath.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Bench] No result to save"));
+		return false;
+	}
+
+	const FString BaselinePath = ResolveBaselinePath();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(BaselinePath));
+
+	const bool bCopied = PlatformFile.CopyFile(*BaselinePath, *LastResultPath);
+	UE_LOG(LogTemp, Log, TEXT("[Bench] Baseline %s -> %s (%s)"), *LastResultPath, *BaselinePath, bCopied ? TEXT("ok") : TEXT("failed"));
+	return bCopied;
+}
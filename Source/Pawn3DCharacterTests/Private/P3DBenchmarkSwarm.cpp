@@ -0,0 +1,129 @@
+﻿#include "P3DBenchmarkSubsystem.h"
+
+#include "P3DBenchmarkShared.h"
+#include "DronePawn.h"
+#include "DroneSwarmSubsystem.h"
+#include "Engine/World.h"
+
+namespace
+{
+	// 군집: 팔로워 수 / 슬롯 간격 / 리더 고도(구면 대형 아래쪽이 바닥에 안 닿게) / 유지 목표 프레임 시간
+	constexpr int32 SwarmFollowerCount = 256;
+	constexpr float SwarmSpacing = 250.f;
+	constexpr float SwarmAltitude = 1500.f;
+	constexpr double SwarmTargetFrameMs = 1000.0 / 60.0;
+}
+
+void UP3DBenchmarkSubsystem::AddSwarmScenarios()
+{
+	for (const EDroneFormation Formation : { EDroneFormation::Line, EDroneFormation::Wedge, EDroneFormation::Sphere })
+	{
+		const FString FormationName = StaticEnum<EDroneFormation>()->GetNameStringByValue(int64(Formation));
+		Scenarios.Add({ FString::Printf(TEXT("Swarm_%s_%d"), *FormationName, SwarmFollowerCount), EScenarioKind::Swarm, true, false, SwarmFollowerCount,
+			EMover::Default, EAnimMode::Default, false, false, Formation });
+	}
+}
+
+// 군집: 리더만 스크립트 입력, 팔로워는 UDroneSwarmSubsystem이 한 번에 조종
+
+bool UP3DBenchmarkSubsystem::BeginSwarm(const FScenario& Scenario)
+{
+	UWorld* World = GetWorld();
+	UDroneSwarmSubsystem* Swarm = World->GetSubsystem<UDroneSwarmSubsystem>();
+	if (!Swarm) return false;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const TSubclassOf<APawn> DroneClass = GetDronePawnClass();
+	SwarmStart = GetSpawnOrigin() + FVector(0.f, 0.f, SwarmAltitude);
+
+	ADronePawn* Leader = World->SpawnActor<ADronePawn>(DroneClass, SwarmStart, FRotator::ZeroRotator, SpawnParams);
+	if (!Leader) return false;
+
+	SpawnedPawns.Add(Leader);
+	BenchSwarmId = Swarm->CreateSwarm(Leader, Scenario.Formation, SwarmSpacing);
+
+	// AP3DPlayerController::SpawnSwarm과 같이 슬롯 자리에 배치(리더 Yaw 0)
+	for (int32 Slot = 0; Slot < Scenario.Count; ++Slot)
+	{
+		const FVector Location = SwarmStart + UDroneSwarmSubsystem::ComputeSlotOffset(Scenario.Formation, Slot, Scenario.Count, SwarmSpacing);
+
+		ADronePawn* Follower = World->SpawnActor<ADronePawn>(DroneClass, Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Follower) continue;
+
+		Swarm->AddFollower(BenchSwarmId, Follower);
+		SpawnedPawns.Add(Follower);
+	}
+
+	return true;
+}
+
+void UP3DBenchmarkSubsystem::RunSwarmFrame(int32 Frame)
+{
+	ADronePawn* Leader = SpawnedPawns.Num() > 0 ? Cast<ADronePawn>(SpawnedPawns[0]) : nullptr;
+	if (!IsValid(Leader)) return;
+
+	// 프레임 번호만으로 정해지는 경로: 전진 + 좌우 흔들기 + 완만한 선회, 고도는 시작 높이 주변
+	const float T = Frame / 60.f;
+	const float Hover = P3DDroneFlight::GetHoverInput(Leader->GetFlightParams());
+	const float TargetZ = float(SwarmStart.Z) + 200.f * FMath::Sin(T * 0.3f);
+
+	FP3DScriptedInput Input;
+	Input.Move = FVector2D(0.3f * FMath::Sin(T * 0.5f), 0.8f);
+	Input.Look = FVector2D(0.4f * FMath::Sin(T * 0.7f), 0.f);
+	Input.UpDown = FMath::Clamp(Hover + 0.01f * (TargetZ - float(Leader->GetActorLocation().Z)), -1.f, 1.f);
+
+	Leader->InjectScriptedInput(Input);
+}
+
+void UP3DBenchmarkSubsystem::SummarizeSwarm(FScenarioResult& OutResult) const
+{
+	const int32 Num = FMath::Max(1, Samples.Num());
+	const double Followers = FMath::Max(1, SpawnedPawns.Num() - 1);
+
+	TArray<double> FrameMs;
+	TArray<double> SolverMs;
+	FrameMs.Reserve(Samples.Num());
+	SolverMs.Reserve(Samples.Num());
+
+	double GameThreadSum = 0.0, SolverSum = 0.0, SlotErrorSum = 0.0, OverlapSum = 0.0;
+	for (const FFrameSample& Sample : Samples)
+	{
+		GameThreadSum += Sample.GameThreadMs;
+		SolverSum += Sample.SwarmSolverMs;
+		SlotErrorSum += Sample.SwarmSlotErrorCm;
+		OverlapSum += Sample.SwarmOverlapPairs;
+		FrameMs.Add(Sample.FrameMs);
+		SolverMs.Add(Sample.SwarmSolverMs);
+	}
+
+	const double FrameMsP95 = P3DBench::Percentile(MoveTemp(FrameMs), 0.95);
+
+	OutResult.Add(TEXT("Followers"), SpawnedPawns.Num() - 1);
+	OutResult.Add(TEXT("Frames"), Samples.Num());
+	OutResult.Add(TEXT("SwarmFrameMsP95"), FrameMsP95);
+	OutResult.Add(TEXT("SwarmHolds60Fps"), FrameMsP95 <= SwarmTargetFrameMs ? 1.0 : 0.0);
+	OutResult.Add(TEXT("GameThreadMsAvg"), GameThreadSum / Num);
+	OutResult.Add(TEXT("SwarmSolverMsAvg"), SolverSum / Num);
+	OutResult.Add(TEXT("SwarmSolverMsP95"), P3DBench::Percentile(MoveTemp(SolverMs), 0.95));
+	OutResult.Add(TEXT("SwarmSolverUsPerFollower"), SolverSum / Num / Followers * 1000.0);
+	OutResult.Add(TEXT("SwarmSlotErrorCmAvg"), SlotErrorSum / Num);
+	OutResult.Add(TEXT("SwarmOverlapPairsAvg"), OverlapSum / Num);
+
+	if (FrameMsP95 > SwarmTargetFrameMs)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Bench] Swarm frame p95 %.2f ms > %.2f ms (60 fps)"), FrameMsP95, SwarmTargetFrameMs);
+	}
+}
+
+void UP3DBenchmarkSubsystem::EndSwarm()
+{
+	if (BenchSwarmId == INDEX_NONE) return;
+
+	if (UDroneSwarmSubsystem* Swarm = GetWorld() ? GetWorld()->GetSubsystem<UDroneSwarmSubsystem>() : nullptr)
+	{
+		Swarm->DestroySwarm(BenchSwarmId);
+	}
+	BenchSwarmId = INDEX_NONE;
+}
@@ -0,0 +1,246 @@
+﻿#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "DronePawn.h"
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+
+// =========================================================
+// 드론 고정 스텝 결정성 (헤드리스: -nullrhi -ExecCmds="Automation RunTests Pawn3D.Drone")
+// - 같은 스크립트 입력을 30/60/144 fps + 히치 프레임(0.25초, 최대 서브스텝 초과) 간격으로 비행
+// - 같은 시뮬 스텝 번호의 위치(매 스텝) + 마지막 공통 스텝 위치가 30 fps 기준과 허용 오차 안
+// - 얇은 바닥(2cm) 위로 하강: 히치 프레임이 있어도 바닥을 뚫고 내려가지 않음
+// =========================================================
+namespace P3DDroneDeterminismTest
+{
+	// 스텝이 같으면 같은 연산 → 사실상 0, float 누적 차이만 허용
+	constexpr double ToleranceCm = 0.01;
+
+	constexpr float FlightSeconds = 3.f;
+	constexpr float HitchSeconds = 0.25f;
+	constexpr int32 HitchFrame = 10;
+
+	// 기준 대비 비교된 스텝 비율 하한(빈 비교로 통과 방지)
+	constexpr double MinComparedRatio = 0.9;
+
+	constexpr float FloorHalfThickness = 1.f;
+
+	struct FRate
+	{
+		const TCHAR* Name;
+		float FrameDT;
+		bool bHitch;
+	};
+
+	const FRate Rates[] =
+	{
+		{ TEXT("30fps"),       1.f / 30.f,  false },
+		{ TEXT("60fps"),       1.f / 60.f,  false },
+		{ TEXT("144fps"),      1.f / 144.f, false },
+		{ TEXT("60fps+hitch"), 1.f / 60.f,  true },
+	};
+
+	// 렌더링 없는 게임 월드(BeginPlay까지)
+	class FTestWorld
+	{
+	public:
+		FTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("P3DDroneDeterminismTest"));
+			FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+			Context.SetCurrentWorld(World);
+
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+		}
+
+		~FTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		// 등록된 바디를 씬 질의 가속 구조에 반영(월드 Tick을 안 돌리므로 직접)
+		void FlushPhysics() const
+		{
+			if (FPhysScene* Scene = World->GetPhysicsScene())
+			{
+				Scene->StartFrame();
+				Scene->WaitPhysScenes();
+				Scene->EndFrame();
+			}
+		}
+
+		UWorld* World = nullptr;
+	};
+
+	ADronePawn* SpawnDrone(UWorld* World, const FVector& Location)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		ADronePawn* Drone = World->SpawnActor<ADronePawn>(ADronePawn::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Drone) return nullptr;
+
+		// 엔진 Tick은 끄고 직접 Tick(비동기 탐색/보간은 비교 대상 아님)
+		Drone->SetActorTickEnabled(false);
+		Drone->bUseFixedTimestep = true;
+		Drone->bUseAsyncGroundProbe = false;
+		Drone->bUseGroundCache = false;   // 앞 실행의 캐시가 다음 실행 궤적에 섞이지 않게
+		Drone->bInterpolateRender = false;
+		return Drone;
+	}
+
+	// 윗면 높이 = TopZ, 충돌만 있는 정적 박스
+	AActor* SpawnThinFloor(UWorld* World, float TopZ)
+	{
+		AActor* Floor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+		if (!Floor) return nullptr;
+
+		UBoxComponent* Box = NewObject<UBoxComponent>(Floor, TEXT("Floor"));
+		Box->SetMobility(EComponentMobility::Static);
+		Box->SetBoxExtent(FVector(5000.f, 5000.f, FloorHalfThickness), false);
+		Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		Box->SetWorldLocation(FVector(0.f, 0.f, TopZ - FloorHalfThickness));
+		Floor->SetRootComponent(Box);
+		Box->RegisterComponent();
+		return Floor;
+	}
+
+	struct FRun
+	{
+		TMap<uint64, FVector> Steps;   // 시뮬 스텝 번호 → 위치
+		float MinZ = TNumericLimits<float>::Max();
+	};
+
+	void Fly(ADronePawn& Drone, const FVector& Start, const FP3DScriptedInput& Input, const FRate& Rate, FRun& OutRun)
+	{
+		Drone.SetActorLocationAndRotation(Start, FRotator::ZeroRotator, false, nullptr, ETeleportType::TeleportPhysics);
+		Drone.ResetFlightState();
+		Drone.InjectScriptedInput(Input);
+
+		float Elapsed = 0.f;
+		for (int32 Frame = 0; Elapsed < FlightSeconds; ++Frame)
+		{
+			const float DT = (Rate.bHitch && Frame == HitchFrame) ? HitchSeconds : Rate.FrameDT;
+			Drone.Tick(DT);
+			Elapsed += DT;
+
+			const FVector Location = Drone.GetSimTransform().GetLocation();
+			OutRun.Steps.Add(Drone.GetSimStepCount(), Location);
+			OutRun.MinZ = FMath::Min(OutRun.MinZ, float(Location.Z));
+		}
+	}
+
+	// 같은 스텝 번호끼리 최대 거리 + 마지막 공통 스텝 거리
+	void Compare(FAutomationTestBase& Test, const FString& What, const FRun& Reference, const FRun& Run)
+	{
+		double MaxDeviation = 0.0;
+		int32 Compared = 0;
+		uint64 LastCommonStep = 0;
+
+		for (const TPair<uint64, FVector>& Pair : Run.Steps)
+		{
+			if (const FVector* Other = Reference.Steps.Find(Pair.Key))
+			{
+				MaxDeviation = FMath::Max(MaxDeviation, FVector::Dist(*Other, Pair.Value));
+				LastCommonStep = FMath::Max(LastCommonStep, Pair.Key);
+				++Compared;
+			}
+		}
+
+		Test.TestTrue(FString::Printf(TEXT("%s: compared %d of %d steps"), *What, Compared, Reference.Steps.Num()),
+			Compared >= FMath::FloorToInt32(Reference.Steps.Num() * MinComparedRatio));
+		Test.TestTrue(FString::Printf(TEXT("%s: sampled max deviation %.4f cm <= %.4f cm"), *What, MaxDeviation, ToleranceCm),
+			MaxDeviation <= ToleranceCm);
+
+		if (LastCommonStep > 0)
+		{
+			const double FinalDeviation = FVector::Dist(Reference.Steps[LastCommonStep], Run.Steps[LastCommonStep]);
+			Test.TestTrue(FString::Printf(TEXT("%s: final (step %llu) deviation %.4f cm <= %.4f cm"), *What, LastCommonStep, FinalDeviation, ToleranceCm),
+				FinalDeviation <= ToleranceCm);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FP3DDroneFrameRateDeterminismTest, "Pawn3D.Drone.FrameRateDeterminism",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FP3DDroneFrameRateDeterminismTest::RunTest(const FString& Parameters)
+{
+	using namespace P3DDroneDeterminismTest;
+
+	FTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+
+	// 1) 자유 비행(바닥 없음): 전진 + 상승
+	{
+		const FVector Start(0.f, 0.f, 5000.f);
+		ADronePawn* Drone = SpawnDrone(World, Start);
+		if (!TestNotNull(TEXT("Spawn drone"), Drone)) return false;
+
+		FP3DScriptedInput Input;
+		Input.Move = FVector2D(0.3f, 1.f);
+		Input.UpDown = 0.5f;
+
+		TArray<FRun> Runs;
+		for (const FRate& Rate : Rates)
+		{
+			Fly(*Drone, Start, Input, Rate, Runs.AddDefaulted_GetRef());
+		}
+
+		for (int32 i = 1; i < Runs.Num(); ++i)
+		{
+			Compare(*this, FString::Printf(TEXT("Flight %s vs %s"), Rates[i].Name, Rates[0].Name), Runs[0], Runs[i]);
+		}
+
+		Drone->Destroy();
+	}
+
+	// 2) 얇은 바닥으로 하강: 히치 프레임에서도 바닥 위에 멈춤 + 착지 궤적 일치
+	{
+		constexpr float FloorTopZ = 0.f;
+		const FVector Start(0.f, 0.f, 150.f);
+
+		SpawnThinFloor(World, FloorTopZ);
+		TestWorld.FlushPhysics();
+
+		ADronePawn* Drone = SpawnDrone(World, Start);
+		if (!TestNotNull(TEXT("Spawn drone above floor"), Drone)) return false;
+
+		FP3DScriptedInput Input;
+		Input.Move = FVector2D(0.f, 0.5f);
+		Input.UpDown = -1.f;
+
+		// 중심이 바닥 윗면 아래로 내려가면 관통(반지름만큼 위에 떠 있어야 정상)
+		const float MinCenterZ = FloorTopZ;
+
+		TArray<FRun> Runs;
+		for (const FRate& Rate : Rates)
+		{
+			FRun& Run = Runs.AddDefaulted_GetRef();
+			Fly(*Drone, Start, Input, Rate, Run);
+
+			TestTrue(FString::Printf(TEXT("Landing %s: lowest center Z %.2f stays above floor top %.2f"), Rate.Name, Run.MinZ, MinCenterZ),
+				Run.MinZ > MinCenterZ);
+		}
+
+		for (int32 i = 1; i < Runs.Num(); ++i)
+		{
+			Compare(*this, FString::Printf(TEXT("Landing %s vs %s"), Rates[i].Name, Rates[0].Name), Runs[0], Runs[i]);
+		}
+
+		Drone->Destroy();
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,222 @@
+﻿#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "DroneNavSubsystem.h"
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+
+// =========================================================
+// 내비 옥트리 자동 무효화 (헤드리스: -nullrhi -ExecCmds="Automation RunTests Pawn3D.Drone")
+// - 바닥~천장을 막는 Stationary 벽이 한쪽을 막고 있는 상태로 BeginPlay → 옥트리 생성
+// - 벽을 반대쪽으로 옮기면(InvalidateNavBox 직접 호출 없음) 경로가 반대쪽으로 돌아감
+// - 벽을 파괴하면 거의 직선 경로
+// =========================================================
+namespace P3DDroneNavInvalidationTest
+{
+	// 옥트리 바운드 = 모서리 표시 박스 + 벽(Z로 바운드 전체를 덮어서 위로 넘어갈 수 없게)
+	constexpr float HalfSize = 1500.f;
+	constexpr float WallHalfHeight = 1600.f;
+	constexpr float WallHalfLength = 1000.f;
+	constexpr float WallHalfThickness = 50.f;
+
+	// 벽 중심 Y(한쪽 끝이 바운드 끝에 닿음) → 반대쪽에 틈
+	constexpr float WallOffsetY = HalfSize + 10.f - WallHalfLength;
+
+	const FVector PathStart(-1000.f, 0.f, 0.f);
+	const FVector PathGoal(1000.f, 0.f, 0.f);
+
+	constexpr double TimeoutSeconds = 10.0;
+
+	// 벽이 없을 때 직선 대비 허용 길이
+	constexpr double MaxStraightRatio = 1.1;
+
+	// BeginPlay 전에 액터를 놓을 수 있는 게임 월드(레벨에 배치된 지형처럼 보이게)
+	class FTestWorld
+	{
+	public:
+		FTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("P3DDroneNavInvalidationTest"));
+			FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+			Context.SetCurrentWorld(World);
+		}
+
+		~FTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		void BeginPlay() const
+		{
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+		}
+
+		// 등록된 바디를 씬 질의 가속 구조에 반영(월드 Tick을 안 돌리므로 직접)
+		void FlushPhysics() const
+		{
+			if (FPhysScene* Scene = World->GetPhysicsScene())
+			{
+				Scene->StartFrame();
+				Scene->WaitPhysScenes();
+				Scene->EndFrame();
+			}
+		}
+
+		UWorld* World = nullptr;
+	};
+
+	// 충돌만 있는 박스 액터
+	AActor* SpawnBlocker(UWorld* World, const FVector& Location, const FVector& Extent, EComponentMobility::Type Mobility)
+	{
+		AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity);
+		if (!Actor) return nullptr;
+
+		UBoxComponent* Box = NewObject<UBoxComponent>(Actor, TEXT("Blocker"));
+		Box->SetMobility(Mobility);
+		Box->SetBoxExtent(Extent, false);
+		Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		Box->SetWorldLocation(Location);
+		Actor->SetRootComponent(Box);
+		Box->RegisterComponent();
+		return Actor;
+	}
+
+	FBox WallBox(float CenterY)
+	{
+		const FVector Center(0.f, CenterY, 0.f);
+		const FVector Extent(WallHalfThickness, WallHalfLength, WallHalfHeight);
+		return FBox(Center - Extent, Center + Extent);
+	}
+
+	// 요청 → 결과가 올 때까지 서브시스템 Tick(무효화 적용 + 발송 + 전달)
+	bool QueryPath(UDroneNavSubsystem& Nav, FDroneNavPath& OutPath)
+	{
+		bool bDone = false;
+		Nav.RequestPath(PathStart, PathGoal, FOnDronePathReady::CreateLambda([&bDone, &OutPath](const FDroneNavPath& Path)
+		{
+			OutPath = Path;
+			bDone = true;
+		}));
+
+		const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+		while (!bDone && FPlatformTime::Seconds() < Deadline)
+		{
+			Nav.Tick(0.f);
+			if (!bDone)
+			{
+				FPlatformProcess::Sleep(0.001f);
+			}
+		}
+		return bDone;
+	}
+
+	bool Crosses(const FDroneNavPath& Path, const FBox& Box)
+	{
+		for (int32 i = 1; i < Path.Points.Num(); ++i)
+		{
+			const FVector& From = Path.Points[i - 1];
+			const FVector& To = Path.Points[i];
+			if (FMath::LineBoxIntersection(Box, From, To, To - From)) return true;
+		}
+		return false;
+	}
+
+	double Length(const FDroneNavPath& Path)
+	{
+		double Total = 0.0;
+		for (int32 i = 1; i < Path.Points.Num(); ++i)
+		{
+			Total += FVector::Dist(Path.Points[i - 1], Path.Points[i]);
+		}
+		return Total;
+	}
+
+	// 벽 가운데 X를 지나는 Y(벽을 어느 쪽으로 돌았는지)
+	double CrossingY(const FDroneNavPath& Path)
+	{
+		for (int32 i = 1; i < Path.Points.Num(); ++i)
+		{
+			const FVector& From = Path.Points[i - 1];
+			const FVector& To = Path.Points[i];
+			if ((From.X <= 0.0) != (To.X <= 0.0))
+			{
+				const double Alpha = From.X / (From.X - To.X);
+				return FMath::Lerp(From.Y, To.Y, Alpha);
+			}
+		}
+		return 0.0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FP3DDroneNavRerouteTest, "Pawn3D.Drone.NavRerouteOnBlockerChange",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FP3DDroneNavRerouteTest::RunTest(const FString& Parameters)
+{
+	using namespace P3DDroneNavInvalidationTest;
+
+	FTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+
+	SpawnBlocker(World, FVector(-HalfSize, -HalfSize, 0.f), FVector(10.f), EComponentMobility::Static);
+	SpawnBlocker(World, FVector(HalfSize, HalfSize, 0.f), FVector(10.f), EComponentMobility::Static);
+
+	AActor* Wall = SpawnBlocker(World, FVector(0.f, -WallOffsetY, 0.f),
+		FVector(WallHalfThickness, WallHalfLength, WallHalfHeight), EComponentMobility::Stationary);
+	if (!TestNotNull(TEXT("Spawn wall"), Wall)) return false;
+
+	TestWorld.FlushPhysics();
+	TestWorld.BeginPlay();
+
+	UDroneNavSubsystem* Nav = World->GetSubsystem<UDroneNavSubsystem>();
+	if (!TestNotNull(TEXT("Nav subsystem"), Nav)) return false;
+	if (!TestTrue(TEXT("Build nav octree"), Nav->BuildNavOctree())) return false;
+
+	// 1) 벽이 -Y 쪽 → +Y 틈으로
+	{
+		FDroneNavPath Path;
+		if (!TestTrue(TEXT("Initial path completes"), QueryPath(*Nav, Path))) return false;
+		TestTrue(TEXT("Initial path result"), Path.Result == EDroneNavPathResult::Success);
+		TestTrue(FString::Printf(TEXT("Initial path goes around +Y (crossing Y %.0f)"), CrossingY(Path)), CrossingY(Path) > 0.0);
+		TestFalse(TEXT("Initial path avoids the wall"), Crosses(Path, WallBox(-WallOffsetY)));
+	}
+
+	// 2) 벽을 +Y 쪽으로 옮김(자동 무효화만) → -Y 틈으로
+	{
+		Wall->SetActorLocation(FVector(0.f, WallOffsetY, 0.f), false, nullptr, ETeleportType::TeleportPhysics);
+		TestWorld.FlushPhysics();
+
+		FDroneNavPath Path;
+		if (!TestTrue(TEXT("Path after move completes"), QueryPath(*Nav, Path))) return false;
+		TestTrue(TEXT("Path after move result"), Path.Result == EDroneNavPathResult::Success);
+		TestTrue(FString::Printf(TEXT("Path after move goes around -Y (crossing Y %.0f)"), CrossingY(Path)), CrossingY(Path) < 0.0);
+		TestFalse(TEXT("Path after move avoids the moved wall"), Crosses(Path, WallBox(WallOffsetY)));
+	}
+
+	// 3) 벽 파괴 → 직선에 가까움
+	{
+		Wall->Destroy();
+		TestWorld.FlushPhysics();
+
+		FDroneNavPath Path;
+		if (!TestTrue(TEXT("Path after destroy completes"), QueryPath(*Nav, Path))) return false;
+		TestTrue(TEXT("Path after destroy result"), Path.Result == EDroneNavPathResult::Success);
+
+		const double Straight = FVector::Dist(PathStart, PathGoal);
+		TestTrue(FString::Printf(TEXT("Path after destroy length %.0f <= %.0f"), Length(Path), Straight * MaxStraightRatio),
+			Length(Path) <= Straight * MaxStraightRatio);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,269 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DroneSwarmSubsystem.h"
+#include "P3DBenchmarkSubsystem.generated.h"
+
+class APawn;
+class AP3DPlayerController;
+class FJsonObject;
+
+// =========================================================
+// Pawn 모듈 성능 벤치마크 (Pawn3DCharacterTests 모듈, 헤드리스 실행 가능)
+// - N개의 ABasePawn / ADronePawn을 현재 맵(L_StartMap)에 깔고 스크립트 입력으로 구동
+// - 시나리오: Pawn 수별 소크, 드론 바닥 탐색 동기/비동기, 고정 스텝 결정성, 빙의 전환 반복(1000회 반복 시 프레임 시간/할당 평탄성 포함),
+//   BasePawn 이동 컴포넌트 vs CharacterMovementComponent, 애니메이션 예산(애님 없음/예산 없음/예산),
+//   Mass 원거리 군중(엔티티당 메모리/프로세서 시간), 롤백 재시뮬 속도(드론 100대 기준 ms당 프레임),
+//   월드 파티션 스트리밍 비행(예측 소스 vs 기본 소스: 스트리밍 대기 프레임/상주 메모리, 월드 파티션 맵에서만),
+//   드론 3D 경로 탐색 동시 요청(요청~콜백 지연 p50/p95/p99, 초당 경로 수),
+//   드론 장애물 회피 감지(프레임당 레이 수/ms, 드론당 us, 예산 초과로 생략한 드론 수),
+//   드론 군집 대형(리더 1 + 팔로워 256, 대형별 솔버 ms/프레임 p95/60fps 유지 여부/슬롯 오차/겹침)
+// - 결과: Saved/Benchmarks/*.json, 기준(baseline) JSON과 비교해서 회귀 판정
+//   (커맨드라인 실행은 기준 파일이 없거나 못 읽으면, 또는 측정한 판정 지표에 기준 값이 없으면 실패 처리)
+// - 시나리오 구성/구동/집계는 기능별 P3DBenchmark<기능>.cpp, 여기 본체는 단계 진행/측정/결과만
+//
+// 실행 예)
+//   UnrealEditor-Cmd Pawn3DCharacter.uproject /Game/Maps/L_StartMap -game -nullrhi -P3DBench -P3DBenchCounts=1,10,100,1000
+//   콘솔: p3d.Bench.Run 1 10 100 / p3d.Bench.Stop / p3d.Bench.SaveBaseline
+// =========================================================
+UCLASS()
+class PAWN3DCHARACTERTESTS_API UP3DBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Counts가 비어 있으면 1/10/100/1000
+	void StartBenchmark(const TArray<int32>& Counts, bool bInQuitWhenDone);
+	void StopBenchmark();
+
+	bool IsRunning() const { return CurrentIndex != INDEX_NONE; }
+
+	// 마지막 결과 파일을 기준 파일 위치로 복사
+	bool SaveLastResultAsBaseline() const;
+
+private:
+	enum class EScenarioKind : uint8
+	{
+		Soak,          // N개 Pawn 스크립트 입력 구동
+		Determinism,   // 서로 다른 프레임 간격으로 같은 입력 → 시뮬 결과 비교
+		Possession,    // ToggleDrone N회 반복(Possession_Soak: 전반/후반 프레임 시간·할당 변화)
+		Mass,          // UP3DMassPopulationSubsystem 엔티티 N개(배회 + 승격/강등)
+		Rollback,      // 드론 N개 스냅샷 기록하며 구동 → 끝에서 최근 프레임 되돌려 재시뮬 반복
+		Streaming,     // 빙의한 드론으로 직선 비행(월드 파티션 셀 스트리밍 대기/메모리)
+		Navigation,    // UDroneNavSubsystem에 경로 요청 N개를 한 번에 넣고 게임 스레드 콜백까지 지연 측정
+		Swarm,         // 스크립트 입력 리더 1 + 팔로워 N(UDroneSwarmSubsystem 대형 유지)
+	};
+
+	// Soak에서 쓸 Pawn 클래스(Mover_*: 메시/애님 없는 C++ 클래스끼리 이동 비용만 비교)
+	enum class EMover : uint8
+	{
+		Default,       // 게임모드/컨트롤러에 설정된 클래스
+		Kinematic,     // ABasePawn + UBasePawnMovementComponent
+		Character,     // ACharacter + UCharacterMovementComponent
+	};
+
+	// Anim_*: 메시 애님 처리 방식(같은 N끼리 비교해서 애님 비용과 예산 준수 여부 산출)
+	enum class EAnimMode : uint8
+	{
+		Default,       // 현재 설정 그대로
+		NoAnim,        // 메시 Tick 끔(애님 비용 0 기준선)
+		NoBudget,      // 예산 할당기 끔(전부 매 프레임)
+		Budget,        // 예산 할당기 켬(p3d.Anim.BudgetMs)
+	};
+
+	enum class EPhase : uint8
+	{
+		Setup,
+		Warmup,
+		Measure,
+		Teardown,
+	};
+
+	struct FScenario
+	{
+		FString Name;
+		EScenarioKind Kind = EScenarioKind::Soak;
+		bool bDrone = false;
+		bool bAsyncProbe = false;
+		int32 Count = 0;
+		EMover Mover = EMover::Default;
+		EAnimMode Anim = EAnimMode::Default;
+		bool bPredictiveStreaming = false;
+		bool bAvoidance = false;
+		EDroneFormation Formation = EDroneFormation::Wedge;
+		int32 MeasureFrames = 0;       // 0이면 p3d.Bench.MeasureFrames
+	};
+
+	struct FFrameSample
+	{
+		double FrameMs = 0.0;
+		double GameThreadMs = 0.0;
+		double PawnTickMs = 0.0;
+		uint64 Allocs = 0;
+		uint64 SceneQueries = 0;
+		int32 AnimTicked = 0;
+		double MassMs = 0.0;
+		int32 MassPromoted = 0;
+		int32 AvoidRays = 0;
+		int32 AvoidOverBudget = 0;
+		double AvoidMs = 0.0;
+		double SwarmSolverMs = 0.0;
+		double SwarmSlotErrorCm = 0.0;
+		int32 SwarmOverlapPairs = 0;
+	};
+
+	// 시나리오별 결과(이름 → 값, 순서 유지)
+	struct FScenarioResult
+	{
+		FString Name;
+		TArray<TPair<FString, double>> Metrics;
+
+		void Add(const FString& Key, double Value) { Metrics.Emplace(Key, Value); }
+		const double* Find(const FString& Key) const;
+	};
+
+	TArray<FScenario> Scenarios;
+	TArray<FScenarioResult> Results;
+
+	int32 CurrentIndex = INDEX_NONE;
+	EPhase Phase = EPhase::Setup;
+	int32 PhaseFrame = 0;
+	bool bQuitWhenDone = false;
+
+	// 이번 시나리오에서 만든 Pawn(끝나면 제거)
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<APawn>> SpawnedPawns;
+
+	TArray<FFrameSample> Samples;
+
+	// 프레임 간 차이 계산용
+	uint64 LastAllocs = 0;
+	uint64 LastSceneQueries = 0;
+	uint64 LastPawnTickCycles = 0;
+	uint64 LastMassCycles = 0;
+
+	// Possession 시나리오
+	TWeakObjectPtr<AP3DPlayerController> BenchController;
+	TArray<double> ToggleMs;
+	TArray<double> ToggleAllocs;   // 전환 1회당 할당 수(ToggleMs와 같은 순서)
+
+	FString LastResultPath;
+
+	// Anim_* 시나리오 동안 바꾼 p3d.Anim.Budget 원래 값(INDEX_NONE이면 안 바꿈)
+	int32 SavedAnimBudget = INDEX_NONE;
+
+	// Rollback 시나리오 동안 바꾼 p3d.Rollback.Record 원래 값(INDEX_NONE이면 안 바꿈)
+	int32 SavedRollbackRecord = INDEX_NONE;
+
+	// Streaming 시나리오(끝나면 원래 Pawn 다시 빙의)
+	TWeakObjectPtr<APawn> StreamingSavedPawn;
+	FVector StreamingStart = FVector::ZeroVector;
+	int32 StreamStallFrames = 0;
+	int32 StreamHitchFrames = 0;
+	int32 StreamPeakLoadedCells = 0;
+	int64 StreamStartUsedMemory = 0;
+	int64 StreamPeakUsedMemory = 0;
+
+	// Swarm 시나리오(리더 = SpawnedPawns[0])
+	int32 BenchSwarmId = INDEX_NONE;
+	FVector SwarmStart = FVector::ZeroVector;
+
+private:
+	void BuildScenarios(const TArray<int32>& Counts);
+
+	void BeginScenario(const FScenario& Scenario);
+	void TickScenario(const FScenario& Scenario);
+	void EndScenario(const FScenario& Scenario);
+	int32 GetMeasureFrames(const FScenario& Scenario) const;
+
+	void SpawnPawns(const FScenario& Scenario);
+	void DestroyPawns();
+	void DriveScriptedInput(int32 Frame);
+
+	AP3DPlayerController* FindLocalController() const;
+
+	// ===== 기능별 시나리오(P3DBenchmark<기능>.cpp) =====
+
+	void AddDeterminismScenarios();
+	// 한 프레임 안에서 Tick을 직접 돌려 비교(엔진 Tick 간격과 무관)
+	void RunDeterminism(FScenarioResult& OutResult);
+
+	void AddPossessionScenarios();
+	// 로컬 컨트롤러가 없으면 false
+	bool BeginPossessionToggle();
+	void RunPossessionFrame();
+	void SummarizePossession(FScenarioResult& OutResult) const;
+	void EndPossessionToggle();
+
+	void AddRollbackScenarios();
+	// 기록된 최근 프레임을 여러 번 되돌려 재시뮬(재시뮬 속도/결정성/할당)
+	void RunRollbackResim(FScenarioResult& OutResult);
+	void SetRollbackRecording(bool bRecord);
+	void RestoreRollbackRecording();
+
+	void AddStreamingScenarios();
+	// 드론 스폰 + 빙의(월드 파티션 맵이 아니거나 로컬 컨트롤러가 없으면 false)
+	bool BeginStreamingFlight(const FScenario& Scenario);
+	void RunStreamingFrame(float DeltaTime);
+	void SummarizeStreaming(FScenarioResult& OutResult) const;
+	void EndStreamingFlight();
+
+	void AddNavigationScenarios();
+	// 옥트리가 없으면 런타임 생성(실패하면 false)
+	bool BeginNavigationStress();
+	void StartNavigationRequests(int32 Count);
+	void SummarizeNavigation(FScenarioResult& OutResult) const;
+
+	void AddSwarmScenarios();
+	// 리더 + 팔로워를 슬롯 자리에 스폰해서 군집 생성(서브시스템이 없으면 false)
+	bool BeginSwarm(const FScenario& Scenario);
+	void RunSwarmFrame(int32 Frame);
+	void SummarizeSwarm(FScenarioResult& OutResult) const;
+	void EndSwarm();
+
+	void AddMoverScenarios();
+	// Mover_Character_N 끝에서 같은 N의 Kinematic 결과와 비교 → Mover_Compare_N
+	void AddMoverComparison(const FScenario& Scenario);
+
+	void AddAnimScenarios();
+	void ApplyAnimMode(EAnimMode Mode);
+	void RestoreAnimMode();
+	int32 CountAnimTicked() const;
+
+	// Anim_Budget_N 끝에서 같은 N의 NoAnim/NoBudget 결과와 비교 → Anim_Compare_N
+	void AddAnimBudgetComparison(const FScenario& Scenario);
+
+	void AddMassScenarios();
+	// 엔티티 스폰(서브시스템이 없거나 하나도 못 만들면 false)
+	bool BeginMassPopulation(const FScenario& Scenario);
+	void SummarizeMass(FScenarioResult& OutResult) const;
+	void DestroyMassPopulation();
+
+	void AddAvoidanceScenarios();
+	void SummarizeAvoidance(FScenarioResult& OutResult) const;
+
+	// ===== 측정 / 결과 =====
+
+	void ResetCounters();
+	void RecordFrame(float DeltaTime);
+	void SummarizeSoak(const FScenario& Scenario, FScenarioResult& OutResult) const;
+
+	void Finish();
+	// 회귀 항목을 Root에 기록하고 개수 반환(커맨드라인 실행에서 기준 파일이 없으면 1)
+	int32 CompareWithBaseline(const TSharedRef<FJsonObject>& Root) const;
+	FString WriteResults(int32& OutRegressions);
+
+	FVector GetSpawnOrigin() const;
+	TSubclassOf<APawn> GetBasePawnClass() const;
+	TSubclassOf<APawn> GetDronePawnClass() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};